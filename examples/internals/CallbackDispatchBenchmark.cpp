@@ -0,0 +1,202 @@
+/** @file
+    @brief Benchmark of delivering tracker reports to client interfaces
+    through RemoteHandlerInternals, against the per-interface reference
+    counting and per-report passes it used to do. Not automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RemoteHandlerInternals.h"
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+namespace common = osvr::common;
+using osvr::client::RemoteHandlerInternals;
+
+/// Just enough of a client context to get interfaces from.
+class BenchmarkContext : public ::OSVR_ClientContextObject {
+  public:
+    explicit BenchmarkContext(common::ClientContextDeleter del)
+        : ::OSVR_ClientContextObject("com.osvr.bench.dispatch", del) {}
+
+  private:
+    void m_update() override {}
+    void m_sendRoute(std::string const &) override {}
+    common::PathTree const &m_getPathTree() const override { return m_tree; }
+    common::Transform const &m_getRoomToWorldTransform() const override {
+        return m_roomToWorld;
+    }
+    void m_setRoomToWorldTransform(common::Transform const &xform) override {
+        m_roomToWorld = xform;
+    }
+    common::PathTree m_tree;
+    common::Transform m_roomToWorld;
+};
+
+/// The previous dispatch: a reference-counted pin per interface, and a pass
+/// over the interfaces for each report.
+class PreviousInternals {
+  public:
+    explicit PreviousInternals(common::InterfaceList &ifaces)
+        : m_interfaces(ifaces) {}
+    template <typename ReportType>
+    void setStateAndTriggerCallbacks(const OSVR_TimeValue &timestamp,
+                                     ReportType const &report) {
+        common::ClientInterfacePtr pin;
+        for (auto &iface : m_interfaces) {
+            pin = iface;
+            pin->setState(timestamp, report);
+            pin->triggerCallbacks(timestamp, report);
+        }
+    }
+
+  private:
+    common::InterfaceList &m_interfaces;
+};
+
+static std::size_t g_callbacks = 0;
+static void poseCallback(void *, const OSVR_TimeValue *,
+                         const OSVR_PoseReport *) {
+    ++g_callbacks;
+}
+
+struct Reports {
+    OSVR_PoseReport pose;
+    OSVR_PositionReport position;
+    OSVR_OrientationReport orientation;
+};
+
+static Reports makeReports(int sensor) {
+    Reports ret;
+    ret.pose.sensor = sensor;
+    ret.pose.pose.translation = {{0.1, 1.6, -0.2}};
+    ret.pose.pose.rotation = {{1, 0, 0, 0}};
+    ret.position.sensor = sensor;
+    ret.position.xyz = ret.pose.pose.translation;
+    ret.orientation.sensor = sensor;
+    ret.orientation.rotation = ret.pose.pose.rotation;
+    return ret;
+}
+
+template <typename F>
+static double reportsPerSecond(std::size_t reports, F &&f) {
+    auto start = clock_type::now();
+    f();
+    auto seconds =
+        std::chrono::duration<double>(clock_type::now() - start).count();
+    return reports / seconds;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t rounds = 1000;
+    if (argc > 1) {
+        rounds = std::strtoul(argv[1], nullptr, 10);
+    }
+    const std::size_t sensors = 100;
+    const std::size_t interfacesPerSensor = 10;
+
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<BenchmarkContext>());
+    std::vector<common::InterfaceList> lists(sensors);
+    for (std::size_t sensor = 0; sensor < sensors; ++sensor) {
+        auto path = "/me/tracker/" + std::to_string(sensor);
+        for (std::size_t i = 0; i < interfacesPerSensor; ++i) {
+            auto iface = ctx->getInterface(path.c_str());
+            // A pose callback on some: the position and orientation
+            // reports go unsubscribed, as they usually do.
+            if (i % 2 == 0) {
+                iface->registerCallback(&poseCallback, nullptr);
+            }
+            lists[sensor].push_back(iface);
+        }
+    }
+    std::vector<Reports> reports;
+    for (std::size_t sensor = 0; sensor < sensors; ++sensor) {
+        reports.push_back(makeReports(static_cast<int>(sensor)));
+    }
+    OSVR_TimeValue timestamp = {1, 0};
+    auto total = rounds * sensors;
+
+    std::vector<RemoteHandlerInternals> current;
+    std::vector<PreviousInternals> previous;
+    current.reserve(sensors);
+    previous.reserve(sensors);
+    for (auto &list : lists) {
+        current.emplace_back(list);
+        previous.emplace_back(list);
+    }
+
+    auto currentRate = reportsPerSecond(total, [&] {
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (std::size_t sensor = 0; sensor < sensors; ++sensor) {
+                auto const &r = reports[sensor];
+                current[sensor].forEachInterface(
+                    [&](common::ClientInterface &iface) {
+                        RemoteHandlerInternals::deliver(iface, timestamp,
+                                                        r.pose);
+                        RemoteHandlerInternals::deliver(iface, timestamp,
+                                                        r.position);
+                        RemoteHandlerInternals::deliver(iface, timestamp,
+                                                        r.orientation);
+                    });
+            }
+        }
+    });
+    auto currentCallbacks = g_callbacks;
+    g_callbacks = 0;
+
+    auto previousRate = reportsPerSecond(total, [&] {
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (std::size_t sensor = 0; sensor < sensors; ++sensor) {
+                auto const &r = reports[sensor];
+                previous[sensor].setStateAndTriggerCallbacks(timestamp,
+                                                             r.pose);
+                previous[sensor].setStateAndTriggerCallbacks(timestamp,
+                                                             r.position);
+                previous[sensor].setStateAndTriggerCallbacks(timestamp,
+                                                             r.orientation);
+            }
+        }
+    });
+
+    std::cout << sensors << " sensors x " << interfacesPerSensor
+              << " interfaces, " << rounds << " rounds\n"
+              << "Pinned snapshot, single pass: " << currentRate
+              << " tracker reports/sec (" << currentCallbacks
+              << " callbacks)\n"
+              << "Previous: " << previousRate << " tracker reports/sec ("
+              << g_callbacks << " callbacks)" << std::endl;
+    return 0;
+}
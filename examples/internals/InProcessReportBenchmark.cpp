@@ -0,0 +1,122 @@
+/** @file
+    @brief Benchmark of the latency from a device sending a tracker report to
+    a consumer in the same process (like an analysis plugin) getting it: over
+    the VRPN loopback, as before, and through an in-process channel. Not
+    automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+
+// Internal Includes
+#include <osvr/Common/InProcessReportRouter.h>
+#include <osvr/Util/QuatlibInteropC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <quat.h>
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using clock_type = std::chrono::steady_clock;
+namespace common = osvr::common;
+
+static std::size_t g_callbacks = 0;
+
+static void VRPN_CALLBACK handleVrpnPose(void *, vrpn_TRACKERCB info) {
+    // What the client-side handler does with a decoded message.
+    OSVR_TimeValue timestamp;
+    osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+    OSVR_PoseState pose;
+    osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+    osvrVec3FromQuatlib(&(pose.translation), info.pos);
+    ++g_callbacks;
+}
+
+/// @returns mean nanoseconds per report, from sending to the callback
+/// returning.
+template <typename F> static double nanosecondsPerReport(std::size_t n, F &&f) {
+    auto start = clock_type::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        f(i);
+    }
+    return std::chrono::duration<double, std::nano>(clock_type::now() - start)
+               .count() /
+           n;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t reports = 1000000;
+    if (argc > 1) {
+        reports = std::strtoul(argv[1], nullptr, 10);
+    }
+    const int sensors = 16;
+
+    q_vec_type pos = {0.1, 1.6, -0.2};
+    q_type quat = {0, 0, 0, 1};
+
+    // Like the server: a device and an analysis plugin's remote share one
+    // connection, and messages are passed to local handlers as packed.
+    auto conn = vrpn_ConnectionPtr::create_server_connection("loopback:");
+    vrpn_Tracker_Server server("Bench", conn.get(), sensors);
+    vrpn_Tracker_Remote remote("Bench@localhost", conn.get());
+    remote.register_change_handler(nullptr, &handleVrpnPose);
+
+    auto vrpnLatency = nanosecondsPerReport(reports, [&](std::size_t i) {
+        struct timeval tv;
+        vrpn_gettimeofday(&tv, nullptr);
+        server.report_pose(int(i % sensors), tv, pos, quat);
+    });
+    auto vrpnCallbacks = g_callbacks;
+    g_callbacks = 0;
+
+    auto router = common::InProcessReportRouter::get(conn.get());
+    auto channel = router->getTrackerChannel("Bench");
+    channel->addPublisher();
+    common::TrackerReportChannel::Subscriber subscriber;
+    subscriber.pose = [](OSVR_TimeValue const &, OSVR_ChannelCount,
+                         OSVR_PoseState const &) { ++g_callbacks; };
+    auto id = channel->subscribe(subscriber);
+
+    auto inProcessLatency = nanosecondsPerReport(reports, [&](std::size_t i) {
+        // What the device does in addition to its VRPN message.
+        OSVR_TimeValue timestamp;
+        osvrTimeValueGetNow(&timestamp);
+        OSVR_PoseState pose;
+        osvrVec3FromQuatlib(&(pose.translation), pos);
+        osvrQuatFromQuatlib(&(pose.rotation), quat);
+        channel->sendPose(timestamp, OSVR_ChannelCount(i % sensors), pose);
+        // What the client context's update does.
+        channel->deliver(id);
+    });
+    channel->unsubscribe(id);
+    channel->removePublisher();
+
+    std::cout << reports << " tracker reports\n"
+              << "VRPN loopback: " << vrpnLatency << " ns/report ("
+              << vrpnCallbacks << " callbacks)\n"
+              << "In-process channel: " << inProcessLatency
+              << " ns/report (" << g_callbacks << " callbacks)" << std::endl;
+    return 0;
+}
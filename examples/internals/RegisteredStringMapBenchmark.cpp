@@ -0,0 +1,166 @@
+/** @file
+    @brief Benchmark of RegisteredStringMap with skeleton-sized name sets,
+    against the linear scan it used to do. Not automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/RegisteredStringMap.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+/// Names like a full-body skeleton with articulated hands, for each of a
+/// number of devices.
+static std::vector<std::string> makeSkeletonNames(std::size_t devices) {
+    static const char *bodyJoints[] = {
+        "pelvis",     "spine0",    "spine1",    "spine2",   "spine3",
+        "neck",       "head",      "clavicleL", "armL",     "forearmL",
+        "handL",      "clavicleR", "armR",      "forearmR", "handR",
+        "upperLegL",  "lowerLegL", "footL",     "toesL",    "upperLegR",
+        "lowerLegR",  "footR",     "toesR"};
+    static const char *fingers[] = {"thumb", "index", "middle", "ring",
+                                    "pinky"};
+    std::vector<std::string> names;
+    for (std::size_t dev = 0; dev < devices; ++dev) {
+        auto prefix = "/com_osvr_Skeleton" + std::to_string(dev) + "/";
+        for (auto joint : bodyJoints) {
+            names.push_back(prefix + joint);
+        }
+        for (auto side : {"Left", "Right"}) {
+            for (auto finger : fingers) {
+                for (int bone = 0; bone < 4; ++bone) {
+                    names.push_back(prefix + finger + side +
+                                    std::to_string(bone));
+                }
+            }
+        }
+    }
+    return names;
+}
+
+/// The previous implementation, for comparison.
+class LinearStringMap {
+  public:
+    std::size_t registerStringID(std::string const &str) {
+        auto it = std::find(begin(m_entries), end(m_entries), str);
+        if (it != end(m_entries)) {
+            return std::distance(begin(m_entries), it);
+        }
+        m_entries.push_back(str);
+        return m_entries.size() - 1;
+    }
+    std::size_t getStringID(std::string const &str) const {
+        return std::distance(
+            begin(m_entries),
+            std::find(begin(m_entries), end(m_entries), str));
+    }
+    std::string getStringFromId(std::size_t id) const {
+        return m_entries[id];
+    }
+
+  private:
+    std::vector<std::string> m_entries;
+};
+
+template <typename F> static double timeMicroseconds(F &&f) {
+    auto start = clock_type::now();
+    f();
+    return std::chrono::duration<double, std::micro>(clock_type::now() -
+                                                     start)
+        .count();
+}
+
+template <typename MapType, typename IdType>
+static void run(const char *label, std::vector<std::string> const &names,
+                std::size_t lookupRounds,
+                std::size_t (*getValue)(IdType),
+                IdType (*makeId)(std::size_t)) {
+    MapType map;
+    auto registerTime = timeMicroseconds([&] {
+        for (auto const &name : names) {
+            map.registerStringID(name);
+        }
+    });
+
+    // Lookups as done by the skeleton C API: by C string.
+    std::size_t checksum = 0;
+    auto lookupTime = timeMicroseconds([&] {
+        for (std::size_t round = 0; round < lookupRounds; ++round) {
+            for (auto const &name : names) {
+                checksum += getValue(map.getStringID(name.c_str()));
+            }
+        }
+    });
+
+    std::size_t totalLength = 0;
+    auto reverseTime = timeMicroseconds([&] {
+        for (std::size_t round = 0; round < lookupRounds; ++round) {
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                totalLength += map.getStringFromId(makeId(i)).size();
+            }
+        }
+    });
+
+    auto lookups = static_cast<double>(names.size() * lookupRounds);
+    std::cout << label << ":\n"
+              << "  register " << names.size() << " names: " << registerTime
+              << " us\n"
+              << "  name -> id: " << lookupTime * 1000. / lookups
+              << " ns per lookup\n"
+              << "  id -> name: " << reverseTime * 1000. / lookups
+              << " ns per lookup\n"
+              << "  (checksums " << checksum << ", " << totalLength << ")"
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t devices = 40;
+    if (argc > 1) {
+        devices = std::strtoul(argv[1], nullptr, 10);
+    }
+    const std::size_t lookupRounds = 10;
+    auto names = makeSkeletonNames(devices);
+    std::cout << devices << " skeleton devices, " << names.size()
+              << " names, " << lookupRounds << " lookup rounds\n"
+              << std::endl;
+
+    using osvr::util::StringID;
+    run<osvr::common::RegisteredStringMap, StringID>(
+        "RegisteredStringMap (hashed)", names, lookupRounds,
+        [](StringID id) { return std::size_t(id.value()); },
+        [](std::size_t i) { return StringID(static_cast<uint32_t>(i)); });
+    run<LinearStringMap, std::size_t>(
+        "Linear scan (previous)", names, lookupRounds,
+        [](std::size_t id) { return id; }, [](std::size_t i) { return i; });
+    return 0;
+}
@@ -0,0 +1,154 @@
+/** @file
+    @brief Benchmark of wakeup lateness for the sleep primitives used by the
+    server and device loops. Not automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/PreciseSleep.h>
+
+// Library/third-party includes
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using clock_type = osvr::util::time::PreciseClock;
+using std::chrono::microseconds;
+
+/// Prints statistics of wakeup lateness, in microseconds.
+static void report(const char *label, std::vector<double> late) {
+    double sum = 0;
+    for (auto l : late) {
+        sum += l;
+    }
+    auto mean = sum / late.size();
+    double sq = 0;
+    for (auto l : late) {
+        sq += (l - mean) * (l - mean);
+    }
+    std::sort(begin(late), end(late));
+    auto p99 = late[std::min(late.size() - 1, late.size() * 99 / 100)];
+    std::cout << label << ":\n"
+              << "  mean " << mean << " us late, std dev "
+              << std::sqrt(sq / late.size()) << " us, p99 " << p99
+              << " us, max " << late.back() << " us" << std::endl;
+}
+
+/// Times a relative sleep of @p period, @p iterations times.
+static void runSleep(const char *label, std::size_t iterations,
+                     microseconds period,
+                     std::function<void(microseconds)> const &sleep) {
+    std::vector<double> late;
+    late.reserve(iterations);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto start = clock_type::now();
+        sleep(period);
+        auto slept = std::chrono::duration<double, std::micro>(
+                         clock_type::now() - start)
+                         .count();
+        late.push_back(slept - period.count());
+    }
+    report(label, std::move(late));
+}
+
+/// Runs a periodic loop with a little work each iteration, and reports both
+/// wakeup lateness and how far the loop drifted from its nominal rate.
+static void runPeriodic(const char *label, std::size_t iterations,
+                        microseconds period, microseconds spin,
+                        microseconds work) {
+    std::vector<double> late;
+    late.reserve(iterations);
+    osvr::util::time::PeriodicDeadline deadline(period, spin);
+    auto start = clock_type::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto workEnd = clock_type::now() + work;
+        while (clock_type::now() < workEnd) {
+        }
+        late.push_back(
+            std::chrono::duration<double, std::micro>(deadline.wait())
+                .count());
+    }
+    auto elapsed =
+        std::chrono::duration<double, std::micro>(clock_type::now() - start)
+            .count();
+    report(label, std::move(late));
+    std::cout << "  drift " << elapsed - double(period.count()) * iterations
+              << " us over " << iterations << " periods, "
+              << deadline.missedDeadlines() << " deadlines missed"
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = 2000;
+    if (argc > 1) {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+    const microseconds period(1000);
+    const microseconds spin(100);
+    std::cout << iterations << " iterations of " << period.count()
+              << " us\n"
+              << std::endl;
+
+    runSleep("boost::this_thread::sleep (previous microsleep)", iterations,
+             period, [](microseconds us) {
+                 boost::this_thread::sleep(
+                     boost::posix_time::microseconds(us.count()));
+             });
+    runSleep("std::this_thread::sleep_for", iterations, period,
+             [](microseconds us) { std::this_thread::sleep_for(us); });
+    runSleep("util::time::sleepFor", iterations, period,
+             [](microseconds us) { osvr::util::time::sleepFor(us); });
+    runSleep("util::time::sleepFor, 100 us spin", iterations, period,
+             [&](microseconds us) { osvr::util::time::sleepFor(us, spin); });
+
+    // The old server loop: work, then sleep a fixed time.
+    const microseconds work(200);
+    {
+        std::vector<double> late;
+        auto start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto workEnd = clock_type::now() + work;
+            while (clock_type::now() < workEnd) {
+            }
+            osvr::util::time::sleepFor(period);
+        }
+        auto elapsed = std::chrono::duration<double, std::micro>(
+                           clock_type::now() - start)
+                           .count();
+        std::cout << "Work then sleep (previous server loop):\n  drift "
+                  << elapsed - double(period.count()) * iterations
+                  << " us over " << iterations << " periods" << std::endl;
+    }
+    runPeriodic("PeriodicDeadline", iterations, period,
+                microseconds::zero(), work);
+    runPeriodic("PeriodicDeadline, 100 us spin", iterations, period, spin,
+                work);
+    return 0;
+}
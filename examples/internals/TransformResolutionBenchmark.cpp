@@ -0,0 +1,147 @@
+/** @file
+    @brief Benchmark of resolving routes through deeply nested transforms,
+    and of getting the overall transform from the result either from the
+    pre-parsed levels or by the JSON round trip. Not automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Common/OriginalSource.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+#include <json/value.h>
+#include <json/writer.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using clock_type = std::chrono::steady_clock;
+namespace common = osvr::common;
+namespace elements = osvr::common::elements;
+
+static const char DEVICE[] = "com_osvr_Benchmark/Tracker";
+static const char SENSOR_PATH[] = "/com_osvr_Benchmark/Tracker/tracker/0";
+
+static std::string aliasPath(std::size_t i) {
+    return "/bench/alias" + std::to_string(i);
+}
+
+/// A chain of aliases, each pointing to the next through a few levels of
+/// the sort of transforms found in display and tracker configs.
+static void setupTree(common::PathTree &tree, std::size_t depth) {
+    tree.getNodeByPath("/com_osvr_Benchmark", elements::PluginElement());
+    tree.getNodeByPath(
+        "/com_osvr_Benchmark/Tracker",
+        elements::DeviceElement::createVRPNDeviceElement(DEVICE,
+                                                         "localhost:3883"));
+    tree.getNodeByPath("/com_osvr_Benchmark/Tracker/tracker",
+                       elements::InterfaceElement());
+    Json::FastWriter writer;
+    for (std::size_t i = 0; i < depth; ++i) {
+        Json::Value basis(Json::objectValue);
+        basis["changeBasis"]["x"] = "x";
+        basis["changeBasis"]["y"] = "-z";
+        basis["changeBasis"]["z"] = "y";
+        basis["child"] =
+            (i + 1 == depth) ? std::string(SENSOR_PATH) : aliasPath(i + 1);
+
+        Json::Value offset(Json::objectValue);
+        offset["translate"] = Json::Value(Json::arrayValue);
+        offset["translate"].append(0.01 * i);
+        offset["translate"].append(0.);
+        offset["translate"].append(-0.05);
+        offset["rotate"]["axis"] = "-y";
+        offset["rotate"]["degrees"] = 3;
+        offset["child"] = basis;
+
+        Json::Value level(Json::objectValue);
+        level["postrotate"]["axis"] = "z";
+        level["postrotate"]["radians"] = 0.01;
+        level["child"] = offset;
+        tree.getNodeByPath(aliasPath(i),
+                           elements::AliasElement(writer.write(level)));
+    }
+}
+
+template <typename F> static double timeMicroseconds(F &&f) {
+    auto start = clock_type::now();
+    f();
+    return std::chrono::duration<double, std::micro>(clock_type::now() -
+                                                     start)
+        .count();
+}
+
+static void run(std::size_t depth, std::size_t rounds) {
+    common::PathTree tree;
+    setupTree(tree, depth);
+    auto path = aliasPath(0);
+
+    double checksum = 0;
+    auto resolveTime = timeMicroseconds([&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            auto source = common::resolveTreeNode(tree, path);
+            checksum += source->getTransform().size();
+        }
+    });
+
+    auto source = *common::resolveTreeNode(tree, path);
+    auto composeTime = timeMicroseconds([&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            checksum += source.getTransform().compose().getPost()(0, 3);
+        }
+    });
+    auto jsonTime = timeMicroseconds([&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            common::JSONTransformVisitor visitor(source.getTransformJson());
+            checksum += visitor.getTransform().getPost()(0, 3);
+        }
+    });
+
+    std::cout << depth << " aliases, " << source.getTransform().size()
+              << " transform levels:\n"
+              << "  resolve route: " << resolveTime / rounds << " us\n"
+              << "  transform from parsed levels: " << composeTime / rounds
+              << " us\n"
+              << "  transform by JSON round trip: " << jsonTime / rounds
+              << " us\n"
+              << "  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t rounds = 1000;
+    if (argc > 1) {
+        rounds = std::strtoul(argv[1], nullptr, 10);
+    }
+    static const std::size_t depths[] = {1, 4, 16, 64};
+    for (auto depth : depths) {
+        run(depth, rounds);
+    }
+    return 0;
+}
@@ -32,6 +32,7 @@
 #include <osvr/Util/Logger.h>
 #include <osvr/Common/PathTree_fwd.h>
 #include <osvr/Common/ClientContext_fwd.h>
+#include <osvr/Common/ResolveTreeNode.h>
 #include <osvr/Client/InterfaceTree.h>
 
 // Library/third-party includes
@@ -110,6 +111,10 @@ namespace client {
         /// common::PathTreeOwner events.
         common::PathTreeObserverPtr m_treeObserver;
 
+        /// @brief Previous resolutions of paths to their sources, reused
+        /// across tree updates where the route is unchanged.
+        common::TreeNodeResolutionCache m_resolutionCache;
+
         /// @brief Factory for producing remote handlers
         RemoteHandlerFactory &m_factory;
 
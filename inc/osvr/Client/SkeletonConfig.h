@@ -31,6 +31,7 @@
 #include <osvr/Client/ViewerEye.h>
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Common/ClientInterfacePtr.h>
+#include <osvr/Common/InterfaceStateSnapshot.h>
 #include <osvr/Common/PathTree.h>
 #include <osvr/Common/RegisteredStringMap.h>
 #include <osvr/Util/ChannelCountC.h>
@@ -122,6 +123,10 @@ namespace client {
         InterfaceMap m_boneInterfaces;
         PoseMap m_jointPoses;
         PoseMap m_bonePoses;
+        /// @brief The joint interfaces followed by the bone interfaces.
+        osvr::common::InterfaceStateSnapshot m_snapshot;
+        std::vector<osvr::common::StateSnapshotEntry<OSVR_PoseReport>>
+            m_snapshotEntries;
     };
 
     inline bool
@@ -153,7 +158,7 @@ namespace client {
         // but we need to make sure we actually allocate an entry for it
 
         // get the string id
-        auto stringId =
+        auto const &stringId =
             m_jointMap.getStringFromId(m_jointInterfaces[jointIndex].first);
 
         // then get the joint id
@@ -169,11 +174,12 @@ namespace client {
             return false;
         }
         *boneId = 0;
-        if (boneIndex >= m_boneMap.getEntries().size()) {
+        if (boneIndex >= m_boneMap.size()) {
             return false;
         }
 
-        auto boneName = m_boneMap.getEntries().at(boneIndex);
+        auto const &boneName =
+            m_boneMap.getStringFromId(util::StringID(boneIndex));
 
         auto ret = getBoneId(boneName.c_str(), boneId);
 
@@ -224,18 +230,17 @@ namespace client {
     }
 
     inline OSVR_SkeletonBoneCount SkeletonConfig::getNumBones() const {
-        return static_cast<OSVR_SkeletonBoneCount>(
-            m_boneMap.getEntries().size());
+        return static_cast<OSVR_SkeletonBoneCount>(m_boneMap.size());
     }
 
     inline OSVR_SkeletonJointCount SkeletonConfig::getNumJoints() const {
-        return static_cast<OSVR_SkeletonJointCount>(
-            m_jointMap.getEntries().size());
+        return static_cast<OSVR_SkeletonJointCount>(m_jointMap.size());
     }
 
     inline std::string
     SkeletonConfig::getBoneName(OSVR_SkeletonBoneCount boneId) const {
-        auto boneName = m_boneMap.getStringFromId(util::StringID(boneId));
+        auto const &boneName =
+            m_boneMap.getStringFromId(util::StringID(boneId));
         if (boneName.empty()) {
             throw IdNotFound();
         }
@@ -243,7 +248,8 @@ namespace client {
     }
     inline std::string
     SkeletonConfig::getJointName(OSVR_SkeletonJointCount jointId) const {
-        auto jointName = m_jointMap.getStringFromId(util::StringID(jointId));
+        auto const &jointName =
+            m_jointMap.getStringFromId(util::StringID(jointId));
         if (jointName.empty()) {
             throw IdNotFound();
         }
@@ -41,6 +41,9 @@
 #include <boost/optional.hpp>
 
 // Standard includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 #include <utility>
@@ -131,7 +134,12 @@ namespace client {
             OSVR_DisplayInputCount displayInputIdx,
             util::Angle opticalAxisOffsetY = 0. * util::radians);
         util::Rectd m_getRect(double near, double far) const;
+        Eigen::Matrix4d m_computeProjection(double near, double far,
+                                            OSVR_MatrixConventions flags) const;
         Eigen::Isometry3d getPoseIsometry() const;
+        /// @brief Updates the cached eye pose and view, if the pose state
+        /// has changed since they were computed.
+        void m_updatePoseCache() const;
         InternalInterfaceOwner m_pose;
         Eigen::Vector3d m_offset;
 #if 0
@@ -145,6 +153,35 @@ namespace client {
         boost::optional<OSVR_RadialDistortionParameters> m_radDistortParams;
         OSVR_DisplayInputCount m_displayInputIdx;
         util::Angle m_opticalAxisOffsetY;
+
+        /// Unaligned, since eyes are stored in a plain std::vector.
+        typedef Eigen::Matrix<double, 4, 4, Eigen::DontAlign> CachedMatrix;
+
+        /// @name Cached eye pose and view matrix
+        /// @brief Keyed on the interface's state update count when they were
+        /// computed, since a new pose may repeat the last one's timestamp.
+        /// @{
+        mutable bool m_poseCacheValid = false;
+        mutable std::uint64_t m_poseCacheUpdateCount = 0;
+        mutable CachedMatrix m_poseCache;
+        mutable CachedMatrix m_viewCache;
+        /// @}
+
+        /// @brief A cached projection matrix: projection inputs are fixed for
+        /// the life of the display config.
+        struct CachedProjection {
+            double near;
+            double far;
+            OSVR_MatrixConventions flags;
+            CachedMatrix projection;
+        };
+        /// @brief Apps usually only use one or two sets of parameters, so a
+        /// few entries, replaced in turn, are plenty.
+        static const std::size_t PROJECTION_CACHE_SIZE = 4;
+        mutable std::array<CachedProjection, PROJECTION_CACHE_SIZE>
+            m_projectionCache;
+        mutable std::size_t m_projectionCacheCount = 0;
+        mutable std::size_t m_projectionCacheNext = 0;
     };
 
 } // namespace client
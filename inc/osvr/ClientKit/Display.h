@@ -375,6 +375,37 @@ namespace clientkit {
             return (ret == OSVR_RETURN_SUCCESS);
         }
 
+        /// @brief Attempt to get the view matrices of all eyes and the
+        /// projection matrices of their first surfaces at once.
+        ///
+        /// @param views Room for getNumEyes() matrices
+        /// @param projections Room for getNumEyes() matrices
+        ///
+        /// @return false if there was an error in the input parameters or if
+        /// no pose (and thus view) is yet available.
+        ///
+        /// @sa osvrClientGetViewerEyeViewProjectionMatricesd
+        bool getViewProjectionMatrices(double near, double far,
+                                       OSVR_MatrixConventions flags,
+                                       OSVR_EyeCount numEyes, double *views,
+                                       double *projections) {
+            OSVR_ReturnCode ret = osvrClientGetViewerEyeViewProjectionMatricesd(
+                m_disp, m_viewer, near, far, flags, numEyes, views,
+                projections);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
+        /// @overload
+        bool getViewProjectionMatrices(float near, float far,
+                                       OSVR_MatrixConventions flags,
+                                       OSVR_EyeCount numEyes, float *views,
+                                       float *projections) {
+            OSVR_ReturnCode ret = osvrClientGetViewerEyeViewProjectionMatricesf(
+                m_disp, m_viewer, near, far, flags, numEyes, views,
+                projections);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
         /// @name Iteration methods
         /// @{
         template <typename F>
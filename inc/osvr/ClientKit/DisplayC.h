@@ -266,6 +266,49 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
     OSVR_MatrixConventions flags, float *mat);
 
+/** @brief Get the view matrices of all eyes of a viewer, and the projection
+    matrices of their first surfaces, in one call - matrices of **doubles**.
+
+    Equivalent to calling osvrClientGetViewerEyeViewMatrixd() and
+    osvrClientGetViewerEyeSurfaceProjectionMatrixd() (with surface 0) for each
+    eye, for render loops that want them all each frame.
+
+    @param disp Display config object
+    @param viewer Viewer ID
+    @param near Distance to near clipping plane - must be nonzero, typically
+    positive.
+    @param far Distance to far clipping plane - must be nonzero, typically
+    positive and greater than near.
+    @param flags Bitwise OR of matrix convention flags (see @ref MatrixFlags),
+    used for both view and projection matrices.
+    @param numEyes Number of eyes the output arrays have room for: must be the
+    number of eyes from osvrClientGetNumEyesForViewer().
+    @param[out] viewMatrices Pass a double[numEyes * ::OSVR_MATRIX_SIZE]: the
+    view matrix for each eye, one after another.
+    @param[out] projectionMatrices Pass a double[numEyes * ::OSVR_MATRIX_SIZE]:
+    the projection matrix for each eye, one after another.
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose was
+    yet available for some eye, in which case the output arguments are
+    unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetViewerEyeViewProjectionMatricesd(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, double near, double far,
+    OSVR_MatrixConventions flags, OSVR_EyeCount numEyes, double *viewMatrices,
+    double *projectionMatrices);
+
+/** @brief Get the view matrices of all eyes of a viewer, and the projection
+    matrices of their first surfaces, in one call - matrices of **floats**.
+
+    @copydetails osvrClientGetViewerEyeViewProjectionMatricesd()
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetViewerEyeViewProjectionMatricesf(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, float near, float far,
+    OSVR_MatrixConventions flags, OSVR_EyeCount numEyes, float *viewMatrices,
+    float *projectionMatrices);
+
 /** @brief Each eye of each viewer in a display config has one or more surfaces
     (aka "screens") on which content should be rendered.
 
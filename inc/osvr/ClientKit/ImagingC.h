@@ -32,9 +32,11 @@
 /* Internal Includes */
 #include <osvr/ClientKit/Export.h>
 #include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/BoolC.h>
 #include <osvr/Util/ReturnCodesC.h>
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/StdInt.h>
 
 /* Library/third-party includes */
 /* none */
@@ -50,6 +52,52 @@ OSVR_EXTERN_C_BEGIN
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
 osvrClientFreeImage(OSVR_ClientContext ctx, OSVR_ImageBufferElement *buf);
 
+/** @brief Sets whether image callbacks lend frames instead of handing over
+    ownership of them (off by default).
+
+    Frames from a server on the same machine come in shared memory: by
+    default, the server can't reuse the memory of a frame until every image
+    buffer for it has been freed, so an app holding on to frames can stall
+    the camera. When lending, it can: a lent image buffer is only sure to be
+    valid during the callback. To keep the frame, copy it with
+    osvrClientCopyImage(). Either way, free the buffer from the callback with
+    osvrClientFreeImage() as usual. Frames reuse the memory of earlier ones:
+    a frame isn't lent while a lent buffer at its address is still unfreed.
+
+    @param ctx Client context.
+    @param borrowing Whether to lend frames.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetImageBorrowing(OSVR_ClientContext ctx, OSVR_CBool borrowing);
+
+/** @brief Gets an image buffer the app owns for an image buffer from a
+    callback, copying lent frames (into pooled memory) and sharing others.
+
+    Succeeds for lent frames during the callback, and afterwards if the
+    server hasn't written over the frame yet.
+
+    @param ctx Client context.
+    @param buf Image buffer from a callback, not yet freed.
+    @param[out] copy Image buffer for the same frame, to free with
+    osvrClientFreeImage() (in addition to buf).
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientCopyImage(OSVR_ClientContext ctx, OSVR_ImageBufferElement *buf,
+                    OSVR_ImageBufferElement **copy);
+
+/** @brief Asks servers on other machines to send only one in every
+    decimation frames over the network (1, sending every frame, by default).
+
+    Frames from a server on the same machine come in shared memory, so aren't
+    affected. The server sends the same frames to all of its remote clients,
+    so honors the request it got last.
+
+    @param ctx Client context.
+    @param decimation Frames per frame sent: at least 1.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetImagingDecimation(OSVR_ClientContext ctx, uint32_t decimation);
+
 OSVR_EXTERN_C_END
 
 #endif
@@ -0,0 +1,113 @@
+/** @file
+    @brief Header
+
+    Must be c-safe!
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_StateSnapshotC_h_GUID_706679B5_2AA7_44E4_BC6D_0A6266E0C3EE
+#define INCLUDED_StateSnapshotC_h_GUID_706679B5_2AA7_44E4_BC6D_0A6266E0C3EE
+
+/* Internal Includes */
+#include <osvr/ClientKit/Export.h>
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/BoolC.h>
+#include <osvr/Util/ClientOpaqueTypesC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/ReturnCodesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+#include <stdint.h>
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup ClientKit
+    @{
+    @name State Snapshot API
+    @{
+*/
+
+/** @brief Opaque type of a state snapshot: a set of interfaces whose states
+    can be read all at once, typically once per rendered frame.
+
+    Reading states one interface at a time, with an osvrClientUpdate() call
+    in between, can mix states from before and after that update: a snapshot
+    reads all of them in one call, from the same update.
+*/
+typedef struct OSVR_StateSnapshotObject *OSVR_StateSnapshot;
+
+/** @brief The pose state of one interface in a snapshot. */
+typedef struct OSVR_PoseSnapshotEntry {
+    /** @brief Time of the report the state is from. */
+    struct OSVR_TimeValue timestamp;
+    /** @brief The state, if valid. */
+    OSVR_PoseState state;
+    /** @brief Whether the interface had any pose state yet. */
+    OSVR_CBool valid;
+} OSVR_PoseSnapshotEntry;
+
+/** @brief Creates a state snapshot of the given interfaces.
+
+    @param ctx Client context
+    @param ifaces Array of interfaces from that context. They must not be freed
+    before the snapshot is.
+    @param numInterfaces Number of interfaces in ifaces.
+    @param[out] snapshot Output parameter for the snapshot: free it with
+    osvrClientFreeStateSnapshot() (or it is freed with the context).
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientCreateStateSnapshot(
+    OSVR_ClientContext ctx, OSVR_ClientInterface const *ifaces,
+    uint32_t numInterfaces, OSVR_StateSnapshot *snapshot);
+
+/** @brief Reads the latest pose state of every interface in a snapshot into
+    an array you provide, in the order the interfaces were given when creating
+    the snapshot. Does not allocate.
+
+    @param snapshot State snapshot
+    @param[out] entries Array with room for numEntries entries: entries for
+    interfaces without pose state have valid set to false.
+    @param numEntries Must be the number of interfaces in the snapshot.
+    @param[out] updateCount Optional (may be NULL): the number of
+    osvrClientUpdate() calls so far, identifying the update all these states
+    are from.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetPoseSnapshot(OSVR_StateSnapshot snapshot,
+                          OSVR_PoseSnapshotEntry *entries, uint32_t numEntries,
+                          uint64_t *updateCount);
+
+/** @brief Frees a state snapshot. The interfaces in it are not freed. */
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientFreeStateSnapshot(OSVR_StateSnapshot snapshot);
+
+/** @} */
+/** @} */
+
+OSVR_EXTERN_C_END
+
+#endif
@@ -38,6 +38,7 @@
 
 namespace osvr {
 namespace common {
+    class WildcardAliasSet;
     namespace detail {
         /// @brief Options struct for internal usage by AliasProcessor
         struct AliasProcessorOptions {
@@ -45,6 +46,7 @@ namespace common {
             bool permitRelativeSource = false;
             bool permitWildcard = false;
             AliasPriority defaultPriority = ALIASPRIORITY_AUTOMATIC;
+            WildcardAliasSet *wildcardRecord = nullptr;
         };
     } // namespace detail
 
@@ -108,6 +110,15 @@ namespace common {
             m_opts.defaultPriority = prio;
             return *this;
         }
+
+        /// @brief Record wildcard aliases with absolute paths in the given
+        /// set, so they can later be applied to nodes added to the tree
+        /// without processing all aliases again. Implies enableWildcard().
+        AliasProcessor &recordWildcardsIn(WildcardAliasSet &wildcards) {
+            m_opts.permitWildcard = true;
+            m_opts.wildcardRecord = &wildcards;
+            return *this;
+        }
         /// @}
 
         /// @name Action methods
@@ -0,0 +1,89 @@
+/** @file
+    @brief Header for referring to image frames in shared memory without
+    holding them, and for copying them out into pooled buffers.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BorrowedImage_h_GUID_101D6953_2BF8_48E7_A5B2_246B3F61F831
+#define INCLUDED_BorrowedImage_h_GUID_101D6953_2BF8_48E7_A5B2_246B3F61F831
+
+// Internal Includes
+#include <osvr/Common/ClientContext_fwd.h>
+#include <osvr/Common/Export.h>
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief A frame in a shared memory ring buffer, lent to the client: it
+    /// holds no lock on the frame, so doesn't keep the server from writing
+    /// over it.
+    ///
+    /// The sequence number of the frame serves as its generation: once it's
+    /// no longer in the ring buffer, the frame is gone.
+    struct BorrowedImage {
+        OSVR_ImagingMetadata metadata;
+        IPCRingBufferPtr shm;
+        IPCRingBuffer::sequence_type seqNum;
+        /// @brief The frame, locked, while callbacks for it are running:
+        /// empty otherwise.
+        ImageBufferPtr locked;
+    };
+    typedef shared_ptr<BorrowedImage> BorrowedImagePtr;
+
+    /// @brief Gets the size of an image buffer, in bytes.
+    inline std::size_t getImageBufferSize(OSVR_ImagingMetadata const &meta) {
+        return std::size_t(meta.height) * meta.width * meta.depth *
+               meta.channels;
+    }
+
+    /// @brief Copies a borrowed frame into a buffer from a pool shared by
+    /// the process: the buffer goes back into the pool when released.
+    ///
+    /// @returns an empty pointer if the frame has been written over.
+    OSVR_COMMON_EXPORT ImageBufferPtr
+    copyBorrowedImage(BorrowedImage const &image);
+
+    /// @brief Gives a client context @p n references to a frame, one for
+    /// each callback about to get it, keyed by the address of its data.
+    ///
+    /// Frames from shared memory are lent, if the context asks for that,
+    /// using @p borrowed (created if empty) so contexts share one lock. Ring
+    /// buffer entries reuse addresses, though: a frame isn't lent while the
+    /// context still has a lent frame of another generation at its address,
+    /// so the address always refers to the newest one. It's handed over
+    /// instead, like when not lending.
+    OSVR_COMMON_EXPORT void acquireImage(ClientContext &ctx,
+                                         ImageData const &data, std::size_t n,
+                                         BorrowedImagePtr &borrowed);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_BorrowedImage_h_GUID_101D6953_2BF8_48E7_A5B2_246B3F61F831
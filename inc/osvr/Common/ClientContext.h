@@ -43,6 +43,7 @@
 #include <boost/any.hpp>
 
 // Standard includes
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -56,6 +57,11 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// @brief System-wide update method.
     OSVR_COMMON_EXPORT void update();
 
+    /// @brief Gets the number of completed calls to update(): interface
+    /// state only changes during update(), so states read while this stays
+    /// the same are from the same update.
+    std::uint64_t getUpdateCount() const { return m_updateCount; }
+
     /// @brief Accessor for app ID
     std::string const &getAppId() const;
 
@@ -95,12 +101,42 @@ struct OSVR_ClientContextObject : boost::noncopyable {
         return m_ownedObjects.acquire(obj);
     }
 
+    /// @brief Pass ownership of some object to the client context, to be
+    /// released by a key other than its own address.
+    template <typename T> void *acquireObject(void *key, T obj) {
+        return m_ownedObjects.acquire(key, obj);
+    }
+
+    /// @brief Finds an object, of type T, whose lifetime is controlled by the
+    /// client context.
+    ///
+    /// @returns null if not found.
+    template <typename T> T *findObject(void *key) {
+        return m_ownedObjects.find<T>(key);
+    }
+
     /// @brief Frees some object whose lifetime is controlled by the client
     /// context.
     ///
     /// @returns true if the object was found and released.
     OSVR_COMMON_EXPORT bool releaseObject(void *obj);
 
+    /// @brief Sets whether image callbacks lend frames from shared memory
+    /// instead of handing over ownership: see osvrClientSetImageBorrowing()
+    void setImageBorrowing(bool borrowing) { m_imageBorrowing = borrowing; }
+
+    /// @brief Gets whether image callbacks lend frames from shared memory.
+    bool getImageBorrowing() const { return m_imageBorrowing; }
+
+    /// @brief Sets how many frames remote imaging servers should skip per
+    /// frame sent over the network: see osvrClientSetImagingDecimation()
+    void setImagingDecimation(std::uint32_t decimation) {
+        m_imagingDecimation = decimation;
+    }
+
+    /// @brief Gets the imaging decimation requested of remote servers.
+    std::uint32_t getImagingDecimation() const { return m_imagingDecimation; }
+
     /// @brief Gets the transform from room space to world space.
     OSVR_COMMON_EXPORT osvr::common::Transform const &
     getRoomToWorldTransform() const;
@@ -163,10 +199,13 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     m_setRoomToWorldTransform(osvr::common::Transform const &xform) = 0;
 
     std::string const m_appId;
+    std::uint64_t m_updateCount = 0;
     InterfaceList m_interfaces;
     osvr::common::ClientInterfaceFactory m_clientInterfaceFactory;
 
     osvr::util::MultipleKeyedOwnershipContainer m_ownedObjects;
+    bool m_imageBorrowing = false;
+    std::uint32_t m_imagingDecimation = 1;
     osvr::common::ClientContextDeleter m_deleter;
 
     /// Logger for the use of OSVR libraries on behalf of the client
@@ -42,6 +42,7 @@
 #include <boost/any.hpp>
 
 // Standard includes
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
@@ -85,6 +86,12 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
 
     bool hasAnyState() const { return m_state.hasAnyState(); }
 
+    /// @brief Gets a count that changes whenever any state on this interface
+    /// is set: see InterfaceState::getUpdateCount()
+    std::uint64_t getStateUpdateCount() const {
+        return m_state.getUpdateCount();
+    }
+
     /// @brief Set saved state for a report type.
     template <typename ReportType>
     void setState(const OSVR_TimeValue &timestamp, ReportType const &report) {
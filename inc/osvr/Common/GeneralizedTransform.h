@@ -27,14 +27,17 @@
 
 // Internal Includes
 #include <osvr/Common/Export.h>
+#include <osvr/Common/Transform.h>
 #include <osvr/Util/ContainerWrapper.h>
 
 // Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
 #include <json/value.h>
 
 // Standard includes
 #include <vector>
 #include <algorithm>
+#include <string>
 
 namespace osvr {
 namespace common {
@@ -42,6 +45,11 @@ namespace common {
     ///
     /// Stores the levels of the transform in outer-inner order, with the
     /// "child" key/value removed and only re-created in get().
+    ///
+    /// Each level is also parsed as it is added, and composed into the
+    /// overall transform retrieved by compose(), so that doesn't require
+    /// going back through the JSON. (Levels modified in place through the
+    /// iterators are only re-parsed on resize(), as remove_if() does.)
     class GeneralizedTransform
         : public util::ContainerWrapper<std::vector<Json::Value>,
                                         util::container_policies::iterators,
@@ -93,14 +101,31 @@ namespace common {
         /// If leaf is empty, behaves like get()
         OSVR_COMMON_EXPORT Json::Value get(std::string const &leaf) const;
 
+        /// @brief Get the overall transformation described by all levels:
+        /// equivalent to parsing get() with a JSONTransformVisitor.
+        /// @throws std::runtime_error if any level was malformed.
+        OSVR_COMMON_EXPORT Transform compose() const;
+
         /// @brief A shrinking resize.
         void resize(const_iterator newEnd) {
             container().resize(newEnd - begin());
+            recomposeTransform();
         }
 
       private:
         void pushLevelBack(Json::Value level);
         Json::Value recompose(Json::Value leaf = Json::nullValue) const;
+        /// @brief Parse a level and compose it either inside or outside of
+        /// the levels composed so far.
+        void composeLevel(Json::Value const &level, bool inner);
+        OSVR_COMMON_EXPORT void recomposeTransform();
+
+        /// Unaligned, since this gets copied around in other containers.
+        typedef Eigen::Matrix<double, 4, 4, Eigen::DontAlign> Matrix;
+        Matrix m_pre = Matrix::Identity();
+        Matrix m_post = Matrix::Identity();
+        /// @brief Error from parsing a malformed level, if any.
+        std::string m_error;
     };
 
     /// @brief Remove levels from a generalized transform as dictated by an
@@ -0,0 +1,48 @@
+/** @file
+    @brief Header for a process-wide pool of image buffers.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageBufferPool_h_GUID_1F560029_39FC_490A_B479_02D3C029E507
+#define INCLUDED_ImageBufferPool_h_GUID_1F560029_39FC_490A_B479_02D3C029E507
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/ImagingComponent.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief Gets an aligned image buffer of the given size from a pool
+    /// shared by the process: the buffer goes back into the pool when
+    /// released, since frames usually come one after another, all the same
+    /// size.
+    OSVR_COMMON_EXPORT ImageBufferPtr makePooledImageBuffer(std::size_t bytes);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageBufferPool_h_GUID_1F560029_39FC_490A_B479_02D3C029E507
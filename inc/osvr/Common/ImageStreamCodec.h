@@ -0,0 +1,103 @@
+/** @file
+    @brief Header for the lossless encoding of image frames sent over the
+    network.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageStreamCodec_h_GUID_1B26C51F_9424_4333_AF94_3490AADAE997
+#define INCLUDED_ImageStreamCodec_h_GUID_1B26C51F_9424_4333_AF94_3490AADAE997
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief How an image frame sent over the network is encoded.
+    enum class ImageEncoding : uint8_t {
+        /// @brief The bytes of the frame as-is.
+        Raw = 0,
+        /// @brief Each byte as the difference from the same byte of the
+        /// previous pixel, then run-length encoded (PackBits-style): suited to
+        /// frames with large flat areas, like those of IR tracking cameras.
+        DeltaRLE = 1
+    };
+
+    /// @brief Encodes a frame with ImageEncoding::DeltaRLE, appending to out.
+    ///
+    /// @param pixelStride Bytes per pixel (channels times depth): nonzero.
+    OSVR_COMMON_EXPORT void encodeDeltaRLE(uint8_t const *src, std::size_t len,
+                                           std::size_t pixelStride,
+                                           std::vector<uint8_t> &out);
+
+    /// @brief Decodes a frame encoded with ImageEncoding::DeltaRLE into dest,
+    /// which must have room for exactly destLen bytes.
+    ///
+    /// @returns false if the encoded data is malformed or doesn't decode to
+    /// destLen bytes.
+    OSVR_COMMON_EXPORT bool decodeDeltaRLE(uint8_t const *src, std::size_t len,
+                                           std::size_t pixelStride,
+                                           uint8_t *dest, std::size_t destLen);
+
+    /// @brief Header of a piece of a frame sent over the network: the piece
+    /// itself follows it in the message.
+    struct ImageChunkHeader {
+        OSVR_ImagingMetadata metadata;
+        OSVR_ChannelCount sensor;
+        uint32_t frameNumber;
+        uint32_t chunkIndex;
+        uint32_t chunkCount;
+        ImageEncoding encoding;
+        /// @brief Size of the whole frame, as encoded.
+        uint32_t encodedSize;
+        /// @brief Where this piece goes in the encoded frame.
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    /// @brief Highest sensor number accepted in image chunks: each sensor
+    /// gets state of its own, allocated up to the highest one seen.
+    static const OSVR_ChannelCount MAX_IMAGE_CHUNK_SENSOR = 255;
+
+    /// @brief Largest frame, in bytes, accepted in image chunks: 256 MiB,
+    /// enough for 8K (7680x4320) with four 16-bit channels.
+    static const uint32_t MAX_IMAGE_CHUNK_FRAME_SIZE = 256 * 1024 * 1024;
+
+    /// @brief Checks the parts of an image chunk that don't depend on any
+    /// earlier chunk, before anything is allocated from them.
+    ///
+    /// @param payloadLen Bytes in the message after the header.
+    OSVR_COMMON_EXPORT bool isImageChunkValid(ImageChunkHeader const &header,
+                                              std::size_t payloadLen);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageStreamCodec_h_GUID_1B26C51F_9424_4333_AF94_3490AADAE997
@@ -26,9 +26,11 @@
 #define INCLUDED_ImagingComponent_h_GUID_BA26C922_01FD_43B3_8EB7_A9AB2777CEBC
 
 // Internal Includes
+#include <osvr/Common/Buffer.h>
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/Export.h>
 #include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Common/ImageStreamCodec.h>
 #include <osvr/Common/ImagingComponentConfig.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Util/ChannelCountC.h>
@@ -38,7 +40,7 @@
 #include <vrpn_BaseClass.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -47,7 +49,21 @@ namespace common {
         OSVR_ChannelCount sensor;
         OSVR_ImagingMetadata metadata;
         ImageBufferPtr buffer;
+        /// @brief For frames from shared memory, the ring buffer and sequence
+        /// number, so the frame can be lent instead of held (null otherwise).
+        IPCRingBufferPtr shm;
+        IPCRingBuffer::sequence_type seqNum;
     };
+    /// @brief How image frames are sent to clients over the network (as
+    /// opposed to shared memory).
+    struct NetworkImagingOptions {
+        /// @brief Frames per frame sent: 1 sends every frame.
+        uint32_t decimation = 1;
+        /// @brief Encoding tried for frames too large for a single message:
+        /// frames it doesn't shrink are sent raw.
+        ImageEncoding encoding = ImageEncoding::DeltaRLE;
+    };
+
     namespace messages {
         class ImageRegion : public MessageRegistration<ImageRegion> {
           public:
@@ -69,6 +85,17 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+        class ImageChunk : public MessageRegistration<ImageChunk> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+        class ImagingNetworkRequest
+            : public MessageRegistration<ImagingNetworkRequest> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component
@@ -99,6 +126,14 @@ namespace common {
         messages::ImagePlacedInProcessMemory imagePlacedInProcessMemory;
 #endif
 
+        /// @brief Message from server to client, containing a piece of a
+        /// (possibly encoded) frame too large for an imageRegion message.
+        messages::ImageChunk imageChunk;
+
+        /// @brief Message from client to server, requesting how frames are
+        /// sent over the network.
+        messages::ImagingNetworkRequest imagingNetworkRequest;
+
         OSVR_COMMON_EXPORT void sendImageData(
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
@@ -108,6 +143,23 @@ namespace common {
             ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
 
+        /// @brief Sets how frames are sent over the network (server side).
+        ///
+        /// Client requests later override the decimation.
+        OSVR_COMMON_EXPORT void
+        setNetworkOptions(NetworkImagingOptions const &options);
+
+        /// @brief Asks the server to send only one in every decimation
+        /// frames over the network (client side).
+        ///
+        /// This also tells the server that this client understands
+        /// imageChunk messages: until some client has sent it, frames too
+        /// large for an imageRegion message aren't sent over the network.
+        ///
+        /// The server has one stream for all its remote clients, so the last
+        /// request wins.
+        OSVR_COMMON_EXPORT void requestNetworkDecimation(uint32_t decimation);
+
       private:
         ImagingComponent();
         virtual void m_parentSet();
@@ -124,6 +176,13 @@ namespace common {
                                       OSVR_ChannelCount sensor,
                                       OSVR_TimeValue const &timestamp);
 
+        /// @brief Sends a frame as one or more imageChunk messages.
+        /// @return true if we could send it.
+        bool m_sendImageChunks(OSVR_ImagingMetadata const &metadata,
+                               OSVR_ImageBufferElement *imageData,
+                               OSVR_ChannelCount sensor,
+                               OSVR_TimeValue const &timestamp);
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         /// @return true if we could send it.
         bool m_sendImageDataViaInProcessMemory(
@@ -142,13 +201,51 @@ namespace common {
         m_handleImagePlacedInProcessMemory(void *userdata, vrpn_HANDLERPARAM p);
 #endif
 
+        static int VRPN_CALLBACK m_handleImageChunk(void *userdata,
+                                                    vrpn_HANDLERPARAM p);
+
+        static int VRPN_CALLBACK
+        m_handleImagingNetworkRequest(void *userdata, vrpn_HANDLERPARAM p);
+
         void m_checkFirst(OSVR_ImagingMetadata const &metadata);
         void m_growShmVecIfRequired(OSVR_ChannelCount sensor);
+        void m_growWireVecsIfRequired(OSVR_ChannelCount sensor);
+
+        /// @brief A frame being reassembled from imageChunk messages.
+        struct PartialFrame {
+            bool active = false;
+            uint32_t frameNumber = 0;
+            uint32_t chunksReceived = 0;
+            uint32_t chunkCount = 0;
+            OSVR_ImagingMetadata metadata;
+            ImageEncoding encoding = ImageEncoding::Raw;
+            uint32_t encodedSize = 0;
+            /// @brief Where raw chunks go.
+            ImageBufferPtr buffer;
+            /// @brief Where encoded chunks go, kept between frames.
+            std::vector<uint8_t> encoded;
+        };
 
         std::vector<ImageHandler> m_cb;
         bool m_gotOne;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+
+        NetworkImagingOptions m_networkOptions;
+        /// @brief Has a remote client asked for frames, so we know it
+        /// understands imageChunk messages?
+        bool m_chunksRequested = false;
+        /// @brief Frames sent over the network, one for each sensor
+        std::vector<uint32_t> m_wireFrameNumbers;
+        /// @brief Frames skipped since the last one sent, one for each sensor
+        std::vector<uint32_t> m_wireFramesSkipped;
+        /// @brief Encoded frame scratch space, kept between frames.
+        std::vector<uint8_t> m_encoded;
+        /// @brief Message buffer for image data sent over the network, kept
+        /// between frames so it's only allocated once.
+        Buffer<> m_sendBuffer;
+        /// @brief One for each sensor
+        std::vector<PartialFrame> m_partialFrames;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,279 @@
+/** @file
+    @brief Header for passing device reports directly to consumers in the same
+    process (such as analysis plugins in the server), instead of through VRPN
+    messages on a connection.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InProcessReportRouter_h_GUID_EEAE3312_DA75_4806_8B95_8792FD848F2E
+#define INCLUDED_InProcessReportRouter_h_GUID_EEAE3312_DA75_4806_8B95_8792FD848F2E
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class vrpn_Connection;
+
+namespace osvr {
+namespace common {
+    /// @brief The tracker reports of one device, as sent by the device: the
+    /// same content as its VRPN tracker messages (and so with the same
+    /// defaults for parts not sent), but without encoding or decoding them.
+    ///
+    /// Timing: sending only queues a report for each subscriber. The
+    /// handlers are called, in the order the reports were sent, when the
+    /// subscriber calls deliver() - a client context does that from its
+    /// update(), just where it would have run the VRPN remote's mainloop.
+    /// So an analysis plugin gets all the reports of a server loop pass from
+    /// its client context update, before its own device update runs, as it
+    /// did over VRPN.
+    ///
+    /// Threading: none of the channel is thread-safe (only the router is),
+    /// so devices must send from the server thread, which is also where
+    /// consumers update. Handlers are called on the thread calling
+    /// deliver(), and must not subscribe or unsubscribe.
+    class TrackerReportChannel : boost::noncopyable {
+      public:
+        typedef std::function<void(OSVR_TimeValue const &, OSVR_ChannelCount,
+                                   OSVR_PoseState const &)>
+            PoseHandler;
+        typedef std::function<void(OSVR_TimeValue const &, OSVR_ChannelCount,
+                                   OSVR_VelocityState const &)>
+            VelocityHandler;
+        typedef std::function<void(OSVR_TimeValue const &, OSVR_ChannelCount,
+                                   OSVR_AccelerationState const &)>
+            AccelerationHandler;
+
+        /// @brief Handlers for a consumer: any may be empty.
+        struct Subscriber {
+            PoseHandler pose;
+            VelocityHandler velocity;
+            AccelerationHandler acceleration;
+        };
+
+        typedef std::size_t SubscriptionID;
+
+        /// @brief Reports queued for a subscriber that doesn't call deliver()
+        /// are dropped, oldest first, past this many.
+        static const std::size_t MAX_QUEUED_REPORTS = 4096;
+
+        /// @name Consumer methods
+        /// @{
+        /// @brief Whether a device is currently sending on this channel: if
+        /// not, consumers should use VRPN instead.
+        bool hasPublisher() const { return m_publishers > 0; }
+
+        SubscriptionID subscribe(Subscriber const &subscriber) {
+            auto id = ++m_lastID;
+            m_subscriptions.emplace_back();
+            m_subscriptions.back().id = id;
+            m_subscriptions.back().handlers = subscriber;
+            return id;
+        }
+
+        void unsubscribe(SubscriptionID id) {
+            for (auto it = begin(m_subscriptions), e = end(m_subscriptions);
+                 it != e; ++it) {
+                if (it->id == id) {
+                    m_subscriptions.erase(it);
+                    return;
+                }
+            }
+        }
+
+        /// @brief Calls the handlers of a subscription for each report sent
+        /// since the last call.
+        void deliver(SubscriptionID id) {
+            for (auto &subscription : m_subscriptions) {
+                if (subscription.id == id) {
+                    subscription.deliver();
+                    return;
+                }
+            }
+        }
+        /// @}
+
+        /// @name Device methods
+        /// @{
+        void addPublisher() { ++m_publishers; }
+        void removePublisher() { --m_publishers; }
+        bool hasSubscribers() const { return !m_subscriptions.empty(); }
+
+        void sendPose(OSVR_TimeValue const &timestamp, OSVR_ChannelCount sensor,
+                      OSVR_PoseState const &pose) {
+            for (auto &subscription : m_subscriptions) {
+                if (subscription.handlers.pose) {
+                    subscription
+                        .push(ReportType::Pose, timestamp, sensor)
+                        .pose = pose;
+                }
+            }
+        }
+
+        void sendVelocity(OSVR_TimeValue const &timestamp,
+                          OSVR_ChannelCount sensor,
+                          OSVR_VelocityState const &vel) {
+            for (auto &subscription : m_subscriptions) {
+                if (subscription.handlers.velocity) {
+                    subscription
+                        .push(ReportType::Velocity, timestamp, sensor)
+                        .velocity = vel;
+                }
+            }
+        }
+
+        void sendAcceleration(OSVR_TimeValue const &timestamp,
+                              OSVR_ChannelCount sensor,
+                              OSVR_AccelerationState const &accel) {
+            for (auto &subscription : m_subscriptions) {
+                if (subscription.handlers.acceleration) {
+                    subscription
+                        .push(ReportType::Acceleration, timestamp, sensor)
+                        .acceleration = accel;
+                }
+            }
+        }
+        /// @}
+
+      private:
+        enum class ReportType { Pose, Velocity, Acceleration };
+        struct QueuedReport {
+            ReportType type;
+            OSVR_TimeValue timestamp;
+            OSVR_ChannelCount sensor;
+            union {
+                OSVR_PoseState pose;
+                OSVR_VelocityState velocity;
+                OSVR_AccelerationState acceleration;
+            };
+        };
+        struct Subscription {
+            SubscriptionID id;
+            Subscriber handlers;
+            /// A ring once full: storage is kept between deliveries, so
+            /// steady state doesn't allocate, and dropping the oldest report
+            /// is just overwriting it.
+            std::vector<QueuedReport> queue;
+            /// Index of the oldest report in a full queue.
+            std::size_t oldest = 0;
+
+            /// @brief Queues a report, for the caller to fill in the state.
+            QueuedReport &push(ReportType type,
+                               OSVR_TimeValue const &timestamp,
+                               OSVR_ChannelCount sensor) {
+                QueuedReport *report;
+                if (queue.size() < MAX_QUEUED_REPORTS) {
+                    queue.emplace_back();
+                    report = &queue.back();
+                } else {
+                    report = &queue[oldest];
+                    oldest = (oldest + 1) % MAX_QUEUED_REPORTS;
+                }
+                report->type = type;
+                report->timestamp = timestamp;
+                report->sensor = sensor;
+                return *report;
+            }
+
+            void deliver() {
+                for (std::size_t i = oldest, e = queue.size(); i < e; ++i) {
+                    deliver(queue[i]);
+                }
+                for (std::size_t i = 0; i < oldest; ++i) {
+                    deliver(queue[i]);
+                }
+                queue.clear();
+                oldest = 0;
+            }
+
+            void deliver(QueuedReport const &report) {
+                switch (report.type) {
+                case ReportType::Pose:
+                    handlers.pose(report.timestamp, report.sensor, report.pose);
+                    break;
+                case ReportType::Velocity:
+                    handlers.velocity(report.timestamp, report.sensor,
+                                      report.velocity);
+                    break;
+                case ReportType::Acceleration:
+                    handlers.acceleration(report.timestamp, report.sensor,
+                                          report.acceleration);
+                    break;
+                }
+            }
+        };
+
+        std::size_t m_publishers = 0;
+        SubscriptionID m_lastID = 0;
+        std::vector<Subscription> m_subscriptions;
+    };
+
+    typedef shared_ptr<TrackerReportChannel> TrackerReportChannelPtr;
+
+    class InProcessReportRouter;
+    typedef shared_ptr<InProcessReportRouter> InProcessReportRouterPtr;
+
+    /// @brief Channels of reports, by device name, for the devices on a
+    /// server connection.
+    ///
+    /// Devices and in-process consumers (like the client context of an
+    /// analysis plugin) both get the router from the VRPN connection they
+    /// share, so it doesn't have to be passed between them.
+    class InProcessReportRouter : boost::noncopyable {
+      public:
+        /// @brief Gets the router for a connection, creating it if needed.
+        /// It lives as long as something holds a reference to it.
+        OSVR_COMMON_EXPORT static InProcessReportRouterPtr
+        get(vrpn_Connection *conn);
+
+        /// @brief Gets the number of routers currently alive, for testing.
+        OSVR_COMMON_EXPORT static std::size_t getNumRouters();
+
+        /// @brief Gets the tracker channel for a device (qualified name, with
+        /// no host), creating it if needed.
+        OSVR_COMMON_EXPORT TrackerReportChannelPtr
+        getTrackerChannel(std::string const &device);
+
+      private:
+        std::mutex m_mutex;
+        std::unordered_map<std::string, weak_ptr<TrackerReportChannel>>
+            m_trackers;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_InProcessReportRouter_h_GUID_EEAE3312_DA75_4806_8B95_8792FD848F2E
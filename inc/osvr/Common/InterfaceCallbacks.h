@@ -28,6 +28,7 @@
 // Internal Includes
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/ReportFromCallback.h>
+#include <osvr/Common/CallbackType.h>
 #include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
@@ -36,18 +37,24 @@
 
 // Standard includes
 #include <vector>
-#include <functional>
 
 namespace osvr {
 namespace common {
+    /// @brief A registered callback for a report type: the C function pointer
+    /// and its userdata, called directly rather than through a type-erased
+    /// wrapper.
+    template <typename ReportType> struct RegisteredCallback {
+        traits::CallbackFromReport_t<ReportType> callback;
+        void *userdata;
+    };
+
     /// @brief Trait computing the storage for callbacks for a report
     /// type.
     /// @todo can't use quote because of bad interaction with MSVC 2013 that
     /// causes types to get mixed up - only the first quote works.
     struct CallbackStorage {
         template <typename ReportType>
-        using apply = std::vector<
-            std::function<void(const OSVR_TimeValue *, const ReportType *)>>;
+        using apply = std::vector<RegisteredCallback<ReportType>>;
     };
 
     using CallbackTuple =
@@ -60,18 +67,14 @@ namespace common {
         void addCallback(CallbackType cb, void *userdata) {
             using ReportType = traits::ReportFromCallback_t<CallbackType>;
             typepack::get<ReportType>(m_callbacks)
-                .push_back(
-                    [cb, userdata](util::time::TimeValue const *timestamp,
-                                   ReportType const *report) {
-                        cb(userdata, timestamp, report);
-                    });
+                .push_back(RegisteredCallback<ReportType>{cb, userdata});
         }
 
         template <typename ReportType>
         void triggerCallbacks(util::time::TimeValue const &timestamp,
                               ReportType const &report) const {
-            for (auto const &f : typepack::cget<ReportType>(m_callbacks)) {
-                f(&timestamp, &report);
+            for (auto const &cb : typepack::cget<ReportType>(m_callbacks)) {
+                cb.callback(cb.userdata, &timestamp, &report);
             }
         }
 
@@ -38,7 +38,7 @@
 #include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <cstdint>
 
 namespace osvr {
 namespace common {
@@ -73,6 +73,7 @@ namespace common {
             c.timestamp = timestamp;
             typepack::get<ReportType, StateMap>(m_states) = c;
             m_hasState = true;
+            ++m_updateCount;
         }
 
         template <typename ReportType> bool hasState() const {
@@ -82,6 +83,11 @@ namespace common {
 
         bool hasAnyState() const { return m_hasState; }
 
+        /// @brief Gets the number of times state has been set, for any report
+        /// type: unchanged means no state has changed, even if a new report
+        /// carried the same timestamp as the last.
+        std::uint64_t getUpdateCount() const { return m_updateCount; }
+
         template <typename ReportType>
         void getState(util::time::TimeValue &timestamp,
                       traits::StateFromReport_t<ReportType> &state) const {
@@ -96,6 +102,7 @@ namespace common {
       private:
         StateMap m_states;
         bool m_hasState = false;
+        std::uint64_t m_updateCount = 0;
     };
 
 } // namespace common
@@ -0,0 +1,105 @@
+/** @file
+    @brief Header for reading the state of a fixed set of interfaces all at
+    once.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InterfaceStateSnapshot_h_GUID_07B0D666_4417_4770_8B38_DB53C7C25C02
+#define INCLUDED_InterfaceStateSnapshot_h_GUID_07B0D666_4417_4770_8B38_DB53C7C25C02
+
+// Internal Includes
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/ReportStateTraits.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief The state of one interface in a snapshot.
+    template <typename ReportType> struct StateSnapshotEntry {
+        util::time::TimeValue timestamp;
+        traits::StateFromReport_t<ReportType> state;
+        bool valid;
+    };
+
+    /// @brief A set of interfaces, registered once, whose states for a report
+    /// type can then be read together into a caller-provided array.
+    ///
+    /// The entry type is duck-typed: anything with `timestamp`, `state`, and
+    /// `valid` members, such as StateSnapshotEntry or the equivalent C
+    /// structs in ClientKit.
+    ///
+    /// The interfaces are not owned: they must outlive the snapshot.
+    class InterfaceStateSnapshot {
+      public:
+        explicit InterfaceStateSnapshot(ClientContext &ctx) : m_ctx(&ctx) {}
+
+        void clear() { m_interfaces.clear(); }
+        void reserve(std::size_t n) { m_interfaces.reserve(n); }
+        void push_back(ClientInterface &iface) {
+            m_interfaces.push_back(&iface);
+        }
+        std::size_t size() const { return m_interfaces.size(); }
+
+        /// @brief Reads the state of one interface into an entry: the same
+        /// path every read from a snapshot takes.
+        ///
+        /// @returns whether there was state.
+        template <typename ReportType, typename Entry>
+        static bool getEntry(ClientInterface const &iface, Entry &entry) {
+            bool hasState =
+                iface.getState<ReportType>(entry.timestamp, entry.state);
+            entry.valid = hasState;
+            return hasState;
+        }
+
+        /// @brief Reads the state of every interface, in the order they were
+        /// added, into entries (which must have room for size() of them).
+        /// Does not allocate.
+        ///
+        /// Interface state only changes during the context's update, so all
+        /// entries are from the same update: its count is returned.
+        template <typename ReportType, typename Entry>
+        std::uint64_t get(Entry *entries) const {
+            for (auto iface : m_interfaces) {
+                getEntry<ReportType>(*iface, *entries);
+                ++entries;
+            }
+            return m_ctx->getUpdateCount();
+        }
+
+      private:
+        ClientContext *m_ctx;
+        std::vector<ClientInterface *> m_interfaces;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_InterfaceStateSnapshot_h_GUID_07B0D666_4417_4770_8B38_DB53C7C25C02
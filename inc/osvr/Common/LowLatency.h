@@ -51,6 +51,12 @@ namespace common {
     /// is VR" so when milliseconds count, it might be OK. Bruce Dawson even
     /// says so :)
     /// https://randomascii.wordpress.com/2016/03/08/power-wastage-on-an-idle-laptop/#comment-20184
+    ///
+    /// On Linux, this instead applies the real-time settings configured for
+    /// the "server" thread role (osvr::util::sched::RealtimeConfig: priority,
+    /// CPU affinity, timer slack) to the constructing thread and locks the
+    /// process's memory if so configured, restoring the previous state when
+    /// destroyed.
     class LowLatency {
       public:
         OSVR_COMMON_EXPORT LowLatency();
@@ -62,6 +62,14 @@ namespace common {
 
         void nestTransform(Json::Value const &transform);
 
+        /// @brief Replaces the transform wholesale, as when reusing one
+        /// previously resolved.
+        void setTransform(GeneralizedTransform const &transform);
+
+        /// @brief Gets the nested transform: its compose() gives the
+        /// overall transform without needing to parse getTransformJson().
+        OSVR_COMMON_EXPORT GeneralizedTransform const &getTransform() const;
+
         PathNode *getDevice() const;
 
         /// @brief Gets the full path of the device node
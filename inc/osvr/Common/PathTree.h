@@ -35,11 +35,15 @@
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
     /// @brief A tree representation, with path/url syntax, of the known OSVR
     /// system.
+    ///
+    /// Lookups by path are cached: like the rest of this class, that is not
+    /// thread-safe, even for const access.
     class PathTree : boost::noncopyable {
       public:
         /// @brief Constructor
@@ -87,8 +91,16 @@ namespace common {
         PathNode const &getRoot() const { return *m_root; }
 
       private:
+        /// @brief Looks up a previous successful lookup of the path.
+        PathNode *m_getCachedNode(std::string const &path) const;
+        void m_cacheNode(std::string const &path, PathNode const &node) const;
+
         /// @brief Root node of the tree.
         PathNodePtr m_root;
+
+        /// @brief Nodes previously found by path. Nodes are only ever removed
+        /// by reset(), which clears this, so entries never go stale.
+        mutable std::unordered_map<std::string, PathNode *> m_pathCache;
     };
 
     /// @brief Make node an alias pointing to source, with the given priority,
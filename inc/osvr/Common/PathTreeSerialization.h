@@ -49,6 +49,12 @@ namespace common {
 
     /// @brief Deserialize a path tree from a JSON array of objects
     OSVR_COMMON_EXPORT void jsonToPathTree(PathTree &tree, Json::Value nodes);
+
+    /// @brief Computes a short version string identifying the contents of a
+    /// serialized path tree: equal trees have equal versions, so it may be
+    /// used to validate a cached copy without transferring the tree.
+    OSVR_COMMON_EXPORT std::string
+    pathTreeJsonVersion(Json::Value const &nodes);
 } // namespace common
 } // namespace osvr
 
@@ -0,0 +1,238 @@
+/** @file
+    @brief Header for a structure-of-arrays batch of poses, for applying a
+    transform to many at once.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseBatch_h_GUID_AE944BDF_41D8_4416_8C9E_40205BE47673
+#define INCLUDED_PoseBatch_h_GUID_AE944BDF_41D8_4416_8C9E_40205BE47673
+
+// Internal Includes
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief A batch of poses stored as a structure of arrays (one array per
+    /// quaternion and translation component), so that a transform can be
+    /// applied to all of them with array arithmetic that Eigen vectorizes
+    /// (SSE, AVX, or NEON, as enabled when compiling - scalar otherwise).
+    ///
+    /// Storage only grows, so reusing a batch doesn't allocate once it has
+    /// reached the largest size needed.
+    class PoseBatch {
+      public:
+        PoseBatch() = default;
+
+        void clear() { m_size = 0; }
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        void push_back(OSVR_Pose3 const &pose) {
+            if (m_size == static_cast<std::size_t>(m_data.rows())) {
+                m_data.conservativeResize(m_size < 8 ? 8 : m_size * 2,
+                                          Eigen::NoChange);
+            }
+            auto row = static_cast<Eigen::Index>(m_size);
+            for (int i = 0; i < 4; ++i) {
+                m_data(row, W + i) = pose.rotation.data[i];
+            }
+            for (int i = 0; i < 3; ++i) {
+                m_data(row, TX + i) = pose.translation.data[i];
+            }
+            ++m_size;
+        }
+
+        void get(std::size_t i, OSVR_Pose3 &pose) const {
+            auto row = static_cast<Eigen::Index>(i);
+            for (int c = 0; c < 4; ++c) {
+                pose.rotation.data[c] = m_data(row, W + c);
+            }
+            for (int c = 0; c < 3; ++c) {
+                pose.translation.data[c] = m_data(row, TX + c);
+            }
+        }
+
+        /// @brief Applies a transform to every pose, with the same result
+        /// (up to the sign of the quaternion) as xform.transform() on each
+        /// pose as a matrix.
+        ///
+        /// Transforms whose pre and post parts are both rigid - the usual
+        /// case - are applied to the whole batch at once; others fall back
+        /// to going through matrices pose by pose.
+        void transform(Transform const &xform) {
+            if (empty()) {
+                return;
+            }
+            if (!isRigid(xform.getPre()) || !isRigid(xform.getPost())) {
+                m_transformByMatrices(xform);
+                return;
+            }
+            Eigen::Matrix3d preRot = xform.getPre().topLeftCorner<3, 3>();
+            Eigen::Vector3d preTrans = xform.getPre().topRightCorner<3, 1>();
+            Eigen::Matrix3d postRot = xform.getPost().topLeftCorner<3, 3>();
+            Eigen::Vector3d postTrans =
+                xform.getPost().topRightCorner<3, 1>();
+            m_transformRigid(Eigen::Quaterniond(preRot), preTrans,
+                             Eigen::Quaterniond(postRot), postRot, postTrans);
+        }
+
+        /// @brief Is this (4x4 homogeneous) matrix a rotation and
+        /// translation only?
+        static bool isRigid(Eigen::Matrix4d const &m) {
+            static const double EPSILON = 1.0e-9;
+            if (!m.bottomRows<1>().isApprox(Eigen::RowVector4d::UnitW(),
+                                            EPSILON)) {
+                return false;
+            }
+            Eigen::Matrix3d rot = m.topLeftCorner<3, 3>();
+            return (rot.transpose() * rot)
+                       .isApprox(Eigen::Matrix3d::Identity(), EPSILON) &&
+                   rot.determinant() > 0;
+        }
+
+      private:
+        /// Columns of m_data
+        enum { W = 0, X, Y, Z, TX, TY, TZ, NUM_COLUMNS };
+        typedef Eigen::Array<double, Eigen::Dynamic, NUM_COLUMNS> Storage;
+
+        typedef Eigen::Array<double, Eigen::Dynamic, 6> Scratch;
+
+        Storage::ColXpr::SegmentReturnType col(int c) {
+            return m_data.col(c).head(static_cast<Eigen::Index>(m_size));
+        }
+        Scratch::ColXpr::SegmentReturnType scratch(int c) {
+            return m_scratch.col(c).head(static_cast<Eigen::Index>(m_size));
+        }
+
+        /// Pose by pose: for transforms with scaling or reflection in them.
+        void m_transformByMatrices(Transform const &xform) {
+            OSVR_Pose3 pose;
+            for (std::size_t i = 0; i < m_size; ++i) {
+                get(i, pose);
+                util::eigen_interop::map(pose) =
+                    xform.transform(util::eigen_interop::map(pose).matrix());
+                auto row = static_cast<Eigen::Index>(i);
+                for (int c = 0; c < 4; ++c) {
+                    m_data(row, W + c) = pose.rotation.data[c];
+                }
+                for (int c = 0; c < 3; ++c) {
+                    m_data(row, TX + c) = pose.translation.data[c];
+                }
+            }
+        }
+
+        /// The whole batch: with pose (q, t), computes rotation
+        /// postRot * q * preRot and translation
+        /// postRot * (q * preTrans + t) + postTrans.
+        void m_transformRigid(Eigen::Quaterniond const &preRot,
+                              Eigen::Vector3d const &preTrans,
+                              Eigen::Quaterniond const &postRot,
+                              Eigen::Matrix3d const &postRotMatrix,
+                              Eigen::Vector3d const &postTrans) {
+            if (m_scratch.rows() < m_data.rows()) {
+                m_scratch.resize(m_data.rows(), Eigen::NoChange);
+            }
+            auto w = col(W);
+            auto x = col(X);
+            auto y = col(Y);
+            auto z = col(Z);
+            auto tx = col(TX);
+            auto ty = col(TY);
+            auto tz = col(TZ);
+
+            // Rotate the constant preTrans by each q:
+            // v + 2 * (w * (u x v) + u x (u x v)), with u the vector part.
+            const double vx = preTrans.x();
+            const double vy = preTrans.y();
+            const double vz = preTrans.z();
+            auto cx = scratch(0);
+            auto cy = scratch(1);
+            auto cz = scratch(2);
+            auto rx = scratch(3);
+            auto ry = scratch(4);
+            auto rz = scratch(5);
+            cx = y * vz - z * vy;
+            cy = z * vx - x * vz;
+            cz = x * vy - y * vx;
+            rx = vx + 2 * (w * cx + (y * cz - z * cy)) + tx;
+            ry = vy + 2 * (w * cy + (z * cx - x * cz)) + ty;
+            rz = vz + 2 * (w * cz + (x * cy - y * cx)) + tz;
+            auto const &p = postRotMatrix;
+            tx = p(0, 0) * rx + p(0, 1) * ry + p(0, 2) * rz + postTrans.x();
+            ty = p(1, 0) * rx + p(1, 1) * ry + p(1, 2) * rz + postTrans.y();
+            tz = p(2, 0) * rx + p(2, 1) * ry + p(2, 2) * rz + postTrans.z();
+
+            // Quaternion multiplication by a constant, on either side, is
+            // linear in the other quaternion: so postRot * q * preRot is a
+            // constant 4x4 matrix times (w, x, y, z).
+            Eigen::Matrix4d k = leftMultiplyMatrix(postRot) *
+                                rightMultiplyMatrix(preRot);
+            auto nw = scratch(0);
+            auto nx = scratch(1);
+            auto ny = scratch(2);
+            nw = k(0, 0) * w + k(0, 1) * x + k(0, 2) * y + k(0, 3) * z;
+            nx = k(1, 0) * w + k(1, 1) * x + k(1, 2) * y + k(1, 3) * z;
+            ny = k(2, 0) * w + k(2, 1) * x + k(2, 2) * y + k(2, 3) * z;
+            z = k(3, 0) * w + k(3, 1) * x + k(3, 2) * y + k(3, 3) * z;
+            w = nw;
+            x = nx;
+            y = ny;
+        }
+
+        /// Matrix of a * q, acting on q as (w, x, y, z).
+        static Eigen::Matrix4d leftMultiplyMatrix(Eigen::Quaterniond const &a) {
+            Eigen::Matrix4d ret;
+            ret << a.w(), -a.x(), -a.y(), -a.z(), //
+                a.x(), a.w(), -a.z(), a.y(),      //
+                a.y(), a.z(), a.w(), -a.x(),      //
+                a.z(), -a.y(), a.x(), a.w();
+            return ret;
+        }
+
+        /// Matrix of q * a, acting on q as (w, x, y, z).
+        static Eigen::Matrix4d
+        rightMultiplyMatrix(Eigen::Quaterniond const &a) {
+            Eigen::Matrix4d ret;
+            ret << a.w(), -a.x(), -a.y(), -a.z(), //
+                a.x(), a.w(), a.z(), -a.y(),      //
+                a.y(), -a.z(), a.w(), a.x(),      //
+                a.z(), a.y(), -a.x(), a.w();
+            return ret;
+        }
+
+        Storage m_data;
+        /// Intermediate results, kept to avoid allocating each time.
+        Scratch m_scratch;
+        std::size_t m_size = 0;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PoseBatch_h_GUID_AE944BDF_41D8_4416_8C9E_40205BE47673
@@ -30,9 +30,15 @@
 #include <osvr/Util/StringIds.h>
 
 // Library/third-party includes
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_ref.hpp>
 #include <json/value.h>
 
 // Standard includes
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace osvr {
@@ -40,21 +46,35 @@ namespace common {
 
     /// Centralize a string registry. Basically, the server side, and part
     /// of the client side internals.
+    ///
+    /// Lookups by string go through a hash index, and accept anything
+    /// convertible to a boost::string_ref (std::string, const char *) without
+    /// making a copy.
     class RegisteredStringMap {
       public:
+        OSVR_COMMON_EXPORT RegisteredStringMap();
+        /// Copies rebuild the index, which refers into the entries.
+        OSVR_COMMON_EXPORT
+        RegisteredStringMap(RegisteredStringMap const &other);
+        OSVR_COMMON_EXPORT RegisteredStringMap &
+        operator=(RegisteredStringMap const &other);
+
         /// register new ID with given string and returns StringID.
         /// If string already exists, then it returns existing StringID
         OSVR_COMMON_EXPORT util::StringID
-        registerStringID(std::string const &str);
+        registerStringID(boost::string_ref str);
 
         /// retrieve the StringID associated with the given string
         /// returns an empty util::StringID if it was not found
         OSVR_COMMON_EXPORT util::StringID
-        getStringID(std::string const &str) const;
+        getStringID(boost::string_ref str) const;
 
         /// retrieve the name of the string given the ID
         /// returns empty string if nothing found
-        OSVR_COMMON_EXPORT std::string getStringFromId(util::StringID id) const;
+        ///
+        /// The reference remains valid as long as the map does.
+        OSVR_COMMON_EXPORT std::string const &
+        getStringFromId(util::StringID id) const;
 
         /// Has a new entry been added since the flag was last cleared?
         OSVR_COMMON_EXPORT bool isModified() const;
@@ -65,8 +85,21 @@ namespace common {
 
         OSVR_COMMON_EXPORT std::vector<std::string> getEntries() const;
 
+        /// Number of entries - cheaper than getEntries().size()
+        OSVR_COMMON_EXPORT std::size_t size() const;
+
       protected:
-        std::vector<std::string> m_regEntries;
+        /// A deque rather than a vector so that entries never move once
+        /// added: the index refers to their contents.
+        std::deque<std::string> m_regEntries;
+
+        struct StringRefHash {
+            std::size_t operator()(boost::string_ref str) const {
+                return boost::hash_range(str.begin(), str.end());
+            }
+        };
+        /// Maps the contents of each entry to its index in m_regEntries.
+        std::unordered_map<boost::string_ref, uint32_t, StringRefHash> m_index;
 
         /// special flag that gets switched whenever new element is inserted;
         bool m_modified = false;
@@ -81,15 +114,17 @@ namespace common {
         /// register new ID with given string and returns StringID.
         /// If string already exists, then it returns existing StringID
         OSVR_COMMON_EXPORT util::StringID
-        registerStringID(std::string const &str);
+        registerStringID(boost::string_ref str);
 
         /// retrieve the StringID associated with the given string
         /// returns an empty util::StringID if it's not found
-        OSVR_COMMON_EXPORT util::StringID getStringID(std::string const &str) const;
+        OSVR_COMMON_EXPORT util::StringID
+        getStringID(boost::string_ref str) const;
 
         /// retrieve the name of the string given the ID
         /// returns empty string if nothing found
-        OSVR_COMMON_EXPORT std::string getStringFromId(util::StringID id) const;
+        OSVR_COMMON_EXPORT std::string const &
+        getStringFromId(util::StringID id) const;
 
         /// This is the extra method used by clients, to convert from server's
         /// ids. Will return NULL if peerID to Local ID mapping doesn't exist
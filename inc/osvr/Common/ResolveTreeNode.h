@@ -35,6 +35,8 @@
 
 // Standard includes
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -42,6 +44,50 @@ namespace common {
     OSVR_COMMON_EXPORT boost::optional<OriginalSource>
     resolveTreeNode(PathTree &pathTree, std::string const &path);
 
+    /// @brief The nodes a resolution passed through, with enough of their
+    /// values to tell if resolving again would take the same route.
+    struct TreeNodeResolutionTrace {
+        struct Step {
+            std::string path;
+            /// @brief Index of the element type in the PathElement variant.
+            int which;
+            /// @brief Source, if the node was an alias.
+            std::string aliasSource;
+        };
+        std::vector<Step> steps;
+    };
+
+    /// @brief Memoizes resolveTreeNode(): remembers, for each path resolved,
+    /// the nodes the resolution passed through and the nested transform it
+    /// built up.
+    ///
+    /// Resolving the same path again (including in a tree that has since
+    /// been replaced wholesale) only re-parses aliases and rebuilds the
+    /// transform if one of those nodes has changed: otherwise the
+    /// resolution just has to look up each node on the route, and point
+    /// the result at the current tree's nodes.
+    class TreeNodeResolutionCache {
+      public:
+        /// @brief Equivalent to resolveTreeNode(pathTree, path).
+        OSVR_COMMON_EXPORT boost::optional<OriginalSource>
+        resolve(PathTree &pathTree, std::string const &path);
+
+        /// @brief Forget all cached resolutions.
+        void clear() { m_entries.clear(); }
+
+        /// @brief Number of resolutions served from the cache, for
+        /// diagnostics and testing.
+        std::size_t getHits() const { return m_hits; }
+
+      private:
+        struct Entry {
+            TreeNodeResolutionTrace trace;
+            GeneralizedTransform transform;
+        };
+        std::unordered_map<std::string, Entry> m_entries;
+        std::size_t m_hits = 0;
+    };
+
 } // namespace common
 } // namespace osvr
 
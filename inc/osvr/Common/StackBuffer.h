@@ -0,0 +1,156 @@
+/** @file
+    @brief Header defining a buffer type with inline (usually stack) storage,
+    for serializing messages without heap allocation.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StackBuffer_h_GUID_10F958B1_D9C4_46DB_9E34_EA72E48E5226
+#define INCLUDED_StackBuffer_h_GUID_10F958B1_D9C4_46DB_9E34_EA72E48E5226
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace osvr {
+namespace common {
+    /// @brief A byte container for Buffer that keeps up to InlineCapacity
+    /// bytes in (aligned) storage inside the object, only allocating from the
+    /// heap if a message outgrows that.
+    ///
+    /// Provides just the vector-like interface that Buffer uses: in
+    /// particular, insertion is only supported at the end.
+    template <std::size_t InlineCapacity> class InlineBufferContainer {
+      public:
+        typedef BufferElement value_type;
+        typedef BufferElement *iterator;
+        typedef BufferElement const *const_iterator;
+
+        InlineBufferContainer() : m_data(m_inlineData()) {}
+
+        template <typename InputIterator>
+        InlineBufferContainer(InputIterator beginIt, InputIterator endIt)
+            : InlineBufferContainer() {
+            insert(end(), beginIt, endIt);
+        }
+
+        InlineBufferContainer(InlineBufferContainer const &other)
+            : InlineBufferContainer() {
+            insert(end(), other.begin(), other.end());
+        }
+
+        InlineBufferContainer &operator=(InlineBufferContainer const &other) {
+            if (this != &other) {
+                m_size = 0;
+                insert(end(), other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        iterator begin() { return m_data; }
+        const_iterator begin() const { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator end() const { return m_data + m_size; }
+
+        BufferElement &operator[](std::size_t i) { return m_data[i]; }
+        BufferElement const &operator[](std::size_t i) const {
+            return m_data[i];
+        }
+
+        std::size_t size() const { return m_size; }
+        std::size_t capacity() const { return m_capacity; }
+        BufferElement *data() { return m_data; }
+        BufferElement const *data() const { return m_data; }
+
+        /// @brief Is the data still in the inline storage (no heap
+        /// allocation has been made)?
+        bool isInline() const { return m_data == m_inlineData(); }
+
+        /// @brief Appends the range [first, last): @p pos must be end().
+        template <typename ForwardIterator>
+        void insert(const_iterator pos, ForwardIterator first,
+                    ForwardIterator last) {
+            BOOST_ASSERT_MSG(pos == end(), "Can only append to this container");
+            (void)pos;
+            auto n = static_cast<std::size_t>(std::distance(first, last));
+            m_reserve(m_size + n);
+            std::copy(first, last, end());
+            m_size += n;
+        }
+
+        /// @brief Appends @p n copies of @p val: @p pos must be end().
+        void insert(const_iterator pos, std::size_t n, BufferElement val) {
+            BOOST_ASSERT_MSG(pos == end(), "Can only append to this container");
+            (void)pos;
+            m_reserve(m_size + n);
+            std::fill_n(end(), n, val);
+            m_size += n;
+        }
+
+      private:
+        BufferElement *m_inlineData() {
+            return reinterpret_cast<BufferElement *>(&m_inline);
+        }
+        BufferElement const *m_inlineData() const {
+            return reinterpret_cast<BufferElement const *>(&m_inline);
+        }
+
+        void m_reserve(std::size_t needed) {
+            if (needed <= m_capacity) {
+                return;
+            }
+            auto newCapacity = (std::max)(needed, m_capacity * 2);
+            auto wasInline = isInline();
+            m_heap.resize(newCapacity);
+            if (wasInline) {
+                std::copy(begin(), end(), m_heap.data());
+            }
+            m_data = m_heap.data();
+            m_capacity = newCapacity;
+        }
+
+        typename std::aligned_storage<InlineCapacity,
+                                      DesiredBufferAlignment::value>::type
+            m_inline;
+        BufferByteVector m_heap;
+        BufferElement *m_data;
+        std::size_t m_size = 0;
+        std::size_t m_capacity = InlineCapacity;
+    };
+
+    /// @brief A Buffer with inline storage: declared as a local variable, it
+    /// serializes messages up to InlineCapacity bytes without touching the
+    /// heap, so use it for messages sent in steady state (reports). Larger
+    /// messages still work, with a heap allocation.
+    template <std::size_t InlineCapacity = 512>
+    using StackBuffer = Buffer<InlineBufferContainer<InlineCapacity> >;
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_StackBuffer_h_GUID_10F958B1_D9C4_46DB_9E34_EA72E48E5226
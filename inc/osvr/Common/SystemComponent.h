@@ -69,6 +69,13 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class TreeVersionFromServer
+            : public MessageRegistration<TreeVersionFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -116,15 +123,29 @@ namespace common {
                                    util::time::TimeValue const &)> JsonHandler;
         OSVR_COMMON_EXPORT void registerReplaceTreeHandler(JsonHandler cb);
 
+        /// @brief Sends the tree, preceded by its version (see
+        /// pathTreeJsonVersion()) in a treeVersionOut message.
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @brief Message from server, sent just before each replacement tree
+        /// with its version, so clients holding a cached copy of that tree
+        /// can use it before the full tree arrives.
+        messages::TreeVersionFromServer treeVersionOut;
+
+        typedef std::function<void(std::string const &)> TreeVersionHandler;
+        OSVR_COMMON_EXPORT void
+        registerTreeVersionHandler(TreeVersionHandler cb);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeVersion(void *userdata, vrpn_HANDLERPARAM p);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<TreeVersionHandler> m_treeVersionHandlers;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,151 @@
+/** @file
+    @brief Header for passing the tracker reports of a device to clients on
+    the same machine through a shared memory ring buffer.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerReportRing_h_GUID_2AB7B991_D718_46E7_8386_C5E2CCC8C35A
+#define INCLUDED_TrackerReportRing_h_GUID_2AB7B991_D718_46E7_8386_C5E2CCC8C35A
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Common/InProcessReportRouter.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace osvr {
+namespace common {
+    class TrackerReportRing;
+    typedef shared_ptr<TrackerReportRing> TrackerReportRingPtr;
+
+    /// @brief The tracker reports of one device, in a shared memory ring
+    /// buffer named after it and the port its server listens on, so clients
+    /// on the same machine can poll for them instead of receiving VRPN
+    /// messages through the network stack. (Servers on one machine can only
+    /// share a port if they listen on different interfaces, so the port is
+    /// what tells them apart.)
+    ///
+    /// The server still sends VRPN messages, for remote clients (and local
+    /// ones that can't find the ring). Reports have the same content as those
+    /// messages, as with TrackerReportChannel.
+    ///
+    /// A reader that falls more than a ring's worth of reports behind skips
+    /// the ones overwritten in the meantime.
+    ///
+    /// Every record is stamped with the (steady, machine-wide) time it was
+    /// written, and the server writes a heartbeat record whenever a device
+    /// has been quiet for a while, so readers can tell when the server that
+    /// wrote the ring has gone away or been restarted (leaving them with an
+    /// orphaned ring).
+    class TrackerReportRing : boost::noncopyable {
+      public:
+        /// @brief Creates the ring for a device (qualified name, with no
+        /// host) of the server listening on @p port, replacing any left over.
+        /// For use by the server.
+        ///
+        /// @returns null if the shared memory couldn't be created.
+        OSVR_COMMON_EXPORT static TrackerReportRingPtr
+        create(std::string const &device, int port);
+
+        /// @brief Opens the ring of a device, if its server, listening on
+        /// @p port, created one. For use by clients.
+        ///
+        /// @returns null if there is no such ring, or if its writer isn't
+        /// alive.
+        OSVR_COMMON_EXPORT static TrackerReportRingPtr
+        find(std::string const &device, int port);
+
+        /// @name Writer methods
+        /// @{
+        OSVR_COMMON_EXPORT void sendPose(OSVR_TimeValue const &timestamp,
+                                         OSVR_ChannelCount sensor,
+                                         OSVR_PoseState const &pose);
+        OSVR_COMMON_EXPORT void
+        sendVelocity(OSVR_TimeValue const &timestamp, OSVR_ChannelCount sensor,
+                     OSVR_VelocityState const &vel);
+        OSVR_COMMON_EXPORT void
+        sendAcceleration(OSVR_TimeValue const &timestamp,
+                         OSVR_ChannelCount sensor,
+                         OSVR_AccelerationState const &accel);
+
+        /// @brief Call regularly (every server loop pass): writes a heartbeat
+        /// record if nothing has been written for a while.
+        OSVR_COMMON_EXPORT void heartbeat();
+        /// @}
+
+        /// @brief Passes the reports written since the last call, in order,
+        /// to the handlers (any of which may be empty). The first call only
+        /// passes the latest report.
+        ///
+        /// @returns the number of reports read.
+        OSVR_COMMON_EXPORT std::size_t
+        poll(TrackerReportChannel::Subscriber const &handlers);
+
+        /// @brief Whether, as of the last poll(), the ring has been written
+        /// to recently enough for its writer to be alive. Once false, the
+        /// ring won't be written again: use VRPN instead.
+        bool isWriterAlive() const { return m_writerAlive; }
+
+        /// @brief The first sequence number a reader that next wants @p next
+        /// should read, when @p latest is the newest of the @p entries in the
+        /// ring: skips those overwritten already. Accounts for sequence
+        /// numbers wrapping around.
+        static IPCRingBuffer::sequence_type
+        getFirstToRead(IPCRingBuffer::sequence_type next,
+                       IPCRingBuffer::sequence_type latest,
+                       std::size_t entries) {
+            // Compare by unsigned difference: zero when caught up.
+            IPCRingBuffer::sequence_type pending = latest - next + 1;
+            if (pending > entries) {
+                return latest -
+                       static_cast<IPCRingBuffer::sequence_type>(entries) + 1;
+            }
+            return next;
+        }
+
+      private:
+        struct Record;
+        explicit TrackerReportRing(IPCRingBufferPtr &&buf);
+        void m_put(Record &record);
+        bool m_checkWriterAlive();
+        IPCRingBufferPtr m_buf;
+        bool m_started = false;
+        IPCRingBuffer::sequence_type m_nextSeq = 0;
+        bool m_writerAlive = true;
+        /// @brief Writer only: steady clock time of the last write.
+        std::int64_t m_lastWrite = 0;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerReportRing_h_GUID_2AB7B991_D718_46E7_8386_C5E2CCC8C35A
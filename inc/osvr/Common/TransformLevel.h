@@ -0,0 +1,94 @@
+/** @file
+    @brief Header for a single, pre-parsed level of a routing transform.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TransformLevel_h_GUID_3A945654_E5D9_4B2B_A250_E0F1A7A3C30F
+#define INCLUDED_TransformLevel_h_GUID_3A945654_E5D9_4B2B_A250_E0F1A7A3C30F
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <json/value.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief The operations described by one level of a routing transform,
+    /// parsed out of its JSON once so they can be composed without going
+    /// back to the JSON.
+    ///
+    /// A level is either a change of basis, or a rigid transform applied
+    /// before the data ("translate", "rotate") and/or one applied after it
+    /// ("posttranslate", "postrotate"). Anything else in the level's object
+    /// (including the "child") is ignored, as is a level that isn't an
+    /// object at all.
+    class TransformLevel {
+      public:
+        /// @brief Identity level.
+        TransformLevel() = default;
+
+        /// @brief Parses one level of a routing transform.
+        /// @throws std::runtime_error if the members describing the
+        /// transformation are malformed.
+        OSVR_COMMON_EXPORT static TransformLevel
+        parse(Json::Value const &level);
+
+        /// @brief Does this level leave what it wraps unchanged?
+        bool isIdentity() const {
+            return m_kind == Kind::Identity ||
+                   (m_kind == Kind::Rigid && !m_hasPre && !m_hasPost);
+        }
+
+        /// @brief Wraps this level around a transform made up of the levels
+        /// inside it.
+        OSVR_COMMON_EXPORT void applyTo(Transform &xform) const;
+
+        /// @brief Gets the transform of this level on its own.
+        Transform get() const {
+            Transform ret;
+            applyTo(ret);
+            return ret;
+        }
+
+      private:
+        enum class Kind { Identity, ChangeOfBasis, Rigid };
+        typedef Eigen::Quaternion<double, Eigen::DontAlign> Rotation;
+        Kind m_kind = Kind::Identity;
+        /// @brief Rows are the new axes in terms of the old ones.
+        Eigen::Matrix3d m_basis = Eigen::Matrix3d::Identity();
+        bool m_hasPre = false;
+        bool m_hasPost = false;
+        Eigen::Vector3d m_preTranslation = Eigen::Vector3d::Zero();
+        Rotation m_preRotation = Rotation::Identity();
+        Eigen::Vector3d m_postTranslation = Eigen::Vector3d::Zero();
+        Rotation m_postRotation = Rotation::Identity();
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TransformLevel_h_GUID_3A945654_E5D9_4B2B_A250_E0F1A7A3C30F
@@ -0,0 +1,85 @@
+/** @file
+    @brief Header
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_WildcardAliases_h_GUID_7B563E2A_D022_4C2F_A8EA_4FEB0B9D62AD
+#define INCLUDED_WildcardAliases_h_GUID_7B563E2A_D022_4C2F_A8EA_4FEB0B9D62AD
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/PathElementTypes_fwd.h>
+#include <osvr/Common/PathNode_fwd.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A wildcard alias (a destination path aliased to everything
+    /// under some source path, like "/me/hands": "/dev/tracker/*"), as
+    /// processed by AliasProcessor.
+    struct WildcardAlias {
+        /// @brief Absolute path of the node that the wildcard was under.
+        std::string stem;
+        /// @brief Absolute path under which aliases are created.
+        std::string path;
+        /// @brief Normalized alias, whose leaf gets replaced by the path of
+        /// each node matched.
+        std::string source;
+        AliasPriority priority;
+    };
+
+    inline bool operator==(WildcardAlias const &lhs, WildcardAlias const &rhs) {
+        return lhs.stem == rhs.stem && lhs.path == rhs.path &&
+               lhs.source == rhs.source && lhs.priority == rhs.priority;
+    }
+
+    /// @brief Wildcard aliases that have been processed, kept so that they
+    /// can be applied to just the nodes added to a tree afterwards, instead
+    /// of processing all aliases again.
+    class WildcardAliasSet {
+      public:
+        /// @brief Records a wildcard alias.
+        /// @return false if it was already recorded.
+        OSVR_COMMON_EXPORT bool add(WildcardAlias const &alias);
+
+        /// @brief Applies the recorded wildcard aliases to the nodes in the
+        /// given subtree (typically a device that was just added or
+        /// changed), and only those nodes.
+        /// @return true if changes were made
+        OSVR_COMMON_EXPORT bool applyToSubtree(PathNode &subtree) const;
+
+        std::size_t size() const { return m_aliases.size(); }
+
+      private:
+        std::vector<WildcardAlias> m_aliases;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_WildcardAliases_h_GUID_7B563E2A_D022_4C2F_A8EA_4FEB0B9D62AD
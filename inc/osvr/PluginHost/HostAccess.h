@@ -0,0 +1,57 @@
+/** @file
+    @brief Header
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HostAccess_h_GUID_D58A3E2B_70C1_4A1D_8E30_52F1683DD6F2
+#define INCLUDED_HostAccess_h_GUID_D58A3E2B_70C1_4A1D_8E30_52F1683DD6F2
+
+// Internal Includes
+#include <osvr/PluginHost/Export.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace pluginhost {
+
+    /// @brief Must be called by host-side code reachable from plugin
+    /// callbacks (device creation, message type registration, and the like)
+    /// before it touches state shared between plugins.
+    ///
+    /// Does nothing unless hardware detection is running concurrently (see
+    /// RegistrationContext::setStartupConcurrency()), in which case it blocks
+    /// a detect callback's thread until every plugin sorted before it has
+    /// finished its detection. Host-side registration thus stays serialized,
+    /// and in the same order as a serial detection would produce, while the
+    /// probing that precedes it runs in parallel.
+    ///
+    /// Threads other than those running detect callbacks are never blocked.
+    OSVR_PLUGINHOST_EXPORT void waitForHostAccess();
+
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_HostAccess_h_GUID_D58A3E2B_70C1_4A1D_8E30_52F1683DD6F2
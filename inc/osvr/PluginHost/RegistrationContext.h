@@ -39,6 +39,7 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <string>
 #include <map>
 
@@ -66,8 +67,37 @@ namespace pluginhost {
 
         /// @brief Load all detected plugins except those with a .manualload
         /// suffix
+        ///
+        /// Plugins are registered in order of name. If startup concurrency
+        /// is enabled, their libraries are first loaded into memory in
+        /// parallel.
+        ///
+        /// Unless disabled, a cache of the search results and of what each
+        /// plugin registered is kept on disk: plugins known to provide
+        /// nothing but drivers are not loaded until one of their drivers is
+        /// instantiated - see loadDeferredPlugin().
         OSVR_PLUGINHOST_EXPORT void loadPlugins();
 
+        /// @brief Load a plugin whose loading was deferred by loadPlugins(),
+        /// if any.
+        /// @returns true if such a plugin was loaded.
+        OSVR_PLUGINHOST_EXPORT bool
+        loadDeferredPlugin(std::string const &pluginName);
+
+        /// @brief Set the number of threads used by loadPlugins() and
+        /// triggerHardwareDetect(): 1 (the default) does everything serially
+        /// on the calling thread, 0 means one per hardware thread.
+        ///
+        /// Registration of plugins and of the devices they create stays
+        /// serialized and in the same order as with serial startup - see
+        /// waitForHostAccess().
+        OSVR_PLUGINHOST_EXPORT void
+        setStartupConcurrency(std::size_t threads);
+
+        /// @brief Get the number of threads used by loadPlugins() and
+        /// triggerHardwareDetect(), with 0 already resolved.
+        OSVR_PLUGINHOST_EXPORT std::size_t getStartupConcurrency() const;
+
         /// @brief Assume ownership of a plugin-specific registration context
         /// created and initialized outside of loadPlugin.
         OSVR_PLUGINHOST_EXPORT void
@@ -94,6 +124,10 @@ namespace pluginhost {
         /// @}
 
       private:
+        /// @brief Load a plugin whose library has already been located.
+        void m_loadPluginFromPath(std::string const &pluginName,
+                                  std::string const &pluginPathName);
+
         /// @brief Map of plugin names to owning pointers for plugin
         /// registration.
         typedef std::map<std::string, PluginRegPtr> PluginRegMap;
@@ -104,6 +138,7 @@ namespace pluginhost {
         /// Private impl.
         unique_ptr<Impl> m_impl;
         util::log::LoggerPtr m_logger;
+        std::size_t m_startupConcurrency = 1;
     };
 } // namespace pluginhost
 } // namespace osvr
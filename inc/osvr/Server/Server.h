@@ -37,6 +37,7 @@
 #include <boost/optional.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <string>
 #include <functional>
 #include <stdexcept>
@@ -235,13 +236,32 @@ namespace server {
             std::string const &path, std::string const &deviceName,
             std::string const &server, std::string const &descriptor);
 
-        /// @brief Sets the amount of time (in microseconds) that the server
-        /// loop will sleep each loop when a client is connected (0 means no
-        /// sleep)
+        /// @brief Sets the period (in microseconds) of the server loop when a
+        /// client is connected (0 means run as fast as possible, no sleep)
+        ///
+        /// The loop wakes on a fixed cadence rather than sleeping a fixed
+        /// time after each iteration, so time spent working doesn't add to
+        /// the period.
         ///
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
+        /// @brief Sets how much (in microseconds) of each server loop period
+        /// is spent busy-waiting rather than sleeping, when a client is
+        /// connected. Trades CPU for wakeup precision; 0 (the default) means
+        /// never spin.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void setSleepSpinTime(int microseconds);
+
+        /// @brief Sets the number of threads used to load plugins and run
+        /// hardware detection: 1 (the default) for serial startup, 0 for one
+        /// per hardware thread. Devices are still added in the same order as
+        /// serial startup would add them.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void setStartupConcurrency(std::size_t threads);
+
 #if 0
         /// @brief Returns the amount of time (in microseconds) that the server
         /// loop sleeps each loop.
@@ -35,6 +35,8 @@
 
 // Standard includes
 #include <cmath>
+#include <cstddef>
+#include <vector>
 
 namespace osvr {
 namespace util {
@@ -271,12 +273,308 @@ namespace util {
                 OneEuroFilter<Quat> m_orientationFilter;
             };
 
+            /// The same filtering as a PoseOneEuroFilter per sensor, for
+            /// devices with many sensors (mocap, skeletons): state is kept as
+            /// structure-of-arrays, and the reports of a frame are filtered
+            /// together, with column-wise Eigen operations wherever the math
+            /// allows.
+            ///
+            /// Add each report of a frame with addToFrame(), then call
+            /// filterFrame().
+            template <typename Scalar> class PoseOneEuroFilterBank {
+              public:
+                using scalar = Scalar;
+                using Vec3 = Eigen::Matrix<scalar, 3, 1>;
+                using Quat = Eigen::Quaternion<scalar>;
+                using size_type = std::size_t;
+
+                PoseOneEuroFilterBank(
+                    Params const &positionFilterParams = Params{},
+                    Params const &oriFilterParams = Params{})
+                    : m_positionParams(positionFilterParams),
+                      m_oriParams(oriFilterParams) {}
+
+                /// Number of sensors there is state for.
+                size_type size() const { return m_initialized.size(); }
+
+                /// Sets the number of sensors there is state for: new sensors
+                /// start out unfiltered.
+                void resize(size_type n) {
+                    auto cols = static_cast<Eigen::Index>(n);
+                    m_position.conservativeResize(Eigen::NoChange, cols);
+                    m_positionDx.conservativeResize(Eigen::NoChange, cols);
+                    m_orientation.conservativeResize(Eigen::NoChange, cols);
+                    m_orientationDx.conservativeResize(Eigen::NoChange, cols);
+                    m_dt.conservativeResize(cols);
+                    for (auto i = static_cast<Eigen::Index>(size()); i < cols;
+                         ++i) {
+                        /// Zeroed so that masking them out in a sensor's first
+                        /// frame can't pick up NaNs.
+                        m_position.col(i).setZero();
+                        m_positionDx.col(i).setZero();
+                        m_orientation.col(i) = Quat::Identity().coeffs();
+                        m_orientationDx.col(i).setZero();
+                        /// Same fallback as PoseOneEuroFilter.
+                        m_dt[i] = scalar(1);
+                    }
+                    m_initialized.resize(n, false);
+                    m_pending.resize(n, false);
+                }
+
+                /// Whether the sensor has a report in the current frame.
+                bool isPending(size_type sensor) const {
+                    return sensor < size() && m_pending[sensor];
+                }
+
+                /// Adds a sensor's report to the current frame, growing the
+                /// bank if required. At most one report per sensor fits in a
+                /// frame: call filterFrame() first if isPending().
+                ///
+                /// A dt that isn't positive and finite (duplicate or
+                /// out-of-order timestamps) is replaced by the sensor's last
+                /// good one, so a glitch doesn't upset the filter.
+                void addToFrame(size_type sensor, scalar dt,
+                                Vec3 const &position,
+                                Quat const &orientation) {
+                    if (sensor >= size()) {
+                        resize(sensor + 1);
+                    }
+                    auto s = static_cast<Eigen::Index>(sensor);
+                    if (dt > scalar(0) && std::isfinite(dt)) {
+                        m_dt[s] = dt;
+                    }
+                    if (m_pending[sensor]) {
+                        /// Misuse: replace that report.
+                        for (Eigen::Index i = 0; i < m_frameSize; ++i) {
+                            if (m_frameSensors[i] == sensor) {
+                                m_framePosition.col(i) = position;
+                                m_frameOrientation.col(i) =
+                                    orientation.coeffs();
+                            }
+                        }
+                        return;
+                    }
+                    if (m_frameSize == m_framePosition.cols()) {
+                        m_reserveFrame(
+                            (std::max)(Eigen::Index(8), m_frameSize * 2));
+                    }
+                    auto i = m_frameSize++;
+                    m_frameSensors[i] = sensor;
+                    m_framePosition.col(i) = position;
+                    m_frameOrientation.col(i) = orientation.coeffs();
+                    m_pending[sensor] = true;
+                }
+
+                /// Number of reports in the current frame.
+                size_type frameSize() const {
+                    return static_cast<size_type>(m_frameSize);
+                }
+
+                /// The sensor of a report in the current (or, after
+                /// filterFrame(), just filtered) frame.
+                size_type frameSensor(size_type i) const {
+                    return m_frameSensors[i];
+                }
+
+                /// Filters all reports of the current frame, then starts a
+                /// new one (keeping frameSensor() valid until addToFrame()).
+                void filterFrame() {
+                    auto k = m_frameSize;
+                    if (0 == k) {
+                        return;
+                    }
+                    // Gather the state of the frame's sensors.
+                    for (Eigen::Index i = 0; i < k; ++i) {
+                        auto s = static_cast<Eigen::Index>(m_frameSensors[i]);
+                        m_prevPosition.col(i) = m_position.col(s);
+                        m_prevPositionDx.col(i) = m_positionDx.col(s);
+                        m_prevOrientation.col(i) = m_orientation.col(s);
+                        m_prevOrientationDx.col(i) = m_orientationDx.col(s);
+                        m_frameDt[i] = m_dt[s];
+                        m_first[i] = m_initialized[m_frameSensors[i]]
+                                         ? scalar(0)
+                                         : scalar(1);
+                    }
+                    auto dt = m_frameDt.head(k);
+                    auto first = m_first.head(k);
+
+                    // Position: entirely column-wise.
+                    m_rawDx.leftCols(k) =
+                        ((m_framePosition.leftCols(k) -
+                          m_prevPosition.leftCols(k))
+                             .array()
+                             .rowwise() *
+                         ((scalar(1) - first) / dt))
+                            .matrix();
+                    m_filterDerivative(m_positionParams, k,
+                                       m_prevPositionDx);
+                    m_lowPass(m_framePosition, m_prevPosition, k);
+                    m_scatter(m_prevPosition, m_position, k);
+                    m_scatter(m_prevPositionDx, m_positionDx, k);
+
+                    // Orientation: the log map and slerp go column by column.
+                    for (Eigen::Index i = 0; i < k; ++i) {
+                        if (first[i] != scalar(0)) {
+                            m_rawDx.col(i).setZero();
+                            continue;
+                        }
+                        Quat prev(m_prevOrientation.col(i));
+                        Quat curr(m_frameOrientation.col(i));
+                        m_rawDx.col(i) =
+                            util::quat_ln(curr * prev.conjugate()) / dt[i];
+                    }
+                    m_filterDerivative(m_oriParams, k, m_prevOrientationDx);
+                    for (Eigen::Index i = 0; i < k; ++i) {
+                        Quat curr(m_frameOrientation.col(i));
+                        if (first[i] != scalar(0)) {
+                            m_prevOrientation.col(i) = curr.coeffs();
+                            continue;
+                        }
+                        Quat prev(m_prevOrientation.col(i));
+                        m_prevOrientation.col(i) =
+                            prev.slerp(m_alpha[i], curr).normalized().coeffs();
+                    }
+                    m_scatter(m_prevOrientation, m_orientation, k);
+                    m_scatter(m_prevOrientationDx, m_orientationDx, k);
+
+                    for (Eigen::Index i = 0; i < k; ++i) {
+                        m_initialized[m_frameSensors[i]] = true;
+                        m_pending[m_frameSensors[i]] = false;
+                    }
+                    m_frameSize = 0;
+                }
+
+                Vec3 getPosition(size_type sensor) const {
+                    return m_position.col(static_cast<Eigen::Index>(sensor));
+                }
+
+                scalar getLinearVelocityMagnitude(size_type sensor) const {
+                    return m_positionDx.col(static_cast<Eigen::Index>(sensor))
+                        .norm();
+                }
+
+                Quat getOrientation(size_type sensor) const {
+                    return Quat(
+                        m_orientation.col(static_cast<Eigen::Index>(sensor)));
+                }
+
+                scalar getAngularVelocityMagnitude(size_type sensor) const {
+                    return m_orientationDx
+                        .col(static_cast<Eigen::Index>(sensor))
+                        .norm();
+                }
+
+              private:
+                using Matrix3X = Eigen::Matrix<scalar, 3, Eigen::Dynamic>;
+                using Matrix4X = Eigen::Matrix<scalar, 4, Eigen::Dynamic>;
+                using RowArray = Eigen::Array<scalar, 1, Eigen::Dynamic>;
+
+                /// Low-pass filters m_rawDx into dxHat (previous values in,
+                /// new values out), then computes m_alpha for the values from
+                /// the filtered derivative's magnitude.
+                void m_filterDerivative(Params const &params, Eigen::Index k,
+                                        Matrix3X &dxHat) {
+                    auto dt = m_frameDt.head(k);
+                    auto first = m_first.head(k);
+                    // Effective alpha is 1 for a sensor's first sample: just
+                    // like the low-pass filters, take it as-is.
+                    auto derivTau =
+                        scalar(1) / (scalar(2) * scalar(EIGEN_PI) *
+                                     scalar(params.derivativeCutoff));
+                    m_alpha.head(k) =
+                        (scalar(1) + derivTau / dt).inverse().max(first);
+                    dxHat.leftCols(k) =
+                        (dxHat.leftCols(k).array().rowwise() *
+                             (scalar(1) - m_alpha.head(k)) +
+                         m_rawDx.leftCols(k).array().rowwise() *
+                             m_alpha.head(k))
+                            .matrix();
+                    auto cutoff =
+                        scalar(params.minCutoff) +
+                        scalar(params.beta) *
+                            dxHat.leftCols(k).colwise().norm().array();
+                    m_alpha.head(k) =
+                        (scalar(1) +
+                         (scalar(1) / (scalar(2) * scalar(EIGEN_PI) * cutoff)) /
+                             dt)
+                            .inverse()
+                            .max(first);
+                }
+
+                /// Low-pass filters x into hatx (previous values in, new
+                /// values out) with m_alpha.
+                void m_lowPass(Matrix3X const &x, Matrix3X &hatx,
+                               Eigen::Index k) {
+                    hatx.leftCols(k) =
+                        (hatx.leftCols(k).array().rowwise() *
+                             (scalar(1) - m_alpha.head(k)) +
+                         x.leftCols(k).array().rowwise() * m_alpha.head(k))
+                            .matrix();
+                }
+
+                template <typename MatrixType>
+                void m_scatter(MatrixType const &frameValues,
+                               MatrixType &state, Eigen::Index k) const {
+                    for (Eigen::Index i = 0; i < k; ++i) {
+                        state.col(static_cast<Eigen::Index>(
+                            m_frameSensors[i])) = frameValues.col(i);
+                    }
+                }
+
+                void m_reserveFrame(Eigen::Index n) {
+                    m_frameSensors.resize(static_cast<size_type>(n));
+                    m_framePosition.conservativeResize(Eigen::NoChange, n);
+                    m_frameOrientation.conservativeResize(Eigen::NoChange, n);
+                    m_frameDt.resize(n);
+                    m_first.resize(n);
+                    m_alpha.resize(n);
+                    m_rawDx.resize(Eigen::NoChange, n);
+                    m_prevPosition.resize(Eigen::NoChange, n);
+                    m_prevPositionDx.resize(Eigen::NoChange, n);
+                    m_prevOrientation.resize(Eigen::NoChange, n);
+                    m_prevOrientationDx.resize(Eigen::NoChange, n);
+                }
+
+                const Params m_positionParams;
+                const Params m_oriParams;
+
+                /// @name Per-sensor state, one column each.
+                /// @{
+                Matrix3X m_position;
+                Matrix3X m_positionDx;
+                Matrix4X m_orientation;
+                Matrix3X m_orientationDx;
+                RowArray m_dt;
+                std::vector<bool> m_initialized;
+                std::vector<bool> m_pending;
+                /// @}
+
+                /// @name The current frame, one column per report, and
+                /// scratch space for filtering it.
+                /// @{
+                Eigen::Index m_frameSize = 0;
+                std::vector<size_type> m_frameSensors;
+                Matrix3X m_framePosition;
+                Matrix4X m_frameOrientation;
+                RowArray m_frameDt;
+                RowArray m_first;
+                RowArray m_alpha;
+                Matrix3X m_rawDx;
+                Matrix3X m_prevPosition;
+                Matrix3X m_prevPositionDx;
+                Matrix4X m_prevOrientation;
+                Matrix3X m_prevOrientationDx;
+                /// @}
+            };
+
         } // namespace one_euro
 
         using one_euro::OneEuroFilter;
         using one_euro::PoseOneEuroFilter;
+        using one_euro::PoseOneEuroFilterBank;
 
         using PoseOneEuroFilterd = one_euro::PoseOneEuroFilter<double>;
+        using PoseOneEuroFilterBankd = one_euro::PoseOneEuroFilterBank<double>;
     } // namespace filters
 
 } // namespace util
@@ -32,7 +32,12 @@
 #include <boost/any.hpp>
 
 // Standard includes
+#include <cstddef>
+#include <cstdint>
 #include <map>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace osvr {
 namespace util {
@@ -50,6 +55,14 @@ namespace util {
             return (0 != found);
         }
 
+        boost::any *doFind(void *rawPtr, std::type_info const &type) {
+            auto it = m_container.find(rawPtr);
+            if (m_container.end() == it || it->second.type() != type) {
+                return nullptr;
+            }
+            return &(it->second);
+        }
+
       private:
         typedef std::map<void *, boost::any> Container;
         Container m_container;
@@ -73,10 +86,138 @@ namespace util {
             return false;
         }
 
+        boost::any *doFind(void *rawPtr, std::type_info const &type) {
+            auto range = m_container.equal_range(rawPtr);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second.type() == type) {
+                    return &(it->second);
+                }
+            }
+            return nullptr;
+        }
+
       private:
         typedef std::multimap<void *, boost::any> Container;
         Container m_container;
     };
+
+    /// @brief Like MultipleReferenceOwnershipPolicy, but in a flat
+    /// open-addressed (linear probing) table, so acquiring and releasing
+    /// objects, as done for every frame of every image callback, doesn't
+    /// allocate a node each time.
+    class FlatMultipleReferenceOwnershipPolicy {
+      protected:
+        FlatMultipleReferenceOwnershipPolicy() {}
+
+        void *doInsert(void *rawPtr, boost::any smartPtr) {
+            // Keep at least half the slots empty (not counting released ones)
+            // so probes stay short and always end.
+            if ((m_used + 1) * 2 > m_slots.size()) {
+                m_rehash();
+            }
+            auto i = m_findSlot(rawPtr, [](Slot const &slot) {
+                return slot.state != Slot::OCCUPIED;
+            });
+            auto &slot = m_slots[i];
+            if (slot.state == Slot::EMPTY) {
+                ++m_used;
+            }
+            slot.state = Slot::OCCUPIED;
+            slot.key = rawPtr;
+            slot.value = std::move(smartPtr);
+            return rawPtr;
+        }
+
+        bool doReleaseOne(void *rawPtr) {
+            auto slot = m_find(rawPtr);
+            if (nullptr == slot) {
+                return false;
+            }
+            // Leave a marker, so probes for other keys continue past it.
+            slot->state = Slot::RELEASED;
+            slot->key = nullptr;
+            slot->value = boost::any();
+            return true;
+        }
+
+        boost::any *doFind(void *rawPtr, std::type_info const &type) {
+            if (m_slots.empty()) {
+                return nullptr;
+            }
+            auto i = m_findSlot(rawPtr, [&](Slot const &slot) {
+                return slot.state == Slot::OCCUPIED && slot.key == rawPtr &&
+                       slot.value.type() == type;
+            });
+            auto &slot = m_slots[i];
+            return slot.state == Slot::OCCUPIED ? &(slot.value) : nullptr;
+        }
+
+      private:
+        struct Slot {
+            enum State : std::uint8_t { EMPTY, OCCUPIED, RELEASED };
+            State state = EMPTY;
+            void *key = nullptr;
+            boost::any value;
+        };
+
+        std::size_t m_hash(void *rawPtr) const {
+            // Fibonacci hashing: the low bits of pointers are mostly zero.
+            auto bits = static_cast<std::uint64_t>(
+                reinterpret_cast<std::uintptr_t>(rawPtr));
+            return static_cast<std::size_t>(
+                (bits * UINT64_C(11400714819323198485)) >> 32);
+        }
+
+        /// @brief Returns the index of the first slot, probing from the home
+        /// slot of the key, that satisfies the predicate or is empty.
+        template <typename F>
+        std::size_t m_findSlot(void *rawPtr, F &&pred) const {
+            auto mask = m_slots.size() - 1;
+            auto i = m_hash(rawPtr) & mask;
+            while (m_slots[i].state != Slot::EMPTY && !pred(m_slots[i])) {
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        Slot *m_find(void *rawPtr) {
+            if (m_slots.empty()) {
+                return nullptr;
+            }
+            auto i = m_findSlot(rawPtr, [&](Slot const &slot) {
+                return slot.state == Slot::OCCUPIED && slot.key == rawPtr;
+            });
+            auto &slot = m_slots[i];
+            return slot.state == Slot::OCCUPIED ? &slot : nullptr;
+        }
+
+        /// @brief Re-inserts the occupied slots, dropping release markers,
+        /// into a table twice the size of the live entries (a power of 2).
+        void m_rehash() {
+            std::size_t live = 0;
+            for (auto const &slot : m_slots) {
+                if (slot.state == Slot::OCCUPIED) {
+                    ++live;
+                }
+            }
+            std::size_t size = 16;
+            while (size < (live + 1) * 4) {
+                size *= 2;
+            }
+            std::vector<Slot> old(size);
+            old.swap(m_slots);
+            m_used = 0;
+            for (auto &slot : old) {
+                if (slot.state == Slot::OCCUPIED) {
+                    doInsert(slot.key, std::move(slot.value));
+                }
+            }
+        }
+
+        std::vector<Slot> m_slots;
+        /// @brief Slots not empty: occupied or released.
+        std::size_t m_used = 0;
+    };
     /// @brief Holds on to smart pointers by value, and lets you free them by
     /// providing the corresponding void *.
     template <typename Policy = SingleOwnershipPolicy>
@@ -98,11 +239,25 @@ namespace util {
         ///
         /// @returns true if we found it and released it
         bool release(void *ptr) { return Policy::doReleaseOne(ptr); }
+
+        /// @brief Adds an object to our ownership under a key other than its
+        /// own pointer, such as the address of data it refers to.
+        template <typename T> void *acquire(void *key, T ptr) {
+            return Policy::doInsert(key, ptr);
+        }
+
+        /// @brief Finds an object of type T in our ownership by key.
+        ///
+        /// @returns null if there is none. With multiple references of type T
+        /// to the same key, any one of them.
+        template <typename T> T *find(void *key) {
+            return boost::any_cast<T>(Policy::doFind(key, typeid(T)));
+        }
     };
     typedef BasicKeyedOwnershipContainer<SingleOwnershipPolicy>
         KeyedOwnershipContainer;
 
-    typedef BasicKeyedOwnershipContainer<MultipleReferenceOwnershipPolicy>
+    typedef BasicKeyedOwnershipContainer<FlatMultipleReferenceOwnershipPolicy>
         MultipleKeyedOwnershipContainer;
 } // namespace util
 } // namespace osvr
@@ -35,6 +35,7 @@
 // - none
 
 // Standard includes
+#include <cstdint> // for std::uint64_t
 #include <memory> // for std::shared_ptr
 #include <string> // for std::string
 #include <vector> // for std::vector
@@ -55,6 +56,15 @@ namespace osvr {
 namespace util {
     namespace log {
         class filter_sink;
+        class async_sink;
+
+        /// What asynchronous logging does when its queue is full.
+        enum class AsyncOverflowPolicy {
+            /// The logging thread waits for the worker to free a slot.
+            Block,
+            /// The message is discarded and counted.
+            Drop
+        };
 
         class LogRegistry {
           public:
@@ -121,6 +131,22 @@ namespace util {
 
             bool couldOpenLogFile() const { return sinks_.size() > 1; }
 
+            /**
+             * @brief Whether messages are handed off to a background thread
+             * (for all sinks) instead of being written by the logging thread.
+             *
+             * Enabled by default when logging to file, or with the
+             * OSVR_LOG_ASYNC environment variable set to a queue size.
+             */
+            bool isAsync() const { return bool(async_sink_); }
+
+            /**
+             * @brief Number of messages discarded so far because the
+             * asynchronous queue was full. Only ever non-zero when
+             * OSVR_LOG_ASYNC_OVERFLOW is set to "drop".
+             */
+            OSVR_UTIL_EXPORT std::uint64_t getDroppedMessageCount() const;
+
           protected:
             OSVR_UTIL_EXPORT LogRegistry(std::string const &logFileBaseName);
             OSVR_UTIL_EXPORT ~LogRegistry();
@@ -129,11 +155,16 @@ namespace util {
             void setLevelImpl(LogLevel severity);
             void setConsoleLevelImpl(LogLevel severity);
             void createFileSink();
+            void createAsyncSink();
+            /// The sinks that loggers should write to: either the async sink
+            /// or all of sinks_.
+            std::vector<spdlog::sink_ptr> loggerSinks() const;
             LogLevel minLevel_;
             LogLevel consoleLevel_;
 
             std::vector<spdlog::sink_ptr> sinks_;
             std::shared_ptr<filter_sink> console_filter_;
+            std::shared_ptr<async_sink> async_sink_;
             LoggerPtr consoleOnlyLog_;
             LoggerPtr generalLog_;
             Logger *generalPurposeLog_ = nullptr;
@@ -137,6 +137,13 @@ namespace util {
                     (*os_) << msg;
                 }
 
+                /// A proxy that writes nothing and formats nothing streamed
+                /// into it. Used as a std::ostream, it's @p sink: best one
+                /// with no buffer, so always in a failed state.
+                StreamProxy(Logger &logger, LogLevel level, std::ostream &sink)
+                    : logger_(logger), level_(level), sink_(&sink),
+                      active_(false) {}
+
                 /// destructor appends the finished stringstream at the end
                 /// of the expression.
                 ~StreamProxy() {
@@ -148,24 +155,43 @@ namespace util {
                 /// move construction
                 StreamProxy(StreamProxy &&other)
                     : logger_(other.logger_), level_(other.level_),
-                      os_(std::move(other.os_)), active_(other.active_) {
+                      os_(std::move(other.os_)), sink_(other.sink_),
+                      active_(other.active_) {
                     other.active_ = false;
                 }
 
                 StreamProxy(StreamProxy const &) = delete;
                 StreamProxy &operator=(StreamProxy const &) = delete;
 
-                operator std::ostream &() { return (*os_); }
+                operator std::ostream &() { return stream(); }
+
+                /// Returns the proxy rather than the stream, so a proxy
+                /// writing nothing skips formatting the rest of the
+                /// expression too.
+                template <typename T> StreamProxy &operator<<(T &&what) {
+                    if (os_) {
+                        (*os_) << std::forward<T>(what);
+                    }
+                    return *this;
+                }
 
-                template <typename T> std::ostream &operator<<(T &&what) {
-                    (*os_) << std::forward<T>(what);
-                    return (*os_);
+                /// For manipulators that are function templates, like
+                /// std::endl.
+                StreamProxy &
+                operator<<(std::ostream &(*manip)(std::ostream &)) {
+                    if (os_) {
+                        manip(*os_);
+                    }
+                    return *this;
                 }
 
               private:
+                std::ostream &stream() { return os_ ? *os_ : *sink_; }
+
                 Logger &logger_;
                 LogLevel level_;
                 std::unique_ptr<std::ostringstream> os_;
+                std::ostream *sink_ = nullptr;
                 bool active_ = true;
             };
 
@@ -98,7 +98,7 @@ namespace util {
           private:
             void set() {}
             static const std::size_t SIZE =
-                static_cast<std::size_t>(CompactMatrixFlags::SIZEPLUSONE) - 1;
+                static_cast<std::size_t>(CompactMatrixFlags::SIZEPLUSONE);
             std::bitset<SIZE> m_data;
 
             template <CompactMatrixFlags Flag>
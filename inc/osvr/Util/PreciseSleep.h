@@ -0,0 +1,141 @@
+/** @file
+    @brief Header providing precise, deadline-based sleep primitives and
+    drift-free periodic waits.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PreciseSleep_h_GUID_CF68A42F_C3DF_421A_909D_5D496C80D9E2
+#define INCLUDED_PreciseSleep_h_GUID_CF68A42F_C3DF_421A_909D_5D496C80D9E2
+
+// Internal Includes
+#include <osvr/Util/Export.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+
+namespace osvr {
+namespace util {
+    namespace time {
+        /// @brief The monotonic clock the precise sleep functions use.
+        using PreciseClock = std::chrono::steady_clock;
+
+        /// @brief Sleeps until the given (absolute) deadline, never returning
+        /// before it.
+        ///
+        /// On Linux, this is a clock_nanosleep() on CLOCK_MONOTONIC with an
+        /// absolute deadline, so interruptions and the time taken to set up
+        /// the sleep don't add up. The wakeup can still be late by the timer
+        /// slack (see osvr::util::sched) plus scheduling latency.
+        OSVR_UTIL_EXPORT void sleepUntil(PreciseClock::time_point deadline);
+
+        /// @brief Hybrid sleep: sleeps until @p spin before the deadline,
+        /// then busy-waits for the remainder, trading CPU time for wakeup
+        /// precision. A @p spin of zero is the same as a plain sleepUntil().
+        OSVR_UTIL_EXPORT void sleepUntil(PreciseClock::time_point deadline,
+                                         PreciseClock::duration spin);
+
+        /// @brief Sleeps for at least the given duration, optionally spinning
+        /// for the last @p spin of it.
+        template <typename Rep, typename Period>
+        inline void
+        sleepFor(std::chrono::duration<Rep, Period> const &duration,
+                 PreciseClock::duration spin = PreciseClock::duration::zero()) {
+            using std::chrono::duration_cast;
+            sleepUntil(PreciseClock::now() +
+                           duration_cast<PreciseClock::duration>(duration),
+                       spin);
+        }
+
+        /// @brief Waits for a fixed-rate sequence of deadlines, for periodic
+        /// loops: each deadline is the previous one plus the period, not
+        /// "now" plus the period, so the loop doesn't drift by the time
+        /// spent working or by wakeup latency.
+        ///
+        /// If the loop falls behind by more than a full period, the missed
+        /// deadlines are skipped (and counted) rather than run back-to-back.
+        class PeriodicDeadline {
+          public:
+            using duration = PreciseClock::duration;
+            using time_point = PreciseClock::time_point;
+
+            explicit PeriodicDeadline(duration period,
+                                      duration spin = duration::zero())
+                : m_period(period), m_spin(spin) {}
+
+            /// Waits for the next deadline (the first is one period after
+            /// the first call, or after restart()).
+            /// @return how late the wakeup was.
+            duration wait() {
+                if (!m_started) {
+                    restart();
+                }
+                sleepUntil(m_next, m_spin);
+                auto now = PreciseClock::now();
+                auto late = now - m_next;
+                m_next += m_period;
+                if (m_next <= now && m_period > duration::zero()) {
+                    auto missed = (now - m_next) / m_period + 1;
+                    m_next += missed * m_period;
+                    m_missed += static_cast<std::size_t>(missed);
+                }
+                return late;
+            }
+
+            /// Makes the next deadline one period from now.
+            void restart() {
+                m_next = PreciseClock::now() + m_period;
+                m_started = true;
+            }
+
+            /// Changes the period, restarting the sequence of deadlines.
+            void setPeriod(duration period) {
+                m_period = period;
+                m_started = false;
+            }
+            duration getPeriod() const { return m_period; }
+
+            void setSpin(duration spin) { m_spin = spin; }
+            duration getSpin() const { return m_spin; }
+
+            /// The deadline the next wait() will wait for (if started).
+            time_point nextDeadline() const { return m_next; }
+
+            /// Number of deadlines skipped because the loop fell behind.
+            std::size_t missedDeadlines() const { return m_missed; }
+
+          private:
+            duration m_period;
+            duration m_spin;
+            time_point m_next;
+            bool m_started = false;
+            std::size_t m_missed = 0;
+        };
+
+    } // namespace time
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_PreciseSleep_h_GUID_CF68A42F_C3DF_421A_909D_5D496C80D9E2
@@ -0,0 +1,147 @@
+/** @file
+    @brief Header providing a wrapper around a logger that limits how many
+    messages per unit time it passes on, for use from real-time threads.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RateLimitedLogger_h_GUID_E6F2A6C2_F925_44AB_8B25_47F0E77E0082
+#define INCLUDED_RateLimitedLogger_h_GUID_E6F2A6C2_F925_44AB_8B25_47F0E77E0082
+
+// Internal Includes
+#include <osvr/Util/Log.h>
+#include <osvr/Util/LogLevel.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace osvr {
+namespace util {
+    namespace log {
+
+        /// @brief Wraps a logger with a token bucket, so that a burst of
+        /// messages (a tracking failure reported every frame, for instance)
+        /// can't end up stalling the thread doing the logging.
+        ///
+        /// Up to @c burst messages are passed through immediately, after which
+        /// messages are let through at an average rate of @c burst per
+        /// @c period. Messages in excess of that are discarded, and the number
+        /// discarded is noted in the next message that makes it through.
+        ///
+        /// Not thread-safe: intended to be owned by the (single) thread that
+        /// does the logging. Other threads can log through getLogger(), which
+        /// bypasses the rate limit.
+        class RateLimitedLogger {
+          public:
+            using clock = std::chrono::steady_clock;
+
+            explicit RateLimitedLogger(
+                LoggerPtr logger, std::size_t burst = 10,
+                clock::duration period = std::chrono::seconds(1))
+                : logger_(std::move(logger)),
+                  burst_(static_cast<double>(std::max<std::size_t>(burst, 1))),
+                  tokens_(burst_),
+                  secondsPerToken_(
+                      std::chrono::duration<double>(period).count() / burst_),
+                  lastRefill_(clock::now()) {}
+
+            /// Convenience constructor getting the logger by name.
+            explicit RateLimitedLogger(
+                std::string const &loggerName, std::size_t burst = 10,
+                clock::duration period = std::chrono::seconds(1))
+                : RateLimitedLogger(make_logger(loggerName), burst, period) {}
+
+            /// logger.log(log_level) << "msg" call style: the streamed message
+            /// is silently discarded, without being formatted, if we're over
+            /// the rate limit.
+            Logger::StreamProxy log(LogLevel level) {
+                if (!tryAcquire()) {
+                    ++suppressed_;
+                    return Logger::StreamProxy(*logger_, level, discarded_);
+                }
+                auto proxy = logger_->log(level);
+                if (suppressed_ > 0) {
+                    proxy << "(" << suppressed_
+                          << " earlier messages suppressed) ";
+                    suppressed_ = 0;
+                }
+                return proxy;
+            }
+
+            /// @name logger.info() << "msg" call style
+            /// @{
+            Logger::StreamProxy trace() { return log(LogLevel::trace); }
+            Logger::StreamProxy debug() { return log(LogLevel::debug); }
+            Logger::StreamProxy info() { return log(LogLevel::info); }
+            Logger::StreamProxy notice() { return log(LogLevel::notice); }
+            Logger::StreamProxy warn() { return log(LogLevel::warn); }
+            Logger::StreamProxy error() { return log(LogLevel::error); }
+            Logger::StreamProxy critical() { return log(LogLevel::critical); }
+            /// @}
+
+            /// Number of messages discarded since the last one that made it
+            /// through.
+            std::size_t getSuppressedCount() const { return suppressed_; }
+
+            /// Access the wrapped logger, for messages that must not be
+            /// dropped.
+            Logger &getLogger() const { return *logger_; }
+
+          private:
+            bool tryAcquire() {
+                auto now = clock::now();
+                auto elapsed =
+                    std::chrono::duration<double>(now - lastRefill_).count();
+                lastRefill_ = now;
+                tokens_ = std::min(burst_, tokens_ + elapsed / secondsPerToken_);
+                if (tokens_ < 1.) {
+                    return false;
+                }
+                tokens_ -= 1.;
+                return true;
+            }
+
+            LoggerPtr logger_;
+            double burst_;
+            double tokens_;
+            double secondsPerToken_;
+            clock::time_point lastRefill_;
+            std::size_t suppressed_ = 0;
+            /// Where suppressed messages go if used as a std::ostream: with no
+            /// buffer, it's always in a failed state, so it writes nothing.
+            std::ostream discarded_{nullptr};
+        };
+
+    } // namespace log
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_RateLimitedLogger_h_GUID_E6F2A6C2_F925_44AB_8B25_47F0E77E0082
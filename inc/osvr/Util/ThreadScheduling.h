@@ -0,0 +1,177 @@
+/** @file
+    @brief Header for process-wide configuration of real-time scheduling
+    (priority, CPU affinity, memory locking) of the threads of the server and
+    its plugins.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ThreadScheduling_h_GUID_6D93E9BF_0ED2_49B8_A4C3_3B6D8E1F8A26
+#define INCLUDED_ThreadScheduling_h_GUID_6D93E9BF_0ED2_49B8_A4C3_3B6D8E1F8A26
+
+// Internal Includes
+#include <osvr/Util/Export.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace util {
+    namespace sched {
+        /// @brief The kinds of latency-sensitive threads that can be given
+        /// their own scheduling parameters.
+        enum class ThreadRole {
+            /// The server mainloop thread.
+            Server,
+            /// The callback thread of an asynchronous device.
+            AsyncDevice,
+            /// A tracker's main (fusion) thread.
+            Tracker,
+            /// A tracker's image processing thread.
+            ImageProcessing
+        };
+        static const std::size_t THREAD_ROLE_COUNT = 4;
+
+        /// @brief Gets the configuration-file name of a role ("server",
+        /// "asyncDevice", "tracker", "imageProcessing").
+        OSVR_UTIL_EXPORT const char *getThreadRoleName(ThreadRole role);
+
+        /// @brief Looks up a role by its configuration-file name.
+        /// @return false if the name isn't recognized.
+        OSVR_UTIL_EXPORT bool parseThreadRoleName(std::string const &name,
+                                                  ThreadRole &role);
+
+        enum class SchedulingPolicy {
+            /// Leave the thread's policy and priority alone.
+            Default,
+            /// SCHED_FIFO
+            Fifo,
+            /// SCHED_RR
+            RoundRobin
+        };
+
+        /// @brief Looks up a policy by its configuration-file name
+        /// ("default", "fifo", "rr").
+        /// @return false if the name isn't recognized.
+        OSVR_UTIL_EXPORT bool parseSchedulingPolicy(std::string const &name,
+                                                    SchedulingPolicy &policy);
+
+        struct ThreadSchedulingParams {
+            SchedulingPolicy policy = SchedulingPolicy::Default;
+            /// Real-time priority, 1 (lowest) to 99 on Linux.
+            int priority = 0;
+            /// CPUs to pin the thread to: empty means no affinity change.
+            std::vector<int> cpus;
+        };
+
+        struct RealtimeConfig {
+            /// Lock all current and future pages of the process in memory
+            /// (mlockall) while in low-latency mode.
+            bool lockMemory = false;
+            /// Timer slack for the configured threads, in nanoseconds:
+            /// negative leaves the kernel default (50 us) alone.
+            long timerSlackNanoseconds = -1;
+            /// Log statistics about how late the server thread wakes up.
+            bool reportJitter = false;
+            /// Indexed by ThreadRole.
+            std::array<ThreadSchedulingParams, THREAD_ROLE_COUNT> threads;
+
+            ThreadSchedulingParams &operator[](ThreadRole role) {
+                return threads[static_cast<std::size_t>(role)];
+            }
+            ThreadSchedulingParams const &operator[](ThreadRole role) const {
+                return threads[static_cast<std::size_t>(role)];
+            }
+        };
+
+        /// @brief Sets the process-wide configuration: call before starting
+        /// the threads it should apply to (typically, while parsing the
+        /// server config file).
+        OSVR_UTIL_EXPORT void setRealtimeConfig(RealtimeConfig const &config);
+
+        /// @brief Gets (a copy of) the process-wide configuration.
+        OSVR_UTIL_EXPORT RealtimeConfig getRealtimeConfig();
+
+        /// @brief Applies the configured scheduling policy, priority, CPU
+        /// affinity and timer slack for the role to the calling thread.
+        ///
+        /// Missing privileges (no CAP_SYS_NICE, a low RLIMIT_RTPRIO) are not
+        /// an error: the priority is clamped to the limit, or failing that
+        /// the thread is left at normal priority, and a warning is logged.
+        ///
+        /// A no-op on platforms other than Linux.
+        ///
+        /// @return true if everything configured for the role took effect.
+        OSVR_UTIL_EXPORT bool applyThreadRole(ThreadRole role);
+
+        /// @brief Locks the process's memory if so configured.
+        /// @return true if memory is now locked (by this call).
+        OSVR_UTIL_EXPORT bool lockProcessMemory();
+
+        /// @brief Undoes a successful lockProcessMemory().
+        OSVR_UTIL_EXPORT void unlockProcessMemory();
+
+        /// @brief Accumulates how late a periodic thread woke up compared to
+        /// when it asked to.
+        class JitterStats {
+          public:
+            /// Records one wakeup that was @p microseconds late.
+            void record(double microseconds) {
+                m_count++;
+                m_sum += microseconds;
+                m_sumSquares += microseconds * microseconds;
+                m_max = (std::max)(m_max, microseconds);
+            }
+            std::size_t count() const { return m_count; }
+            double mean() const {
+                return m_count == 0 ? 0. : m_sum / double(m_count);
+            }
+            double max() const { return m_max; }
+            double stddev() const {
+                if (m_count < 2) {
+                    return 0.;
+                }
+                auto m = mean();
+                auto variance = m_sumSquares / double(m_count) - m * m;
+                return variance > 0. ? std::sqrt(variance) : 0.;
+            }
+            void reset() { *this = JitterStats{}; }
+
+          private:
+            std::size_t m_count = 0;
+            double m_sum = 0.;
+            double m_sumSquares = 0.;
+            double m_max = 0.;
+        };
+
+    } // namespace sched
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_ThreadScheduling_h_GUID_6D93E9BF_0ED2_49B8_A4C3_3B6D8E1F8A26
@@ -32,12 +32,15 @@
 #include <boost/noncopyable.hpp>
 #include <boost/operators.hpp>
 #include <boost/assert.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_ref.hpp>
 
 // Standard includes
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace osvr {
 namespace util {
@@ -49,6 +52,11 @@ namespace util {
             NoSuchChild(std::string const &name)
                 : std::runtime_error("No child found with the name " + name) {}
         };
+
+        /// @brief Hash used for tree node names.
+        inline std::size_t hashNodeName(boost::string_ref name) {
+            return boost::hash_range(name.begin(), name.end());
+        }
         /// @brief A node in a generic tree, which can contain an object by
         /// value.
         /// @tparam ValueType The contained value type: must be
@@ -63,6 +71,9 @@ namespace util {
         /// - Contained values are mutable.
         /// - Traversal is provided for by templated visit methods that accept a
         /// functor.
+        /// - Child lookup by name compares precomputed name hashes first, and
+        /// switches from a linear search to a hash index once a node has
+        /// more than a handful of children.
         /// - A "get or create" method is provided that guarantees the return a
         /// child of the given name (default-constructing one if it doesn't
         /// exist)
@@ -104,11 +115,21 @@ namespace util {
             static ptr_type createRoot(value_type const &val);
 
             /// @brief Get the named child, creating it if it doesn't exist.
-            type &getOrCreateChildByName(std::string const &name);
+            type &getOrCreateChildByName(boost::string_ref name);
 
             /// @brief Get the named child, throwing NoSuchChild if it doesn't
             /// exist.
-            type const &getChildByName(std::string const &name) const;
+            type const &getChildByName(boost::string_ref name) const;
+
+            /// @brief Get the named child, or nullptr if it doesn't exist.
+            type *findChildByName(boost::string_ref name) {
+                return m_getChildByName(name);
+            }
+
+            /// @overload
+            type const *findChildByName(boost::string_ref name) const {
+                return m_getChildByName(name);
+            }
 
             /// @brief Gets the name of the current node. This will be empty if
             /// and
@@ -184,7 +205,7 @@ namespace util {
 
             /// @brief Internal helper to get child by name, or a null pointer
             /// if no such child.
-            weak_ptr_type m_getChildByName(std::string const &name) const;
+            weak_ptr_type m_getChildByName(boost::string_ref name) const;
 
             /// @brief Internal helper to add a named child. Assumes no such
             /// child already exists!
@@ -197,9 +218,29 @@ namespace util {
             /// @brief Ownership of children
             ChildList m_children;
 
+            /// @brief Number of children past which we build m_childIndex
+            /// rather than searching m_children.
+            static const std::size_t LINEAR_SEARCH_MAX_CHILDREN = 8;
+
+            struct NameHash {
+                std::size_t operator()(boost::string_ref name) const {
+                    return hashNodeName(name);
+                }
+            };
+            typedef std::unordered_map<boost::string_ref, weak_ptr_type,
+                                       NameHash>
+                ChildIndex;
+            /// @brief Index of children by name (referring to the names
+            /// stored in the children themselves), only populated for nodes
+            /// with many children.
+            ChildIndex m_childIndex;
+
             /// @brief Name
             std::string const m_name;
 
+            /// @brief Hash of the name, computed once.
+            std::size_t const m_nameHash;
+
             /// @brief Weak pointer to parent.
             parent_ptr_type m_parent;
         };
@@ -249,22 +290,22 @@ namespace util {
 
         template <typename ValueType>
         inline TreeNode<ValueType> &
-        TreeNode<ValueType>::getOrCreateChildByName(std::string const &name) {
+        TreeNode<ValueType>::getOrCreateChildByName(boost::string_ref name) {
             weak_ptr_type child = m_getChildByName(name);
             if (child != nullptr) {
                 return *child;
             }
-            return TreeNode::create(*this, name);
+            return TreeNode::create(*this, name.to_string());
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType> const &
-        TreeNode<ValueType>::getChildByName(std::string const &name) const {
+        TreeNode<ValueType>::getChildByName(boost::string_ref name) const {
             weak_ptr_type child = m_getChildByName(name);
             if (child != nullptr) {
                 return *child;
             }
-            throw NoSuchChild(name);
+            throw NoSuchChild(name.to_string());
         }
 
         template <typename ValueType>
@@ -301,12 +342,17 @@ namespace util {
 
         template <typename ValueType>
         inline typename TreeNode<ValueType>::weak_ptr_type
-        TreeNode<ValueType>::m_getChildByName(std::string const &name) const {
-            /// @todo Don't use a linear search here - use an unordered map or
-            /// something.
-            auto it = std::find_if(
-                begin(m_children), end(m_children),
-                [&](ptr_type const &n) { return n->getName() == name; });
+        TreeNode<ValueType>::m_getChildByName(boost::string_ref name) const {
+            if (!m_childIndex.empty()) {
+                auto it = m_childIndex.find(name);
+                return it == end(m_childIndex) ? nullptr : it->second;
+            }
+            auto hash = hashNodeName(name);
+            auto it = std::find_if(begin(m_children), end(m_children),
+                                   [&](ptr_type const &n) {
+                                       return n->m_nameHash == hash &&
+                                              n->getName() == name;
+                                   });
             weak_ptr_type ret = nullptr;
             if (it != end(m_children)) {
                 ret = (*it).get();
@@ -318,12 +364,25 @@ namespace util {
         inline void TreeNode<ValueType>::m_addChild(
             typename TreeNode<ValueType>::ptr_type const &child) {
             m_children.push_back(child);
+            if (m_children.size() > LINEAR_SEARCH_MAX_CHILDREN) {
+                if (m_childIndex.empty()) {
+                    for (auto const &existing : m_children) {
+                        m_childIndex.emplace(
+                            boost::string_ref(existing->getName()),
+                            existing.get());
+                    }
+                } else {
+                    m_childIndex.emplace(boost::string_ref(child->getName()),
+                                         child.get());
+                }
+            }
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name)
-            : m_value(), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(), m_children(), m_name(name),
+              m_nameHash(hashNodeName(m_name)), m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -334,7 +393,8 @@ namespace util {
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name,
                                              ValueType const &val)
-            : m_value(val), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(val), m_children(), m_name(name),
+              m_nameHash(hashNodeName(m_name)), m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -343,13 +403,15 @@ namespace util {
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode()
-            : m_value(), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(), m_children(), m_name(), m_nameHash(hashNodeName("")),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(ValueType const &val)
-            : m_value(val), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(val), m_children(), m_name(),
+              m_nameHash(hashNodeName("")), m_parent(nullptr) {
             /// Special root constructor
         }
 
@@ -47,6 +47,9 @@ namespace vrpnserver {
     /// OSVR_PluginRegContext.
     /// @returns the pointer, or null if this isn't a VRPN connection or
     /// something else went wrong.
+    ///
+    /// Serialized with other plugins' host access during concurrent hardware
+    /// detection: see pluginhost::waitForHostAccess().
     OSVR_VRPNSERVER_EXPORT vrpn_Connection *
     getVRPNConnection(OSVR_PluginRegContext ctx);
 
@@ -89,6 +89,11 @@ namespace vrpnserver {
 
         /// @brief Get the vrpn_Connection object to use in constructing your
         /// object.
+        ///
+        /// During concurrent hardware detection, this waits for this plugin's
+        /// turn with the host (see pluginhost::waitForHostAccess()), so call
+        /// it right before constructing - not before any probing you'd like
+        /// to run in parallel with other plugins.
         OSVR_VRPNSERVER_EXPORT vrpn_Connection *getVRPNConnection();
 
         /// @brief Registers your custom device with the server and takes
@@ -0,0 +1,88 @@
+/** @file
+    @brief Header with the motion extrapolation used by the dead-reckoning
+    pose filter.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DeadReckoningMath_h_GUID_0658E7F8_03D1_48DD_9249_60EAAA96C3F3
+#define INCLUDED_DeadReckoningMath_h_GUID_0658E7F8_03D1_48DD_9249_60EAAA96C3F3
+
+// Internal Includes
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/EigenQuatExponentialMap.h>
+
+// Library/third-party includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace deadreckoning {
+    /// Converts an incremental rotation over dt seconds into a rotation vector
+    /// per second (angular velocity, or acceleration for an incremental
+    /// rotation of the angular velocity).
+    ///
+    /// The incremental rotation is a room (tracker) frame rotation by the full
+    /// angle turned in dt, as the unified video-inertial tracker reports it,
+    /// so the resulting rate is in the room frame too. A non-positive dt
+    /// carries no rate and gives zero.
+    inline Eigen::Vector3d incRotToRate(OSVR_IncrementalQuaternion const &inc) {
+        if (inc.dt <= 0) {
+            return Eigen::Vector3d::Zero();
+        }
+        Eigen::Quaterniond q = util::fromQuat(inc.incrementalRotation);
+        if (q.w() < 0) {
+            /// Take the short way around.
+            q.coeffs() *= -1;
+        }
+        /// quat_ln gives the half-angle rotation vector.
+        return 2. * util::quat_ln(q.normalized()) / inc.dt;
+    }
+
+    /// Extrapolates a position dt seconds ahead, assuming constant linear
+    /// acceleration.
+    inline Eigen::Vector3d predictPosition(Eigen::Vector3d const &position,
+                                           Eigen::Vector3d const &velocity,
+                                           Eigen::Vector3d const &acceleration,
+                                           double dt) {
+        return position + velocity * dt + acceleration * (0.5 * dt * dt);
+    }
+
+    /// Extrapolates an orientation dt seconds ahead, assuming constant
+    /// angular acceleration. The rates are room-frame rotation vectors per
+    /// second (see incRotToRate), so the rotation pre-multiplies.
+    inline Eigen::Quaterniond
+    predictOrientation(Eigen::Quaterniond const &orientation,
+                       Eigen::Vector3d const &angularVelocity,
+                       Eigen::Vector3d const &angularAcceleration, double dt) {
+        Eigen::Vector3d rotation =
+            angularVelocity * dt + angularAcceleration * (0.5 * dt * dt);
+        /// quat_exp takes the half-angle rotation vector.
+        return (util::quat_exp(0.5 * rotation) * orientation).normalized();
+    }
+} // namespace deadreckoning
+} // namespace osvr
+
+#endif // INCLUDED_DeadReckoningMath_h_GUID_0658E7F8_03D1_48DD_9249_60EAAA96C3F3
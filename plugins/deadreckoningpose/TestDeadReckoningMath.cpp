@@ -0,0 +1,177 @@
+/** @file
+    @brief Test of the dead-reckoning pose filter's rate conversion and
+    extrapolation, including its frame convention for incremental rotations.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "DeadReckoningMath.h"
+/// The unified video-inertial tracker is the producer whose incremental
+/// rotations we check the frame convention against.
+#include "../unifiedvideoinertialtracker/AngVelTools.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+// - none
+
+using osvr::deadreckoning::incRotToRate;
+using osvr::deadreckoning::predictOrientation;
+using osvr::deadreckoning::predictPosition;
+
+static const double TOLERANCE = 1e-9;
+
+namespace {
+inline OSVR_IncrementalQuaternion makeIncRot(Eigen::Quaterniond const &q,
+                                             double dt) {
+    OSVR_IncrementalQuaternion ret;
+    osvr::util::toQuat(q, ret.incrementalRotation);
+    ret.dt = dt;
+    return ret;
+}
+
+/// Rotation by the full angle |rate| * dt about rate, as an incremental
+/// rotation is documented to be.
+inline Eigen::Quaterniond rotationOver(Eigen::Vector3d const &rate,
+                                       double dt) {
+    return Eigen::Quaterniond(
+        Eigen::AngleAxisd(rate.norm() * dt, rate.normalized()));
+}
+
+inline Eigen::Quaterniond someOrientation() {
+    return Eigen::Quaterniond(
+        Eigen::AngleAxisd(1.2, Eigen::Vector3d(1, -2, 0.5).normalized()));
+}
+} // namespace
+
+TEST_CASE("DeadReckoning-constant-rate") {
+    const Eigen::Vector3d rate(0.3, -1.1, 2.);
+    const double dt = 0.01;
+    auto inc = makeIncRot(rotationOver(rate, dt), dt);
+
+    SECTION("Rate round-trips through an incremental rotation") {
+        REQUIRE(incRotToRate(inc).isApprox(rate, TOLERANCE));
+    }
+
+    SECTION("Either sign of the quaternion gives the same rate") {
+        Eigen::Quaterniond q = rotationOver(rate, dt);
+        q.coeffs() *= -1;
+        auto negated = makeIncRot(q, dt);
+        REQUIRE(incRotToRate(negated).isApprox(rate, TOLERANCE));
+    }
+
+    SECTION("Prediction turns by the full angle over the horizon") {
+        const double horizon = 0.5;
+        auto start = someOrientation();
+        auto predicted =
+            predictOrientation(start, incRotToRate(inc),
+                               Eigen::Vector3d::Zero(), horizon);
+        REQUIRE(predicted.angularDistance(rotationOver(rate, horizon) *
+                                          start) < TOLERANCE);
+        REQUIRE(start.angularDistance(predicted) ==
+                Approx(rate.norm() * horizon));
+    }
+
+    SECTION("Predicting in two steps matches one step") {
+        auto start = someOrientation();
+        auto once = predictOrientation(start, rate, Eigen::Vector3d::Zero(),
+                                       0.04);
+        auto halfway = predictOrientation(start, rate,
+                                          Eigen::Vector3d::Zero(), 0.02);
+        auto twice = predictOrientation(halfway, rate,
+                                        Eigen::Vector3d::Zero(), 0.02);
+        REQUIRE(once.angularDistance(twice) < TOLERANCE);
+    }
+
+    SECTION("Position follows constant acceleration") {
+        const Eigen::Vector3d pos(1, 2, 3);
+        const Eigen::Vector3d vel(0.5, 0, -1);
+        const Eigen::Vector3d acc(0, -9.8, 0);
+        REQUIRE(predictPosition(pos, vel, acc, 0.1)
+                    .isApprox(Eigen::Vector3d(1.05, 2. - 0.049, 2.9),
+                              TOLERANCE));
+    }
+}
+
+TEST_CASE("DeadReckoning-zero-dt") {
+    const Eigen::Vector3d rate(0.3, -1.1, 2.);
+    auto q = rotationOver(rate, 0.01);
+
+    SECTION("An incremental rotation without a positive dt has no rate") {
+        REQUIRE(incRotToRate(makeIncRot(q, 0)).isZero());
+        REQUIRE(incRotToRate(makeIncRot(q, -0.01)).isZero());
+    }
+
+    SECTION("Predicting zero seconds ahead changes nothing") {
+        auto start = someOrientation();
+        REQUIRE(predictOrientation(start, rate, rate, 0)
+                    .angularDistance(start) < TOLERANCE);
+        const Eigen::Vector3d pos(1, 2, 3);
+        REQUIRE(predictPosition(pos, rate, rate, 0) == pos);
+    }
+}
+
+TEST_CASE("DeadReckoning-zero-rate") {
+    SECTION("An identity incremental rotation has no rate") {
+        REQUIRE(incRotToRate(makeIncRot(Eigen::Quaterniond::Identity(), 0.02))
+                    .isZero());
+    }
+
+    SECTION("Without rates, prediction holds the pose") {
+        auto start = someOrientation();
+        REQUIRE(predictOrientation(start, Eigen::Vector3d::Zero(),
+                                   Eigen::Vector3d::Zero(), 0.5)
+                    .angularDistance(start) < TOLERANCE);
+        const Eigen::Vector3d pos(1, 2, 3);
+        REQUIRE(predictPosition(pos, Eigen::Vector3d::Zero(),
+                                Eigen::Vector3d::Zero(), 0.5) == pos);
+    }
+}
+
+TEST_CASE("DeadReckoning-frame-matches-unified-tracker") {
+    /// The unified tracker filters angular velocity in the body frame, and
+    /// reports it as orientation * incRot * orientation^-1 (see
+    /// angVelVecToQuat in ThreadsafeBodyReporting.cpp): a room-frame rotation.
+    const Eigen::Vector3d bodyRate(0.3, -1.1, 2.);
+    const double dt = 1. / 50.;
+    auto orientation = someOrientation();
+    Eigen::Quaterniond reported =
+        orientation * osvr::vbtracker::angVelVecToIncRot(bodyRate, dt) *
+        orientation.conjugate();
+    auto rate = incRotToRate(makeIncRot(reported, dt));
+
+    SECTION("The rate is the body rate rotated into the room frame") {
+        REQUIRE(rate.isApprox(orientation * bodyRate, TOLERANCE));
+    }
+
+    SECTION("Prediction matches integrating the body rate") {
+        const double horizon = 0.1;
+        auto predicted = predictOrientation(
+            orientation, rate, Eigen::Vector3d::Zero(), horizon);
+        REQUIRE(predicted.angularDistance(
+                    orientation * rotationOver(bodyRate, horizon)) <
+                TOLERANCE);
+    }
+}
@@ -0,0 +1,361 @@
+/** @file
+    @brief Full-pose dead-reckoning analysis plugin, publishing a predicted
+    pose per configured prediction horizon.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "DeadReckoningMath.h"
+#include <osvr/AnalysisPluginKit/AnalysisPluginKitC.h>
+#include <osvr/PluginKit/PluginKit.h>
+#include <osvr/PluginKit/TrackerInterfaceC.h>
+#include <osvr/ClientKit/InterfaceC.h>
+#include <osvr/ClientKit/InterfaceCallbackC.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/StringLiteralFileToString.h>
+
+// Generated JSON header file
+#include "org_osvr_filter_deadreckoningpose_json.h"
+
+// Library/third-party includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <json/reader.h>
+#include <json/value.h>
+
+// Standard includes
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Anonymous namespace to avoid symbol collision
+namespace {
+
+using osvr::deadreckoning::incRotToRate;
+using osvr::deadreckoning::predictOrientation;
+using osvr::deadreckoning::predictPosition;
+
+static const auto DRIVER_NAME = "DeadReckoningPoseTracker";
+
+/// A prediction interval to publish, as one block of output sensors.
+struct Horizon {
+    /// Semantic name for the block, optional.
+    std::string name;
+    /// How far ahead of the input report to predict, in seconds.
+    double seconds;
+};
+
+/// The latest known motion state for one input sensor.
+struct SensorState {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    Eigen::Quaterniond orientation = Eigen::Quaterniond::Identity();
+    /// All rates are in the room (tracker) frame.
+    Eigen::Vector3d linearVelocity = Eigen::Vector3d::Zero();
+    Eigen::Vector3d angularVelocity = Eigen::Vector3d::Zero();
+    Eigen::Vector3d linearAcceleration = Eigen::Vector3d::Zero();
+    Eigen::Vector3d angularAcceleration = Eigen::Vector3d::Zero();
+    OSVR_TimeValue timestamp = {};
+    bool hasPose = false;
+    /// Whether anything was reported since we last published.
+    bool dirty = false;
+
+    /// Extrapolates the pose dt seconds ahead, assuming constant
+    /// acceleration.
+    void predict(double dt, OSVR_PoseState &out) const {
+        osvr::util::vecMap(out.translation) =
+            predictPosition(position, linearVelocity, linearAcceleration, dt);
+        osvr::util::toQuat(predictOrientation(orientation, angularVelocity,
+                                              angularAcceleration, dt),
+                           out.rotation);
+    }
+};
+
+class DeadReckoningPoseDevice {
+  public:
+    DeadReckoningPoseDevice(OSVR_PluginRegContext ctx, std::string const &name,
+                            std::string const &input, std::size_t numSensors,
+                            std::vector<Horizon> const &horizons,
+                            bool useAcceleration)
+        : m_horizons(horizons), m_useAcceleration(useAcceleration),
+          m_sensors(numSensors) {
+        /// Create the initialization options
+        OSVR_DeviceInitOptions opts = osvrDeviceCreateInitOptions(ctx);
+
+        osvrDeviceTrackerConfigure(opts, &m_trackerOut);
+
+        /// Create the device token with the options
+        OSVR_DeviceToken dev;
+        if (OSVR_RETURN_FAILURE ==
+            osvrAnalysisSyncInit(ctx, name.c_str(), opts, &dev, &m_clientCtx)) {
+            throw std::runtime_error("Could not initialize analysis plugin!");
+        }
+        m_dev = osvr::pluginkit::DeviceToken(dev);
+
+        /// Send JSON descriptor
+        m_dev.sendJsonDescriptor(makeDescriptor());
+
+        /// Register update callback
+        m_dev.registerUpdateCallback(this);
+
+        /// Create our client interface and register callbacks.
+        if (OSVR_RETURN_FAILURE == osvrClientGetInterface(m_clientCtx,
+                                                          input.c_str(),
+                                                          &m_clientInterface)) {
+            throw std::runtime_error(
+                "Could not get client interface for analysis plugin!");
+        }
+        osvrRegisterPoseCallback(m_clientInterface,
+                                 &DeadReckoningPoseDevice::poseCallback, this);
+        osvrRegisterVelocityCallback(
+            m_clientInterface, &DeadReckoningPoseDevice::velocityCallback,
+            this);
+        if (m_useAcceleration) {
+            osvrRegisterAccelerationCallback(
+                m_clientInterface,
+                &DeadReckoningPoseDevice::accelerationCallback, this);
+        }
+    }
+
+    ~DeadReckoningPoseDevice() {
+        /// Free the client interface so we don't end up getting called after
+        /// destruction.
+        osvrClientFreeInterface(m_clientCtx, m_clientInterface);
+    }
+
+    static void poseCallback(void *userdata, const OSVR_TimeValue *timestamp,
+                             const OSVR_PoseReport *report) {
+        auto &self = *static_cast<DeadReckoningPoseDevice *>(userdata);
+        auto state = self.getSensor(report->sensor);
+        if (!state) {
+            return;
+        }
+        state->position = osvr::util::vecMap(report->pose.translation);
+        state->orientation = osvr::util::fromQuat(report->pose.rotation);
+        state->timestamp = *timestamp;
+        state->hasPose = true;
+        state->dirty = true;
+    }
+
+    static void velocityCallback(void *userdata,
+                                 const OSVR_TimeValue * /*timestamp*/,
+                                 const OSVR_VelocityReport *report) {
+        auto &self = *static_cast<DeadReckoningPoseDevice *>(userdata);
+        auto state = self.getSensor(report->sensor);
+        if (!state) {
+            return;
+        }
+        if (report->state.linearVelocityValid) {
+            state->linearVelocity =
+                osvr::util::vecMap(report->state.linearVelocity);
+        }
+        if (report->state.angularVelocityValid) {
+            state->angularVelocity =
+                incRotToRate(report->state.angularVelocity);
+        }
+        state->dirty = true;
+    }
+
+    static void accelerationCallback(void *userdata,
+                                     const OSVR_TimeValue * /*timestamp*/,
+                                     const OSVR_AccelerationReport *report) {
+        auto &self = *static_cast<DeadReckoningPoseDevice *>(userdata);
+        auto state = self.getSensor(report->sensor);
+        if (!state) {
+            return;
+        }
+        if (report->state.linearAccelerationValid) {
+            state->linearAcceleration =
+                osvr::util::vecMap(report->state.linearAcceleration);
+        }
+        if (report->state.angularAccelerationValid) {
+            state->angularAcceleration =
+                incRotToRate(report->state.angularAcceleration);
+        }
+        state->dirty = true;
+    }
+
+    /// Publishes predictions for every sensor reported on since the last
+    /// update: all client callbacks for this mainloop pass have run by now,
+    /// so a pose and the velocity sent along with it are used together.
+    OSVR_ReturnCode update() {
+        OSVR_PoseState predicted;
+        auto numSensors = m_sensors.size();
+        for (std::size_t sensor = 0; sensor < numSensors; ++sensor) {
+            auto &state = m_sensors[sensor];
+            if (!state.dirty || !state.hasPose) {
+                continue;
+            }
+            state.dirty = false;
+            for (std::size_t h = 0; h < m_horizons.size(); ++h) {
+                state.predict(m_horizons[h].seconds, predicted);
+                /// Keep the input timestamp, so consumers can still tell how
+                /// old the underlying measurement is.
+                osvrDeviceTrackerSendPoseTimestamped(
+                    m_dev, m_trackerOut, &predicted,
+                    static_cast<OSVR_ChannelCount>(h * numSensors + sensor),
+                    &state.timestamp);
+            }
+        }
+        return OSVR_RETURN_SUCCESS;
+    }
+
+  private:
+    SensorState *getSensor(int32_t sensor) {
+        if (sensor < 0 ||
+            static_cast<std::size_t>(sensor) >= m_sensors.size()) {
+            /// Outside the configured numSensors: no output sensor for it.
+            return nullptr;
+        }
+        return &m_sensors[sensor];
+    }
+
+    /// Output sensor h * numSensors + s is input sensor s predicted over
+    /// horizon h: horizon 0 keeps the input's sensor numbering.
+    std::string makeDescriptor() const {
+        Json::Value descriptor;
+        {
+            Json::Reader reader;
+            if (!reader.parse(osvr::util::makeString(
+                                  org_osvr_filter_deadreckoningpose_json),
+                              descriptor)) {
+                throw std::logic_error("Faulty JSON file for Dead Reckoning "
+                                       "Pose Filter - should not be "
+                                       "possible!");
+            }
+        }
+        auto numSensors = m_sensors.size();
+        descriptor["interfaces"]["tracker"]["count"] =
+            Json::UInt(numSensors * m_horizons.size());
+        for (std::size_t h = 0; h < m_horizons.size(); ++h) {
+            auto const &horizonName = m_horizons[h].name;
+            if (horizonName.empty()) {
+                continue;
+            }
+            auto &semantic = descriptor["semantic"];
+            if (1 == numSensors) {
+                semantic[horizonName] = "tracker/" + std::to_string(h);
+                continue;
+            }
+            for (std::size_t sensor = 0; sensor < numSensors; ++sensor) {
+                semantic[horizonName][std::to_string(sensor)] =
+                    "tracker/" + std::to_string(h * numSensors + sensor);
+            }
+        }
+        return descriptor.toStyledString();
+    }
+
+    const std::vector<Horizon> m_horizons;
+    const bool m_useAcceleration;
+
+    OSVR_TrackerDeviceInterface m_trackerOut;
+    osvr::pluginkit::DeviceToken m_dev;
+    OSVR_ClientContext m_clientCtx;
+    OSVR_ClientInterface m_clientInterface;
+
+    std::vector<SensorState, Eigen::aligned_allocator<SensorState>> m_sensors;
+};
+
+class AnalysisPluginInstantiation {
+  public:
+    AnalysisPluginInstantiation() {}
+    OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx, const char *params) {
+        Json::Value root;
+        {
+            Json::Reader reader;
+            if (!reader.parse(params, root)) {
+                std::cerr << "Couldn't parse JSON for dead-reckoning pose "
+                             "filter!"
+                          << std::endl;
+                return OSVR_RETURN_FAILURE;
+            }
+        }
+
+        // required
+        if (!root.isMember("input")) {
+            std::cerr << "Error: got configuration, but no input specified."
+                      << std::endl;
+            return OSVR_RETURN_FAILURE;
+        }
+        auto input = root["input"].asString();
+
+        // optional
+        auto deviceName = root.get("name", DRIVER_NAME).asString();
+        auto numSensors = root.get("numSensors", 1).asInt();
+        if (numSensors < 1) {
+            std::cerr << "Error: numSensors must be at least 1." << std::endl;
+            return OSVR_RETURN_FAILURE;
+        }
+        auto useAcceleration = root.get("useAcceleration", true).asBool();
+
+        std::vector<Horizon> horizons;
+        if (root.isMember("horizons")) {
+            for (auto const &entry : root["horizons"]) {
+                // Either just a number of milliseconds, or an object naming
+                // the horizon.
+                Horizon horizon;
+                if (entry.isObject()) {
+                    horizon.name = entry.get("name", "").asString();
+                    horizon.seconds =
+                        entry.get("milliseconds", 0).asDouble() * 1e-3;
+                } else {
+                    horizon.seconds = entry.asDouble() * 1e-3;
+                }
+                horizons.push_back(horizon);
+            }
+        } else {
+            // Same key and default as the dead-reckoning rotation filter.
+            horizons.push_back(
+                Horizon{"", root.get("predictMilliSeconds", 32).asDouble() *
+                                1e-3});
+        }
+        if (horizons.empty()) {
+            std::cerr << "Error: no prediction horizons specified."
+                      << std::endl;
+            return OSVR_RETURN_FAILURE;
+        }
+
+        osvr::pluginkit::PluginContext context(ctx);
+
+        /// @todo make the token own this instead once there is API for that.
+        context.registerObjectForDeletion(new DeadReckoningPoseDevice(
+            ctx, deviceName, input, static_cast<std::size_t>(numSensors),
+            horizons, useAcceleration));
+        return OSVR_RETURN_SUCCESS;
+    }
+};
+} // namespace
+
+OSVR_PLUGIN(org_osvr_filter_deadreckoningpose) {
+    osvr::pluginkit::PluginContext context(ctx);
+
+    /// Register a detection callback function object.
+    context.registerDriverInstantiationCallback(DRIVER_NAME,
+                                                AnalysisPluginInstantiation());
+
+    return OSVR_RETURN_SUCCESS;
+}
@@ -32,6 +32,7 @@
 #include "VRPNMultiserver.h"
 #include "DevicesWithParameters.h"
 #include <osvr/PluginKit/PluginKit.h>
+#include <osvr/PluginHost/HostAccess.h>
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Util/StringLiteralFileToString.h>
 #include <osvr/VRPNServer/VRPNDeviceRegistration.h>
@@ -77,6 +78,10 @@ class VRPNHardwareDetect : boost::noncopyable {
 #ifdef OSVR_MULTISERVER_VERBOSE
         bool first = true;
 #endif
+        // HIDAPI's enumeration isn't safe to run alongside another plugin's
+        // HID access, and everything found here becomes a VRPN device on the
+        // shared connection anyway: take our turn with the host up front.
+        osvr::pluginhost::waitForHostAccess();
         do {
             gotDevice = false;
             struct hid_device_info *enumData = hid_enumerate(0, 0);
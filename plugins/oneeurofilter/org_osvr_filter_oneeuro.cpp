@@ -39,8 +39,8 @@
 #include <json/value.h>
 
 // Standard includes
+#include <cstddef>
 #include <iostream>
-#include <memory>
 #include <vector>
 
 // Anonymous namespace to avoid symbol collision
@@ -61,7 +61,7 @@ class OneEuroFilterDevice {
     OneEuroFilterDevice(OSVR_PluginRegContext ctx, std::string const &name,
                         std::string const &input, Params const &posParams,
                         Params const &oriParams)
-        : m_posParams(posParams), m_oriParams(oriParams) {
+        : m_filters(posParams, oriParams) {
         /// Create the initialization options
         OSVR_DeviceInitOptions opts = osvrDeviceCreateInitOptions(ctx);
 
@@ -106,84 +106,78 @@ class OneEuroFilterDevice {
         self.handleData(*timestamp, *report);
     }
 
-    /// Processes a tracker report.
+    /// Queues a tracker report: reports are filtered a frame at a time.
     void handleData(OSVR_TimeValue const &timestamp,
                     OSVR_PoseReport const &report) {
-        ensureSensorId(report.sensor);
-        auto &sensorData = *m_sensors[report.sensor];
-        double dt =
-            (timestamp.microseconds - sensorData.lastReport.microseconds) /
-                1000000.0 +
-            (timestamp.seconds - sensorData.lastReport.seconds);
-        if (dt <= 0) {
-            dt = 1; // in case of weirdness, avoid divide by zero.
+        auto sensor = static_cast<std::size_t>(report.sensor);
+        if (m_filters.isPending(sensor)) {
+            /// A second report for this sensor - the frame is over.
+            flushFrame();
         }
-        OSVR_PoseState filteredPose;
+        if (m_lastReport.size() <= sensor) {
+            std::cout << "Resizing to handle sensor #" << sensor << "\n";
+            m_lastReport.resize(sensor + 1);
+            m_hasLastReport.resize(sensor + 1, false);
+        }
+        /// No previous report means no dt: the filter bank then uses its
+        /// fallback (harmless, as a first sample isn't filtered).
+        double dt = 0;
+        if (m_hasLastReport[sensor]) {
+            dt = osvrTimeValueDurationSeconds(&timestamp,
+                                              &m_lastReport[sensor]);
+        }
+        m_lastReport[sensor] = timestamp;
+        m_hasLastReport[sensor] = true;
+
         using osvr::util::vecMap;
-        using osvr::util::toQuat;
         using osvr::util::fromQuat;
-
-        /// Perform filtration
-        vecMap(filteredPose.translation) = sensorData.positionFilter.filter(
-            dt, vecMap(report.pose.translation));
-        auto filteredQuat = sensorData.orientationFilter.filter(
-            dt, fromQuat(report.pose.rotation));
-        toQuat(filteredQuat, filteredPose.rotation);
-
-        /// Update last report time.
-        sensorData.lastReport = timestamp;
-
-        /// Send report
-        osvrDeviceTrackerSendPoseTimestamped(m_dev, m_trackerOut, &filteredPose,
-                                             report.sensor, &timestamp);
+        m_filters.addToFrame(sensor, dt, vecMap(report.pose.translation),
+                             fromQuat(report.pose.rotation));
+        m_frameTimestamps.push_back(timestamp);
     }
 
     OSVR_ReturnCode update() {
-        // Nothing to do here - everything happens in a callback.
+        /// All client callbacks for this pass have already run.
+        flushFrame();
         return OSVR_RETURN_SUCCESS;
     }
 
-    void ensureSensorId(OSVR_ChannelCount sensor) {
-        /// Make sure there's enough entries in the vector.
-        if (m_sensors.size() <= sensor) {
-            std::cout << "Resizing to handle sensor #" << sensor << "\n";
-            m_sensors.resize(sensor + 1);
+    /// Filters all queued reports together and sends the results.
+    void flushFrame() {
+        auto n = m_filters.frameSize();
+        if (0 == n) {
+            return;
         }
-        /// Make sure the desired entry isn't a null pointer.
-        if (!m_sensors[sensor]) {
-            std::cout << "Creating sensor data object for sensor #" << sensor
-                      << std::endl;
-            m_sensors[sensor] = makeSensorData();
+        m_filters.filterFrame();
+
+        using osvr::util::vecMap;
+        using osvr::util::toQuat;
+        OSVR_PoseState filteredPose;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto sensor = m_filters.frameSensor(i);
+            vecMap(filteredPose.translation) = m_filters.getPosition(sensor);
+            toQuat(m_filters.getOrientation(sensor), filteredPose.rotation);
+            osvrDeviceTrackerSendPoseTimestamped(
+                m_dev, m_trackerOut, &filteredPose,
+                static_cast<OSVR_ChannelCount>(sensor), &m_frameTimestamps[i]);
         }
+        m_frameTimestamps.clear();
     }
 
   private:
-    const Params m_posParams;
-    const Params m_oriParams;
-
     OSVR_TrackerDeviceInterface m_trackerOut;
     osvr::pluginkit::DeviceToken m_dev;
     OSVR_ClientContext m_clientCtx;
     OSVR_ClientInterface m_clientInterface;
 
-    struct SensorData {
-        SensorData(Params const &posParams, Params const &oriParams)
-            : positionFilter(posParams), orientationFilter(oriParams),
-              lastReport(osvr::util::time::getNow()) {}
-
-        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
-
-        filters::OneEuroFilter<Eigen::Vector3d> positionFilter;
-        filters::OneEuroFilter<Eigen::Quaterniond> orientationFilter;
-        osvr::util::time::TimeValue lastReport;
-    };
-    using SensorDataPtr = std::unique_ptr<SensorData>;
-
-    SensorDataPtr makeSensorData() const {
-        SensorDataPtr ret(new SensorData(m_posParams, m_oriParams));
-        return ret;
-    }
-    std::vector<SensorDataPtr> m_sensors;
+    filters::PoseOneEuroFilterBankd m_filters;
+    /// @name Per-sensor timestamp of the last report
+    /// @{
+    std::vector<OSVR_TimeValue> m_lastReport;
+    std::vector<bool> m_hasLastReport;
+    /// @}
+    /// Timestamps of the queued reports, in frame order.
+    std::vector<OSVR_TimeValue> m_frameTimestamps;
 };
 
 class AnalysisPluginInstantiation {
@@ -0,0 +1,158 @@
+/** @file
+    @brief Benchmark of beacon blink-code identification with many beacons
+    and long patterns, against the substring search it used to do. Not
+    automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlinkCodeTable.h"
+#include "IdentifierHelpers.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+using clock_type = std::chrono::steady_clock;
+
+/// The previous implementation, for comparison.
+class WrappedStringSearch {
+  public:
+    explicit WrappedStringSearch(std::vector<std::string> const &patterns) {
+        for (auto const &pat : patterns) {
+            auto wrapped = pat + pat;
+            wrapped.pop_back();
+            m_wrapped.push_back(std::move(wrapped));
+        }
+    }
+    int identify(BrightnessList const &brightnesses,
+                 Brightness threshold) const {
+        auto bits = getBitsUsingThreshold(brightnesses, threshold);
+        for (std::size_t i = 0; i < m_wrapped.size(); ++i) {
+            if (m_wrapped[i].find(bits) != std::string::npos) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+  private:
+    std::vector<std::string> m_wrapped;
+};
+
+template <typename F> static double timeMicroseconds(F &&f) {
+    auto start = clock_type::now();
+    f();
+    return std::chrono::duration<double, std::micro>(clock_type::now() -
+                                                     start)
+        .count();
+}
+
+static void run(std::size_t numBeacons, std::size_t length,
+                std::size_t numSamples) {
+    std::mt19937 gen(length * 1000 + numBeacons);
+    std::bernoulli_distribution coin;
+    std::uniform_real_distribution<Brightness> noise(-0.2f, 0.2f);
+
+    std::vector<std::string> patterns;
+    for (std::size_t i = 0; i < numBeacons; ++i) {
+        std::string pat;
+        for (std::size_t bit = 0; bit < length; ++bit) {
+            pat.push_back(coin(gen) ? '*' : '.');
+        }
+        patterns.push_back(pat);
+    }
+
+    // Brightness histories: noisy rotations of the patterns, with one in
+    // five being noise that shouldn't match anything.
+    std::uniform_int_distribution<std::size_t> pickBeacon(0, numBeacons - 1);
+    std::uniform_int_distribution<std::size_t> pickRotation(0, length - 1);
+    std::uniform_int_distribution<int> pickKind(0, 4);
+    std::vector<BrightnessList> samples(numSamples);
+    for (auto &sample : samples) {
+        if (pickKind(gen) == 0) {
+            for (std::size_t bit = 0; bit < length; ++bit) {
+                sample.push_back((coin(gen) ? 1.f : 0.f) + noise(gen));
+            }
+            continue;
+        }
+        auto const &pat = patterns[pickBeacon(gen)];
+        auto rotation = pickRotation(gen);
+        for (std::size_t bit = 0; bit < length; ++bit) {
+            auto c = pat[(bit + rotation) % length];
+            sample.push_back((c == '*' ? 1.f : 0.f) + noise(gen));
+        }
+    }
+    const Brightness threshold = 0.5f;
+
+    BlinkCodeTable table(patterns);
+    WrappedStringSearch search(patterns);
+    std::vector<int> tableIds(numSamples);
+    std::vector<int> searchIds(numSamples);
+    auto tableTime = timeMicroseconds([&] {
+        for (std::size_t i = 0; i < numSamples; ++i) {
+            tableIds[i] = table.identify(samples[i], threshold);
+        }
+    });
+    auto searchTime = timeMicroseconds([&] {
+        for (std::size_t i = 0; i < numSamples; ++i) {
+            searchIds[i] = search.identify(samples[i], threshold);
+        }
+    });
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < numSamples; ++i) {
+        if (tableIds[i] != searchIds[i]) {
+            ++mismatches;
+        }
+    }
+
+    std::cout << numBeacons << " beacons, pattern length " << length
+              << ":\n"
+              << "  BlinkCodeTable:  " << tableTime * 1000. / numSamples
+              << " ns per identification\n"
+              << "  String search:   " << searchTime * 1000. / numSamples
+              << " ns per identification\n";
+    if (mismatches) {
+        std::cout << "  " << mismatches << " RESULTS DIFFERED!\n";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t numBeacons = 48;
+    if (argc > 1) {
+        numBeacons = std::strtoul(argv[1], nullptr, 10);
+    }
+    const std::size_t numSamples = 100000;
+    for (std::size_t length : {16, 24, 32, 48, 64, 96}) {
+        run(numBeacons, length, numSamples);
+    }
+    return 0;
+}
@@ -0,0 +1,199 @@
+/** @file
+    @brief Benchmark of the ring-buffer HistoryContainer, against the deque
+    it used to wrap, in a simulation of TrackedBody's use. Not automated.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+
+// Internal Includes
+#include "HistoryContainer.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <utility>
+
+using namespace osvr::vbtracker;
+using clock_type = std::chrono::steady_clock;
+using osvr::util::time::TimeValue;
+
+/// The previous, deque-based implementation (just the operations TrackedBody
+/// uses), for comparison.
+template <typename ValueType> class DequeHistoryContainer {
+  public:
+    using full_value_type = std::pair<TimeValue, ValueType>;
+    using container_type = std::deque<full_value_type>;
+    using const_iterator = typename container_type::const_iterator;
+    using comparator_type =
+        history::detail::TimestampPairLessThan<ValueType>;
+
+    bool empty() const { return m_history.empty(); }
+    const_iterator begin() const { return m_history.cbegin(); }
+    const_iterator end() const { return m_history.cend(); }
+
+    const_iterator upper_bound(TimeValue const &tv) const {
+        return std::upper_bound(begin(), end(), tv, comparator_type{});
+    }
+    const_iterator closest_not_newer(TimeValue const &tv) const {
+        auto it = upper_bound(tv);
+        if (begin() == it) {
+            return end();
+        }
+        return --it;
+    }
+    std::size_t pop_before(TimeValue const &tv) {
+        auto lastIt = std::lower_bound(m_history.begin(), m_history.end(), tv,
+                                       comparator_type{});
+        auto count = std::distance(m_history.begin(), lastIt);
+        m_history.erase(m_history.begin(), lastIt);
+        return count;
+    }
+    std::size_t pop_after(TimeValue const &tv) {
+        auto firstIt = std::upper_bound(m_history.begin(), m_history.end(),
+                                        tv, comparator_type{});
+        auto count = std::distance(firstIt, m_history.end());
+        m_history.erase(firstIt, m_history.end());
+        return count;
+    }
+    void push_newest(TimeValue const &tv, ValueType const &value) {
+        m_history.emplace_back(tv, value);
+    }
+
+  private:
+    container_type m_history;
+};
+
+/// About the size of a StateHistoryEntry for the 12-dimensional body state:
+/// state vector, covariance and quaternion.
+struct FakeStateEntry {
+    std::array<double, 12 + 12 * 12 + 4> data;
+};
+
+/// About the size of a CannedIMUMeasurement.
+struct FakeIMUEntry {
+    std::array<double, 10> data;
+};
+
+template <typename F> static double timeMicroseconds(F &&f) {
+    auto start = clock_type::now();
+    f();
+    return std::chrono::duration<double, std::micro>(clock_type::now() -
+                                                     start)
+        .count();
+}
+
+static TimeValue fromMicroseconds(std::int64_t us) {
+    TimeValue tv;
+    tv.seconds = us / 1000000;
+    tv.microseconds = us % 1000000;
+    return tv;
+}
+
+/// Mimics TrackedBody: a state and an IMU measurement pushed per IMU report,
+/// and per video frame, a roll back to the frame's timestamp, a replay of the
+/// IMU measurements since, and pruning of history older than the frame.
+///
+/// @return a checksum of the replayed data, to compare implementations.
+template <template <typename> class Container>
+static double simulate(std::size_t imuReports, int imuPeriodUs,
+                       int videoPeriodUs, int videoLatencyUs) {
+    Container<FakeStateEntry> stateHistory;
+    Container<FakeIMUEntry> imuHistory;
+    FakeStateEntry state = {};
+    FakeIMUEntry imu = {};
+    double checksum = 0;
+    std::int64_t nextVideo = videoLatencyUs;
+    for (std::size_t i = 0; i < imuReports; ++i) {
+        auto now = std::int64_t(i) * imuPeriodUs;
+        auto tv = fromMicroseconds(now);
+        imu.data[0] = double(i);
+        imuHistory.push_newest(tv, imu);
+        state.data[0] = double(i);
+        stateHistory.push_newest(tv, state);
+
+        if (now < nextVideo) {
+            continue;
+        }
+        nextVideo += videoPeriodUs;
+        auto videoTime = fromMicroseconds(now - videoLatencyUs);
+        auto it = stateHistory.closest_not_newer(videoTime);
+        if (it == stateHistory.end()) {
+            continue;
+        }
+        auto restoredTime = it->first;
+        checksum += it->second.data[0];
+        stateHistory.pop_after(restoredTime);
+        for (auto replayIt = imuHistory.upper_bound(restoredTime),
+                  e = imuHistory.end();
+             replayIt != e; ++replayIt) {
+            state.data[0] = replayIt->second.data[0];
+            checksum += state.data[0];
+            stateHistory.push_newest(replayIt->first, state);
+        }
+        stateHistory.pop_before(restoredTime);
+        imuHistory.pop_before(restoredTime);
+    }
+    return checksum;
+}
+
+template <typename ValueType>
+using RingHistoryContainer = HistoryContainer<ValueType>;
+
+static void run(int videoLatencyUs, std::size_t imuReports) {
+    const int imuPeriodUs = 1000;
+    const int videoPeriodUs = 10000;
+    double dequeSum = 0;
+    double ringSum = 0;
+    auto dequeTime = timeMicroseconds([&] {
+        dequeSum = simulate<DequeHistoryContainer>(
+            imuReports, imuPeriodUs, videoPeriodUs, videoLatencyUs);
+    });
+    auto ringTime = timeMicroseconds([&] {
+        ringSum = simulate<RingHistoryContainer>(
+            imuReports, imuPeriodUs, videoPeriodUs, videoLatencyUs);
+    });
+    std::cout << "1 kHz IMU, 100 Hz video " << videoLatencyUs / 1000
+              << " ms late:\n"
+              << "  Ring buffer: " << ringTime * 1000. / imuReports
+              << " ns per IMU report\n"
+              << "  Deque:       " << dequeTime * 1000. / imuReports
+              << " ns per IMU report\n";
+    if (dequeSum != ringSum) {
+        std::cout << "  RESULTS DIFFERED!\n";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t imuReports = 1000000;
+    if (argc > 1) {
+        imuReports = std::strtoul(argv[1], nullptr, 10);
+    }
+    for (int latencyUs : {5000, 20000, 50000, 100000}) {
+        run(latencyUs, imuReports);
+    }
+    return 0;
+}
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "LedIdentifier.h"
+#include "BlinkCodeTable.h"
 
 // Library/third-party includes
 // - none
@@ -57,7 +58,7 @@ namespace vbtracker {
 
       private:
         size_t d_length;        //< Length of all patterns
-        PatternList d_patterns; //< Patterns by index
+        BlinkCodeTable d_codes; //< Every rotation of every pattern
     };
 
 } // End namespace vbtracker
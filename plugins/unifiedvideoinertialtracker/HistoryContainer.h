@@ -32,9 +32,14 @@
 #include <osvr/Util/TimeValue.h>
 
 // Standard includes
-#include <deque>
-#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace osvr {
 namespace vbtracker {
@@ -46,20 +51,103 @@ namespace vbtracker {
             template <typename ValueType>
             using full_value_type = std::pair<timestamp, ValueType>;
 
-            template <typename ValueType>
-            using inner_container_type = std::deque<full_value_type<ValueType>>;
+            /// Random-access const iterator over the entries of a
+            /// HistoryContainer, oldest first: indices are logical, wrapped
+            /// around the ring storage when dereferenced.
+            template <typename ValueType> class HistoryIterator {
+              public:
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type = full_value_type<ValueType>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = value_type const *;
+                using reference = value_type const &;
+
+                HistoryIterator() = default;
+                HistoryIterator(pointer data, std::size_t capacity,
+                                std::size_t head, std::size_t index)
+                    : m_data(data), m_capacity(capacity), m_head(head),
+                      m_index(index) {}
+
+                reference operator*() const {
+                    auto i = m_head + m_index;
+                    return m_data[i >= m_capacity ? i - m_capacity : i];
+                }
+                pointer operator->() const { return &(**this); }
+                reference operator[](difference_type n) const {
+                    return *(*this + n);
+                }
 
-            template <typename ValueType>
-            using container_size_type =
-                typename inner_container_type<ValueType>::size_type;
+                HistoryIterator &operator++() {
+                    ++m_index;
+                    return *this;
+                }
+                HistoryIterator operator++(int) {
+                    auto ret = *this;
+                    ++m_index;
+                    return ret;
+                }
+                HistoryIterator &operator--() {
+                    --m_index;
+                    return *this;
+                }
+                HistoryIterator operator--(int) {
+                    auto ret = *this;
+                    --m_index;
+                    return ret;
+                }
+                HistoryIterator &operator+=(difference_type n) {
+                    m_index = static_cast<std::size_t>(
+                        static_cast<difference_type>(m_index) + n);
+                    return *this;
+                }
+                HistoryIterator &operator-=(difference_type n) {
+                    return *this += -n;
+                }
+                HistoryIterator operator+(difference_type n) const {
+                    auto ret = *this;
+                    return ret += n;
+                }
+                friend HistoryIterator operator+(difference_type n,
+                                                 HistoryIterator const &it) {
+                    return it + n;
+                }
+                HistoryIterator operator-(difference_type n) const {
+                    auto ret = *this;
+                    return ret -= n;
+                }
+                difference_type operator-(HistoryIterator const &other) const {
+                    return static_cast<difference_type>(m_index) -
+                           static_cast<difference_type>(other.m_index);
+                }
 
-            template <typename ValueType>
-            using iterator =
-                typename inner_container_type<ValueType>::const_iterator;
+                bool operator==(HistoryIterator const &other) const {
+                    return m_index == other.m_index;
+                }
+                bool operator!=(HistoryIterator const &other) const {
+                    return m_index != other.m_index;
+                }
+                bool operator<(HistoryIterator const &other) const {
+                    return m_index < other.m_index;
+                }
+                bool operator>(HistoryIterator const &other) const {
+                    return m_index > other.m_index;
+                }
+                bool operator<=(HistoryIterator const &other) const {
+                    return m_index <= other.m_index;
+                }
+                bool operator>=(HistoryIterator const &other) const {
+                    return m_index >= other.m_index;
+                }
+
+              private:
+                pointer m_data = nullptr;
+                std::size_t m_capacity = 0;
+                std::size_t m_head = 0;
+                std::size_t m_index = 0;
+            };
 
             template <typename ValueType>
-            using nonconst_iterator =
-                typename inner_container_type<ValueType>::iterator;
+            using iterator = HistoryIterator<ValueType>;
 
             /// Comparison functor for std algorithms usage with
             /// HistoryContainer and related containers.
@@ -98,8 +186,13 @@ namespace vbtracker {
             };
         } // namespace detail
 
-        /// Stores values over time, in chronological order, in a deque for
-        /// two-ended access.
+        /// Stores values over time, in chronological order, in a circular
+        /// buffer for two-ended access.
+        ///
+        /// Storage is contiguous and only grows (doubling) when pushing onto a
+        /// full container, so it settles at the high-water mark: in steady
+        /// state, pushing and popping never allocate. Timestamp searches are
+        /// binary searches. Like a vector, growing invalidates iterators.
         template <typename ValueType, bool AllowDuplicateTimes_ = true>
         class HistoryContainer {
           public:
@@ -107,8 +200,7 @@ namespace vbtracker {
 
             using timestamp_type = detail::timestamp;
             using full_value_type = detail::full_value_type<value_type>;
-            using container_type = detail::inner_container_type<value_type>;
-            using size_type = detail::container_size_type<value_type>;
+            using size_type = std::size_t;
 
             using iterator = detail::iterator<value_type>;
             using const_iterator = iterator;
@@ -121,14 +213,73 @@ namespace vbtracker {
             /// to be pushed.
             static const bool AllowDuplicateTimes = AllowDuplicateTimes_;
 
+            /// Capacity allocated by the first push, if none was reserved.
+            static const size_type MinimumCapacity = 16;
+
+            HistoryContainer() = default;
+
+            /// Constructs with room for the given number of entries.
+            explicit HistoryContainer(size_type initialCapacity) {
+                reserve(initialCapacity);
+            }
+
+            HistoryContainer(HistoryContainer const &other) {
+                reserve(other.size());
+                for (auto const &entry : other) {
+                    m_pushBack(entry);
+                }
+                m_sizeHighWaterMark = other.m_sizeHighWaterMark;
+            }
+
+            HistoryContainer(HistoryContainer &&other) { swap(other); }
+
+            HistoryContainer &operator=(HistoryContainer const &other) {
+                if (this != &other) {
+                    HistoryContainer copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            HistoryContainer &operator=(HistoryContainer &&other) {
+                HistoryContainer moved(std::move(other));
+                swap(moved);
+                return *this;
+            }
+
+            ~HistoryContainer() {
+                clear();
+                m_deallocate();
+            }
+
+            void swap(HistoryContainer &other) {
+                using std::swap;
+                swap(m_data, other.m_data);
+                swap(m_capacity, other.m_capacity);
+                swap(m_head, other.m_head);
+                swap(m_size, other.m_size);
+                swap(m_sizeHighWaterMark, other.m_sizeHighWaterMark);
+            }
+
             /// Get number of entries in history.
-            size_type size() const { return m_history.size(); }
+            size_type size() const { return m_size; }
+
+            /// Get the number of entries there is room for without allocating.
+            size_type capacity() const { return m_capacity; }
 
             /// Get the maximum number of entries ever recorded.
             size_type highWaterMark() const { return m_sizeHighWaterMark; }
 
             /// Gets whether history is empty or not.
-            bool empty() const { return m_history.empty(); }
+            bool empty() const { return 0 == m_size; }
+
+            /// Makes room for at least the given number of entries, so pushing
+            /// up to that many doesn't allocate.
+            void reserve(size_type n) {
+                if (n > m_capacity) {
+                    m_reallocate(n);
+                }
+            }
 
             timestamp_type const &oldest_timestamp() const {
                 if (empty()) {
@@ -136,7 +287,7 @@ namespace vbtracker {
                         "Can't get time of oldest entry in an "
                         "empty history container!");
                 }
-                return m_history.front().first;
+                return m_at(0).first;
             }
 
             value_type const &oldest() const {
@@ -144,7 +295,7 @@ namespace vbtracker {
                     throw std::logic_error("Can't get oldest entry in an "
                                            "empty history container!");
                 }
-                return m_history.front().first;
+                return m_at(0).second;
             }
 
             /// Returns the newest timestamp in the container. Caveat: throws an
@@ -160,7 +311,7 @@ namespace vbtracker {
                         "empty history container!");
                 }
 
-                return m_history.back().first;
+                return m_at(m_size - 1).first;
             }
 
             value_type const &newest() const {
@@ -169,32 +320,35 @@ namespace vbtracker {
                                            "empty history container!");
                 }
 
-                return m_history.back().second;
+                return m_at(m_size - 1).second;
             }
 
             /// Returns a comparison functor (comparing timestamps) for use with
             /// standard algorithms like lower_bound and upper_bound
             static comparator_type comparator() { return comparator_type{}; }
 
-            void pop_oldest() { m_history.pop_front(); }
-            void pop_newest() { m_history.pop_back(); }
-
-            const_iterator begin() const { return m_history.cbegin(); }
-            const_iterator cbegin() const { return m_history.cbegin(); }
-            const_iterator end() const { return m_history.cend(); }
-            const_iterator cend() const { return m_history.cend(); }
-
-            void clear() { m_history.clear(); }
+            void pop_oldest() {
+                m_at(0).~full_value_type();
+                m_head = m_wrap(m_head + 1);
+                --m_size;
+            }
+            void pop_newest() {
+                m_at(m_size - 1).~full_value_type();
+                --m_size;
+            }
 
-          private:
-            /// Needed due to some pre-modern-C++ library differences (like
-            /// containter_type::erase)
-            using nonconst_iterator = detail::nonconst_iterator<value_type>;
+            const_iterator begin() const { return m_iteratorAt(0); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator end() const { return m_iteratorAt(m_size); }
+            const_iterator cend() const { return end(); }
 
-            nonconst_iterator ncbegin() { return m_history.begin(); }
-            nonconst_iterator ncend() { return m_history.end(); }
+            /// Removes all entries, keeping the storage.
+            void clear() {
+                m_destroy(0, m_size);
+                m_size = 0;
+                m_head = 0;
+            }
 
-          public:
             /// Returns true if the given timestamp is strictly newer than the
             /// newest timestamp in the container, or if the container is empty
             /// (thus making the timestamp trivially newest)
@@ -229,26 +383,6 @@ namespace vbtracker {
                 return std::lower_bound(begin(), end(), tv, comparator());
             }
 
-          private:
-            /// Wrapper around std::upper_bound: returns iterator to first
-            /// element newer than timestamp given or end() if none.
-            ///
-            /// Returns a non-const iterator, for older C++ standard library
-            /// implementations that require one for erase and similar.
-            nonconst_iterator nc_upper_bound(timestamp_type const &tv) {
-                return std::upper_bound(ncbegin(), ncend(), tv, comparator());
-            }
-            /// Wrapper around std::lower_bound: returns iterator to first
-            /// element with timestamp equal or newer than timestamp given or
-            /// end() if none.
-            ///
-            /// Returns a non-const iterator, for older C++ standard library
-            /// implementations that require one for erase and similar.
-            nonconst_iterator nc_lower_bound(timestamp_type const &tv) {
-                return std::lower_bound(ncbegin(), ncend(), tv, comparator());
-            }
-
-          public:
             /// Return an iterator to the newest, last pair of timestamp and
             /// value that is not newer than the given timestamp. If none meet
             /// this criteria, returns end().
@@ -276,19 +410,6 @@ namespace vbtracker {
                 return subset_range_type(upper_bound(tv), end());
             }
 
-#if 0
-            /// Remove all entries in history with timestamps strictly older than
-            /// the given timestamp.
-            /// @return number of elements removed.
-            size_type pop_before(timestamp_type const &tv) {
-                auto count = size_type{0};
-                while (!empty() && oldest_timestamp() < tv) {
-                    pop_oldest();
-                    ++count;
-                }
-                return count;
-            }
-#else
             /// Remove all entries in history with timestamps strictly older
             /// than the given timestamp.
             /// @return number of elements removed.
@@ -296,8 +417,8 @@ namespace vbtracker {
                 if (empty()) {
                     return 0;
                 }
-                auto lastIt = nc_lower_bound(tv);
-                if (ncend() == lastIt) {
+                auto lastIt = lower_bound(tv);
+                if (end() == lastIt) {
                     // If we got end() back, that's ambiguous: is the last entry
                     // really >= our timestamp?
                     /// @todo is this right?
@@ -306,26 +427,13 @@ namespace vbtracker {
                         return 0;
                     }
                 }
-                auto count = std::distance(ncbegin(), lastIt);
-                m_history.erase(ncbegin(), lastIt);
+                auto count = static_cast<size_type>(lastIt - begin());
+                m_destroy(0, count);
+                m_head = m_wrap(m_head + count);
+                m_size -= count;
                 return count;
             }
-#endif
-
-#if 0
 
-            /// Remove all entries in history with timestamps strictly newer than
-            /// the given timestamp.
-            /// @return number of elements removed.
-            size_type pop_after(timestamp_type const &tv) {
-                auto count = size_type{0};
-                while (!empty() && tv < newest_timestamp()) {
-                    pop_newest();
-                    ++count;
-                }
-                return count;
-            }
-#else
             /// Remove all entries in history with timestamps strictly newer
             /// than the given timestamp.
             /// @return number of elements removed.
@@ -333,16 +441,11 @@ namespace vbtracker {
                 if (empty()) {
                     return 0;
                 }
-                auto firstIt = nc_upper_bound(tv);
-                if (ncend() == firstIt) {
-                    // If we got end() back, nothing found after our timestamp.
-                    return 0;
-                }
-                auto count = std::distance(firstIt, ncend());
-                m_history.erase(firstIt, ncend());
+                auto count = static_cast<size_type>(end() - upper_bound(tv));
+                m_destroy(m_size - count, m_size);
+                m_size -= count;
                 return count;
             }
-#endif
 
             /// Adds a new value to history. It must be newer (or equal time,
             /// based on template parameters) than the newest (or the history
@@ -350,7 +453,7 @@ namespace vbtracker {
             void push_newest(osvr::util::time::TimeValue const &tv,
                              value_type const &value) {
                 if (is_valid_to_push_newest(tv)) {
-                    m_history.emplace_back(tv, value);
+                    m_pushBack(full_value_type(tv, value));
                     updateSizeHighWaterMark();
                 } else {
                     throw std::logic_error(
@@ -360,11 +463,73 @@ namespace vbtracker {
             }
 
           private:
+            using allocator_type = std::allocator<full_value_type>;
+
+            size_type m_wrap(size_type i) const {
+                return i >= m_capacity ? i - m_capacity : i;
+            }
+            full_value_type &m_at(size_type i) {
+                return m_data[m_wrap(m_head + i)];
+            }
+            full_value_type const &m_at(size_type i) const {
+                return m_data[m_wrap(m_head + i)];
+            }
+            const_iterator m_iteratorAt(size_type i) const {
+                return const_iterator(m_data, m_capacity, m_head, i);
+            }
+
+            /// Destroys the entries in [first, last), if they need it: the
+            /// caller removes them.
+            void m_destroy(size_type first, size_type last) {
+                if (std::is_trivially_destructible<full_value_type>::value) {
+                    return;
+                }
+                for (size_type i = first; i < last; ++i) {
+                    m_at(i).~full_value_type();
+                }
+            }
+
+            void m_pushBack(full_value_type const &entry) {
+                if (m_size == m_capacity) {
+                    m_reallocate(
+                        (std::max)(m_capacity * 2, size_type(MinimumCapacity)));
+                }
+                ::new (static_cast<void *>(&m_data[m_wrap(m_head + m_size)]))
+                    full_value_type(entry);
+                ++m_size;
+            }
+
+            /// Moves the entries into new storage of the given capacity,
+            /// oldest first.
+            void m_reallocate(size_type newCapacity) {
+                auto newData = allocator_type().allocate(newCapacity);
+                for (size_type i = 0; i < m_size; ++i) {
+                    auto &entry = m_at(i);
+                    ::new (static_cast<void *>(&newData[i]))
+                        full_value_type(std::move(entry));
+                    entry.~full_value_type();
+                }
+                m_deallocate();
+                m_data = newData;
+                m_capacity = newCapacity;
+                m_head = 0;
+            }
+
+            void m_deallocate() {
+                if (m_data) {
+                    allocator_type().deallocate(m_data, m_capacity);
+                    m_data = nullptr;
+                    m_capacity = 0;
+                }
+            }
+
             void updateSizeHighWaterMark() {
-                m_sizeHighWaterMark =
-                    (std::max)(m_history.size(), m_sizeHighWaterMark);
+                m_sizeHighWaterMark = (std::max)(m_size, m_sizeHighWaterMark);
             }
-            container_type m_history;
+            full_value_type *m_data = nullptr;
+            size_type m_capacity = 0;
+            size_type m_head = 0;
+            size_type m_size = 0;
             size_type m_sizeHighWaterMark = 0;
         };
     } // namespace history
@@ -31,6 +31,7 @@
 
 // Library/third-party includes
 #include <osvr/Util/Finally.h>
+#include <osvr/Util/ThreadScheduling.h>
 
 // Standard includes
 #include <iostream>
@@ -50,7 +51,7 @@ namespace vbtracker {
             if (blobFile_) {
                 blobFile_ << "sec,usec,x,y,size" << std::endl;
             } else {
-                warn() << "Could not open blob file!" << std::endl;
+                warn() << "Could not open blob file!";
                 logBlobs_ = false;
             }
         }
@@ -73,6 +74,7 @@ namespace vbtracker {
     }
 
     void ImageProcessingThread::threadAction() {
+        util::sched::applyThreadRole(util::sched::ThreadRole::ImageProcessing);
         while (1) {
             {
                 std::unique_lock<std::mutex> lock(stateMutex_);
@@ -149,12 +151,12 @@ namespace vbtracker {
         // results are ready for pickup at the second window.
     }
 
-    std::ostream &ImageProcessingThread::msg() const {
-        return std::cout << "[UnifiedTracker:ImgProcThread] ";
+    util::log::Logger::StreamProxy ImageProcessingThread::msg() const {
+        return logger_.info();
     }
 
-    std::ostream &ImageProcessingThread::warn() const {
-        return msg() << "Warning: ";
+    util::log::Logger::StreamProxy ImageProcessingThread::warn() const {
+        return logger_.warn();
     }
 
 } // namespace vbtracker
@@ -30,6 +30,7 @@
 
 // Library/third-party includes
 #include <opencv2/core/core.hpp>
+#include <osvr/Util/RateLimitedLogger.h>
 
 // Standard includes
 #include <condition_variable>
@@ -67,10 +68,10 @@ namespace vbtracker {
         bool exiting() const { return exiting_; }
 
       private:
-        /// Helper providing a prefixed output stream for normal messages.
-        std::ostream &msg() const;
-        /// Helper providing a prefixed output stream for warning messages.
-        std::ostream &warn() const;
+        /// Helper providing a rate-limited log stream for normal messages.
+        util::log::Logger::StreamProxy msg() const;
+        /// Helper providing a rate-limited log stream for warning messages.
+        util::log::Logger::StreamProxy warn() const;
         /// Performs the retrieval and processing of a single frame.
         void doFrame();
 
@@ -94,6 +95,11 @@ namespace vbtracker {
         cv::Mat gray_;
 
         bool exiting_ = false;
+
+        /// Rate-limited so that a burst of messages can't stall image
+        /// processing.
+        mutable util::log::RateLimitedLogger logger_{
+            "UnifiedTracker:ImgProcThread"};
     };
 
 } // namespace vbtracker
@@ -0,0 +1,221 @@
+/** @file
+    @brief Test comparing the blink code lookup table against a search of
+    every wrapped pattern string, the approach it replaced.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "BlinkCodeTable.h"
+#include "IdentifierHelpers.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+/// The implementation BlinkCodeTable replaced, from OsvrHdkLedIdentifier:
+/// a substring search of each enabled pattern followed by all but its last
+/// character.
+class WrappedStringSearch {
+  public:
+    explicit WrappedStringSearch(std::vector<std::string> const &patterns) {
+        for (auto const &pat : patterns) {
+            if (pat.empty() || pat.find_first_not_of("*.") != pat.npos) {
+                m_wrapped.emplace_back();
+                continue;
+            }
+            auto wrapped = pat + pat;
+            wrapped.pop_back();
+            m_wrapped.push_back(std::move(wrapped));
+        }
+    }
+    int identify(BrightnessList const &brightnesses,
+                 Brightness threshold) const {
+        auto bits = getBitsUsingThreshold(brightnesses, threshold);
+        for (std::size_t i = 0; i < m_wrapped.size(); ++i) {
+            if (!m_wrapped[i].empty() &&
+                m_wrapped[i].find(bits) != std::string::npos) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+  private:
+    std::vector<std::string> m_wrapped;
+};
+
+static const Brightness THRESHOLD = 0.5f;
+
+/// Brightnesses for a bit string, with some noise that doesn't cross the
+/// threshold.
+static BrightnessList toBrightnesses(std::string const &bits,
+                                     std::mt19937 &gen) {
+    std::uniform_real_distribution<Brightness> noise(-0.4f, 0.4f);
+    BrightnessList ret;
+    for (auto c : bits) {
+        ret.push_back((c == '*' ? 1.f : 0.f) + noise(gen));
+    }
+    return ret;
+}
+
+static std::string rotated(std::string const &pat, std::size_t rotation) {
+    return pat.substr(rotation) + pat.substr(0, rotation);
+}
+
+/// Checks both agree, and find the right pattern (or one sharing the
+/// rotation), for every rotation of every pattern.
+static void checkEveryRotation(std::vector<std::string> const &patterns) {
+    BlinkCodeTable table(patterns);
+    WrappedStringSearch search(patterns);
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(
+        patterns.size() * 1000 + table.getPatternLength()));
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+        auto const &pat = patterns[i];
+        if (pat.empty() || pat.find_first_not_of("*.") != pat.npos) {
+            continue;
+        }
+        for (std::size_t rot = 0; rot < pat.size(); ++rot) {
+            auto brightnesses = toBrightnesses(rotated(pat, rot), gen);
+            auto expected = search.identify(brightnesses, THRESHOLD);
+            REQUIRE(expected >= 0);
+            REQUIRE(expected <= static_cast<int>(i));
+            REQUIRE(table.identify(brightnesses, THRESHOLD) == expected);
+        }
+    }
+}
+
+/// Checks both agree on random bit strings, nearly all of which match
+/// nothing once the patterns are long enough.
+static void checkRandom(std::vector<std::string> const &patterns,
+                        std::size_t numSamples) {
+    BlinkCodeTable table(patterns);
+    WrappedStringSearch search(patterns);
+    const auto length = table.getPatternLength();
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(length));
+    std::bernoulli_distribution coin;
+    for (std::size_t sample = 0; sample < numSamples; ++sample) {
+        std::string bits;
+        for (std::size_t bit = 0; bit < length; ++bit) {
+            bits.push_back(coin(gen) ? '*' : '.');
+        }
+        auto brightnesses = toBrightnesses(bits, gen);
+        REQUIRE(table.identify(brightnesses, THRESHOLD) ==
+                search.identify(brightnesses, THRESHOLD));
+    }
+}
+
+static std::vector<std::string>
+randomPatterns(std::size_t numBeacons, std::size_t length) {
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(
+        length * 1000 + numBeacons));
+    std::bernoulli_distribution coin;
+    std::vector<std::string> patterns;
+    for (std::size_t i = 0; i < numBeacons; ++i) {
+        std::string pat;
+        for (std::size_t bit = 0; bit < length; ++bit) {
+            pat.push_back(coin(gen) ? '*' : '.');
+        }
+        patterns.push_back(pat);
+    }
+    return patterns;
+}
+
+/// HDK back plate patterns, from the original documentation, with a
+/// disabled one thrown in.
+static const std::vector<std::string> HDK_BACK_PATTERNS = {
+    "***...*........*", "...****..*......", "*.*..........***",
+    "X..*..*....*...*", "**...........***", "*....*....*.....",
+    "...*....*...*..."};
+
+TEST_CASE("BlinkCodeTable-HDKPatterns") {
+    checkEveryRotation(HDK_BACK_PATTERNS);
+
+    // Short enough to compare every possible bit string.
+    BlinkCodeTable table(HDK_BACK_PATTERNS);
+    WrappedStringSearch search(HDK_BACK_PATTERNS);
+    std::mt19937 gen;
+    int matched = 0;
+    for (std::uint32_t code = 0; code < (1u << 16); ++code) {
+        std::string bits;
+        for (int bit = 15; bit >= 0; --bit) {
+            bits.push_back((code >> bit) & 1 ? '*' : '.');
+        }
+        auto brightnesses = toBrightnesses(bits, gen);
+        auto expected = search.identify(brightnesses, THRESHOLD);
+        REQUIRE(table.identify(brightnesses, THRESHOLD) == expected);
+        if (expected >= 0) {
+            ++matched;
+        }
+    }
+    // Six enabled patterns with 16 distinct rotations each: everything
+    // else is a mismatch.
+    REQUIRE(matched == 6 * 16);
+}
+
+TEST_CASE("BlinkCodeTable-RandomPatterns") {
+    for (std::size_t length : {8, 16, 24, 32, 48, 63, 64, 65, 96}) {
+        CAPTURE(length);
+        auto patterns = randomPatterns(48, length);
+        checkEveryRotation(patterns);
+        checkRandom(patterns, 5000);
+    }
+}
+
+TEST_CASE("BlinkCodeTable-SharedRotations") {
+    // Short patterns, so many share rotations: the lowest index must win.
+    auto patterns = randomPatterns(40, 5);
+    patterns.push_back(rotated(patterns[3], 2));
+    checkEveryRotation(patterns);
+    checkRandom(patterns, 1000);
+}
+
+TEST_CASE("BlinkCodeTable-DisabledPatterns") {
+    std::vector<std::string> patterns = {"", "X*..", "*...", ".*.*"};
+    BlinkCodeTable table(patterns);
+    REQUIRE(table.getPatternLength() == 4);
+    checkEveryRotation(patterns);
+    checkRandom(patterns, 200);
+
+    std::mt19937 gen;
+    REQUIRE(table.identify(toBrightnesses("..*.", gen), THRESHOLD) == 2);
+    REQUIRE(table.identify(toBrightnesses("**..", gen), THRESHOLD) == -1);
+
+    BlinkCodeTable none({"", "XX"});
+    REQUIRE(none.getPatternLength() == 0);
+}
+
+TEST_CASE("BlinkCodeTable-MismatchedLengths") {
+    REQUIRE_THROWS_AS(BlinkCodeTable({"*..", "*...."}), std::runtime_error);
+    // Disabled patterns don't count.
+    REQUIRE_NOTHROW(BlinkCodeTable({"*..", "X......", ".*."}));
+}
@@ -0,0 +1,271 @@
+/** @file
+    @brief Randomized test comparing the ring-buffer HistoryContainer against
+    the deque-based implementation it replaced.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "HistoryContainer.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace osvr::vbtracker;
+using osvr::util::time::TimeValue;
+
+/// The previous, deque-based implementation, for reference.
+template <typename ValueType> class DequeHistoryContainer {
+  public:
+    using full_value_type = std::pair<TimeValue, ValueType>;
+    using container_type = std::deque<full_value_type>;
+    using const_iterator = typename container_type::const_iterator;
+    using comparator_type = history::detail::TimestampPairLessThan<ValueType>;
+
+    std::size_t size() const { return m_history.size(); }
+    bool empty() const { return m_history.empty(); }
+    const_iterator begin() const { return m_history.cbegin(); }
+    const_iterator end() const { return m_history.cend(); }
+    TimeValue const &newest_timestamp() const {
+        return m_history.back().first;
+    }
+
+    const_iterator upper_bound(TimeValue const &tv) const {
+        return std::upper_bound(begin(), end(), tv, comparator_type{});
+    }
+    const_iterator lower_bound(TimeValue const &tv) const {
+        return std::lower_bound(begin(), end(), tv, comparator_type{});
+    }
+    const_iterator closest_not_newer(TimeValue const &tv) const {
+        auto it = upper_bound(tv);
+        if (begin() == it) {
+            return end();
+        }
+        return --it;
+    }
+    std::size_t pop_before(TimeValue const &tv) {
+        if (empty()) {
+            return 0;
+        }
+        auto lastIt = std::lower_bound(m_history.begin(), m_history.end(), tv,
+                                       comparator_type{});
+        if (m_history.end() == lastIt && newest_timestamp() < tv) {
+            return 0;
+        }
+        auto count = std::distance(m_history.begin(), lastIt);
+        m_history.erase(m_history.begin(), lastIt);
+        return count;
+    }
+    std::size_t pop_after(TimeValue const &tv) {
+        auto firstIt = std::upper_bound(m_history.begin(), m_history.end(),
+                                        tv, comparator_type{});
+        auto count = std::distance(firstIt, m_history.end());
+        m_history.erase(firstIt, m_history.end());
+        return count;
+    }
+    void pop_oldest() { m_history.pop_front(); }
+    void pop_newest() { m_history.pop_back(); }
+    void push_newest(TimeValue const &tv, ValueType const &value) {
+        m_history.emplace_back(tv, value);
+    }
+
+  private:
+    container_type m_history;
+};
+
+static TimeValue fromMicroseconds(int us) {
+    TimeValue tv;
+    tv.seconds = us / 1000000;
+    tv.microseconds = us % 1000000;
+    return tv;
+}
+
+template <typename Iterator, typename RefIterator>
+static std::ptrdiff_t indexOf(Iterator it, Iterator begin,
+                              RefIterator refIt, RefIterator refBegin) {
+    auto i = std::distance(begin, it);
+    REQUIRE(i == std::distance(refBegin, refIt));
+    return i;
+}
+
+template <typename Container, typename Reference>
+static void requireSame(Container const &history, Reference const &ref) {
+    REQUIRE(history.size() == ref.size());
+    REQUIRE(history.empty() == ref.empty());
+    REQUIRE(std::distance(history.begin(), history.end()) ==
+            std::ptrdiff_t(ref.size()));
+    auto refIt = ref.begin();
+    for (auto const &entry : history) {
+        REQUIRE(entry.first == refIt->first);
+        REQUIRE(entry.second == refIt->second);
+        ++refIt;
+    }
+    /// Backwards and by index too: the iterator does its own wrapping.
+    auto n = std::ptrdiff_t(ref.size());
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+        REQUIRE(history.begin()[i].second == ref.begin()[i].second);
+        REQUIRE((history.end() - (i + 1))->second ==
+                (ref.end() - (i + 1))->second);
+    }
+    if (!ref.empty()) {
+        REQUIRE(history.oldest() == ref.begin()->second);
+        REQUIRE(history.newest() == (ref.end() - 1)->second);
+        REQUIRE(history.newest_timestamp() == ref.newest_timestamp());
+    }
+}
+
+/// Runs a random mix of operations on both containers, comparing them after
+/// each. Pushes outnumber pops in the first half, so the ring buffer grows,
+/// and they balance in the second, so it wraps without growing.
+template <typename ValueType, typename MakeValue>
+static void compareRandomly(std::uint32_t seed, MakeValue &&makeValue) {
+    std::mt19937 gen(seed);
+    HistoryContainer<ValueType> history;
+    DequeHistoryContainer<ValueType> ref;
+    const int iterations = 20000;
+    int now = 0;
+    std::size_t growths = 0;
+    std::size_t pushesAtLastGrowth = 0;
+    std::size_t pushes = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto growing = i < iterations / 2;
+        auto op = std::uniform_int_distribution<int>(0, 99)(gen);
+        auto pushChance = growing ? 70 : 50;
+        if (op < pushChance) {
+            /// Steps of 0 give duplicate timestamps.
+            now += std::uniform_int_distribution<int>(0, 3)(gen);
+            auto tv = fromMicroseconds(now);
+            auto value = makeValue(i);
+            auto capacity = history.capacity();
+            history.push_newest(tv, value);
+            ref.push_newest(tv, value);
+            ++pushes;
+            if (history.capacity() != capacity) {
+                ++growths;
+                pushesAtLastGrowth = pushes;
+            }
+        } else {
+            /// Times both inside and outside the stored range.
+            auto tv = fromMicroseconds(
+                now - std::uniform_int_distribution<int>(-5, 80)(gen));
+            switch (op % 5) {
+            case 0:
+                REQUIRE(history.pop_before(tv) == ref.pop_before(tv));
+                break;
+            case 1:
+                REQUIRE(history.pop_after(tv) == ref.pop_after(tv));
+                break;
+            case 2:
+                if (!ref.empty()) {
+                    history.pop_oldest();
+                    ref.pop_oldest();
+                }
+                break;
+            case 3:
+                if (!ref.empty()) {
+                    history.pop_newest();
+                    ref.pop_newest();
+                }
+                break;
+            default: {
+                auto it = history.closest_not_newer(tv);
+                auto refIt = ref.closest_not_newer(tv);
+                REQUIRE((it == history.end()) == (refIt == ref.end()));
+                if (refIt != ref.end()) {
+                    indexOf(it, history.begin(), refIt, ref.begin());
+                    REQUIRE(it->second == refIt->second);
+                }
+                indexOf(history.upper_bound(tv), history.begin(),
+                        ref.upper_bound(tv), ref.begin());
+                indexOf(history.lower_bound(tv), history.begin(),
+                        ref.lower_bound(tv), ref.begin());
+                auto range = history.get_range_newer_than(tv);
+                REQUIRE(std::distance(range.begin(), range.end()) ==
+                        std::distance(ref.upper_bound(tv), ref.end()));
+                break;
+            }
+            }
+        }
+        requireSame(history, ref);
+        REQUIRE(history.highWaterMark() >= history.size());
+    }
+    /// Make sure both phases did their job.
+    REQUIRE(growths >= 3);
+    REQUIRE(pushes - pushesAtLastGrowth > 2 * history.capacity());
+
+    SECTION("Copy and move preserve the entries") {
+        auto copy = history;
+        requireSame(copy, ref);
+        auto moved = std::move(copy);
+        requireSame(moved, ref);
+        HistoryContainer<ValueType> assigned;
+        assigned = moved;
+        requireSame(assigned, ref);
+    }
+    SECTION("Clearing keeps the storage") {
+        auto capacity = history.capacity();
+        history.clear();
+        REQUIRE(history.empty());
+        REQUIRE(history.capacity() == capacity);
+        REQUIRE(history.begin() == history.end());
+    }
+}
+
+TEST_CASE("HistoryContainer-matches-deque-trivial") {
+    for (std::uint32_t seed = 1; seed <= 3; ++seed) {
+        compareRandomly<int>(seed, [](int i) { return i; });
+    }
+}
+
+TEST_CASE("HistoryContainer-matches-deque-nontrivial") {
+    /// Strings long enough to allocate, so a mistake in construction or
+    /// destruction of entries shows up under a memory checker.
+    compareRandomly<std::string>(42, [](int i) {
+        return std::to_string(i) + std::string(32, 'x');
+    });
+}
+
+TEST_CASE("HistoryContainer-push-order") {
+    HistoryContainer<int> history;
+    history.push_newest(fromMicroseconds(10), 1);
+    history.push_newest(fromMicroseconds(10), 2);
+    REQUIRE_THROWS_AS(history.push_newest(fromMicroseconds(9), 3),
+                      std::logic_error);
+    REQUIRE(history.size() == 2);
+
+    HistoryContainer<int, false> unique;
+    unique.push_newest(fromMicroseconds(10), 1);
+    REQUIRE_THROWS_AS(unique.push_newest(fromMicroseconds(10), 2),
+                      std::logic_error);
+    REQUIRE(unique.size() == 1);
+}
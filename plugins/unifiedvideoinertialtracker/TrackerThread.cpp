@@ -35,6 +35,7 @@
 // Library/third-party includes
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Util/Finally.h>
+#include <osvr/Util/ThreadScheduling.h>
 
 // Standard includes
 #include <future>
@@ -59,7 +60,7 @@ namespace vbtracker {
           m_cameraUsecOffset(cameraUsecOffset), m_bufferImu(bufferImu),
           m_debugData(debugData), m_imuMessages(IMU_MESSAGE_QUEUE_SIZE),
           m_debugDataMessages(32) {
-        msg() << "Tracker thread object created." << std::endl;
+        msg() << "Tracker thread object created.";
     }
 
     TrackerThread::~TrackerThread() {
@@ -77,9 +78,9 @@ namespace vbtracker {
         /// doing what we can asynchronously to also process incoming IMU
         /// messages.
 
-        msg() << "Tracker thread object invoked, waiting for permitStart()."
-              << std::endl;
+        msg() << "Tracker thread object invoked, waiting for permitStart().";
         m_startupSignal.get_future().wait();
+        util::sched::applyThreadRole(util::sched::ThreadRole::Tracker);
         /// sleep an extra half a second to give everyone else time to get off
         /// the starting blocks.
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -95,8 +96,7 @@ namespace vbtracker {
         imageProcThreadObj_ = &imageProcThreadObj;
         m_imageThread = std::thread{[&] { imageProcThreadObj.threadAction(); }};
 
-        msg() << "Tracker thread object entering its main execution loop."
-              << std::endl;
+        msg() << "Tracker thread object entering its main execution loop.";
 
 #ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
         try {
@@ -114,22 +114,21 @@ namespace vbtracker {
                 }
                 if (!keepGoing) {
                     msg() << "Tracker thread object: Just checked our run flag "
-                             "and noticed it turned false..."
-                          << std::endl;
+                             "and noticed it turned false...";
                 }
             }
 #ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
         } catch (std::exception const &e) {
             warn() << "Tracker thread object: exiting because of caught "
                       "exception: "
-                   << e.what() << std::endl;
+                   << e.what();
             m_run = false;
         }
 #endif
-        msg() << "Tracker thread object: functor exiting." << std::endl;
+        msg() << "Tracker thread object: functor exiting.";
 
         if (!imageProcThreadObj.exiting()) {
-            msg() << "Telling image processing thread to exit." << std::endl;
+            msg() << "Telling image processing thread to exit.";
             imageProcThreadObj.signalExit();
         }
         imageProcThreadObj_ = nullptr;
@@ -139,8 +138,10 @@ namespace vbtracker {
     }
 
     void TrackerThread::triggerStop() {
-        /// Main thread method!
-        msg() << "Tracker thread object: triggerStop() called" << std::endl;
+        /// Main thread method! The rate limiter belongs to the tracker
+        /// thread, so log straight to the (thread-safe) wrapped logger.
+        m_logger.getLogger().info()
+            << "Tracker thread object: triggerStop() called";
         std::lock_guard<std::mutex> lock(m_runMutex);
         m_run = false;
     }
@@ -189,24 +190,26 @@ namespace vbtracker {
         m_messageCondVar.notify_one();
     }
 
-    std::ostream &TrackerThread::msg() const {
-        return std::cout << "[UnifiedTracker] ";
+    util::log::Logger::StreamProxy TrackerThread::msg() const {
+        return m_logger.info();
     }
 
-    std::ostream &TrackerThread::warn() const { return msg() << "Warning: "; }
+    util::log::Logger::StreamProxy TrackerThread::warn() const {
+        return m_logger.warn();
+    }
 
     void TrackerThread::doFrame() {
         // Check camera status.
         if (!m_cam.ok()) {
             // Hmm, camera seems bad. Might regain it? Skip for now...
-            warn() << "Camera is reporting it is not OK." << std::endl;
+            warn() << "Camera is reporting it is not OK.";
             return;
         }
         // Trigger a grab.
         if (!m_cam.grab()) {
             // Again failing without quitting, in hopes we get better luck
             // next time...
-            warn() << "Camera grab failed." << std::endl;
+            warn() << "Camera grab failed.";
             return;
         }
         // When we triggered the grab was a good guess of the time
@@ -283,14 +286,13 @@ namespace vbtracker {
         if (!m_frame.data || !m_frameGray.data) {
             // but it ended early due to error.
             warn() << "Camera retrieve appeared to fail: frames had null "
-                      "pointers!"
-                   << std::endl;
+                      "pointers!";
             return;
         }
 
         if (!m_imageData) {
             // but it failed to set the pointer? this is very strange...
-            warn() << "Initial image processing failed somehow!" << std::endl;
+            warn() << "Initial image processing failed somehow!";
             return;
         }
 
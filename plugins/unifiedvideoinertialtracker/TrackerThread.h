@@ -35,6 +35,7 @@
 
 // Library/third-party includes
 #include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/RateLimitedLogger.h>
 
 #include <opencv2/core/core.hpp> // for basic OpenCV types
 
@@ -118,10 +119,12 @@ namespace vbtracker {
                                            cv::Mat const &frameGray);
 
       private:
-        /// Helper providing a prefixed output stream for normal messages.
-        std::ostream &msg() const;
-        /// Helper providing a prefixed output stream for warning messages.
-        std::ostream &warn() const;
+        /// Helper providing a rate-limited log stream for normal messages.
+        /// Tracker thread only (or before it starts): main-thread methods
+        /// must use m_logger.getLogger() instead.
+        util::log::Logger::StreamProxy msg() const;
+        /// Helper providing a rate-limited log stream for warning messages.
+        util::log::Logger::StreamProxy warn() const;
 
         /// Main function called repeatedly, once for each (attempted) frame of
         /// video.
@@ -227,6 +230,10 @@ namespace vbtracker {
 
         /// The thread used by timeConsumingImageStep()
         std::thread m_imageThread;
+
+        /// Rate-limited so that a burst of messages can't stall the frame
+        /// loop.
+        mutable util::log::RateLimitedLogger m_logger{"UnifiedTracker"};
     };
 } // namespace vbtracker
 } // namespace osvr
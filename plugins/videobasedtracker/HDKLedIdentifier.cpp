@@ -31,61 +31,17 @@
 // - none
 
 // Standard includes
-#include <stdexcept>
+// - none
 
 namespace osvr {
 namespace vbtracker {
-    static const auto VALIDCHARS = "*.";
     OsvrHdkLedIdentifier::~OsvrHdkLedIdentifier() {}
-    // Convert from string encoding representations into lists
-    // of boolean values for use in comparison.
+    // Compile the patterns, in string encoding, into a table of every
+    // rotation of each.
     OsvrHdkLedIdentifier::OsvrHdkLedIdentifier(
-        const PatternStringList &PATTERNS) {
-        // Ensure that we have at least one entry in our list and
-        // find the length of the first valid entry.
-        d_length = 0;
-        if (PATTERNS.empty()) {
-            return;
-        }
-
-        for (auto &pat : PATTERNS) {
-            if (!pat.empty() && pat.find_first_not_of(VALIDCHARS) == pat.npos) {
-                // All characters in this pattern are valid - we can consider
-                // this to be a valid pattern and thus establish the size.
-                d_length = pat.length();
-                break;
-            }
-        }
-
-        if (0 == d_length) {
-            // If we still have 0 as the pattern length, return.
-            return;
-        }
-
-        // Decode each string into a new list of boolean values, making
-        // sure each have the correct length.
-
-        for (auto &pat : PATTERNS) {
-            if (pat.empty() || pat.find_first_not_of(VALIDCHARS) != pat.npos) {
-                // This is an intentionally disabled beacon/pattern.
-                d_patterns.emplace_back();
-                continue;
-            }
-
-            // Make sure the pattern is the correct length.
-            if (pat.size() != d_length) {
-                throw std::runtime_error("Got a pattern of incorrect length!");
-            }
-
-            // Make a wrapped pattern, which is the original pattern plus
-            // a second copy of the pattern that has all but the last
-            // character in it.  This will enable use to use the string
-            // find() routine to see if any shift of the pattern is a
-            // match.
-            auto wrapped = pat + pat;
-            wrapped.pop_back();
-            d_patterns.push_back(std::move(wrapped));
-        }
+        const PatternStringList &PATTERNS)
+        : d_codes(PATTERNS) {
+        d_length = d_codes.getPatternLength();
     }
 
     int OsvrHdkLedIdentifier::getId(int currentId,
@@ -121,25 +77,12 @@ namespace vbtracker {
             return currentId;
         }
 
-        // Get a list of boolean values for 0's and 1's using
-        // the threshold computed above.
-        auto bits = getBitsUsingThreshold(brightnesses, threshold);
-
-        // Search through the available patterns to see if the passed-in
-        // pattern matches any of them.  If so, return that pattern.  We
-        // need to check all potential rotations of the pattern, since we
-        // don't know when the code started.  For the HDK, the codes are
-        // rotationally invariant.  We do this by making wrapped strings
-        // and seeing if the pattern shows up anywhe in them, relying on
-        // the std::string find method to do efficiently.
-        for (size_t i = 0; i < d_patterns.size(); i++) {
-            if (d_patterns[i].empty()) {
-                /// Skip turned-off patterns.
-                continue;
-            }
-            if (d_patterns[i].find(bits) != std::string::npos) {
-                return static_cast<int>(i);
-            }
+        // Look up the thresholded pattern in the table of every rotation of
+        // every pattern, since we don't know when the code started.  For the
+        // HDK, the codes are rotationally invariant.
+        auto id = d_codes.identify(brightnesses, threshold);
+        if (id >= 0) {
+            return id;
         }
 
         // No pattern recognized and we should have recognized one, so return
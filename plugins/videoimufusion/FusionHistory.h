@@ -0,0 +1,125 @@
+/** @file
+    @brief Header
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FusionHistory_h_GUID_14E2C297_6247_4EFE_9058_D9A046CA715D
+#define INCLUDED_FusionHistory_h_GUID_14E2C297_6247_4EFE_9058_D9A046CA715D
+
+// Internal Includes
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <Eigen/Core>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// Timestamped values in chronological order, in a ring buffer allocated once
+/// up front: pushing onto a full history drops the oldest entry instead of
+/// allocating, so it's safe to use at IMU report rates.
+///
+/// Entries are addressed by index, oldest first.
+template <typename ValueType> class FusionHistory {
+  public:
+    using timestamp_type = osvr::util::time::TimeValue;
+    using value_type = ValueType;
+
+    explicit FusionHistory(std::size_t capacity)
+        : m_entries((std::max)(capacity, std::size_t(1))) {}
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_entries.size(); }
+    bool empty() const { return 0 == m_size; }
+    void clear() { m_size = 0; }
+
+    timestamp_type const &timestamp(std::size_t i) const {
+        return m_entry(i).first;
+    }
+    value_type const &value(std::size_t i) const { return m_entry(i).second; }
+
+    timestamp_type const &newest_timestamp() const {
+        if (empty()) {
+            throw std::logic_error("Can't get time of newest entry in an "
+                                   "empty history!");
+        }
+        return timestamp(m_size - 1);
+    }
+
+    /// Adds a value newer than (or as new as) all others, dropping the oldest
+    /// if full.
+    void push_newest(timestamp_type const &tv, value_type const &value) {
+        if (!empty() && tv < newest_timestamp()) {
+            throw std::logic_error("Can't push_newest a value that's older "
+                                   "than the most recent value!");
+        }
+        if (m_size == capacity()) {
+            m_begin = (m_begin + 1) % capacity();
+            --m_size;
+        }
+        auto &entry = m_entries[(m_begin + m_size) % capacity()];
+        entry.first = tv;
+        entry.second = value;
+        ++m_size;
+    }
+
+    /// Returns the index of the first entry strictly newer than the given
+    /// timestamp, or size() if none.
+    std::size_t upper_bound(timestamp_type const &tv) const {
+        std::size_t lo = 0;
+        std::size_t hi = m_size;
+        while (lo < hi) {
+            auto mid = lo + (hi - lo) / 2;
+            if (tv < timestamp(mid)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    /// Returns the index of the newest entry not newer than the given
+    /// timestamp, or size() if none (all are newer, or it's empty).
+    std::size_t closest_not_newer(timestamp_type const &tv) const {
+        auto i = upper_bound(tv);
+        return 0 == i ? m_size : i - 1;
+    }
+
+    /// Removes all entries strictly newer than the given timestamp.
+    void pop_after(timestamp_type const &tv) { m_size = upper_bound(tv); }
+
+  private:
+    using entry_type = std::pair<timestamp_type, value_type>;
+    entry_type const &m_entry(std::size_t i) const {
+        return m_entries[(m_begin + i) % capacity()];
+    }
+    std::vector<entry_type, Eigen::aligned_allocator<entry_type>> m_entries;
+    std::size_t m_begin = 0;
+    std::size_t m_size = 0;
+};
+
+#endif // INCLUDED_FusionHistory_h_GUID_14E2C297_6247_4EFE_9058_D9A046CA715D
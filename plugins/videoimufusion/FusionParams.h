@@ -32,7 +32,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 struct VideoIMUFusionParams {
     double videoPosVariance = 3.0e-4;
@@ -44,6 +44,11 @@ struct VideoIMUFusionParams {
     double damping = 0.1;
     double eyeHeight = 1.6;
     bool cameraIsForward = true;
+    /// Filter states and IMU reports kept to apply late video reports. IMU
+    /// orientation reports, angular velocity reports and video reports each
+    /// take a state slot, so the time covered is 512 divided by their
+    /// combined rate: about a quarter second with both IMU reports at 1 kHz.
+    std::size_t historySize = 512;
 };
 
 #endif // INCLUDED_FusionParams_h_GUID_BD4F7F35_7854_4C9C_F4FF_73F62D33287D
@@ -59,9 +59,7 @@ VideoIMUFusion::RunningData::RunningData(
     OSVR_OrientationState const &initialIMU, OSVR_PoseState const &initialVideo,
     OSVR_TimeValue const &lastTS)
     : m_processModel(params.damping, params.positionNoise, params.oriNoise),
-      m_state(),
-#if 0
-      m_imuMeas(ei::map(initialIMU),
+      m_state(), m_imuMeas(ei::map(initialIMU),
                            Vector<3>::Constant(params.imuOriVariance)),
       m_imuMeasVel(Vector<3>::Zero(),
                    Vector<3>::Constant(params.imuAngVelVariance)),
@@ -69,8 +67,9 @@ VideoIMUFusion::RunningData::RunningData(
                       Vector<3>::Constant(params.videoOriVariance)),
       m_cameraMeasPos(Vector<3>::Zero(),
                       Vector<3>::Constant(params.videoPosVariance)),
-#endif
-      m_rTc(rTc), m_last(lastTS) {
+      m_rTc(rTc), m_last(lastTS), m_lastVideo(lastTS),
+      m_stateHistory(params.historySize),
+      m_imuHistory(params.historySize) {
 
 #ifdef OSVR_FPE
     FPExceptionEnabler fpe;
@@ -84,4 +83,5 @@ VideoIMUFusion::RunningData::RunningData(
     state().setStateVector(initialState);
     state().setQuaternion(Eigen::Quaterniond(roomPose.rotation()));
     state().setErrorCovariance(Vector<12>(InitialStateError).asDiagonal());
+    m_pushState();
 }
@@ -42,17 +42,16 @@ inline void dumpKalmanDebugOuput(const char name[], const char expr[],
 
 // Internal Includes
 #include "VideoIMUFusion.h"
+#include "FusionHistory.h"
 #include "FusionParams.h"
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Util/TimeValue.h>
 
 #include <osvr/Kalman/PoseDampedConstantVelocity.h>
-#if 0
 #include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <osvr/Kalman/AbsoluteOrientationMeasurement.h>
 #include <osvr/Kalman/AbsolutePositionMeasurement.h>
 #include <osvr/Kalman/AngularVelocityMeasurement.h>
-#endif
 
 #include <osvr/Util/Verbosity.h>
 
@@ -64,14 +63,12 @@ inline void dumpKalmanDebugOuput(const char name[], const char expr[],
 
 using ProcessModel = osvr::kalman::PoseDampedConstantVelocityProcessModel;
 using FilterState = ProcessModel::State;
-#if 0
 using AbsoluteOrientationMeasurement =
     osvr::kalman::AbsoluteOrientationMeasurement<FilterState>;
 using AbsolutePositionMeasurement =
     osvr::kalman::AbsolutePositionMeasurement<FilterState>;
 using AngularVelocityMeasurement =
     osvr::kalman::AngularVelocityMeasurement<FilterState>;
-#endif
 class VideoIMUFusion::RunningData {
   public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -85,6 +82,10 @@ class VideoIMUFusion::RunningData {
                          const OSVR_OrientationReport &report);
     void handleIMUVelocity(const OSVR_TimeValue &timestamp,
                            const Eigen::Vector3d &angVel);
+    /// Video reports come in late relative to IMU reports: one older than
+    /// the filter state rolls the filter back to its timestamp, then replays
+    /// the IMU reports since. One older than the history, or than the last
+    /// video report, is applied as if it were current.
     void handleVideoTrackerReport(const OSVR_TimeValue &timestamp,
                                   const OSVR_PoseReport &report);
 
@@ -105,20 +106,40 @@ class VideoIMUFusion::RunningData {
     }
 
   private:
+    /// An IMU report, kept for replay.
+    struct IMUMeasurement {
+        bool isOrientation;
+        Eigen::Quaterniond orientation;
+        Eigen::Vector3d angularVelocity;
+    };
+    void m_handleIMUMeasurement(const OSVR_TimeValue &timestamp,
+                                IMUMeasurement const &meas);
+    void m_applyIMUMeasurement(const OSVR_TimeValue &timestamp,
+                               IMUMeasurement const &meas);
+    /// Restores the newest saved state not newer than the given time,
+    /// forgetting those after it.
+    /// @return false if the history doesn't go back that far.
+    bool m_rollBackTo(const OSVR_TimeValue &timestamp);
+    void m_pushState();
+
     FilterState &state() { return m_state; }
     FilterState const &state() const { return m_state; }
     ProcessModel &processModel() { return m_processModel; }
     ProcessModel const &processModel() const { return m_processModel; }
     ProcessModel m_processModel;
     FilterState m_state;
-#if 0
     AbsoluteOrientationMeasurement m_imuMeas;
     AngularVelocityMeasurement m_imuMeasVel;
     AbsoluteOrientationMeasurement m_cameraMeasOri;
     AbsolutePositionMeasurement m_cameraMeasPos;
-#endif
     const Eigen::Isometry3d m_rTc;
     OSVR_TimeValue m_last;
+    /// Rolling back past this would undo a video report: not replayed.
+    OSVR_TimeValue m_lastVideo;
+    /// Filter state after each report applied.
+    FusionHistory<FilterState> m_stateHistory;
+    /// IMU reports, to replay after applying a late video report.
+    FusionHistory<IMUMeasurement> m_imuHistory;
 };
 
 #endif // INCLUDED_RunningData_h_GUID_6B3479E5_9D56_4BA9_DEC0_84AF53842168
@@ -42,23 +42,95 @@ namespace ei = osvr::util::eigen_interop;
 
 void VideoIMUFusion::RunningData::handleIMUReport(
     const OSVR_TimeValue &timestamp, const OSVR_OrientationReport &report) {
-    state().setQuaternion(ei::map(report.rotation));
+    IMUMeasurement meas;
+    meas.isOrientation = true;
+    meas.orientation = ei::map(report.rotation);
+    m_handleIMUMeasurement(timestamp, meas);
 }
 
 void VideoIMUFusion::RunningData::handleIMUVelocity(
     const OSVR_TimeValue &timestamp, const Eigen::Vector3d &angVel) {
-    state().angularVelocity() = angVel;
+    IMUMeasurement meas;
+    meas.isOrientation = false;
+    meas.angularVelocity = angVel;
+    m_handleIMUMeasurement(timestamp, meas);
+}
+
+void VideoIMUFusion::RunningData::m_handleIMUMeasurement(
+    const OSVR_TimeValue &timestamp, IMUMeasurement const &meas) {
+    if (m_imuHistory.empty() ||
+        !(timestamp < m_imuHistory.newest_timestamp())) {
+        m_imuHistory.push_newest(timestamp, meas);
+    }
+    /// else out of order: applied, but can't be kept in order for replay.
+    m_applyIMUMeasurement(timestamp, meas);
+}
+
+void VideoIMUFusion::RunningData::m_applyIMUMeasurement(
+    const OSVR_TimeValue &timestamp, IMUMeasurement const &meas) {
+    if (!preReport(timestamp)) {
+        return;
+    }
+    if (meas.isOrientation) {
+        m_imuMeas.setMeasurement(meas.orientation);
+        osvr::kalman::correct(state(), processModel(), m_imuMeas);
+    } else {
+        m_imuMeasVel.setMeasurement(meas.angularVelocity);
+        osvr::kalman::correct(state(), processModel(), m_imuMeasVel);
+    }
+    m_pushState();
 }
 
 void VideoIMUFusion::RunningData::handleVideoTrackerReport(
     const OSVR_TimeValue &timestamp, const OSVR_PoseReport &report) {
-    state().position() = takeCameraPoseToRoom(report.pose).translation();
+    bool late = timestamp < m_last;
+    if (late && (timestamp < m_lastVideo || !m_rollBackTo(timestamp))) {
+        /// Can't roll back that far: apply it as if it were current.
+        late = false;
+    }
+    if (!preReport(timestamp)) {
+        return;
+    }
+    m_lastVideo = m_last;
+    Eigen::Isometry3d roomPose = takeCameraPoseToRoom(report.pose);
+    m_cameraMeasPos.setMeasurement(roomPose.translation());
+    osvr::kalman::correct(state(), processModel(), m_cameraMeasPos);
+    m_cameraMeasOri.setMeasurement(Eigen::Quaterniond(roomPose.rotation()));
+    osvr::kalman::correct(state(), processModel(), m_cameraMeasOri);
+    m_pushState();
+
+    if (late) {
+        /// Replay the IMU reports since, which m_rollBackTo() undid.
+        for (auto i = m_imuHistory.upper_bound(timestamp),
+                  e = m_imuHistory.size();
+             i < e; ++i) {
+            m_applyIMUMeasurement(m_imuHistory.timestamp(i),
+                                  m_imuHistory.value(i));
+        }
+    }
+}
+
+bool VideoIMUFusion::RunningData::m_rollBackTo(
+    const OSVR_TimeValue &timestamp) {
+    auto i = m_stateHistory.closest_not_newer(timestamp);
+    if (m_stateHistory.size() == i) {
+        return false;
+    }
+    state() = m_stateHistory.value(i);
+    m_last = m_stateHistory.timestamp(i);
+    m_stateHistory.pop_after(m_last);
+    return true;
+}
+
+void VideoIMUFusion::RunningData::m_pushState() {
+    m_stateHistory.push_newest(m_last, state());
 }
 
 /// Returns true if we succeeded and can filter in some data.
 bool VideoIMUFusion::RunningData::preReport(const OSVR_TimeValue &timestamp) {
     auto dt = duration(timestamp, m_last);
     if (dt > 0) {
+        osvr::kalman::predict(state(), processModel(), dt);
         m_last = timestamp;
     }
     return true;
@@ -0,0 +1,208 @@
+/** @file
+    @brief Test for FusionHistory, including the roll back and replay that
+    the fusion filter does with it to apply late video reports.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "FusionHistory.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <vector>
+
+using History = FusionHistory<int>;
+using osvr::util::time::TimeValue;
+
+static inline TimeValue ms(int milliseconds) {
+    TimeValue ret;
+    ret.seconds = milliseconds / 1000;
+    ret.microseconds = (milliseconds % 1000) * 1000;
+    return ret;
+}
+
+TEST_CASE("FusionHistory-insertion") {
+    History history(4);
+    REQUIRE(history.empty());
+    REQUIRE(history.capacity() == 4);
+    REQUIRE_THROWS_AS(history.newest_timestamp(), std::logic_error);
+
+    history.push_newest(ms(10), 1);
+    history.push_newest(ms(20), 2);
+    /// Same time as the newest is fine.
+    history.push_newest(ms(20), 3);
+    REQUIRE(history.size() == 3);
+    REQUIRE(history.value(0) == 1);
+    REQUIRE(history.value(2) == 3);
+    REQUIRE(history.newest_timestamp() == ms(20));
+
+    SECTION("Older than the newest") {
+        REQUIRE_THROWS_AS(history.push_newest(ms(15), 4), std::logic_error);
+        REQUIRE(history.size() == 3);
+    }
+
+    SECTION("Full history drops the oldest") {
+        for (int i = 0; i < 6; ++i) {
+            history.push_newest(ms(30 + i), 10 + i);
+        }
+        REQUIRE(history.size() == 4);
+        for (std::size_t i = 0; i < 4; ++i) {
+            REQUIRE(history.value(i) == 12 + int(i));
+            REQUIRE(history.timestamp(i) == ms(32 + int(i)));
+        }
+    }
+
+    SECTION("Searching by time") {
+        REQUIRE(history.upper_bound(ms(5)) == 0);
+        REQUIRE(history.upper_bound(ms(10)) == 1);
+        REQUIRE(history.upper_bound(ms(20)) == 3);
+        REQUIRE(history.upper_bound(ms(25)) == 3);
+        /// Nothing old enough.
+        REQUIRE(history.closest_not_newer(ms(5)) == history.size());
+        REQUIRE(history.closest_not_newer(ms(10)) == 0);
+        REQUIRE(history.closest_not_newer(ms(15)) == 0);
+        REQUIRE(history.closest_not_newer(ms(25)) == 2);
+    }
+}
+
+TEST_CASE("FusionHistory-rollback") {
+    History history(8);
+    /// Wrap the ring buffer first, so rolling back crosses its end.
+    for (int i = 0; i < 13; ++i) {
+        history.push_newest(ms(10 * i), i);
+    }
+    REQUIRE(history.size() == 8);
+    REQUIRE(history.value(0) == 5);
+
+    auto i = history.closest_not_newer(ms(84));
+    REQUIRE(history.value(i) == 8);
+    history.pop_after(history.timestamp(i));
+    REQUIRE(history.size() == 4);
+    REQUIRE(history.newest_timestamp() == ms(80));
+
+    /// Time goes forward again from the rolled back state.
+    history.push_newest(ms(84), 100);
+    REQUIRE(history.size() == 5);
+    REQUIRE(history.value(4) == 100);
+
+    history.pop_after(ms(0));
+    REQUIRE(history.empty());
+    history.push_newest(ms(0), 1);
+    REQUIRE(history.value(0) == 1);
+}
+
+namespace {
+/// Stands in for the fusion filter: state is the running sum of the IMU
+/// measurements, and a video measurement replaces it.
+class ToyFilter {
+  public:
+    explicit ToyFilter(std::size_t historySize)
+        : m_states(historySize), m_imu(historySize) {
+        m_states.push_newest(m_last, m_state);
+    }
+    void imu(TimeValue const &tv, int meas) {
+        m_imu.push_newest(tv, meas);
+        m_applyIMU(tv, meas);
+    }
+    /// Same roll back and replay as RunningData::handleVideoTrackerReport
+    /// @return false if it was too old to roll back to: applied as current.
+    bool video(TimeValue const &tv, int meas) {
+        bool late = tv < m_last;
+        bool rolledBack = true;
+        if (late) {
+            auto i = m_states.closest_not_newer(tv);
+            if (m_states.size() == i) {
+                late = rolledBack = false;
+            } else {
+                m_state = m_states.value(i);
+                m_last = m_states.timestamp(i);
+                m_states.pop_after(m_last);
+            }
+        }
+        if (m_last < tv) {
+            m_last = tv;
+        }
+        m_state = meas;
+        m_states.push_newest(m_last, m_state);
+        if (late) {
+            for (auto i = m_imu.upper_bound(tv), e = m_imu.size(); i < e;
+                 ++i) {
+                m_applyIMU(m_imu.timestamp(i), m_imu.value(i));
+            }
+        }
+        return rolledBack;
+    }
+    int state() const { return m_state; }
+
+  private:
+    void m_applyIMU(TimeValue const &tv, int meas) {
+        m_last = tv;
+        m_state += meas;
+        m_states.push_newest(m_last, m_state);
+    }
+    int m_state = 0;
+    TimeValue m_last = ms(0);
+    History m_states;
+    History m_imu;
+};
+} // namespace
+
+TEST_CASE("FusionHistory-replay") {
+    /// Video at 35 ms replaces the sum, then IMU from 40 ms on adds up.
+    const int expected = 1000 + 4 + 5 + 6;
+    SECTION("Video report in order") {
+        ToyFilter filter(64);
+        for (int i = 1; i <= 3; ++i) {
+            filter.imu(ms(10 * i), i);
+        }
+        REQUIRE(filter.video(ms(35), 1000));
+        for (int i = 4; i <= 6; ++i) {
+            filter.imu(ms(10 * i), i);
+        }
+        REQUIRE(filter.state() == expected);
+    }
+    SECTION("Late video report") {
+        ToyFilter filter(64);
+        for (int i = 1; i <= 6; ++i) {
+            filter.imu(ms(10 * i), i);
+        }
+        REQUIRE(filter.state() == 21);
+        REQUIRE(filter.video(ms(35), 1000));
+        REQUIRE(filter.state() == expected);
+        /// And later reports build on the replayed state.
+        filter.imu(ms(70), 7);
+        REQUIRE(filter.state() == expected + 7);
+    }
+    SECTION("Video report older than the history") {
+        ToyFilter filter(4);
+        for (int i = 1; i <= 6; ++i) {
+            filter.imu(ms(10 * i), i);
+        }
+        REQUIRE_FALSE(filter.video(ms(15), 1000));
+        REQUIRE(filter.state() == 1000);
+    }
+}
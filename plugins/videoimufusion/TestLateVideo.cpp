@@ -0,0 +1,174 @@
+/** @file
+    @brief Test of the fusion filter applying late video reports, by rolling
+    back and replaying, and reports it has no history for.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "VideoIMUFusion.h"
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/QuaternionC.h>
+#include <osvr/Util/Vec3C.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+// - none
+
+namespace ei = osvr::util::eigen_interop;
+
+static inline OSVR_TimeValue ms(int milliseconds) {
+    OSVR_TimeValue ret;
+    ret.seconds = milliseconds / 1000;
+    ret.microseconds = (milliseconds % 1000) * 1000;
+    return ret;
+}
+
+/// Video reports of the tracked device x meters to the side of where it
+/// started, a quarter meter in front of the camera.
+static OSVR_PoseReport makeVideoReport(double x) {
+    OSVR_PoseReport report;
+    report.sensor = 0;
+    osvrQuatSetIdentity(&report.pose.rotation);
+    osvrVec3Zero(&report.pose.translation);
+    report.pose.translation.data[0] = x;
+    report.pose.translation.data[2] = 0.25;
+    return report;
+}
+
+/// The fusion filter, held still in front of the camera until it's running,
+/// at 2 seconds.
+class TestFusion {
+  public:
+    explicit TestFusion(std::size_t historySize = 512)
+        : m_fusion(makeParams(historySize)) {
+        OSVR_OrientationState identity;
+        osvrQuatSetIdentity(&identity);
+        for (int t = 1000; t <= 2000 && !m_fusion.running(); t += 50) {
+            m_fusion.handleVideoTrackerDataDuringStartup(
+                ms(t), makeVideoReport(0), identity);
+        }
+        REQUIRE(m_fusion.running());
+    }
+
+    /// IMU reports, of no rotation, every millisecond of [begin, end]
+    void imu(int begin, int end) {
+        OSVR_OrientationReport report;
+        report.sensor = 0;
+        osvrQuatSetIdentity(&report.rotation);
+        for (int t = begin; t <= end; ++t) {
+            m_fusion.handleIMUData(ms(t), report);
+        }
+    }
+
+    void imu(int t, Eigen::Quaterniond const &rotation) {
+        OSVR_OrientationReport report;
+        report.sensor = 0;
+        ei::map(report.rotation) = rotation;
+        m_fusion.handleIMUData(ms(t), report);
+    }
+
+    void video(int t, double x) {
+        m_fusion.handleVideoTrackerDataWhileRunning(ms(t), makeVideoReport(x));
+    }
+
+    Eigen::Vector3d position() const {
+        return ei::map(m_fusion.getLatestPose()).translation();
+    }
+
+    Eigen::Quaterniond orientation() const {
+        return ei::map(m_fusion.getLatestPose()).rotation();
+    }
+
+  private:
+    static VideoIMUFusionParams makeParams(std::size_t historySize) {
+        VideoIMUFusionParams params;
+        params.historySize = historySize;
+        return params;
+    }
+    VideoIMUFusion m_fusion;
+};
+
+TEST_CASE("VideoIMUFusion-late-video") {
+    /// Video from 2010 ms, of the device moved 5 cm, arriving after the IMU
+    /// reports up to 2050 ms.
+    TestFusion late;
+    late.imu(2001, 2050);
+    late.video(2010, 0.05);
+
+    /// What it would be, had it arrived on time.
+    TestFusion inOrder;
+    inOrder.imu(2001, 2010);
+    inOrder.video(2010, 0.05);
+    inOrder.imu(2011, 2050);
+    REQUIRE((late.position() - inOrder.position()).norm() < 1e-12);
+
+    /// What applying it as if it were current gives: the prediction since
+    /// 2010 ms is missing.
+    TestFusion asCurrent;
+    asCurrent.imu(2001, 2050);
+    asCurrent.video(2050, 0.05);
+    REQUIRE((late.position() - asCurrent.position()).norm() > 1e-4);
+
+    SECTION("Later reports build on the replayed state") {
+        late.imu(2051, 2060);
+        inOrder.imu(2051, 2060);
+        REQUIRE((late.position() - inOrder.position()).norm() < 1e-12);
+    }
+}
+
+TEST_CASE("VideoIMUFusion-reports-without-history") {
+    SECTION("Video older than the history is applied as current") {
+        TestFusion shortHistory(16);
+        shortHistory.imu(2001, 2050);
+        shortHistory.video(2010, 0.05);
+        TestFusion asCurrent(16);
+        asCurrent.imu(2001, 2050);
+        asCurrent.video(2050, 0.05);
+        REQUIRE((shortHistory.position() - asCurrent.position()).norm() <
+                1e-12);
+    }
+
+    SECTION("Video older than the last video doesn't undo it") {
+        TestFusion older;
+        older.imu(2001, 2050);
+        older.video(2030, 0.05);
+        older.video(2020, 0.02);
+        TestFusion asCurrent;
+        asCurrent.imu(2001, 2050);
+        asCurrent.video(2030, 0.05);
+        asCurrent.video(2050, 0.02);
+        REQUIRE((older.position() - asCurrent.position()).norm() < 1e-12);
+    }
+
+    SECTION("Out-of-order IMU reports are applied") {
+        TestFusion fusion;
+        fusion.imu(2001, 2050);
+        Eigen::Quaterniond before = fusion.orientation();
+        fusion.imu(2040, Eigen::Quaterniond(Eigen::AngleAxisd(
+                             1.5, Eigen::Vector3d::UnitY())));
+        REQUIRE(fusion.orientation().angularDistance(before) > 0.01);
+    }
+}
@@ -119,10 +119,10 @@ void VideoIMUFusion::handleIMUVelocity(const OSVR_TimeValue &timestamp,
                                        const Eigen::Vector3d &angVel) {
     /// Arbitrary, chosen to avoid aliasing
     static const auto DT = 1. / 50.;
-    /// @todo Do we need a factor of 0.5 to turn angular velocity vector into
-    /// quaternion derivative?
+    /// The incremental rotation turns by the full angle over DT, as the input
+    /// report is decoded: the exponential map takes the half-angle vector.
     ei::map(m_lastVelocity.angularVelocity.incrementalRotation) =
-        osvr::util::quat_exp_map((angVel * DT).eval()).exp();
+        osvr::util::quat_exp_map((angVel * DT * 0.5).eval()).exp();
     m_lastVelocity.angularVelocity.dt = DT;
 
     ei::map(m_lastVelocity.linearVelocity) = Eigen::Vector3d::Zero();
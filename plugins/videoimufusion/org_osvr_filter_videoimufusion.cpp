@@ -98,6 +98,9 @@ class AnalysisPluginInstantiation {
             root.get("eyeHeight", fusionParams.eyeHeight).asDouble();
         fusionParams.cameraIsForward =
             root.get("cameraIsForward", fusionParams.cameraIsForward).asBool();
+        fusionParams.historySize =
+            root.get("historySize", Json::UInt(fusionParams.historySize))
+                .asUInt();
 
         osvr::pluginkit::PluginContext context(ctx);
 
@@ -0,0 +1,171 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlinkCodeTable.h"
+#include "IdentifierHelpers.h"
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <stdexcept>
+
+namespace osvr {
+namespace vbtracker {
+    static const auto VALIDCHARS = "*.";
+
+    static inline bool isEnabledPattern(std::string const &pat) {
+        return !pat.empty() && pat.find_first_not_of(VALIDCHARS) == pat.npos;
+    }
+
+    /// Fibonacci hashing multiplier: 2^64 divided by the golden ratio.
+    static const std::uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+    BlinkCodeTable::BlinkCodeTable(std::vector<std::string> const &patterns) {
+        // The first enabled pattern establishes the length.
+        for (auto &pat : patterns) {
+            if (isEnabledPattern(pat)) {
+                m_length = pat.length();
+                break;
+            }
+        }
+        if (0 == m_length) {
+            return;
+        }
+
+        std::size_t numEnabled = 0;
+        for (auto &pat : patterns) {
+            if (!isEnabledPattern(pat)) {
+                continue;
+            }
+            if (pat.size() != m_length) {
+                throw std::runtime_error("Got a pattern of incorrect length!");
+            }
+            ++numEnabled;
+        }
+
+        if (!m_usePackedCodes()) {
+            for (auto &pat : patterns) {
+                if (!isEnabledPattern(pat)) {
+                    m_wrapped.emplace_back();
+                    continue;
+                }
+                auto wrapped = pat + pat;
+                wrapped.pop_back();
+                m_wrapped.push_back(std::move(wrapped));
+            }
+            return;
+        }
+
+        // Size the table to a power of two at most half full with every
+        // rotation of every pattern.
+        std::size_t capacity = 16;
+        unsigned bits = 4;
+        while (capacity < numEnabled * m_length * 2) {
+            capacity *= 2;
+            ++bits;
+        }
+        m_hashShift = 64 - bits;
+        m_table.assign(capacity, Entry{0, -1});
+
+        const auto mask =
+            m_length == 64 ? ~std::uint64_t(0)
+                           : ((std::uint64_t(1) << m_length) - 1);
+        const int numPatterns = static_cast<int>(patterns.size());
+        for (int i = 0; i < numPatterns; ++i) {
+            auto const &pat = patterns[i];
+            if (!isEnabledPattern(pat)) {
+                continue;
+            }
+            std::uint64_t code = 0;
+            for (auto c : pat) {
+                code = (code << 1) | (c == '*' ? 1 : 0);
+            }
+            for (std::size_t rot = 0; rot < m_length; ++rot) {
+                m_insert(code, i);
+                code = ((code << 1) | (code >> (m_length - 1))) & mask;
+            }
+        }
+    }
+
+    int BlinkCodeTable::identify(BrightnessList const &brightnesses,
+                                 Brightness threshold) const {
+        BOOST_ASSERT_MSG(brightnesses.size() == m_length,
+                         "Must pass exactly as many brightnesses as the "
+                         "pattern length!");
+        if (0 == m_length) {
+            return -1;
+        }
+        if (!m_usePackedCodes()) {
+            auto bits = getBitsUsingThreshold(brightnesses, threshold);
+            for (std::size_t i = 0; i < m_wrapped.size(); ++i) {
+                if (!m_wrapped[i].empty() &&
+                    m_wrapped[i].find(bits) != std::string::npos) {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+        std::uint64_t code = 0;
+        for (auto val : brightnesses) {
+            code = (code << 1) | (val >= threshold ? 1 : 0);
+        }
+        return m_lookup(code);
+    }
+
+    std::size_t BlinkCodeTable::m_getSlot(std::uint64_t code) const {
+        return static_cast<std::size_t>((code * HASH_MULTIPLIER) >>
+                                        m_hashShift);
+    }
+
+    void BlinkCodeTable::m_insert(std::uint64_t code, int index) {
+        auto slotMask = m_table.size() - 1;
+        for (auto slot = m_getSlot(code);; slot = (slot + 1) & slotMask) {
+            auto &entry = m_table[slot];
+            if (entry.index < 0) {
+                entry.code = code;
+                entry.index = index;
+                return;
+            }
+            if (entry.code == code) {
+                // A rotation shared with an earlier pattern (or a repeat of
+                // this one's): the earlier pattern wins, as it always has.
+                return;
+            }
+        }
+    }
+
+    int BlinkCodeTable::m_lookup(std::uint64_t code) const {
+        auto slotMask = m_table.size() - 1;
+        for (auto slot = m_getSlot(code);; slot = (slot + 1) & slotMask) {
+            auto const &entry = m_table[slot];
+            if (entry.index < 0 || entry.code == code) {
+                return entry.index;
+            }
+        }
+    }
+
+} // namespace vbtracker
+} // namespace osvr
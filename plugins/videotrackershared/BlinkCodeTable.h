@@ -0,0 +1,98 @@
+/** @file
+    @brief Header
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BlinkCodeTable_h_GUID_DE4828A5_553F_4EC9_9656_B1420C4BD1BB
+#define INCLUDED_BlinkCodeTable_h_GUID_DE4828A5_553F_4EC9_9656_B1420C4BD1BB
+
+// Internal Includes
+#include "BasicTypes.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+
+    /// @brief Lookup table from every cyclic rotation of a set of blink
+    /// code patterns to the index of the pattern, for identifying beacons
+    /// whose code could have started at any point in its cycle.
+    ///
+    /// Patterns are strings with '*' meaning that the LED is bright and '.'
+    /// that it is dim at that point in time, all of the same length. Empty
+    /// patterns, or those with any other characters, are intentionally
+    /// disabled beacons that will never be identified.
+    ///
+    /// Patterns up to 64 long are packed into integer codes, so
+    /// identification is a single hash table probe: longer ones fall back
+    /// to a substring search of each pattern.
+    class BlinkCodeTable {
+      public:
+        /// @throws std::runtime_error if a pattern is of a different length
+        /// than the first enabled one.
+        explicit BlinkCodeTable(std::vector<std::string> const &patterns);
+
+        /// @brief Length of all the patterns, or 0 if none are enabled.
+        std::size_t getPatternLength() const { return m_length; }
+
+        /// @brief Identifies a sequence of brightnesses, exactly as long as
+        /// the patterns, split into bright and dim at the threshold.
+        ///
+        /// @return the index of the pattern with a rotation matching the
+        /// sequence (the lowest such index, if there are several), or -1 if
+        /// none match.
+        int identify(BrightnessList const &brightnesses,
+                     Brightness threshold) const;
+
+      private:
+        bool m_usePackedCodes() const { return m_length <= 64; }
+        std::size_t m_getSlot(std::uint64_t code) const;
+        void m_insert(std::uint64_t code, int index);
+        int m_lookup(std::uint64_t code) const;
+
+        std::size_t m_length = 0;
+
+        /// @brief Open-addressed, linear-probed table of packed codes, with
+        /// the oldest state in the most significant of the low m_length
+        /// bits.
+        struct Entry {
+            std::uint64_t code;
+            int index; //< -1 for an empty slot
+        };
+        std::vector<Entry> m_table;
+        /// @brief Shift to reduce a multiplicative hash to a slot index.
+        unsigned m_hashShift = 64;
+
+        /// @brief For patterns too long to pack: each pattern followed by
+        /// all but its last character, so every rotation is a substring.
+        std::vector<std::string> m_wrapped;
+    };
+
+} // namespace vbtracker
+} // namespace osvr
+#endif // INCLUDED_BlinkCodeTable_h_GUID_DE4828A5_553F_4EC9_9656_B1420C4BD1BB
@@ -82,7 +82,7 @@ namespace client {
         /// up a handler) we don't have a leftover one still active.
         m_interfaces.eraseHandlerForPath(path);
 
-        auto source = common::resolveTreeNode(m_pathTree, path);
+        auto source = m_resolutionCache.resolve(m_pathTree, path);
         if (!source.is_initialized()) {
             if (verboseFailure) {
                 logger()->info() << "Could not resolve source for " << path;
@@ -34,6 +34,7 @@
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Client/InterfaceTree.h>
 #include <osvr/Util/Verbosity.h>
+#include <osvr/Common/BorrowedImage.h>
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/ImagingComponent.h>
 
@@ -51,12 +52,14 @@ namespace client {
         ImagingRemoteHandler(vrpn_ConnectionPtr const &conn,
                              std::string const &deviceName,
                              boost::optional<OSVR_ChannelCount> sensor,
-                             common::InterfaceList &ifaces)
-            : m_dev(common::createClientDevice(deviceName, conn)),
+                             common::InterfaceList &ifaces,
+                             common::ClientContext &ctx)
+            : m_conn(conn), m_dev(common::createClientDevice(deviceName, conn)),
               m_internals(ifaces), m_all(!sensor.is_initialized()),
-              m_sensor(sensor) {
+              m_sensor(sensor), m_ctx(ctx) {
             auto imaging = common::ImagingComponent::create();
             m_dev->addComponent(imaging);
+            m_imaging = imaging.get();
             imaging->registerImageHandler(
                 [&](common::ImageData const &data,
                     util::time::TimeValue const &timestamp) {
@@ -73,7 +76,22 @@ namespace client {
             /// @todo do we need to unregister?
         }
 
-        virtual void update() { m_dev->update(); }
+        virtual void update() {
+            m_dev->update();
+            if (!m_conn->connected()) {
+                /// Ask again once we're connected: the server may be new.
+                m_requested = false;
+                return;
+            }
+            /// The request also opts us in to frames too large for an
+            /// imageRegion message, so it goes out even with no decimation.
+            auto decimation = m_ctx.getImagingDecimation();
+            if (!m_requested || decimation != m_requestedDecimation) {
+                m_imaging->requestNetworkDecimation(decimation);
+                m_requested = true;
+                m_requestedDecimation = decimation;
+            }
+        }
 
       private:
         void m_handleImage(common::ImageData const &data,
@@ -88,23 +106,33 @@ namespace client {
             report.state.metadata = data.metadata;
             report.state.data = data.buffer.get();
 
-            m_internals.forEachInterface(
-                [&timestamp, &report, &data](common::ClientInterface &iface) {
-                    // Note: not setting state here! we don't store image state.
-                    auto n = iface.getNumCallbacksFor(report);
-                    for (std::size_t i = 0; i < n; ++i) {
-                        // Acquire a reference for each callback we're going to
-                        // call.
-                        iface.getContext().acquireObject(data.buffer);
-                    }
-                    iface.triggerCallbacks(timestamp, report);
-                });
+            /// Created for the first context lending frames, then shared.
+            common::BorrowedImagePtr borrowed;
+            m_internals.forEachInterface([&](common::ClientInterface &iface) {
+                // Note: not setting state here! we don't store image state.
+                auto n = iface.getNumCallbacksFor(report);
+                // Lends the frame if it can: the app may copy it out, but
+                // holding on to it doesn't keep the server from reusing it.
+                common::acquireImage(iface.getContext(), data, n, borrowed);
+                iface.triggerCallbacks(timestamp, report);
+            });
+            if (borrowed) {
+                // Callbacks are done: the frame is only lent from now on.
+                borrowed->locked.reset();
+            }
         }
 
+        vrpn_ConnectionPtr m_conn;
         common::BaseDevicePtr m_dev;
         RemoteHandlerInternals m_internals;
         bool m_all;
         boost::optional<OSVR_ChannelCount> m_sensor;
+        common::ClientContext &m_ctx;
+        /// @brief Owned by m_dev.
+        common::ImagingComponent *m_imaging;
+        /// @brief Have we sent a request on the current connection?
+        bool m_requested = false;
+        std::uint32_t m_requestedDecimation = 1;
     };
 
     ImagingRemoteFactory::ImagingRemoteFactory(
@@ -113,7 +141,7 @@ namespace client {
 
     shared_ptr<RemoteHandler> ImagingRemoteFactory::
     operator()(common::OriginalSource const &source,
-               common::InterfaceList &ifaces, common::ClientContext &) {
+               common::InterfaceList &ifaces, common::ClientContext &ctx) {
 
         shared_ptr<RemoteHandler> ret;
 
@@ -127,7 +155,7 @@ namespace client {
         /// @todo find out why make_shared causes a crash here
         ret.reset(new ImagingRemoteHandler(
             m_conns.getConnection(devElt), devElt.getFullDeviceName(),
-            source.getSensorNumberAsChannelCount(), ifaces));
+            source.getSensorNumberAsChannelCount(), ifaces, ctx));
         return ret;
     }
 
@@ -24,21 +24,23 @@
 
 // Internal Includes
 #include "PureClientContext.h"
+#include "TreeCache.h"
 #include <boost/algorithm/string.hpp>
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Common/CreateDevice.h>
-#include <osvr/Common/DeduplicatingFunctionWrapper.h>
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathTreeSerialization.h>
 #include <osvr/Common/SystemComponent.h>
+#include <osvr/Util/PreciseSleep.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 #include <json/value.h>
+#include <vrpn_Connection.h>
 
 // Standard includes
-#include <thread>
 #include <unordered_set>
 
 namespace osvr {
@@ -82,6 +84,7 @@ namespace client {
     static const std::chrono::milliseconds STARTUP_CONNECT_TIMEOUT(200);
     static const std::chrono::milliseconds STARTUP_TREE_TIMEOUT(1000);
     static const std::chrono::milliseconds STARTUP_LOOP_SLEEP(1);
+    using clock = std::chrono::steady_clock;
 
     PureClientContext::PureClientContext(const char appId[], const char host[],
                                          common::ClientContextDeleter del)
@@ -105,31 +108,36 @@ namespace client {
         m_systemDevice = common::createClientDevice(sysDeviceName, m_mainConn);
         m_systemComponent =
             m_systemDevice->addComponent(common::SystemComponent::create());
-        using DedupJsonFunction =
-            common::DeduplicatingFunctionWrapper<Json::Value const &>;
-
         m_systemComponent->registerReplaceTreeHandler(
-            DedupJsonFunction([&](Json::Value nodes) {
-                logger()->debug("Got updated path tree, processing");
-                // Replace localhost before we even convert the json to a tree.
-                // replace the @localhost with the correct host name
-                // in case we are a remote client, otherwise the connection
-                // would fail
-                replaceLocalhostServers(nodes, m_host);
-
-                // Tree observers will handle destruction/creation of remote
-                // handlers.
-                m_pathTreeOwner.replaceTree(nodes);
-            }));
-
-        typedef std::chrono::system_clock clock;
+            [&](Json::Value const &nodes, util::time::TimeValue const &) {
+                m_handleReplaceTree(nodes);
+            });
+        m_systemComponent->registerTreeVersionHandler(
+            [&](std::string const &version) {
+                if (!m_treeIsLive && version == m_treeVersion) {
+                    logger()->debug("Cached path tree is current");
+                    m_treeIsLive = true;
+                }
+            });
+
+        // Start with the cached tree, if any, so routing can begin before the
+        // live tree arrives.
+        m_treeCacheFile = getTreeCacheFilePath(m_host);
+        if (!m_treeCacheFile.empty()) {
+            Json::Value nodes;
+            std::string version;
+            if (loadCachedTree(m_treeCacheFile, nodes, version)) {
+                logger()->debug() << "Loaded cached path tree " << version;
+                m_applyTree(nodes, version);
+            }
+        }
+
         auto begin = clock::now();
 
-        // Spin the update to get a connection
+        // Wait for a connection
         auto connEnd = begin + STARTUP_CONNECT_TIMEOUT;
         while (clock::now() < connEnd && !m_gotConnection) {
-            m_update();
-            std::this_thread::sleep_for(STARTUP_LOOP_SLEEP);
+            m_waitAndUpdate(connEnd);
         }
         if (!m_gotConnection) {
             logger()->notice()
@@ -142,11 +150,11 @@ namespace client {
             return; // Bail early if we don't even have a connection
         }
 
-        // Spin the update to get a path tree
+        // Wait for the path tree, or confirmation that the cached one is
+        // current: the server sends both as soon as we connect.
         auto treeEnd = begin + STARTUP_TREE_TIMEOUT;
-        while (clock::now() < treeEnd && !m_pathTreeOwner) {
-            m_update();
-            std::this_thread::sleep_for(STARTUP_LOOP_SLEEP);
+        while (clock::now() < treeEnd && !m_treeIsLive) {
+            m_waitAndUpdate(treeEnd);
         }
         auto timeToStartup = (clock::now() - begin);
 
@@ -161,7 +169,9 @@ namespace client {
             << "ms: "
             << (m_gotConnection ? "have connection to server, "
                                 : "don't have connection to server, ")
-            << (m_pathTreeOwner ? "have path tree" : "don't have path tree");
+            << (m_treeIsLive ? "have path tree"
+                             : (m_pathTreeOwner ? "have cached path tree"
+                                                : "don't have path tree"));
     }
 
     PureClientContext::~PureClientContext() {}
@@ -181,6 +191,59 @@ namespace client {
         m_ifaceMgr.updateHandlers();
     }
 
+    void
+    PureClientContext::m_waitAndUpdate(clock::time_point const &deadline) {
+        if (!m_mainConn->connected()) {
+            // VRPN polls while setting up the connection, so there is no
+            // socket to wait on yet.
+            m_update();
+            util::time::sleepFor(STARTUP_LOOP_SLEEP);
+            return;
+        }
+        // Block in select() on the connection until a message arrives or the
+        // deadline passes.
+        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+                             deadline - clock::now())
+                             .count();
+        if (remaining > 0) {
+            struct timeval timeout;
+            timeout.tv_sec = static_cast<long>(remaining / 1000000);
+            timeout.tv_usec = static_cast<long>(remaining % 1000000);
+            m_mainConn->mainloop(&timeout);
+        }
+        m_update();
+    }
+
+    void PureClientContext::m_handleReplaceTree(Json::Value const &nodes) {
+        m_treeIsLive = true;
+        auto version = common::pathTreeJsonVersion(nodes);
+        if (version == m_treeVersion) {
+            // Sent again to a new client, or matches our cached copy.
+            return;
+        }
+        logger()->debug("Got updated path tree, processing");
+        if (!m_treeCacheFile.empty() &&
+            !saveCachedTree(m_treeCacheFile, nodes, version)) {
+            logger()->debug() << "Could not write path tree cache file "
+                              << m_treeCacheFile;
+        }
+        m_applyTree(nodes, version);
+    }
+
+    void PureClientContext::m_applyTree(Json::Value nodes,
+                                        std::string const &version) {
+        m_treeVersion = version;
+        // Replace localhost before we even convert the json to a tree.
+        // replace the @localhost with the correct host name
+        // in case we are a remote client, otherwise the connection
+        // would fail
+        replaceLocalhostServers(nodes, m_host);
+
+        // Tree observers will handle destruction/creation of remote
+        // handlers.
+        m_pathTreeOwner.replaceTree(nodes);
+    }
+
     void PureClientContext::m_sendRoute(std::string const &route) {
         m_systemComponent->sendClientRouteUpdate(route);
         m_update();
@@ -197,7 +260,9 @@ namespace client {
     }
 
     bool PureClientContext::m_getStatus() const {
-        return m_gotConnection && m_pathTreeOwner;
+        // A cached tree is enough to start routing, but not to say we're
+        // fully started: the server may have changed since.
+        return m_gotConnection && m_pathTreeOwner && m_treeIsLive;
     }
 
     common::PathTree const &PureClientContext::m_getPathTree() const {
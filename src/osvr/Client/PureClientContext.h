@@ -44,6 +44,7 @@
 #include <vrpn_ConnectionPtr.h>
 
 // Standard includes
+#include <chrono>
 #include <string>
 
 namespace osvr {
@@ -61,6 +62,18 @@ namespace client {
         void m_update() override;
         void m_sendRoute(std::string const &route) override;
 
+        /// @brief Waits (up to the deadline) for messages from the server,
+        /// then updates.
+        void m_waitAndUpdate(
+            std::chrono::steady_clock::time_point const &deadline);
+
+        /// @brief Handles a tree from the server, replacing ours and updating
+        /// the cache if it's changed.
+        void m_handleReplaceTree(Json::Value const &nodes);
+
+        /// @brief Replaces our path tree with the given nodes.
+        void m_applyTree(Json::Value nodes, std::string const &version);
+
         /// @brief Called with each new interface object before it is returned
         /// to the client.
         void
@@ -108,6 +121,18 @@ namespace client {
         /// @brief Have we gotten a connection to the main server?
         bool m_gotConnection = false;
 
+        /// @brief Version of the current path tree (see
+        /// common::pathTreeJsonVersion())
+        std::string m_treeVersion;
+
+        /// @brief Is the current tree known to match the server's? (false
+        /// while using a cached tree that hasn't been confirmed)
+        bool m_treeIsLive = false;
+
+        /// @brief File to cache the path tree in, empty if caching is
+        /// disabled.
+        std::string m_treeCacheFile;
+
         /// @brief Room to world transform.
         common::Transform m_roomToWorld;
 
@@ -33,7 +33,8 @@
 // - none
 
 // Standard includes
-// - none
+#include <algorithm>
+#include <cstddef>
 
 namespace osvr {
 namespace client {
@@ -54,32 +55,63 @@ namespace client {
         template <typename ReportType>
         void setStateAndTriggerCallbacks(const OSVR_TimeValue &timestamp,
                                          ReportType const &report) {
+            forEachInterface(
+                [&timestamp, &report](common::ClientInterface &iface) {
+                    deliver(iface, timestamp, report);
+                });
+        }
+
+        /// @brief Set state and call callbacks for a report type on a single
+        /// interface: for use in forEachInterface() when delivering several
+        /// reports at once.
+        template <typename ReportType>
+        static void deliver(common::ClientInterface &iface,
+                            const OSVR_TimeValue &timestamp,
+                            ReportType const &report) {
             static_assert(
                 osvr::common::traits::KeepStateForReport<ReportType>::value,
                 "Should only call a state setter if we're keeping state for "
                 "this report type!");
-
-            forEachInterface(
-                [&timestamp, &report](common::ClientInterface &iface) {
-                    iface.setState(timestamp, report);
-                    iface.triggerCallbacks(timestamp, report);
-                });
+            iface.setState(timestamp, report);
+            iface.triggerCallbacks(timestamp, report);
         }
 
         /// @brief Do something with every client interface object, if the above
         /// options don't suit your needs.
+        ///
+        /// Iterates over our own copy of the interface list, only re-made when
+        /// the list has changed, so the interfaces stay alive (and the
+        /// iteration valid) even if a callback releases or acquires an
+        /// interface, without touching reference counts on every report.
         template <typename F> void forEachInterface(F &&f) {
-            common::ClientInterfacePtr pin;
-            for (auto &iface : m_interfaces) {
-                /// @todo is this needed? it increments a shared_ptr reference
-                /// count which is expensive.
-                pin = iface;
-                f(*pin);
+            if (m_dispatchDepth == 0 && !m_pinnedIsCurrent()) {
+                m_pinned = m_interfaces;
+            }
+            DispatchScope scope{m_dispatchDepth};
+            for (auto const &iface : m_pinned) {
+                f(*iface);
             }
         }
 
       private:
+        struct DispatchScope {
+            explicit DispatchScope(std::size_t &depth) : m_depth(depth) {
+                ++m_depth;
+            }
+            ~DispatchScope() { --m_depth; }
+            std::size_t &m_depth;
+        };
+        /// Comparing the pointers doesn't touch the reference counts.
+        bool m_pinnedIsCurrent() const {
+            return m_pinned.size() == m_interfaces.size() &&
+                   std::equal(m_pinned.begin(), m_pinned.end(),
+                              m_interfaces.begin());
+        }
         common::InterfaceList &m_interfaces;
+        /// @brief Snapshot of m_interfaces, replaced only between (not during)
+        /// dispatches, in case a callback re-enters the client update.
+        common::InterfaceList m_pinned;
+        std::size_t m_dispatchDepth = 0;
     };
 } // namespace client
 } // namespace osvr
@@ -151,7 +151,8 @@ namespace client {
         return cfg;
     }
 
-    SkeletonConfig::SkeletonConfig(OSVR_ClientContext ctx) : m_ctx(ctx) {}
+    SkeletonConfig::SkeletonConfig(OSVR_ClientContext ctx)
+        : m_ctx(ctx), m_snapshot(*ctx) {}
 
     void SkeletonConfig::updateArticulationTree(
         osvr::common::PathTree const &articulationTree) {
@@ -169,29 +170,41 @@ namespace client {
             [&traverser](osvr::common::PathNode const &node) {
                 osvr::common::applyPathNodeVisitor(traverser, node);
             });
+
+        /// joints then bones, in order, as updateSkeletonPoses expects.
+        m_snapshot.clear();
+        m_snapshot.reserve(m_jointInterfaces.size() + m_boneInterfaces.size());
+        for (auto &val : m_jointInterfaces) {
+            m_snapshot.push_back(*val.second);
+        }
+        for (auto &val : m_boneInterfaces) {
+            m_snapshot.push_back(*val.second);
+        }
     }
 
     void SkeletonConfig::updateSkeletonPoses() {
+        // Read all joints and bones at once, so they're from the same update.
+        m_snapshotEntries.resize(m_snapshot.size());
+        if (!m_snapshotEntries.empty()) {
+            m_snapshot.get<OSVR_PoseReport>(m_snapshotEntries.data());
+        }
 
         // clear old values
         m_jointPoses.clear();
         m_bonePoses.clear();
 
+        auto entry = begin(m_snapshotEntries);
         for (auto &val : m_jointInterfaces) {
-            OSVR_TimeValue timestamp;
-            OSVR_Pose3 pose;
-            osvrPose3SetIdentity(&pose);
-            if (val.second->getState<OSVR_PoseReport>(timestamp, pose)) {
-                m_jointPoses.push_back(std::make_pair(val.first, pose));
+            if (entry->valid) {
+                m_jointPoses.push_back(std::make_pair(val.first, entry->state));
             }
+            ++entry;
         }
         for (auto &val : m_boneInterfaces) {
-            OSVR_TimeValue timestamp;
-            OSVR_Pose3 pose;
-            osvrPose3SetIdentity(&pose);
-            if (val.second->getState<OSVR_PoseReport>(timestamp, pose)) {
-                m_bonePoses.push_back(std::make_pair(val.first, pose));
+            if (entry->valid) {
+                m_bonePoses.push_back(std::make_pair(val.first, entry->state));
             }
+            ++entry;
         }
     }
 } // namespace client
@@ -29,10 +29,13 @@
 #include "VRPNConnectionCollection.h"
 #include <osvr/Client/InterfaceTree.h>
 #include <osvr/Common/ClientInterface.h>
-#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Common/GeneralizedTransform.h>
+#include <osvr/Common/InProcessReportRouter.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PoseBatch.h>
 #include <osvr/Common/Tracing.h>
+#include <osvr/Common/TrackerReportRing.h>
 #include <osvr/Common/TrackerSensorInfo.h>
 #include <osvr/Common/Transform.h>
 #include <osvr/Util/ChannelCountC.h>
@@ -50,7 +53,7 @@
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace ei = osvr::util::eigen_interop;
 
@@ -63,36 +66,52 @@ namespace client {
             bool reportPosition = false;
             bool reportOrientation = false;
         };
+        /// @param inProcess The channel of the device, if it might be sending
+        /// in this process: used instead of a VRPN remote if it has a
+        /// publisher.
+        /// @param ring The shared memory ring of the device, if found: used
+        /// instead of a VRPN remote otherwise.
         VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
+                           common::InProcessReportRouterPtr const &router,
+                           common::TrackerReportChannelPtr const &inProcess,
+                           common::TrackerReportRingPtr const &ring,
                            Options const &options,
                            common::TrackerSensorInfo const &info,
                            common::Transform const &t,
                            boost::optional<int> sensor,
                            common::InterfaceList &ifaces,
                            common::ClientContext &ctx)
-            : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
-              m_info(info), m_sensor(sensor) {
-            if (m_info.reportsPosition || m_info.reportsOrientation) {
-                m_remote->register_change_handler(this,
-                                                  &VRPNTrackerHandler::handle,
-                                                  m_sensor.get_value_or(-1));
+            : m_conn(conn), m_src(src), m_transform(t), m_ctx(ctx),
+              m_internals(ifaces), m_opts(options), m_info(info),
+              m_sensor(sensor) {
+            if (inProcess && inProcess->hasPublisher()) {
+                m_router = router;
+                m_inProcess = inProcess;
+                m_subscription = m_inProcess->subscribe(m_makeSubscriber());
+                OSVR_DEV_VERBOSE("Constructed an in-process TrackerHandler for "
+                                 << src << " sensor "
+                                 << m_sensor.get_value_or(-1));
+                return;
             }
-            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
-                    m_sensor.get_value_or(-1));
+            if (ring) {
+                m_ring = ring;
+                m_ringHandlers = m_makeSubscriber();
+                OSVR_DEV_VERBOSE("Constructed a shared memory "
+                                 "TrackerHandler for "
+                                 << src << " sensor "
+                                 << m_sensor.get_value_or(-1));
+                return;
             }
-            if (m_info.reportsLinearAcceleration ||
-                m_info.reportsAngularAcceleration) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
-                    m_sensor.get_value_or(-1));
-            }
-            OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
-                             << src << " sensor " << m_sensor.get_value_or(-1));
+            m_makeRemote();
         }
         virtual ~VRPNTrackerHandler() {
+            if (m_inProcess) {
+                m_inProcess->unsubscribe(m_subscription);
+                return;
+            }
+            if (!m_remote) {
+                return;
+            }
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->unregister_change_handler(this,
                                                     &VRPNTrackerHandler::handle,
@@ -133,148 +152,350 @@ namespace client {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
             self->m_handle(info);
         }
-        virtual void update() { m_remote->mainloop(); }
+        virtual void update() {
+            if (m_remote) {
+                m_remote->mainloop();
+            } else if (m_inProcess) {
+                m_inProcess->deliver(m_subscription);
+            } else if (m_ring) {
+                m_ring->poll(m_ringHandlers);
+                if (!m_ring->isWriterAlive()) {
+                    OSVR_DEV_VERBOSE("Shared memory tracker reports for "
+                                     << m_src
+                                     << " went stale, switching to VRPN");
+                    m_ring.reset();
+                    m_makeRemote();
+                }
+            }
+            m_flushPoses();
+        }
 
       private:
-        /// Pass pose messages on to the client
+        void m_makeRemote() {
+            m_remote.reset(
+                new vrpn_Tracker_Remote(m_src.c_str(), m_conn.get()));
+            if (m_info.reportsPosition || m_info.reportsOrientation) {
+                m_remote->register_change_handler(this,
+                                                  &VRPNTrackerHandler::handle,
+                                                  m_sensor.get_value_or(-1));
+            }
+            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
+                m_remote->register_change_handler(
+                    this, &VRPNTrackerHandler::handleVel,
+                    m_sensor.get_value_or(-1));
+            }
+            if (m_info.reportsLinearAcceleration ||
+                m_info.reportsAngularAcceleration) {
+                m_remote->register_change_handler(
+                    this, &VRPNTrackerHandler::handleAccel,
+                    m_sensor.get_value_or(-1));
+            }
+            OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
+                             << m_src << " sensor "
+                             << m_sensor.get_value_or(-1));
+        }
+
+        /// Handlers for reports sent by a device in this process or through
+        /// shared memory: the same as for its VRPN messages, minus decoding
+        /// them.
+        common::TrackerReportChannel::Subscriber m_makeSubscriber() {
+            common::TrackerReportChannel::Subscriber ret;
+            if (m_info.reportsPosition || m_info.reportsOrientation) {
+                ret.pose = [&](OSVR_TimeValue const &timestamp,
+                               OSVR_ChannelCount sensor,
+                               OSVR_PoseState const &pose) {
+                    if (m_wantsSensor(sensor)) {
+                        m_handlePose(timestamp, sensor, pose);
+                    }
+                };
+            }
+            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
+                ret.velocity = [&](OSVR_TimeValue const &timestamp,
+                                   OSVR_ChannelCount sensor,
+                                   OSVR_VelocityState const &vel) {
+                    if (m_wantsSensor(sensor)) {
+                        m_handleVelocity(timestamp, sensor, vel);
+                    }
+                };
+            }
+            if (m_info.reportsLinearAcceleration ||
+                m_info.reportsAngularAcceleration) {
+                ret.acceleration = [&](OSVR_TimeValue const &timestamp,
+                                       OSVR_ChannelCount sensor,
+                                       OSVR_AccelerationState const &accel) {
+                    if (m_wantsSensor(sensor)) {
+                        m_handleAcceleration(timestamp, sensor, accel);
+                    }
+                };
+            }
+            return ret;
+        }
+
+        /// Same filtering as the sensor argument when registering VRPN
+        /// change handlers.
+        bool m_wantsSensor(OSVR_ChannelCount sensor) const {
+            return !m_sensor || OSVR_ChannelCount(*m_sensor) == sensor;
+        }
+
         void m_handle(vrpn_TRACKERCB const &info) {
-            common::tracing::markNewTrackerData();
-            OSVR_PoseReport report;
-            report.sensor = info.sensor;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            auto xform = getCurrentTransform();
-            ei::map(report.pose) =
-                xform.transform(ei::map(report.pose).matrix());
+            OSVR_Pose3 pose;
+            osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+            osvrVec3FromQuatlib(&(pose.translation), info.pos);
+            m_handlePose(timestamp, info.sensor, pose);
+        }
 
-            if (m_opts.reportPose) {
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
+        /// Collect pose messages: those with the same timestamp (as from a
+        /// skeleton or mocap device, when routed as a whole) are transformed
+        /// together and passed on to the client when a message with a
+        /// different timestamp or type comes in, or at the end of update().
+        void m_handlePose(OSVR_TimeValue const &timestamp, int32_t sensor,
+                          OSVR_Pose3 const &pose) {
+            common::tracing::markNewTrackerData();
+            if (!m_pendingSensors.empty() && timestamp != m_pendingTimestamp) {
+                m_flushPoses();
             }
+            m_pendingTimestamp = timestamp;
+            m_pendingPoses.push_back(pose);
+            m_pendingSensors.push_back(sensor);
+        }
+
+        /// Pass collected pose messages on to the client
+        void m_flushPoses() {
+            if (m_pendingSensors.empty()) {
+                return;
+            }
+            m_pendingPoses.transform(getCurrentTransform());
+
+            auto const &timestamp = m_pendingTimestamp;
+            for (std::size_t i = 0, e = m_pendingSensors.size(); i < e; ++i) {
+                OSVR_PoseReport report;
+                report.sensor = m_pendingSensors[i];
+                m_pendingPoses.get(i, report.pose);
 
-            if (m_opts.reportPosition) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = report.sensor;
                 positionReport.xyz = report.pose.translation;
 
-                m_internals.setStateAndTriggerCallbacks(timestamp,
-                                                        positionReport);
-            }
-
-            if (m_opts.reportOrientation) {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = report.sensor;
                 oriReport.rotation = report.pose.rotation;
 
-                m_internals.setStateAndTriggerCallbacks(timestamp, oriReport);
+                // One pass over the interfaces for all three reports.
+                m_internals.forEachInterface(
+                    [&](common::ClientInterface &iface) {
+                        if (m_opts.reportPose) {
+                            RemoteHandlerInternals::deliver(iface, timestamp,
+                                                            report);
+                        }
+                        if (m_opts.reportPosition) {
+                            RemoteHandlerInternals::deliver(
+                                iface, timestamp, positionReport);
+                        }
+                        if (m_opts.reportOrientation) {
+                            RemoteHandlerInternals::deliver(iface, timestamp,
+                                                            oriReport);
+                        }
+                    });
             }
+            m_pendingPoses.clear();
+            m_pendingSensors.clear();
         }
 
-        /// Pass velocity messages on to the client
         void m_handle(vrpn_TRACKERVELCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
-
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_VelocityState vel;
+            osvrVec3FromQuatlib(&(vel.linearVelocity), info.vel);
+            osvrQuatFromQuatlib(&(vel.angularVelocity.incrementalRotation),
+                                info.vel_quat);
+            vel.angularVelocity.dt = info.vel_quat_dt;
+            m_handleVelocity(timestamp, info.sensor, vel);
+        }
+
+        /// Pass velocity messages on to the client: validity comes from the
+        /// device descriptor, not the message.
+        void m_handleVelocity(OSVR_TimeValue const &timestamp, int32_t sensor,
+                              OSVR_VelocityState const &vel) {
+            // Keep the order of messages.
+            m_flushPoses();
+
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
 
             OSVR_VelocityReport overallReport;
-            overallReport.sensor = info.sensor;
+            overallReport.sensor = sensor;
             auto xform = getCurrentTransform();
 
             overallReport.state.linearVelocityValid =
                 m_info.reportsLinearVelocity;
             if (m_info.reportsLinearVelocity) {
-                OSVR_LinearVelocityState vel;
-                osvrVec3FromQuatlib(&(vel), info.vel);
+                OSVR_LinearVelocityState linVel = vel.linearVelocity;
 
-                ei::map(vel) = xform.transformDerivative(ei::map(vel));
+                ei::map(linVel) = xform.transformDerivative(ei::map(linVel));
 
-                overallReport.state.linearVelocity = vel;
-                OSVR_LinearVelocityReport report;
-                report.sensor = info.sensor;
-                report.state = vel;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
+                overallReport.state.linearVelocity = linVel;
             }
 
             overallReport.state.angularVelocityValid =
                 m_info.reportsAngularVelocity;
             if (m_info.reportsAngularVelocity) {
-                OSVR_AngularVelocityState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.vel_quat);
-                state.dt = info.vel_quat_dt;
+                OSVR_AngularVelocityState state = vel.angularVelocity;
 
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
 
                 overallReport.state.angularVelocity = state;
-                OSVR_AngularVelocityReport report;
-                report.sensor = info.sensor;
-                report.state = state;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
-            m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
+            OSVR_LinearVelocityReport linearReport;
+            linearReport.sensor = sensor;
+            linearReport.state = overallReport.state.linearVelocity;
+            OSVR_AngularVelocityReport angularReport;
+            angularReport.sensor = sensor;
+            angularReport.state = overallReport.state.angularVelocity;
+
+            m_internals.forEachInterface([&](common::ClientInterface &iface) {
+                if (m_info.reportsLinearVelocity) {
+                    RemoteHandlerInternals::deliver(iface, timestamp,
+                                                    linearReport);
+                }
+                if (m_info.reportsAngularVelocity) {
+                    RemoteHandlerInternals::deliver(iface, timestamp,
+                                                    angularReport);
+                }
+                RemoteHandlerInternals::deliver(iface, timestamp,
+                                                overallReport);
+            });
         }
 
-        /// Pass acceleration messages on to the client
         void m_handle(vrpn_TRACKERACCCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_AccelerationState accel;
+            osvrVec3FromQuatlib(&(accel.linearAcceleration), info.acc);
+            osvrQuatFromQuatlib(
+                &(accel.angularAcceleration.incrementalRotation),
+                info.acc_quat);
+            accel.angularAcceleration.dt = info.acc_quat_dt;
+            m_handleAcceleration(timestamp, info.sensor, accel);
+        }
+
+        /// Pass acceleration messages on to the client: validity comes from
+        /// the device descriptor, not the message.
+        void m_handleAcceleration(OSVR_TimeValue const &timestamp,
+                                  int32_t sensor,
+                                  OSVR_AccelerationState const &accel) {
+            // Keep the order of messages.
+            m_flushPoses();
+
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
 
             OSVR_AccelerationReport overallReport;
-            overallReport.sensor = info.sensor;
+            overallReport.sensor = sensor;
 
             auto xform = getCurrentTransform();
 
             overallReport.state.linearAccelerationValid =
                 m_info.reportsLinearAcceleration;
             if (m_info.reportsLinearAcceleration) {
-                OSVR_LinearAccelerationState accel;
-                osvrVec3FromQuatlib(&(accel), info.acc);
+                OSVR_LinearAccelerationState linAccel =
+                    accel.linearAcceleration;
 
-                ei::map(accel) = xform.transformDerivative(ei::map(accel));
+                ei::map(linAccel) =
+                    xform.transformDerivative(ei::map(linAccel));
 
-                overallReport.state.linearAcceleration = accel;
-                OSVR_LinearAccelerationReport report;
-                report.sensor = info.sensor;
-                report.state = accel;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
+                overallReport.state.linearAcceleration = linAccel;
             }
             overallReport.state.angularAccelerationValid =
                 m_info.reportsAngularAcceleration;
             if (m_info.reportsAngularAcceleration) {
 
-                OSVR_AngularAccelerationState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.acc_quat);
-                state.dt = info.acc_quat_dt;
+                OSVR_AngularAccelerationState state =
+                    accel.angularAcceleration;
 
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
 
                 overallReport.state.angularAcceleration = state;
-                OSVR_AngularAccelerationReport report;
-                report.sensor = info.sensor;
-                report.state = state;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
-            m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
+            OSVR_LinearAccelerationReport linearReport;
+            linearReport.sensor = sensor;
+            linearReport.state = overallReport.state.linearAcceleration;
+            OSVR_AngularAccelerationReport angularReport;
+            angularReport.sensor = sensor;
+            angularReport.state = overallReport.state.angularAcceleration;
+
+            m_internals.forEachInterface([&](common::ClientInterface &iface) {
+                if (m_info.reportsLinearAcceleration) {
+                    RemoteHandlerInternals::deliver(iface, timestamp,
+                                                    linearReport);
+                }
+                if (m_info.reportsAngularAcceleration) {
+                    RemoteHandlerInternals::deliver(iface, timestamp,
+                                                    angularReport);
+                }
+                RemoteHandlerInternals::deliver(iface, timestamp,
+                                                overallReport);
+            });
         }
+        /// @name Used to make a VRPN remote, if reports don't come another
+        /// way (or stop doing so)
+        /// @{
+        vrpn_ConnectionPtr m_conn;
+        std::string m_src;
+        /// @}
+        /// Null if reports come in-process or through shared memory instead.
         unique_ptr<vrpn_Tracker_Remote> m_remote;
+        /// @name In-process reports
+        /// @{
+        common::InProcessReportRouterPtr m_router;
+        common::TrackerReportChannelPtr m_inProcess;
+        common::TrackerReportChannel::SubscriptionID m_subscription = 0;
+        /// @}
+        /// @name Reports through shared memory
+        /// @{
+        common::TrackerReportRingPtr m_ring;
+        common::TrackerReportChannel::Subscriber m_ringHandlers;
+        /// @}
         common::Transform m_transform;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
         Options m_opts;
         common::TrackerSensorInfo m_info;
         boost::optional<int> m_sensor;
+
+        /// @name Pose messages collected but not yet passed on
+        /// @{
+        common::PoseBatch m_pendingPoses;
+        std::vector<int32_t> m_pendingSensors;
+        OSVR_TimeValue m_pendingTimestamp;
+        /// @}
     };
 
+    /// Whether a device's server string (host, with optional port) refers to
+    /// this machine.
+    /// @brief The port of a server on this machine, from its "host" or
+    /// "host:port" string, or 0 if it's elsewhere.
+    static int getLocalPort(std::string const &server) {
+        auto colon = server.find(':');
+        auto host = server.substr(0, colon);
+        if (host != "localhost" && host != "127.0.0.1") {
+            return 0;
+        }
+        if (colon == std::string::npos) {
+            return vrpn_DEFAULT_LISTEN_PORT_NO;
+        }
+        try {
+            return boost::lexical_cast<int>(server.substr(colon + 1));
+        } catch (boost::bad_lexical_cast &) {
+            return 0;
+        }
+    }
+
     TrackerRemoteFactory::TrackerRemoteFactory(
         VRPNConnectionCollection const &conns)
         : m_conns(conns) {}
@@ -300,13 +521,28 @@ namespace client {
 
         common::Transform xform{};
         if (source.hasTransform()) {
-            common::JSONTransformVisitor xformParse(source.getTransformJson());
-            xform = xformParse.getTransform();
+            xform = source.getTransform().compose();
+        }
+
+        /// A device on the connection we'd use might be sending in this
+        /// process (as for analysis plugins in the server): if so, skip
+        /// encoding and decoding its reports.
+        auto conn = m_conns.getConnection(devElt);
+        auto router = common::InProcessReportRouter::get(conn.get());
+        auto inProcess = router->getTrackerChannel(devElt.getDeviceName());
+
+        /// Otherwise, a server on this machine shares its reports through
+        /// shared memory.
+        common::TrackerReportRingPtr ring;
+        auto localPort = getLocalPort(devElt.getServer());
+        if (!inProcess->hasPublisher() && localPort != 0) {
+            ring = common::TrackerReportRing::find(devElt.getDeviceName(),
+                                                   localPort);
         }
 
         /// @todo find out why make_shared causes a crash here
         ret.reset(new VRPNTrackerHandler(
-            m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
+            conn, devElt.getFullDeviceName().c_str(), router, inProcess, ring,
             opts, info, xform, source.getSensorNumber(), ifaces, ctx));
         return ret;
     }
@@ -0,0 +1,138 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TreeCache.h"
+#include <osvr/Common/JSONHelpers.h>
+#include <osvr/Util/GetEnvironmentVariable.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#ifdef OSVR_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+// Standard includes
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace osvr {
+namespace client {
+    /// Bump if the format of the cache file changes.
+    static const int CACHE_FORMAT = 1;
+
+    std::string getTreeCacheFilePath(std::string const &host) {
+        auto dir = util::getEnvironmentVariable("OSVR_CLIENT_TREE_CACHE");
+        if (!dir || dir->empty() || *dir == "0") {
+            return std::string();
+        }
+        // One file per host: keep only characters safe in a file name.
+        std::string name = "ClientTree-";
+        for (char c : host) {
+            auto uc = static_cast<unsigned char>(c);
+            name.push_back((std::isalnum(uc) || c == '-' || c == '.') ? c
+                                                                      : '_');
+        }
+        name += ".json";
+        auto ret = *dir;
+        auto last = ret.back();
+        if (last != '/' && last != '\\') {
+            ret.push_back('/');
+        }
+        return ret + name;
+    }
+
+    bool loadCachedTree(std::string const &filename, Json::Value &nodes,
+                        std::string &version) {
+        std::ifstream file(filename);
+        if (!file) {
+            return false;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        auto root = common::jsonParse(contents.str());
+        if (!root.isObject() || root["format"] != CACHE_FORMAT ||
+            !root["version"].isString() || !root["nodes"].isArray()) {
+            return false;
+        }
+        version = root["version"].asString();
+        nodes = root["nodes"];
+        return true;
+    }
+
+    static inline long getProcessId() {
+#ifdef OSVR_WINDOWS
+        return static_cast<long>(_getpid());
+#else
+        return static_cast<long>(getpid());
+#endif
+    }
+
+    /// @brief Renames a file over another in one step, so readers see either
+    /// the old file or the new one, never neither.
+    static inline bool replaceFile(std::string const &from,
+                                   std::string const &to) {
+#ifdef OSVR_WINDOWS
+        return MoveFileExA(from.c_str(), to.c_str(),
+                           MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    bool saveCachedTree(std::string const &filename, Json::Value const &nodes,
+                        std::string const &version) {
+        Json::Value root(Json::objectValue);
+        root["format"] = CACHE_FORMAT;
+        root["version"] = version;
+        root["nodes"] = nodes;
+        // Write a temporary file, named for this process so concurrently
+        // starting clients don't share it, and rename it into place, so they
+        // never see a partial file.
+        std::ostringstream os;
+        os << filename << "." << getProcessId() << ".tmp";
+        auto tempName = os.str();
+        bool written = false;
+        {
+            std::ofstream file(tempName, std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            file << common::jsonToCompactString(root);
+            written = bool(file);
+        }
+        if (written && replaceFile(tempName, filename)) {
+            return true;
+        }
+        std::remove(tempName.c_str());
+        return false;
+    }
+} // namespace client
+} // namespace osvr
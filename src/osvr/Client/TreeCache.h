@@ -0,0 +1,62 @@
+/** @file
+    @brief Header
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TreeCache_h_GUID_E977B5B8_0F1F_4EE7_ACDD_877D50728955
+#define INCLUDED_TreeCache_h_GUID_E977B5B8_0F1F_4EE7_ACDD_877D50728955
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <json/value.h>
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace client {
+    /// @brief Gets the file to cache the path tree from the given host in, or
+    /// an empty string if tree caching is disabled.
+    ///
+    /// Caching is enabled by setting the environment variable
+    /// OSVR_CLIENT_TREE_CACHE to a directory to store the cached trees in.
+    std::string getTreeCacheFilePath(std::string const &host);
+
+    /// @brief Loads a cached path tree (as serialized nodes, as received from
+    /// the server) and its version.
+    ///
+    /// @return false if there is no usable cache in the file.
+    bool loadCachedTree(std::string const &filename, Json::Value &nodes,
+                        std::string &version);
+
+    /// @brief Writes a path tree and its version to a cache file, replacing
+    /// its contents.
+    ///
+    /// @return false if the file could not be written.
+    bool saveCachedTree(std::string const &filename, Json::Value const &nodes,
+                        std::string const &version);
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_TreeCache_h_GUID_E977B5B8_0F1F_4EE7_ACDD_877D50728955
@@ -26,6 +26,7 @@
 #include <osvr/Client/Viewer.h>
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/InterfaceStateSnapshot.h>
 
 // Library/third-party includes
 // - none
@@ -39,13 +40,14 @@ namespace client {
         : m_head(ctx, path) {}
 
     OSVR_Pose3 Viewer::getPose() const {
-        OSVR_TimeValue timestamp;
-        OSVR_Pose3 pose;
-        bool hasState = m_head->getState<OSVR_PoseReport>(timestamp, pose);
+        common::StateSnapshotEntry<OSVR_PoseReport> entry;
+        bool hasState =
+            common::InterfaceStateSnapshot::getEntry<OSVR_PoseReport>(
+                *m_head, entry);
         if (!hasState) {
             throw NoPoseYet();
         }
-        return pose;
+        return entry.state;
     }
 
     bool Viewer::hasPose() const {
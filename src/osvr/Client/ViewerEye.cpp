@@ -38,18 +38,30 @@
 
 namespace osvr {
 namespace client {
-    Eigen::Isometry3d ViewerEye::getPoseIsometry() const {
-        OSVR_TimeValue timestamp;
-        OSVR_Pose3 pose;
-        bool hasState = m_pose->getState<OSVR_PoseReport>(timestamp, pose);
-        if (!hasState) {
+    void ViewerEye::m_updatePoseCache() const {
+        if (!m_pose->hasStateForReportType<OSVR_PoseReport>()) {
             throw NoPoseYet();
         }
+        auto updateCount = m_pose->getStateUpdateCount();
+        if (m_poseCacheValid && updateCount == m_poseCacheUpdateCount) {
+            return;
+        }
+        OSVR_TimeValue timestamp;
+        OSVR_Pose3 pose;
+        m_pose->getState<OSVR_PoseReport>(timestamp, pose);
         Eigen::Isometry3d transformedPose =
             util::fromPose(pose) * Eigen::Translation3d(m_offset) *
             Eigen::AngleAxisd(util::getRadians(m_opticalAxisOffsetY),
                               Eigen::Vector3d::UnitY());
-        return transformedPose;
+        m_poseCache = transformedPose.matrix();
+        m_viewCache = transformedPose.inverse().matrix();
+        m_poseCacheUpdateCount = updateCount;
+        m_poseCacheValid = true;
+    }
+
+    Eigen::Isometry3d ViewerEye::getPoseIsometry() const {
+        m_updatePoseCache();
+        return Eigen::Isometry3d(Eigen::Matrix4d(m_poseCache));
     }
     OSVR_Pose3 ViewerEye::getPose() const {
         Eigen::Isometry3d transformedPose = getPoseIsometry();
@@ -63,8 +75,8 @@ namespace client {
     }
 
     Eigen::Matrix4d ViewerEye::getView() const {
-        Eigen::Isometry3d transformedPose = getPoseIsometry();
-        return transformedPose.inverse().matrix();
+        m_updatePoseCache();
+        return m_viewCache;
     }
 
     util::Rectd ViewerEye::m_getRect(double near, double /*far*/ = 100) const {
@@ -129,6 +141,29 @@ namespace client {
     Eigen::Matrix4d
     ViewerEye::getProjection(double near, double far,
                              OSVR_MatrixConventions flags) const {
+        for (std::size_t i = 0; i < m_projectionCacheCount; ++i) {
+            auto const &entry = m_projectionCache[i];
+            if (entry.near == near && entry.far == far &&
+                entry.flags == flags) {
+                return entry.projection;
+            }
+        }
+        auto &entry = m_projectionCache[m_projectionCacheNext];
+        entry.near = near;
+        entry.far = far;
+        entry.flags = flags;
+        entry.projection = m_computeProjection(near, far, flags);
+        m_projectionCacheNext =
+            (m_projectionCacheNext + 1) % PROJECTION_CACHE_SIZE;
+        if (m_projectionCacheCount < PROJECTION_CACHE_SIZE) {
+            ++m_projectionCacheCount;
+        }
+        return entry.projection;
+    }
+
+    Eigen::Matrix4d
+    ViewerEye::m_computeProjection(double near, double far,
+                                   OSVR_MatrixConventions flags) const {
         using C = osvr::util::detail::CompactMatrixConventions;
         using F = osvr::util::detail::CompactMatrixFlags;
         namespace opts = osvr::util::projection_options;
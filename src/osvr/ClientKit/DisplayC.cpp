@@ -265,6 +265,67 @@ OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     return getViewMatrixImpl(disp, viewer, eye, mat, flags);
 }
 
+template <typename Scalar>
+static inline OSVR_ReturnCode getViewProjectionMatricesImpl(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, Scalar near, Scalar far,
+    OSVR_MatrixConventions flags, OSVR_EyeCount numEyes, Scalar *views,
+    Scalar *projections) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_VIEWER_ID;
+    OSVR_VALIDATE_OUTPUT_PTR(views, "view matrices");
+    OSVR_VALIDATE_OUTPUT_PTR(projections, "projection matrices");
+    if (numEyes != disp->cfg->getNumViewerEyes(viewer)) {
+        OSVR_DEV_VERBOSE("Passed the wrong number of eyes for the viewer!");
+        return OSVR_RETURN_FAILURE;
+    }
+    if (near <= 0 || far <= 0 || near == far) {
+        OSVR_DEV_VERBOSE("Near and far distances must be positive and "
+                         "different!");
+        return OSVR_RETURN_FAILURE;
+    }
+    auto const &eyes = disp->cfg->getViewer(viewer);
+    // Check first, to leave the outputs unmodified on failure.
+    for (auto const &eye : eyes) {
+        if (!eye.hasPose()) {
+            OSVR_DEV_VERBOSE("Error getting viewer eye matrices: no pose yet "
+                             "available");
+            return OSVR_RETURN_FAILURE;
+        }
+    }
+    try {
+        for (auto const &eye : eyes) {
+            osvr::util::matrixEigenAssign(eye.getView(), flags, views);
+            osvr::util::matrixEigenAssign(eye.getProjection(near, far, flags),
+                                          flags, projections);
+            views += OSVR_MATRIX_SIZE;
+            projections += OSVR_MATRIX_SIZE;
+        }
+    } catch (std::exception &e) {
+        OSVR_DEV_VERBOSE(
+            "Error getting viewer eye matrices - exception: " << e.what());
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeViewProjectionMatricesd(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, double near, double far,
+    OSVR_MatrixConventions flags, OSVR_EyeCount numEyes, double *viewMatrices,
+    double *projectionMatrices) {
+    return getViewProjectionMatricesImpl(disp, viewer, near, far, flags,
+                                         numEyes, viewMatrices,
+                                         projectionMatrices);
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeViewProjectionMatricesf(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, float near, float far,
+    OSVR_MatrixConventions flags, OSVR_EyeCount numEyes, float *viewMatrices,
+    float *projectionMatrices) {
+    return getViewProjectionMatricesImpl(disp, viewer, near, far, flags,
+                                         numEyes, viewMatrices,
+                                         projectionMatrices);
+}
+
 OSVR_ReturnCode
 osvrClientGetNumSurfacesForViewerEye(OSVR_DisplayConfig disp,
                                      OSVR_ViewerCount viewer, OSVR_EyeCount eye,
@@ -24,7 +24,10 @@
 
 // Internal Includes
 #include <osvr/ClientKit/ImagingC.h>
+#include <osvr/Common/BorrowedImage.h>
 #include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 // - none
@@ -37,3 +40,59 @@ OSVR_ReturnCode osvrClientFreeImage(OSVR_ClientContext ctx,
     auto ret = ctx->releaseObject(buf);
     return (ret ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE);
 }
+
+OSVR_ReturnCode osvrClientSetImageBorrowing(OSVR_ClientContext ctx,
+                                            OSVR_CBool borrowing) {
+    if (nullptr == ctx) {
+        OSVR_DEV_VERBOSE("Passed a null client context!");
+        return OSVR_RETURN_FAILURE;
+    }
+    ctx->setImageBorrowing(borrowing == OSVR_TRUE);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientCopyImage(OSVR_ClientContext ctx,
+                                    OSVR_ImageBufferElement *buf,
+                                    OSVR_ImageBufferElement **copy) {
+    if (nullptr == ctx || nullptr == copy) {
+        OSVR_DEV_VERBOSE("Passed a null client context or output pointer!");
+        return OSVR_RETURN_FAILURE;
+    }
+    *copy = nullptr;
+    // Already owned by the app: just share it. Checked first, since an
+    // older lent frame may still be held at the same address.
+    auto owned = ctx->findObject<osvr::common::ImageBufferPtr>(buf);
+    if (owned) {
+        auto ret = *owned;
+        *copy = ret.get();
+        ctx->acquireObject(ret);
+        return OSVR_RETURN_SUCCESS;
+    }
+    auto borrowed = ctx->findObject<osvr::common::BorrowedImagePtr>(buf);
+    if (!borrowed) {
+        OSVR_DEV_VERBOSE("Image buffer not found: already freed?");
+        return OSVR_RETURN_FAILURE;
+    }
+    auto ret = osvr::common::copyBorrowedImage(**borrowed);
+    if (!ret) {
+        OSVR_DEV_VERBOSE("Lent frame was already written over!");
+        return OSVR_RETURN_FAILURE;
+    }
+    *copy = ret.get();
+    ctx->acquireObject(ret);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientSetImagingDecimation(OSVR_ClientContext ctx,
+                                               uint32_t decimation) {
+    if (nullptr == ctx) {
+        OSVR_DEV_VERBOSE("Passed a null client context!");
+        return OSVR_RETURN_FAILURE;
+    }
+    if (0 == decimation) {
+        OSVR_DEV_VERBOSE("Imaging decimation must be at least 1!");
+        return OSVR_RETURN_FAILURE;
+    }
+    ctx->setImagingDecimation(decimation);
+    return OSVR_RETURN_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/ClientKit/StateSnapshotC.h>
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/InterfaceStateSnapshot.h>
+#include <osvr/Util/MacroToolsC.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+struct OSVR_StateSnapshotObject {
+    explicit OSVR_StateSnapshotObject(OSVR_ClientContext context)
+        : ctx(context), snapshot(*context) {}
+    OSVR_ClientContext ctx;
+    /// Shared ownership of the interfaces, so a snapshot never refers to a
+    /// freed one.
+    std::vector<osvr::common::ClientInterfacePtr> interfaces;
+    osvr::common::InterfaceStateSnapshot snapshot;
+};
+
+#define OSVR_VALIDATE_OUTPUT_PTR(X, DESC)                                      \
+    OSVR_UTIL_MULTILINE_BEGIN                                                  \
+    if (nullptr == X) {                                                        \
+        OSVR_DEV_VERBOSE("Passed a null pointer for output parameter " #X      \
+                         ", " DESC "!");                                       \
+        return OSVR_RETURN_FAILURE;                                            \
+    }                                                                          \
+    OSVR_UTIL_MULTILINE_END
+
+#define OSVR_VALIDATE_STATE_SNAPSHOT                                           \
+    OSVR_UTIL_MULTILINE_BEGIN                                                  \
+    if (nullptr == snapshot) {                                                 \
+        OSVR_DEV_VERBOSE("Passed a null state snapshot!");                     \
+        return OSVR_RETURN_FAILURE;                                            \
+    }                                                                          \
+    OSVR_UTIL_MULTILINE_END
+
+OSVR_ReturnCode
+osvrClientCreateStateSnapshot(OSVR_ClientContext ctx,
+                              OSVR_ClientInterface const *ifaces,
+                              uint32_t numInterfaces,
+                              OSVR_StateSnapshot *snapshot) {
+    OSVR_VALIDATE_OUTPUT_PTR(snapshot, "state snapshot");
+    *snapshot = nullptr;
+    if (nullptr == ctx) {
+        OSVR_DEV_VERBOSE("Passed a null client context!");
+        return OSVR_RETURN_FAILURE;
+    }
+    if (nullptr == ifaces && numInterfaces > 0) {
+        OSVR_DEV_VERBOSE("Passed a null interface array!");
+        return OSVR_RETURN_FAILURE;
+    }
+    auto ret = std::make_shared<OSVR_StateSnapshotObject>(ctx);
+    ret->interfaces.reserve(numInterfaces);
+    ret->snapshot.reserve(numInterfaces);
+    auto const &owned = ctx->getInterfaces();
+    for (uint32_t i = 0; i < numInterfaces; ++i) {
+        auto it = std::find_if(
+            begin(owned), end(owned),
+            [&](osvr::common::ClientInterfacePtr const &iface) {
+                return iface.get() == ifaces[i];
+            });
+        if (it == end(owned)) {
+            OSVR_DEV_VERBOSE("Interface " << i
+                                          << " is not from this context!");
+            return OSVR_RETURN_FAILURE;
+        }
+        ret->interfaces.push_back(*it);
+        ret->snapshot.push_back(**it);
+    }
+    ctx->acquireObject(ret);
+    *snapshot = ret.get();
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetPoseSnapshot(OSVR_StateSnapshot snapshot,
+                                          OSVR_PoseSnapshotEntry *entries,
+                                          uint32_t numEntries,
+                                          uint64_t *updateCount) {
+    OSVR_VALIDATE_STATE_SNAPSHOT;
+    OSVR_VALIDATE_OUTPUT_PTR(entries, "snapshot entries");
+    if (numEntries != snapshot->snapshot.size()) {
+        OSVR_DEV_VERBOSE("Passed " << numEntries << " entries for a snapshot "
+                                   << "of " << snapshot->snapshot.size()
+                                   << " interfaces!");
+        return OSVR_RETURN_FAILURE;
+    }
+    auto count = snapshot->snapshot.get<OSVR_PoseReport>(entries);
+    if (updateCount) {
+        *updateCount = count;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientFreeStateSnapshot(OSVR_StateSnapshot snapshot) {
+    OSVR_VALIDATE_STATE_SNAPSHOT;
+    OSVR_ClientContext ctx = snapshot->ctx;
+    BOOST_ASSERT_MSG(
+        ctx != nullptr,
+        "Should never get a state snapshot object with a null context in it.");
+    if (nullptr == ctx) {
+        return OSVR_RETURN_FAILURE;
+    }
+    auto freed = ctx->releaseObject(snapshot);
+    return freed ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
@@ -28,12 +28,13 @@
 #include <osvr/Common/PathNode.h>
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Util/Flag.h>
-#include <osvr/Util/TreeTraversalVisitor.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/ParseAlias.h>
 #include <osvr/Common/RoutingKeys.h>
+#include <osvr/Common/WildcardAliases.h>
 
 #include "PathParseAndRetrieve.h"
+#include "VisitWildcardMatches.h"
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -41,7 +42,8 @@
 #include <boost/algorithm/string/erase.hpp>
 
 // Standard includes
-// - none
+#include <utility>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -51,30 +53,33 @@ namespace common {
         static const size_t WILDCARD_SUFFIX_LEN = sizeof(WILDCARD_SUFFIX) - 1;
 
         /// @brief Handles wildcards with a functor of your choice: it should
-        /// take in a PathNode& node, std::string const& relPath
-        /// where relPath is relative to the parent of the wildcard.
+        /// take in a std::string const& relPath, where relPath is relative to
+        /// the parent of the wildcard, and a std::string const& fullPath of
+        /// the matched node.
+        ///
+        /// @return the absolute path of the parent of the wildcard.
         template <typename T>
-        inline void applyWildcard(PathNode &node,
-                                  std::string const &pathWithWildcard,
-                                  T functor) {
+        inline std::string applyWildcard(PathNode &node,
+                                         std::string const &pathWithWildcard,
+                                         T functor) {
             auto startingPath = pathWithWildcard;
             boost::algorithm::erase_tail(startingPath, WILDCARD_SUFFIX_LEN);
             auto &startingNode = treePathRetrieve(node, startingPath);
             auto absoluteStartingPath = getFullPath(startingNode);
-            auto absoluteStartingPathLen = absoluteStartingPath.length();
-            util::traverseWith(startingNode, [&](PathNode &node) {
-                // Don't visit null nodes
-                if (elements::isNull(node.value())) {
-                    return;
-                }
-                auto visitPath = getFullPath(node);
-                /// This is relative to the initial starting path stem: where we
-                /// started the traversal.
-                auto relPath = visitPath;
-                boost::algorithm::erase_head(relPath,
-                                             absoluteStartingPathLen + 1);
-                functor(node, relPath);
-            });
+
+            // Collect the matches first: the functor may add nodes to the
+            // subtree we're visiting.
+            std::vector<std::pair<std::string, std::string>> matches;
+            auto collect = [&](PathNode &, std::string const &relPath,
+                               std::string const &fullPath) {
+                matches.emplace_back(relPath, fullPath);
+            };
+            detail::visitWildcardMatches(startingNode, absoluteStartingPath,
+                                         std::string(), collect);
+            for (auto const &match : matches) {
+                functor(match.first, match.second);
+            }
+            return absoluteStartingPath;
         }
 
         /// @brief Predicate that checks if this path contains a wildcard.
@@ -163,23 +168,32 @@ namespace common {
                         << parsedSource.getAlias());
                 }
 
+                auto const aliasTemplate = parsedSource.getAlias();
+                std::string stem;
                 if (parsedSource.isSimple()) {
-                    applyWildcard(
+                    stem = applyWildcard(
                         m_devNode, leaf,
-                        [&](PathNode &node, std::string const &relPath) {
+                        [&](std::string const &relPath,
+                            std::string const &fullPath) {
                             m_processSingleEntry(path + getPathSeparator() +
                                                      relPath,
-                                                 getFullPath(node), priority);
+                                                 fullPath, priority);
+                        });
+                } else {
+                    stem = applyWildcard(
+                        m_devNode, leaf, [&](std::string const &relPath,
+                                             std::string const &fullPath) {
+                            parsedSource.setLeaf(fullPath);
+                            m_processSingleEntry(
+                                path + getPathSeparator() + relPath,
+                                parsedSource.getAlias(), priority);
                         });
-                    return;
                 }
 
-                applyWildcard(m_devNode, leaf, [&](PathNode &node,
-                                                   std::string const &relPath) {
-                    parsedSource.setLeaf(getFullPath(node));
-                    m_processSingleEntry(path + getPathSeparator() + relPath,
-                                         parsedSource.getAlias(), priority);
-                });
+                if (m_opts.wildcardRecord && isPathAbsolute(path)) {
+                    m_opts.wildcardRecord->add(
+                        WildcardAlias{stem, path, aliasTemplate, priority});
+                }
             }
 
             /// @brief Called for each individual alias path to be processed for
@@ -0,0 +1,88 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/BorrowedImage.h>
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ImageBufferPool.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    namespace {
+        ImageBufferPtr copyImage(OSVR_ImagingMetadata const &metadata,
+                                 IPCRingBuffer::pointer_to_const_type src) {
+            auto bytes = getImageBufferSize(metadata);
+            auto ret = makePooledImageBuffer(bytes);
+            std::memcpy(ret.get(), src, bytes);
+            return ret;
+        }
+    } // namespace
+
+    ImageBufferPtr copyBorrowedImage(BorrowedImage const &image) {
+        if (image.locked) {
+            // Already locked for callbacks: locking again could deadlock
+            // with a waiting writer.
+            return copyImage(image.metadata, image.locked.get());
+        }
+        if (!image.shm) {
+            return ImageBufferPtr();
+        }
+        auto frame = image.shm->get(image.seqNum);
+        if (!frame) {
+            // Written over since.
+            return ImageBufferPtr();
+        }
+        return copyImage(image.metadata, frame.get());
+    }
+
+    void acquireImage(ClientContext &ctx, ImageData const &data,
+                      std::size_t n, BorrowedImagePtr &borrowed) {
+        void *key = data.buffer.get();
+        bool lend = data.shm && ctx.getImageBorrowing();
+        if (lend) {
+            auto lent = ctx.findObject<BorrowedImagePtr>(key);
+            lend = !lent || (*lent)->seqNum == data.seqNum;
+        }
+        if (!lend) {
+            for (std::size_t i = 0; i < n; ++i) {
+                ctx.acquireObject(data.buffer);
+            }
+            return;
+        }
+        if (!borrowed) {
+            borrowed = make_shared<BorrowedImage>(BorrowedImage{
+                data.metadata, data.shm, data.seqNum, data.buffer});
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            ctx.acquireObject(key, borrowed);
+        }
+    }
+} // namespace common
+} // namespace osvr
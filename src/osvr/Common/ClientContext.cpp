@@ -89,6 +89,7 @@ void OSVR_ClientContextObject::update() {
     for (auto const &iface : m_interfaces) {
         iface->update();
     }
+    ++m_updateCount;
 }
 
 ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
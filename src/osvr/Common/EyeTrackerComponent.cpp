@@ -27,7 +27,7 @@
 #include <osvr/Common/EyeTrackerComponent.h>
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Serialization.h>
-#include <osvr/Common/Buffer.h>
+#include <osvr/Common/StackBuffer.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -74,7 +74,7 @@ namespace common {
     EyeTrackerComponent::sendNotification(OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        StackBuffer<> buf;
         OSVR_EyeNotification notification;
         notification.sensor = sensor;
         messages::EyeRegion::MessageSerialization msg(notification);
@@ -25,11 +25,14 @@
 // Internal Includes
 #include <osvr/Common/GeneralizedTransform.h>
 #include <osvr/Common/RoutingKeys.h>
+#include <osvr/Common/TransformLevel.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
+#include <exception>
+#include <stdexcept>
 #include <utility>
 
 namespace osvr {
@@ -57,6 +60,7 @@ namespace common {
         Json::Value newLayer{transform};
         if (newLayer.isObject()) {
             container().insert(begin(), newLayer);
+            composeLevel(container().front(), false);
         }
     }
 
@@ -68,11 +72,58 @@ namespace common {
         return recompose(leaf.empty() ? Json::nullValue : Json::Value(leaf));
     }
 
+    Transform GeneralizedTransform::compose() const {
+        if (!m_error.empty()) {
+            throw std::runtime_error(m_error);
+        }
+        return Transform(m_pre, m_post);
+    }
+
     void GeneralizedTransform::pushLevelBack(Json::Value level) {
         if (level.isMember(routing_keys::child())) {
             level.removeMember(routing_keys::child());
         }
         container().emplace_back(std::move(level));
+        composeLevel(container().back(), true);
+    }
+
+    void GeneralizedTransform::composeLevel(Json::Value const &level,
+                                            bool inner) {
+        TransformLevel parsed;
+        try {
+            parsed = TransformLevel::parse(level);
+        } catch (std::exception &e) {
+            // Report it when the transform is actually used, like parsing
+            // the JSON at that point would.
+            if (m_error.empty()) {
+                m_error = e.what();
+            }
+            return;
+        }
+        if (parsed.isIdentity()) {
+            return;
+        }
+        if (inner) {
+            // Everything composed so far wraps around this new level.
+            Transform xform = parsed.get();
+            xform.transform(Transform(m_pre, m_post));
+            m_pre = xform.getPre();
+            m_post = xform.getPost();
+        } else {
+            Transform xform(m_pre, m_post);
+            parsed.applyTo(xform);
+            m_pre = xform.getPre();
+            m_post = xform.getPost();
+        }
+    }
+
+    void GeneralizedTransform::recomposeTransform() {
+        m_pre = Matrix::Identity();
+        m_post = Matrix::Identity();
+        m_error.clear();
+        for (auto const &level : container()) {
+            composeLevel(level, true);
+        }
     }
     namespace {
         template <typename Container> class ReverseFacade {
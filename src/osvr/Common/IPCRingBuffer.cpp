@@ -189,7 +189,9 @@ namespace common {
                     Base::m_shm.reset(new ManagedMemory(
                         bip::open_only, opts.getName().c_str()));
                 } catch (bip::interprocess_exception &e) {
-                    getIPCRingBufferLogger().error()
+                    // Not necessarily an error: callers may be probing for
+                    // a segment that's only there for local clients.
+                    getIPCRingBufferLogger().debug()
                         << "Failed to open shared memory segment "
                         << opts.getName() << " with exception: " << e.what();
                     return;
@@ -0,0 +1,99 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageBufferPool.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace {
+        /// @brief Aligned image buffers, kept by size when released for
+        /// reuse.
+        class ImageBufferPool
+            : public enable_shared_from_this<ImageBufferPool> {
+          public:
+            /// @brief Buffers kept per size: enough for an app holding a few
+            /// frames at a time.
+            static const std::size_t MAX_FREE_PER_SIZE = 4;
+
+            ImageBufferPtr get(std::size_t bytes) {
+                util::AlignedImageBufferPtr buf;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto &free = m_free[bytes];
+                    if (!free.empty()) {
+                        buf = std::move(free.back());
+                        free.pop_back();
+                    }
+                }
+                if (!buf) {
+                    buf = util::makeAlignedImageBuffer(bytes);
+                }
+                // Released buffers may outlive the pool: then they are just
+                // freed.
+                weak_ptr<ImageBufferPool> weakPool = shared_from_this();
+                return ImageBufferPtr(
+                    buf.release(),
+                    [weakPool, bytes](OSVR_ImageBufferElement *ptr) {
+                        util::AlignedImageBufferPtr owned(ptr);
+                        auto pool = weakPool.lock();
+                        if (pool) {
+                            pool->m_return(bytes, std::move(owned));
+                        }
+                    });
+            }
+
+          private:
+            void m_return(std::size_t bytes,
+                          util::AlignedImageBufferPtr &&buf) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto &free = m_free[bytes];
+                if (free.size() < MAX_FREE_PER_SIZE) {
+                    free.push_back(std::move(buf));
+                }
+            }
+            std::mutex m_mutex;
+            std::unordered_map<std::size_t,
+                               std::vector<util::AlignedImageBufferPtr>>
+                m_free;
+        };
+    } // namespace
+
+    ImageBufferPtr makePooledImageBuffer(std::size_t bytes) {
+        static auto pool = make_shared<ImageBufferPool>();
+        return pool->get(bytes);
+    }
+} // namespace common
+} // namespace osvr
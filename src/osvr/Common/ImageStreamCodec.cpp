@@ -0,0 +1,155 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageStreamCodec.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    /// Control bytes: below this, a literal run of (control + 1) bytes
+    /// follows; otherwise, the next byte repeats (control - REPEAT_BIAS)
+    /// times.
+    static const uint8_t MIN_REPEAT_CONTROL = 128;
+    static const std::size_t REPEAT_BIAS = 125;
+    static const std::size_t MIN_REPEAT = 3;
+    static const std::size_t MAX_REPEAT = 255 - REPEAT_BIAS;
+    static const std::size_t MAX_LITERAL = MIN_REPEAT_CONTROL;
+
+    void encodeDeltaRLE(uint8_t const *src, std::size_t len,
+                        std::size_t pixelStride, std::vector<uint8_t> &out) {
+        auto delta = [&](std::size_t i) -> uint8_t {
+            return i < pixelStride ? src[i]
+                                   : uint8_t(src[i] - src[i - pixelStride]);
+        };
+        std::size_t literalStart = 0;
+        std::size_t literalLen = 0;
+        auto flushLiterals = [&] {
+            while (literalLen > 0) {
+                auto n = std::min(literalLen, MAX_LITERAL);
+                out.push_back(uint8_t(n - 1));
+                for (std::size_t i = 0; i < n; ++i) {
+                    out.push_back(delta(literalStart + i));
+                }
+                literalStart += n;
+                literalLen -= n;
+            }
+        };
+
+        std::size_t i = 0;
+        while (i < len) {
+            auto value = delta(i);
+            std::size_t run = 1;
+            while (i + run < len && run < MAX_REPEAT &&
+                   delta(i + run) == value) {
+                ++run;
+            }
+            if (run >= MIN_REPEAT) {
+                flushLiterals();
+                out.push_back(uint8_t(run + REPEAT_BIAS));
+                out.push_back(value);
+                i += run;
+                literalStart = i;
+            } else {
+                literalLen += run;
+                i += run;
+            }
+        }
+        flushLiterals();
+    }
+
+    bool decodeDeltaRLE(uint8_t const *src, std::size_t len,
+                        std::size_t pixelStride, uint8_t *dest,
+                        std::size_t destLen) {
+        std::size_t in = 0;
+        std::size_t out = 0;
+        while (in < len) {
+            auto control = src[in++];
+            if (control < MIN_REPEAT_CONTROL) {
+                std::size_t n = control + 1u;
+                if (in + n > len || out + n > destLen) {
+                    return false;
+                }
+                std::memcpy(dest + out, src + in, n);
+                in += n;
+                out += n;
+            } else {
+                std::size_t n = control - REPEAT_BIAS;
+                if (in >= len || out + n > destLen) {
+                    return false;
+                }
+                std::memset(dest + out, src[in++], n);
+                out += n;
+            }
+        }
+        if (out != destLen) {
+            return false;
+        }
+        for (std::size_t i = pixelStride; i < destLen; ++i) {
+            dest[i] = uint8_t(dest[i] + dest[i - pixelStride]);
+        }
+        return true;
+    }
+
+    bool isImageChunkValid(ImageChunkHeader const &header,
+                           std::size_t payloadLen) {
+        if (header.sensor > MAX_IMAGE_CHUNK_SENSOR ||
+            header.length > payloadLen) {
+            return false;
+        }
+        auto const &meta = header.metadata;
+        auto bytes = uint64_t(meta.height) * meta.width * meta.depth *
+                     meta.channels;
+        if (0 == bytes || bytes > MAX_IMAGE_CHUNK_FRAME_SIZE) {
+            return false;
+        }
+        switch (header.encoding) {
+        case ImageEncoding::Raw:
+            if (header.encodedSize != bytes) {
+                return false;
+            }
+            break;
+        case ImageEncoding::DeltaRLE:
+            /// Only sent when it actually shrinks the frame.
+            if (0 == header.encodedSize || header.encodedSize >= bytes) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+        return header.chunkCount > 0 &&
+               header.chunkCount <= header.encodedSize &&
+               header.chunkIndex < header.chunkCount &&
+               header.offset <= header.encodedSize &&
+               header.length <= header.encodedSize - header.offset;
+    }
+} // namespace common
+} // namespace osvr
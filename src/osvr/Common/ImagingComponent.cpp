@@ -26,7 +26,8 @@
 #include <osvr/Common/ImagingComponent.h>
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Serialization.h>
-#include <osvr/Common/Buffer.h>
+#include <osvr/Common/StackBuffer.h>
+#include <osvr/Common/ImageBufferPool.h>
 #include <osvr/Util/AlignedMemoryUniquePtr.h>
 #include <osvr/Util/Flag.h>
 #include <osvr/Util/Verbosity.h>
@@ -35,7 +36,10 @@
 // - none
 
 // Standard includes
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
 namespace osvr {
@@ -193,8 +197,67 @@ namespace common {
         const char *ImagePlacedInSharedMemory::identifier() {
             return "com.osvr.imaging.imageplacedinsharedmemory";
         }
+
+        namespace {
+            template <typename T>
+            void process(ImageChunkHeader &header, T &p) {
+                process(header.metadata, p);
+                p(header.sensor);
+                p(header.frameNumber);
+                p(header.chunkIndex);
+                p(header.chunkCount);
+                p(header.encoding,
+                  serialization::EnumAsIntegerTag<ImageEncoding, uint8_t>());
+                p(header.encodedSize);
+                p(header.offset);
+                p(header.length);
+            }
+        } // namespace
+
+        class ImageChunk::MessageSerialization {
+          public:
+            MessageSerialization() {}
+            explicit MessageSerialization(ImageChunkHeader const &header)
+                : m_header(header) {}
+
+            template <typename T> void processMessage(T &p) {
+                process(m_header, p);
+            }
+
+            ImageChunkHeader const &getHeader() const { return m_header; }
+
+          private:
+            ImageChunkHeader m_header;
+        };
+
+        const char *ImageChunk::identifier() {
+            return "com.osvr.imaging.imagechunk";
+        }
+
+        class ImagingNetworkRequest::MessageSerialization {
+          public:
+            explicit MessageSerialization(uint32_t decimation = 1)
+                : m_decimation(decimation) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_decimation);
+            }
+
+            uint32_t getDecimation() const { return m_decimation; }
+
+          private:
+            uint32_t m_decimation;
+        };
+
+        const char *ImagingNetworkRequest::identifier() {
+            return "com.osvr.imaging.networkrequest";
+        }
     } // namespace messages
 
+    /// @brief Bytes of frame in each imageChunk message: half of the VRPN TCP
+    /// buffer, so a chunk and its header always fit.
+    static const uint32_t IMAGE_CHUNK_SIZE = vrpn_CONNECTION_TCP_BUFLEN / 2;
+
     shared_ptr<ImagingComponent>
     ImagingComponent::create() {
         shared_ptr<ImagingComponent> ret(new ImagingComponent());
@@ -234,7 +297,7 @@ namespace common {
         auto imageBufferCopy = util::makeAlignedImageBuffer(imageBufferSize);
         memcpy(imageBufferCopy.get(), imageData, imageBufferSize);
 
-        Buffer<> buf;
+        StackBuffer<> buf;
         messages::ImagePlacedInProcessMemory::MessageSerialization
             serialization(messages::InProcessMemoryMessage{
                 metadata, sensor,
@@ -276,7 +339,7 @@ namespace common {
         auto &shm = *(m_shmBuf[sensor]);
         auto seq = shm.put(imageData, imageBufferSize);
 
-        Buffer<> buf;
+        StackBuffer<> buf;
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
             messages::SharedMemoryMessage{metadata, seq, sensor,
                                           IPCRingBuffer::getABILevel(),
@@ -291,24 +354,86 @@ namespace common {
     bool ImagingComponent::m_sendImageDataOnTheWire(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-        /// @todo currently only handle 8bit data over network
-        if (metadata.depth != 1) {
+        m_growWireVecsIfRequired(sensor);
+        auto &skipped = m_wireFramesSkipped[sensor];
+        if (skipped + 1 < m_networkOptions.decimation) {
+            ++skipped;
             return false;
         }
-        Buffer<> buf;
-        messages::ImageRegion::MessageSerialization msg(metadata, imageData,
-                                                        sensor);
-        serialize(buf, msg);
-        if (buf.size() > vrpn_CONNECTION_TCP_BUFLEN) {
-#if 0
-            OSVR_DEV_VERBOSE("Skipping imaging message: size is "
-                             << buf.size() << " vs the maximum of "
-                             << vrpn_CONNECTION_TCP_BUFLEN);
-#endif
+        skipped = 0;
+
+        /// Small 8-bit frames go in a single imageRegion message, which
+        /// clients from before imageChunk messages understand too.
+        if (metadata.depth == 1 &&
+            getBufferSize(metadata) < vrpn_CONNECTION_TCP_BUFLEN) {
+            auto &buf = m_sendBuffer;
+            buf.getContents().clear();
+            messages::ImageRegion::MessageSerialization msg(metadata,
+                                                            imageData, sensor);
+            serialize(buf, msg);
+            if (buf.size() <= vrpn_CONNECTION_TCP_BUFLEN) {
+                m_getParent().packMessage(buf, imageRegion.getMessageType(),
+                                          timestamp);
+                m_getParent().sendPending();
+                return true;
+            }
+        }
+        if (!m_chunksRequested) {
+            /// No client has said it understands imageChunk messages, so
+            /// this frame just doesn't go over the network.
             return false;
         }
-        m_getParent().packMessage(buf, imageRegion.getMessageType(), timestamp);
-        m_getParent().sendPending();
+        return m_sendImageChunks(metadata, imageData, sensor, timestamp);
+    }
+
+    bool ImagingComponent::m_sendImageChunks(
+        OSVR_ImagingMetadata const &metadata,
+        OSVR_ImageBufferElement *imageData, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
+        auto bytes = getBufferSize(metadata);
+        auto pixelStride = std::size_t(metadata.channels) * metadata.depth;
+        if (0 == bytes || 0 == pixelStride ||
+            sensor > MAX_IMAGE_CHUNK_SENSOR ||
+            bytes > MAX_IMAGE_CHUNK_FRAME_SIZE) {
+            /// Clients would drop it anyway.
+            return false;
+        }
+        auto encoding = ImageEncoding::Raw;
+        auto frame = reinterpret_cast<uint8_t const *>(imageData);
+        uint32_t frameSize = bytes;
+        if (m_networkOptions.encoding == ImageEncoding::DeltaRLE) {
+            m_encoded.clear();
+            encodeDeltaRLE(frame, bytes, pixelStride, m_encoded);
+            if (m_encoded.size() < bytes) {
+                encoding = ImageEncoding::DeltaRLE;
+                frame = m_encoded.data();
+                frameSize = static_cast<uint32_t>(m_encoded.size());
+            }
+        }
+
+        ImageChunkHeader header;
+        header.metadata = metadata;
+        header.sensor = sensor;
+        header.frameNumber = m_wireFrameNumbers[sensor]++;
+        header.chunkCount =
+            (frameSize + IMAGE_CHUNK_SIZE - 1) / IMAGE_CHUNK_SIZE;
+        header.encoding = encoding;
+        header.encodedSize = frameSize;
+        for (header.chunkIndex = 0; header.chunkIndex < header.chunkCount;
+             ++header.chunkIndex) {
+            header.offset = header.chunkIndex * IMAGE_CHUNK_SIZE;
+            header.length =
+                std::min(IMAGE_CHUNK_SIZE, frameSize - header.offset);
+            auto &buf = m_sendBuffer;
+            buf.getContents().clear();
+            messages::ImageChunk::MessageSerialization msg(header);
+            serialize(buf, msg);
+            buf.append(reinterpret_cast<char const *>(frame + header.offset),
+                       header.length);
+            m_getParent().packMessage(buf, imageChunk.getMessageType(),
+                                      timestamp);
+            m_getParent().sendPending();
+        }
         return true;
     }
 
@@ -394,7 +519,8 @@ namespace common {
         if (getResult) {
             auto bufptr = getResult.getBufferSmartPointer();
             self->m_checkFirst(msg.metadata);
-            auto data = ImageData{msg.sensor, msg.metadata, bufptr};
+            auto data =
+                ImageData{msg.sensor, msg.metadata, bufptr, shm, msg.seqNum};
 
             for (auto const &cb : self->m_cb) {
                 cb(data, timestamp);
@@ -403,6 +529,121 @@ namespace common {
         return 0;
     }
 
+    int VRPN_CALLBACK
+    ImagingComponent::m_handleImageChunk(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageChunk::MessageSerialization msg;
+        try {
+            deserialize(bufReader, msg);
+        } catch (std::exception &) {
+            OSVR_DEV_VERBOSE("Skipping truncated image chunk");
+            return 0;
+        }
+        auto const &header = msg.getHeader();
+        if (!isImageChunkValid(header, bufReader.bytesRemaining())) {
+            OSVR_DEV_VERBOSE("Skipping image chunk with unknown encoding, "
+                             "inconsistent sizes, or out-of-range sensor");
+            return 0;
+        }
+        auto sensor = header.sensor;
+        self->m_growShmVecIfRequired(sensor);
+        if (self->m_shmBuf[sensor]) {
+            /// Getting this sensor's frames through shared memory already.
+            return 0;
+        }
+        auto chunk = reinterpret_cast<uint8_t const *>(
+            bufReader.readBytes(header.length));
+
+        self->m_growWireVecsIfRequired(sensor);
+        auto &frame = self->m_partialFrames[sensor];
+        auto bytes = getBufferSize(header.metadata);
+        if (!frame.active || frame.frameNumber != header.frameNumber) {
+            /// Start of a new frame: drops any frame left incomplete.
+            frame.active = true;
+            frame.frameNumber = header.frameNumber;
+            frame.chunksReceived = 0;
+            frame.chunkCount = header.chunkCount;
+            frame.metadata = header.metadata;
+            frame.encoding = header.encoding;
+            frame.encodedSize = header.encodedSize;
+            frame.buffer = makePooledImageBuffer(bytes);
+            if (frame.encoding == ImageEncoding::DeltaRLE) {
+                frame.encoded.resize(header.encodedSize);
+            }
+        } else if (frame.chunkCount != header.chunkCount ||
+                   frame.encoding != header.encoding ||
+                   frame.encodedSize != header.encodedSize ||
+                   getBufferSize(frame.metadata) != bytes) {
+            OSVR_DEV_VERBOSE("Skipping image frame with inconsistent chunks");
+            frame.active = false;
+            return 0;
+        }
+        auto dest = frame.encoding == ImageEncoding::Raw
+                        ? reinterpret_cast<uint8_t *>(frame.buffer.get())
+                        : frame.encoded.data();
+        std::memcpy(dest + header.offset, chunk, header.length);
+        if (++frame.chunksReceived < header.chunkCount) {
+            return 0;
+        }
+
+        frame.active = false;
+        if (frame.encoding == ImageEncoding::DeltaRLE &&
+            !decodeDeltaRLE(
+                frame.encoded.data(), frame.encoded.size(),
+                std::size_t(frame.metadata.channels) * frame.metadata.depth,
+                reinterpret_cast<uint8_t *>(frame.buffer.get()), bytes)) {
+            OSVR_DEV_VERBOSE("Skipping image frame that failed to decode");
+            return 0;
+        }
+        ImageData data;
+        data.sensor = sensor;
+        data.metadata = frame.metadata;
+        data.buffer = std::move(frame.buffer);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+        self->m_checkFirst(data.metadata);
+        for (auto const &cb : self->m_cb) {
+            cb(data, timestamp);
+        }
+        return 0;
+    }
+
+    int VRPN_CALLBACK ImagingComponent::m_handleImagingNetworkRequest(
+        void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImagingNetworkRequest::MessageSerialization msg;
+        try {
+            deserialize(bufReader, msg);
+        } catch (std::exception &) {
+            OSVR_DEV_VERBOSE("Skipping truncated imaging network request");
+            return 0;
+        }
+        self->m_networkOptions.decimation =
+            std::max(msg.getDecimation(), uint32_t(1));
+        /// Only clients that understand imageChunk messages send this.
+        self->m_chunksRequested = true;
+        return 0;
+    }
+
+    void
+    ImagingComponent::setNetworkOptions(NetworkImagingOptions const &options) {
+        m_networkOptions = options;
+        m_networkOptions.decimation =
+            std::max(m_networkOptions.decimation, uint32_t(1));
+    }
+
+    void ImagingComponent::requestNetworkDecimation(uint32_t decimation) {
+        StackBuffer<> buf;
+        messages::ImagingNetworkRequest::MessageSerialization msg(decimation);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, imagingNetworkRequest.getMessageType());
+        m_getParent().sendPending();
+    }
+
     void ImagingComponent::registerImageHandler(ImageHandler handler) {
         if (m_cb.empty()) {
             m_registerHandler(&ImagingComponent::m_handleImageRegion, this,
@@ -412,6 +653,9 @@ namespace common {
                 &ImagingComponent::m_handleImagePlacedInSharedMemory, this,
                 imagePlacedInSharedMemory.getMessageType());
 
+            m_registerHandler(&ImagingComponent::m_handleImageChunk, this,
+                              imageChunk.getMessageType());
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
             m_registerHandler(
                 &ImagingComponent::m_handleImagePlacedInProcessMemory, this,
@@ -426,6 +670,10 @@ namespace common {
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         m_getParent().registerMessageType(imagePlacedInProcessMemory);
 #endif
+        m_getParent().registerMessageType(imageChunk);
+        m_getParent().registerMessageType(imagingNetworkRequest);
+        m_registerHandler(&ImagingComponent::m_handleImagingNetworkRequest,
+                          this, imagingNetworkRequest.getMessageType());
     }
 
     void ImagingComponent::m_checkFirst(OSVR_ImagingMetadata const &metadata) {
@@ -442,5 +690,13 @@ namespace common {
             m_shmBuf.resize(sensor + 1);
         }
     }
+    void
+    ImagingComponent::m_growWireVecsIfRequired(OSVR_ChannelCount sensor) {
+        if (m_partialFrames.size() <= sensor) {
+            m_wireFrameNumbers.resize(sensor + 1);
+            m_wireFramesSkipped.resize(sensor + 1);
+            m_partialFrames.resize(sensor + 1);
+        }
+    }
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,106 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InProcessReportRouter.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <map>
+
+namespace osvr {
+namespace common {
+    namespace {
+        /// Routers by connection, not keeping them alive: each router removes
+        /// its entry when the last reference to it goes away.
+        class RouterRegistry
+            : public enable_shared_from_this<RouterRegistry> {
+          public:
+            InProcessReportRouterPtr get(vrpn_Connection *conn) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto &weak = m_routers[conn];
+                auto ret = weak.lock();
+                if (!ret) {
+                    weak_ptr<RouterRegistry> self(shared_from_this());
+                    ret.reset(new InProcessReportRouter,
+                              [self, conn](InProcessReportRouter *router) {
+                                  delete router;
+                                  if (auto registry = self.lock()) {
+                                      registry->remove(conn);
+                                  }
+                              });
+                    weak = ret;
+                }
+                return ret;
+            }
+
+            std::size_t size() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_routers.size();
+            }
+
+          private:
+            void remove(vrpn_Connection *conn) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_routers.find(conn);
+                // A new router may already have taken the dead one's place.
+                if (it != end(m_routers) && it->second.expired()) {
+                    m_routers.erase(it);
+                }
+            }
+            std::mutex m_mutex;
+            std::map<vrpn_Connection *, weak_ptr<InProcessReportRouter>>
+                m_routers;
+        };
+
+        /// Shared, so that routers outliving it (at exit) can tell.
+        RouterRegistry &getRegistry() {
+            static auto registry = make_shared<RouterRegistry>();
+            return *registry;
+        }
+    } // namespace
+
+    InProcessReportRouterPtr InProcessReportRouter::get(vrpn_Connection *conn) {
+        return getRegistry().get(conn);
+    }
+
+    std::size_t InProcessReportRouter::getNumRouters() {
+        return getRegistry().size();
+    }
+
+    TrackerReportChannelPtr
+    InProcessReportRouter::getTrackerChannel(std::string const &device) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto &weak = m_trackers[device];
+        auto ret = weak.lock();
+        if (!ret) {
+            ret = make_shared<TrackerReportChannel>();
+            weak = ret;
+        }
+        return ret;
+    }
+} // namespace common
+} // namespace osvr
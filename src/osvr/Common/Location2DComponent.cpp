@@ -27,7 +27,7 @@
 #include <osvr/Common/Location2DComponent.h>
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Serialization.h>
-#include <osvr/Common/Buffer.h>
+#include <osvr/Common/StackBuffer.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -80,7 +80,7 @@ namespace common {
                                           OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        StackBuffer<> buf;
         messages::LocationRecord::MessageSerialization msg(location, sensor);
         serialize(buf, msg);
 
@@ -26,7 +26,7 @@
 #include <osvr/Common/LocomotionComponent.h>
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Serialization.h>
-#include <osvr/Common/Buffer.h>
+#include <osvr/Common/StackBuffer.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -108,7 +108,7 @@ namespace common {
         OSVR_NaviVelocityState naviVelocityState, OSVR_ChannelCount sensor,
         OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        StackBuffer<> buf;
 
         messages::NaviVelocityRecord::MessageSerialization msg(
             naviVelocityState, sensor);
@@ -122,7 +122,7 @@ namespace common {
         OSVR_NaviPositionState naviPositionState, OSVR_ChannelCount sensor,
         OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        StackBuffer<> buf;
 
         messages::NaviPositionRecord::MessageSerialization msg(
             naviPositionState, sensor);
@@ -24,12 +24,19 @@
 
 // Internal Includes
 #include <osvr/Common/LowLatency.h>
+#include <osvr/Util/ThreadScheduling.h>
 
 #ifdef _WIN32
 #define NO_MINMAX
 #include <windows.h>
 #endif
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#endif
+
 namespace osvr {
 namespace common {
 
@@ -61,6 +68,56 @@ namespace common {
     }
 #endif
 
+#ifdef __linux__
+#define OSVR_HAVE_LOWLATENCY_CODE
+    /// Applies the "server" thread role of the configured real-time settings
+    /// (see osvr::util::sched) to the constructing thread and locks memory if
+    /// requested, restoring the previous state on destruction.
+    struct LowLatency::Impl {
+        pthread_t thread;
+        bool haveSched = false;
+        int policy = SCHED_OTHER;
+        sched_param param = {};
+        bool haveAffinity = false;
+        cpu_set_t cpus;
+        int timerSlack = -1;
+        bool lockedMemory = false;
+    };
+
+    LowLatency::LowLatency() : m_impl(new Impl) {
+        auto &impl = *m_impl;
+        impl.thread = pthread_self();
+        impl.haveSched =
+            0 == pthread_getschedparam(impl.thread, &impl.policy, &impl.param);
+        impl.haveAffinity = 0 == pthread_getaffinity_np(impl.thread,
+                                                        sizeof(impl.cpus),
+                                                        &impl.cpus);
+        impl.timerSlack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+
+        impl.lockedMemory = util::sched::lockProcessMemory();
+        util::sched::applyThreadRole(util::sched::ThreadRole::Server);
+    }
+
+    LowLatency::~LowLatency() {
+        auto &impl = *m_impl;
+        if (impl.lockedMemory) {
+            util::sched::unlockProcessMemory();
+        }
+        /// Nothing we can do about failures here.
+        if (impl.haveSched) {
+            pthread_setschedparam(impl.thread, impl.policy, &impl.param);
+        }
+        if (impl.haveAffinity) {
+            pthread_setaffinity_np(impl.thread, sizeof(impl.cpus), &impl.cpus);
+        }
+        /// Timer slack can only be set for the calling thread.
+        if (impl.timerSlack > 0 && pthread_equal(impl.thread, pthread_self())) {
+            prctl(PR_SET_TIMERSLACK,
+                  static_cast<unsigned long>(impl.timerSlack), 0, 0, 0);
+        }
+    }
+#endif
+
 #ifndef OSVR_HAVE_LOWLATENCY_CODE
     // Fallback no-op implementations
     struct LowLatency::Impl {};
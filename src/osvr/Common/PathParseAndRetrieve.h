@@ -35,6 +35,7 @@
 #include <boost/algorithm/string/find_iterator.hpp>
 #include <boost/algorithm/string/finder.hpp>
 #include <boost/range/adaptor/sliced.hpp>
+#include <boost/utility/string_ref.hpp>
 
 // Standard includes
 #include <string>
@@ -44,7 +45,7 @@ namespace common {
     namespace detail {
         struct GetOrCreateFunctor {
             template <typename Node>
-            Node *operator()(Node *node, std::string const &component) const {
+            Node *operator()(Node *node, boost::string_ref component) const {
                 return &(node->getOrCreateChildByName(component));
             }
         };
@@ -52,7 +53,7 @@ namespace common {
         struct GetChildFunctor {
             template <typename Node>
             Node const *operator()(Node const *node,
-                                   std::string const &component) const {
+                                   boost::string_ref component) const {
                 return &(node->getChildByName(component));
             }
         };
@@ -103,15 +104,14 @@ namespace common {
                 // but default constructed.
                 auto end = decltype(begin)();
 
-                // Temporary string that will be re-used each pass through the
-                // loop
-                std::string component;
-
                 // Use the iterators as a range in a loop, to process each
                 // component of the path
                 for (auto rangeIt : boost::make_iterator_range(begin, end)) {
-                    // Extract the component to a string for interpretation.
-                    component = boost::copy_range<std::string>(rangeIt);
+                    // Refer to the component in place rather than copying it
+                    // out: the child lookup doesn't need a std::string.
+                    boost::string_ref component(
+                        rangeIt.empty() ? nullptr : &(*rangeIt.begin()),
+                        rangeIt.size());
 
                     // Interpret the component: four cases
                     if (component.empty()) {
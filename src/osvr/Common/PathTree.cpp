@@ -46,12 +46,18 @@ namespace osvr {
 namespace common {
     PathTree::PathTree() : m_root(PathNode::createRoot()) {}
     PathNode &PathTree::getNodeByPath(std::string const &path) {
-        return pathParseAndRetrieve(*m_root, path);
+        auto cached = m_getCachedNode(path);
+        if (cached) {
+            return *cached;
+        }
+        auto &ret = pathParseAndRetrieve(*m_root, path);
+        m_cacheNode(path, ret);
+        return ret;
     }
     PathNode &
     PathTree::getNodeByPath(std::string const &path,
                             PathElement const &finalComponentDefault) {
-        auto &ret = pathParseAndRetrieve(*m_root, path);
+        auto &ret = getNodeByPath(path);
 
         // Handle null elements as final component.
         elements::ifNullReplaceWith(ret.value(), finalComponentDefault);
@@ -59,11 +65,31 @@ namespace common {
     }
 
     PathNode const &PathTree::getNodeByPath(std::string const &path) const {
-        return pathParseAndRetrieve(const_cast<PathNode const &>(*m_root),
-                                    path);
+        auto cached = m_getCachedNode(path);
+        if (cached) {
+            return *cached;
+        }
+        auto &ret = pathParseAndRetrieve(
+            const_cast<PathNode const &>(*m_root), path);
+        m_cacheNode(path, ret);
+        return ret;
     }
 
-    void PathTree::reset() { m_root = PathNode::createRoot(); }
+    void PathTree::reset() {
+        m_pathCache.clear();
+        m_root = PathNode::createRoot();
+    }
+
+    PathNode *PathTree::m_getCachedNode(std::string const &path) const {
+        auto it = m_pathCache.find(path);
+        return it == end(m_pathCache) ? nullptr : it->second;
+    }
+
+    void PathTree::m_cacheNode(std::string const &path,
+                               PathNode const &node) const {
+        /// Only ever called with nodes of this tree, which we own.
+        m_pathCache.emplace(path, const_cast<PathNode *>(&node));
+    }
 
     /// @brief Determine if the node needs updating given that we want to add an
     /// alias there pointing to source with the given automatic status.
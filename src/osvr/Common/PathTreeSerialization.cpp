@@ -29,13 +29,15 @@
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathNode.h>
 #include <osvr/Common/ApplyPathNodeVisitor.h>
+#include <osvr/Common/JSONHelpers.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <cstdint>
+#include <cstdio>
 
 namespace osvr {
 namespace common {
@@ -101,5 +103,20 @@ namespace common {
             tree.getNodeByPath(node["path"].asString()).value() = elt;
         }
     }
+
+    std::string pathTreeJsonVersion(Json::Value const &nodes) {
+        // 64-bit FNV-1a of the compact serialization: object members are
+        // written in sorted order, so this is stable for equal trees.
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : jsonToCompactString(nodes)) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        char buf[17];
+        std::snprintf(buf, sizeof(buf), "%08x%08x",
+                      static_cast<unsigned>(hash >> 32),
+                      static_cast<unsigned>(hash & 0xffffffffu));
+        return std::string(buf);
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
@@ -31,10 +31,36 @@
 
 // Standard includes
 #include <iostream>
+#include <stdexcept>
 
 namespace osvr {
 namespace common {
 
+    RegisteredStringMap::RegisteredStringMap() = default;
+
+    RegisteredStringMap::RegisteredStringMap(RegisteredStringMap const &other)
+        : m_regEntries(other.m_regEntries), m_modified(other.m_modified) {
+        m_index.reserve(m_regEntries.size());
+        uint32_t i = 0;
+        for (auto const &entry : m_regEntries) {
+            m_index.emplace(boost::string_ref(entry), i);
+            ++i;
+        }
+    }
+
+    RegisteredStringMap &RegisteredStringMap::
+    operator=(RegisteredStringMap const &other) {
+        if (this != &other) {
+            RegisteredStringMap copy(other);
+            m_regEntries.swap(copy.m_regEntries);
+            // Swapping deques doesn't move their elements, so the index
+            // stays valid.
+            m_index.swap(copy.m_index);
+            m_modified = copy.m_modified;
+        }
+        return *this;
+    }
+
     /// @brief helper function to print size and contents of the map
     void RegisteredStringMap::printCurrentMap() {
         auto n = m_regEntries.size();
@@ -47,61 +73,70 @@ namespace common {
     }
 
     util::StringID
-    RegisteredStringMap::registerStringID(std::string const &str) {
-        auto entry = std::find(begin(m_regEntries), end(m_regEntries), str);
-        if (end(m_regEntries) != entry) {
+    RegisteredStringMap::registerStringID(boost::string_ref str) {
+        auto entry = m_index.find(str);
+        if (end(m_index) != entry) {
             // we found it.
-            return util::StringID(std::distance(begin(m_regEntries), entry));
+            return util::StringID(entry->second);
         }
 
         // we didn't find an entry in the registry so we'll add a new one
-        auto ret = util::StringID(
-            m_regEntries.size()); // will be the location of the next insert.
-        m_regEntries.push_back(str);
+        auto ret = util::StringID(static_cast<uint32_t>(
+            m_regEntries.size())); // will be the location of the next insert.
+        m_regEntries.emplace_back(str.begin(), str.end());
+        // Key the index on our own copy, not the caller's string.
+        m_index.emplace(boost::string_ref(m_regEntries.back()), ret.value());
         m_modified = true;
         return ret;
     }
 
     util::StringID
-    RegisteredStringMap::getStringID(std::string const &str) const {
-
-        auto entry = std::find(begin(m_regEntries), end(m_regEntries), str);
-        if (end(m_regEntries) != entry) {
+    RegisteredStringMap::getStringID(boost::string_ref str) const {
+        auto entry = m_index.find(str);
+        if (end(m_index) != entry) {
             // we found it.
-            return util::StringID(std::distance(begin(m_regEntries), entry));
+            return util::StringID(entry->second);
         }
         // we did not find an entry with given string
         return util::StringID();
     }
 
-    std::string RegisteredStringMap::getStringFromId(util::StringID id) const {
+    std::string const &
+    RegisteredStringMap::getStringFromId(util::StringID id) const {
+        static const std::string EMPTY_STRING;
 
         // requested non-existent ID (include sanity check)
         if (id.value() >= m_regEntries.size()) {
             // returning empty string
             /// @todo should we throw here?
-            return std::string();
+            return EMPTY_STRING;
         }
 
         return m_regEntries[id.value()];
-    };
+    }
 
     bool RegisteredStringMap::isModified() const { return m_modified; }
     void RegisteredStringMap::clearModifiedFlag() { m_modified = false; }
     std::vector<std::string> RegisteredStringMap::getEntries() const {
-        return m_regEntries;
+        return std::vector<std::string>(begin(m_regEntries),
+                                        end(m_regEntries));
+    }
+    std::size_t RegisteredStringMap::size() const {
+        return m_regEntries.size();
     }
 
     util::StringID
-    CorrelatedStringMap::registerStringID(std::string const &str) {
+    CorrelatedStringMap::registerStringID(boost::string_ref str) {
         return m_local.registerStringID(str);
     }
 
-    util::StringID CorrelatedStringMap::getStringID(std::string const &str) const{
+    util::StringID
+    CorrelatedStringMap::getStringID(boost::string_ref str) const {
         return m_local.getStringID(str);
     }
 
-    std::string CorrelatedStringMap::getStringFromId(util::StringID id) const {
+    std::string const &
+    CorrelatedStringMap::getStringFromId(util::StringID id) const {
         return m_local.getStringFromId(id);
     }
 
@@ -119,10 +154,9 @@ namespace common {
     void CorrelatedStringMap::setupPeerMappings(
         std::vector<std::string> const &peerEntries) {
         m_remoteToLocal.clear();
-        auto n = peerEntries.size();
-        for (uint32_t i = 0; i < n; ++i) {
-            m_remoteToLocal.push_back(
-                m_local.registerStringID(peerEntries[i]).value());
+        m_remoteToLocal.reserve(peerEntries.size());
+        for (auto const &entry : peerEntries) {
+            m_remoteToLocal.push_back(m_local.registerStringID(entry).value());
         }
     }
 } // namespace common
@@ -40,6 +40,7 @@
 
 // Standard includes
 #include <sstream>
+#include <utility>
 
 namespace osvr {
 namespace common {
@@ -71,15 +72,17 @@ namespace common {
 
     // Forward declaration
     void resolveTreeNodeImpl(PathTree &pathTree, std::string const &path,
-                             OriginalSource &source);
+                             OriginalSource &source,
+                             TreeNodeResolutionTrace *trace);
 
     class TreeResolutionVisitor : public boost::static_visitor<>,
                                   boost::noncopyable {
       public:
         TreeResolutionVisitor(common::PathTree &tree, common::PathNode &node,
-                              common::OriginalSource &source)
+                              common::OriginalSource &source,
+                              TreeNodeResolutionTrace *trace)
             : boost::static_visitor<>(), m_tree(tree), m_node(node),
-              m_source(source) {}
+              m_source(source), m_trace(trace) {}
 
         /// @brief Fallback case
         template <typename T> void operator()(T const &) {
@@ -89,6 +92,9 @@ namespace common {
         /// @brief Handle an alias element
         void operator()(elements::AliasElement const &elt) {
             // This is an alias.
+            if (m_trace) {
+                m_trace->steps.back().aliasSource = elt.getSource();
+            }
             ParsedAlias parsed(elt.getSource());
             if (!parsed.isValid()) {
                 OSVR_DEV_VERBOSE("Couldn't parse alias: " << elt.getSource());
@@ -125,35 +131,99 @@ namespace common {
       private:
         void m_decompose() { m_source.decompose(m_node); }
         void m_recurse(std::string const &path) {
-            resolveTreeNodeImpl(m_tree, path, m_source);
+            resolveTreeNodeImpl(m_tree, path, m_source, m_trace);
         }
         PathTree &m_getPathTree() { return m_tree; }
 
         PathTree &m_tree;
         PathNode &m_node;
         OriginalSource &m_source;
+        TreeNodeResolutionTrace *m_trace;
     };
 
     inline void resolveTreeNodeImpl(PathTree &pathTree, std::string const &path,
-                                    OriginalSource &source) {
+                                    OriginalSource &source,
+                                    TreeNodeResolutionTrace *trace) {
         auto &node = pathTree.getNodeByPath(path);
 
         // First do any inference possible here.
         ifNullTryInferFromParent(node);
 
+        if (trace) {
+            trace->steps.push_back(TreeNodeResolutionTrace::Step{
+                path, node.value().which(), std::string()});
+        }
+
         // Now visit.
-        TreeResolutionVisitor visitor(pathTree, node, source);
+        TreeResolutionVisitor visitor(pathTree, node, source, trace);
         boost::apply_visitor(visitor, node.value());
     }
 
     boost::optional<OriginalSource> resolveTreeNode(PathTree &pathTree,
                                                     std::string const &path) {
         OriginalSource source;
-        resolveTreeNodeImpl(pathTree, path, source);
+        resolveTreeNodeImpl(pathTree, path, source, nullptr);
         if (source.isResolved()) {
             return source;
         }
         return boost::optional<OriginalSource>();
     }
+
+    /// @brief Checks that the nodes along a previous resolution's route still
+    /// hold the same things, returning the final node if so.
+    static inline PathNode *
+    retraceResolution(PathTree &pathTree,
+                      TreeNodeResolutionTrace const &trace) {
+        PathNode *node = nullptr;
+        for (auto const &step : trace.steps) {
+            node = &pathTree.getNodeByPath(step.path);
+            // Same inference as a full resolution would do.
+            ifNullTryInferFromParent(*node);
+            if (node->value().which() != step.which) {
+                return nullptr;
+            }
+            if (!step.aliasSource.empty()) {
+                auto elt = boost::get<elements::AliasElement>(&node->value());
+                if (elt->getSource() != step.aliasSource) {
+                    return nullptr;
+                }
+            }
+        }
+        return node;
+    }
+
+    boost::optional<OriginalSource>
+    TreeNodeResolutionCache::resolve(PathTree &pathTree,
+                                     std::string const &path) {
+        auto it = m_entries.find(path);
+        if (it != end(m_entries)) {
+            auto node = retraceResolution(pathTree, it->second.trace);
+            if (node) {
+                // Same route: only the end of it needs looking at again, and
+                // only to point the result at this tree's nodes.
+                auto const &value = node->value();
+                if (boost::get<elements::SensorElement>(&value) ||
+                    boost::get<elements::InterfaceElement>(&value)) {
+                    OriginalSource source;
+                    source.decompose(*node);
+                    if (source.isResolved()) {
+                        source.setTransform(it->second.transform);
+                        ++m_hits;
+                        return source;
+                    }
+                }
+            }
+            m_entries.erase(it);
+        }
+
+        OriginalSource source;
+        TreeNodeResolutionTrace trace;
+        resolveTreeNodeImpl(pathTree, path, source, &trace);
+        if (!source.isResolved()) {
+            return boost::optional<OriginalSource>();
+        }
+        m_entries[path] = Entry{std::move(trace), source.getTransform()};
+        return source;
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
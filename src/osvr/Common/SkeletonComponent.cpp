@@ -25,6 +25,7 @@
 // Internal Includes
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Buffer.h>
+#include <osvr/Common/StackBuffer.h>
 #include <osvr/Common/CommonComponent.h>
 #include <osvr/Common/JSONSerializationTags.h>
 #include <osvr/Common/Serialization.h>
@@ -109,7 +110,7 @@ namespace common {
     void SkeletonComponent::sendNotification(OSVR_ChannelCount sensor,
                                              OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        StackBuffer<> buf;
         SkeletonNotification notification;
         notification.sensor = sensor;
         messages::SkeletonRecord::MessageSerialization msg(notification);
@@ -93,6 +93,24 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        class TreeVersionFromServer::MessageSerialization {
+          public:
+            MessageSerialization(std::string const &str = std::string())
+                : m_str(str) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_str, serialization::StringOnlyMessageTag());
+            }
+
+            std::string const &getValue() const { return m_str; }
+
+          private:
+            std::string m_str;
+        };
+        const char *TreeVersionFromServer::identifier() {
+            return "com.osvr.system.TreeVersionFromServer";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -134,6 +152,13 @@ namespace common {
 
     void SystemComponent::sendReplacementTree(PathTree &tree) {
         auto config = pathTreeToJson(tree);
+        {
+            Buffer<> buf;
+            messages::TreeVersionFromServer::MessageSerialization msg(
+                pathTreeJsonVersion(config));
+            serialize(buf, msg);
+            m_getParent().packMessage(buf, treeVersionOut.getMessageType());
+        }
         Buffer<> buf;
         messages::ReplacementTreeFromServer::MessageSerialization msg(config);
         serialize(buf, msg);
@@ -150,11 +175,20 @@ namespace common {
         m_replaceTreeHandlers.push_back(cb);
     }
 
+    void SystemComponent::registerTreeVersionHandler(TreeVersionHandler cb) {
+        if (m_treeVersionHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeVersion, this,
+                              treeVersionOut.getMessageType());
+        }
+        m_treeVersionHandlers.push_back(cb);
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeVersionOut);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
@@ -171,5 +205,17 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeVersion(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeVersionFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        for (auto const &cb : self->m_treeVersionHandlers) {
+            cb(msg.getValue());
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
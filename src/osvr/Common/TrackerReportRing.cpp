@@ -0,0 +1,261 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerReportRing.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace osvr {
+namespace common {
+    /// @brief One report as laid out in shared memory: only read by clients
+    /// built from the same source, as for the ring buffer itself.
+    struct TrackerReportRing::Record {
+        enum Type : uint32_t { POSE, VELOCITY, ACCELERATION, HEARTBEAT };
+        Type type;
+        OSVR_ChannelCount sensor;
+        /// Steady clock time written, in nanoseconds: comparable between
+        /// processes on the same machine.
+        std::int64_t writtenAt;
+        OSVR_TimeValue timestamp;
+        union {
+            OSVR_PoseState pose;
+            OSVR_VelocityState velocity;
+            OSVR_AccelerationState acceleration;
+        };
+    };
+
+    /// @brief Room for a few frames' worth of reports from a fast device.
+    static const IPCRingBuffer::entry_count_type RING_ENTRIES = 256;
+
+    /// @brief How long a writer may go without writing before it writes a
+    /// heartbeat record.
+    static const std::chrono::milliseconds HEARTBEAT_INTERVAL(200);
+
+    /// @brief How old the newest record may be before its writer is
+    /// considered gone: several missed heartbeats.
+    static const std::chrono::milliseconds STALE_TIMEOUT(1000);
+
+    static std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// @brief Whether a record written at the given time could be from a
+    /// writer that's still alive.
+    static bool isRecent(std::int64_t writtenAt) {
+        auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           STALE_TIMEOUT)
+                           .count();
+        return now() - writtenAt < timeout;
+    }
+
+    static IPCRingBuffer::Options getOptions(std::string const &device,
+                                             int port) {
+        return IPCRingBuffer::Options("com.osvr.tracker/" +
+                                      std::to_string(port) + "/" + device);
+    }
+
+    TrackerReportRingPtr TrackerReportRing::create(std::string const &device,
+                                                   int port) {
+        TrackerReportRingPtr ret;
+        auto buf = IPCRingBuffer::create(
+            getOptions(device, port)
+                .setEntries(RING_ENTRIES)
+                .setEntrySize(sizeof(Record)));
+        if (buf) {
+            ret.reset(new TrackerReportRing(std::move(buf)));
+            // So readers never see an empty ring.
+            ret->heartbeat();
+        }
+        return ret;
+    }
+
+    TrackerReportRingPtr TrackerReportRing::find(std::string const &device,
+                                                 int port) {
+        TrackerReportRingPtr ret;
+        auto buf = IPCRingBuffer::find(getOptions(device, port));
+        if (buf && buf->getEntrySize() >= sizeof(Record)) {
+            ret.reset(new TrackerReportRing(std::move(buf)));
+            if (!ret->m_checkWriterAlive()) {
+                // Left over from a server that's gone.
+                ret.reset();
+            }
+        }
+        return ret;
+    }
+
+    TrackerReportRing::TrackerReportRing(IPCRingBufferPtr &&buf)
+        : m_buf(std::move(buf)) {}
+
+    void TrackerReportRing::sendPose(OSVR_TimeValue const &timestamp,
+                                     OSVR_ChannelCount sensor,
+                                     OSVR_PoseState const &pose) {
+        Record record;
+        record.type = Record::POSE;
+        record.sensor = sensor;
+        record.timestamp = timestamp;
+        record.pose = pose;
+        m_put(record);
+    }
+
+    void TrackerReportRing::sendVelocity(OSVR_TimeValue const &timestamp,
+                                         OSVR_ChannelCount sensor,
+                                         OSVR_VelocityState const &vel) {
+        Record record;
+        record.type = Record::VELOCITY;
+        record.sensor = sensor;
+        record.timestamp = timestamp;
+        record.velocity = vel;
+        m_put(record);
+    }
+
+    void
+    TrackerReportRing::sendAcceleration(OSVR_TimeValue const &timestamp,
+                                        OSVR_ChannelCount sensor,
+                                        OSVR_AccelerationState const &accel) {
+        Record record;
+        record.type = Record::ACCELERATION;
+        record.sensor = sensor;
+        record.timestamp = timestamp;
+        record.acceleration = accel;
+        m_put(record);
+    }
+
+    void TrackerReportRing::heartbeat() {
+        auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            HEARTBEAT_INTERVAL)
+                            .count();
+        if (now() - m_lastWrite < interval) {
+            return;
+        }
+        Record record;
+        record.type = Record::HEARTBEAT;
+        record.sensor = 0;
+        record.timestamp = OSVR_TimeValue{};
+        m_put(record);
+    }
+
+    void TrackerReportRing::m_put(Record &record) {
+        record.writtenAt = m_lastWrite = now();
+        m_buf->put(reinterpret_cast<IPCRingBuffer::pointer_to_const_type>(
+                       &record),
+                   sizeof(Record));
+    }
+
+    bool TrackerReportRing::m_checkWriterAlive() {
+        Record latest;
+        {
+            auto proxy = m_buf->getLatest();
+            if (!proxy) {
+                // Never written to: create() writes right away, so whatever
+                // made this didn't finish.
+                m_writerAlive = false;
+                return false;
+            }
+            std::memcpy(&latest, proxy.get(), sizeof(Record));
+        }
+        m_writerAlive = isRecent(latest.writtenAt);
+        return m_writerAlive;
+    }
+
+    std::size_t
+    TrackerReportRing::poll(TrackerReportChannel::Subscriber const &handlers) {
+        typedef IPCRingBuffer::sequence_type sequence_type;
+        if (!m_writerAlive) {
+            return 0;
+        }
+        sequence_type latest;
+        Record record;
+        {
+            auto proxy = m_buf->getLatest();
+            if (!proxy) {
+                return 0;
+            }
+            latest = proxy.getSequenceNumber();
+            std::memcpy(&record, proxy.get(), sizeof(Record));
+        }
+        if (!isRecent(record.writtenAt)) {
+            // Whatever is left is stale too.
+            m_writerAlive = false;
+            return 0;
+        }
+        if (!m_started) {
+            m_started = true;
+            m_nextSeq = latest;
+        }
+        // Fell behind: skip what has been overwritten.
+        m_nextSeq = getFirstToRead(m_nextSeq, latest, m_buf->getEntries());
+
+        std::size_t ret = 0;
+        for (; m_nextSeq != latest + 1; ++m_nextSeq) {
+            {
+                // Copy out, so we hold no lock on the ring while calling
+                // handlers.
+                auto proxy = m_buf->get(m_nextSeq);
+                if (!proxy) {
+                    // Overwritten already.
+                    continue;
+                }
+                std::memcpy(&record, proxy.get(), sizeof(Record));
+            }
+            if (record.type == Record::HEARTBEAT) {
+                continue;
+            }
+            ++ret;
+            switch (record.type) {
+            case Record::POSE:
+                if (handlers.pose) {
+                    handlers.pose(record.timestamp, record.sensor,
+                                  record.pose);
+                }
+                break;
+            case Record::VELOCITY:
+                if (handlers.velocity) {
+                    handlers.velocity(record.timestamp, record.sensor,
+                                      record.velocity);
+                }
+                break;
+            case Record::ACCELERATION:
+                if (handlers.acceleration) {
+                    handlers.acceleration(record.timestamp, record.sensor,
+                                          record.acceleration);
+                }
+                break;
+            case Record::HEARTBEAT:
+                break;
+            }
+        }
+        return ret;
+    }
+} // namespace common
+} // namespace osvr
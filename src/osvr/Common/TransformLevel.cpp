@@ -0,0 +1,187 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @todo Replace the utility functions in here with osvr/Common/JSONEigen
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TransformLevel.h>
+#include <osvr/Common/ChangeOfBasis.h>
+#include <osvr/Common/DegreesToRadians.h>
+
+// Library/third-party includes
+#include <boost/algorithm/string.hpp>
+#include <boost/assert.hpp>
+#include <boost/range/algorithm/count_if.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+
+namespace osvr {
+namespace common {
+
+    static const char AXIS_NAMES[] = "XYZ";
+    static const char MINUS[] = "-";
+    template <typename T = Eigen::Vector3d>
+    inline T vectorFromJson(Json::Value const &v) {
+        T ret = T::Zero();
+        if (v.isString()) {
+            std::string inVal = v.asString();
+            if (inVal.empty()) {
+                throw std::runtime_error(
+                    "Empty string can't be turned into a vector!");
+            }
+            using boost::is_any_of;
+            std::string val(boost::to_upper_copy(inVal));
+            if ((!boost::algorithm::all(
+                     val, is_any_of(AXIS_NAMES) || is_any_of(MINUS) ||
+                              boost::algorithm::is_space())) ||
+                boost::count_if(val, is_any_of(AXIS_NAMES)) != 1 ||
+                boost::count_if(val, is_any_of(MINUS)) > 1) {
+                throw std::runtime_error(
+                    "Cannot turn the specified string into a vector: " + inVal);
+            }
+            double factor =
+                (val.find(MINUS[0]) == std::string::npos) ? 1.0 : -1.0;
+            const std::string axisnames(AXIS_NAMES);
+            for (const char c : val) {
+                auto location = axisnames.find(c);
+                if (location != std::string::npos) {
+                    ret[location] = factor;
+                    return ret;
+                }
+            }
+            BOOST_ASSERT_MSG(false, "Should never reach here!");
+        }
+        if (v.isArray()) {
+            if (v.size() != T::RowsAtCompileTime) {
+                throw std::runtime_error(
+                    "Vector size wrong when converting from JSON!");
+            }
+            for (Json::ArrayIndex i = 0, e = v.size(); i < e; ++i) {
+                ret[i] = v[i].asFloat();
+            }
+            return ret;
+        }
+        throw std::runtime_error("Could not convert JSON to vector: " +
+                                 v.toStyledString());
+    }
+
+    static const char DEGREES_KEY[] = "degrees";
+    static const char RADIANS_KEY[] = "radians";
+    static inline double angleAsRadians(Json::Value const &rotation) {
+        double ret = 0;
+        if (rotation[DEGREES_KEY].isNumeric()) {
+            ret = degreesToRadians(rotation[DEGREES_KEY].asFloat());
+        } else if (rotation[RADIANS_KEY].isNumeric()) {
+            ret = rotation[RADIANS_KEY].asFloat();
+        } else {
+            throw std::runtime_error(
+                "Cannot have a rotation with either degrees or radians!");
+        }
+        return ret;
+    }
+
+    static const char TRANSLATE_KEY[] = "posttranslate";
+    static const char PRETRANSLATE_KEY[] = "translate";
+    static const char ROTATE_KEY[] = "postrotate";
+    static const char PREROTATE_KEY[] = "rotate";
+    static const char AXIS_KEY[] = "axis";
+    static const char CHANGE_BASIS_KEY[] = "changeBasis";
+    static const char X_KEY[] = "x";
+    static const char Y_KEY[] = "y";
+    static const char Z_KEY[] = "z";
+    TransformLevel TransformLevel::parse(Json::Value const &level) {
+        TransformLevel ret;
+        if (!level.isObject()) {
+            // This is a non-object leaf node.
+            return ret;
+        }
+        if (level.isMember(CHANGE_BASIS_KEY)) {
+            Json::Value const &changeBasis = level[CHANGE_BASIS_KEY];
+            ret.m_kind = Kind::ChangeOfBasis;
+            ret.m_basis.row(0) = vectorFromJson<>(changeBasis[X_KEY]);
+            ret.m_basis.row(1) = vectorFromJson<>(changeBasis[Y_KEY]);
+            ret.m_basis.row(2) = vectorFromJson<>(changeBasis[Z_KEY]);
+            return ret;
+        }
+        ret.m_kind = Kind::Rigid;
+        if (level.isMember(TRANSLATE_KEY)) {
+            ret.m_postTranslation = vectorFromJson<>(level[TRANSLATE_KEY]);
+            ret.m_hasPost = true;
+        }
+        if (level.isMember(PRETRANSLATE_KEY)) {
+            ret.m_preTranslation = vectorFromJson<>(level[PRETRANSLATE_KEY]);
+            ret.m_hasPre = true;
+        }
+        if (level.isMember(ROTATE_KEY)) {
+            Json::Value const &rotate = level[ROTATE_KEY];
+            ret.m_postRotation = Eigen::AngleAxisd(
+                angleAsRadians(rotate), vectorFromJson<>(rotate[AXIS_KEY]));
+            ret.m_hasPost = true;
+        }
+        if (level.isMember(PREROTATE_KEY)) {
+            Json::Value const &rotate = level[PREROTATE_KEY];
+            ret.m_preRotation = Eigen::AngleAxisd(
+                angleAsRadians(rotate), vectorFromJson<>(rotate[AXIS_KEY]));
+            ret.m_hasPre = true;
+        }
+        return ret;
+    }
+
+    template <typename Rotation>
+    static inline Eigen::Matrix4d rigidMatrix(Eigen::Vector3d const &position,
+                                              Rotation const &orientation) {
+        Eigen::Affine3d xform;
+        xform.fromPositionOrientationScale(position, orientation,
+                                           Eigen::Vector3d::Constant(1));
+        return xform.matrix();
+    }
+
+    void TransformLevel::applyTo(Transform &xform) const {
+        switch (m_kind) {
+        case Kind::Identity:
+            return;
+        case Kind::ChangeOfBasis: {
+            ChangeOfBasis cb;
+            cb.setNewX(m_basis.row(0).transpose());
+            cb.setNewY(m_basis.row(1).transpose());
+            cb.setNewZ(m_basis.row(2).transpose());
+            xform.transform(cb.get());
+            return;
+        }
+        case Kind::Rigid:
+            if (m_hasPost) {
+                xform.concatPost(
+                    rigidMatrix(m_postTranslation, m_postRotation));
+            }
+            if (m_hasPre) {
+                xform.concatPre(rigidMatrix(m_preTranslation, m_preRotation));
+            }
+            return;
+        }
+    }
+
+} // namespace common
+} // namespace osvr
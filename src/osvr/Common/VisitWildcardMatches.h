@@ -0,0 +1,82 @@
+/** @file
+    @brief Header
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_VisitWildcardMatches_h_GUID_EF03C1EC_66E8_4813_A3F7_C3F8D7AEAA58
+#define INCLUDED_VisitWildcardMatches_h_GUID_EF03C1EC_66E8_4813_A3F7_C3F8D7AEAA58
+
+// Internal Includes
+#include <osvr/Common/PathElementTools.h>
+#include <osvr/Common/PathNode.h>
+#include <osvr/Common/RoutingConstants.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace common {
+    namespace detail {
+        /// @brief Appends a (possibly empty) relative path to a path.
+        inline std::string joinPaths(std::string const &base,
+                                     std::string const &rel) {
+            if (rel.empty()) {
+                return base;
+            }
+            if (base.empty() || base == getPathSeparator()) {
+                return getPathSeparator() + rel;
+            }
+            return base + getPathSeparator() + rel;
+        }
+
+        /// @brief Visits the non-null nodes in the subtree at node, which is
+        /// at relPath relative to the absolute path stem, calling
+        /// f(PathNode &node, std::string const &relPath,
+        /// std::string const &fullPath) for each.
+        ///
+        /// Paths are built up on the way down, rather than walking back up
+        /// to the root from every node.
+        template <typename F>
+        inline void visitWildcardMatches(PathNode &node,
+                                         std::string const &stem,
+                                         std::string const &relPath, F &f) {
+            if (!elements::isNull(node.value())) {
+                f(node, relPath, joinPaths(stem, relPath));
+            }
+            auto visitChild = [&](PathNode &child) {
+                visitWildcardMatches(child, stem,
+                                     relPath.empty()
+                                         ? child.getName()
+                                         : relPath + getPathSeparator() +
+                                               child.getName(),
+                                     f);
+            };
+            node.visitChildren(visitChild);
+        }
+    } // namespace detail
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_VisitWildcardMatches_h_GUID_EF03C1EC_66E8_4813_A3F7_C3F8D7AEAA58
@@ -0,0 +1,142 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "VisitWildcardMatches.h"
+#include <osvr/Common/ParseAlias.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/WildcardAliases.h>
+#include <osvr/Util/Flag.h>
+
+// Library/third-party includes
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Is the absolute path the same as, or under, the absolute path
+    /// base?
+    static inline bool isSameOrUnder(std::string const &path,
+                                     std::string const &base) {
+        if (!boost::algorithm::starts_with(path, base)) {
+            return false;
+        }
+        return path.size() == base.size() || base == getPathSeparator() ||
+               path[base.size()] == getPathSeparatorCharacter();
+    }
+
+    /// @brief The part of path after base, without a leading separator,
+    /// given that isSameOrUnder(path, base).
+    static inline std::string getPathRemainder(std::string const &path,
+                                               std::string const &base) {
+        auto ret = path.substr(base.size());
+        if (!ret.empty() && ret[0] == getPathSeparatorCharacter()) {
+            ret.erase(begin(ret));
+        }
+        return ret;
+    }
+
+    /// @brief Finds an existing descendant of node by relative path, without
+    /// creating anything.
+    static inline PathNode *findDescendant(PathNode &node,
+                                           std::string const &relPath) {
+        PathNode *ret = &node;
+        if (relPath.empty()) {
+            return ret;
+        }
+        std::vector<boost::iterator_range<std::string::const_iterator>>
+            components;
+        boost::algorithm::split(components, relPath, [](char c) {
+            return c == getPathSeparatorCharacter();
+        });
+        for (auto const &component : components) {
+            ret = ret->findChildByName(
+                boost::string_ref(&(*component.begin()), component.size()));
+            if (!ret) {
+                return nullptr;
+            }
+        }
+        return ret;
+    }
+
+    bool WildcardAliasSet::add(WildcardAlias const &alias) {
+        if (std::find(begin(m_aliases), end(m_aliases), alias) !=
+            end(m_aliases)) {
+            return false;
+        }
+        m_aliases.push_back(alias);
+        return true;
+    }
+
+    bool WildcardAliasSet::applyToSubtree(PathNode &subtree) const {
+        util::Flag changed;
+        if (m_aliases.empty()) {
+            return changed.get();
+        }
+        auto subtreePath = getFullPath(subtree);
+        for (auto const &alias : m_aliases) {
+            PathNode *start = nullptr;
+            std::string relPath;
+            if (isSameOrUnder(subtreePath, alias.stem)) {
+                // The new nodes are (some of) those matched by the wildcard.
+                start = &subtree;
+                relPath = getPathRemainder(subtreePath, alias.stem);
+            } else if (isSameOrUnder(alias.stem, subtreePath)) {
+                // The wildcard's stem is within the new nodes.
+                start = findDescendant(
+                    subtree, getPathRemainder(alias.stem, subtreePath));
+            }
+            if (!start) {
+                continue;
+            }
+
+            // Collect the matches before adding any aliases, since the
+            // aliases may be added within the subtree being visited.
+            std::vector<std::pair<std::string, std::string>> matches;
+            auto collect = [&](PathNode &, std::string const &rel,
+                               std::string const &full) {
+                matches.emplace_back(rel, full);
+            };
+            detail::visitWildcardMatches(*start, alias.stem, relPath, collect);
+
+            ParsedAlias source(alias.source);
+            for (auto const &match : matches) {
+                source.setLeaf(match.second);
+                changed += addAliasFromSourceAndRelativeDest(
+                    subtree, source.getAlias(),
+                    detail::joinPaths(alias.path, match.first),
+                    alias.priority);
+            }
+        }
+        return changed.get();
+    }
+
+} // namespace common
+} // namespace osvr
@@ -27,6 +27,7 @@
 // Internal Includes
 #include "AsyncDeviceToken.h"
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Util/ThreadScheduling.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -77,6 +78,8 @@ namespace connection {
                 : m_cb(cb), m_run(&run) {}
             void operator()() {
                 OSVR_DEV_VERBOSE("WaitCallbackLoop starting");
+                util::sched::applyThreadRole(
+                    util::sched::ThreadRole::AsyncDevice);
                 ::util::LoopGuard guard(*m_run);
                 while (m_run->shouldContinue()) {
                     m_cb();
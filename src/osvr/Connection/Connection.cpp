@@ -27,6 +27,7 @@
 #include <osvr/Connection/ConnectionDevice.h>
 #include <osvr/Util/SharedPtr.h>
 #include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/PluginHost/HostAccess.h>
 #include <osvr/Connection/MessageType.h>
 #include "VrpnBasedConnection.h"
 #include "GenericConnectionDevice.h"
@@ -84,6 +85,7 @@ namespace connection {
     /// Wraps the derived implementation for future expandability.
     MessageTypePtr
     Connection::registerMessageType(std::string const &messageId) {
+        pluginhost::waitForHostAccess();
         return m_registerMessageType(messageId);
     }
 
@@ -96,6 +98,7 @@ namespace connection {
 
     ConnectionDevicePtr
     Connection::createConnectionDevice(DeviceInitObject &init) {
+        pluginhost::waitForHostAccess();
         ConnectionDevicePtr dev = m_createConnectionDevice(init);
         if (dev) {
             addDevice(dev);
@@ -107,6 +110,7 @@ namespace connection {
     Connection::registerAdvancedDevice(std::string const &deviceName,
                                        OSVR_DeviceUpdateCallback updateFunction,
                                        void *userdata) {
+        pluginhost::waitForHostAccess();
         ConnectionDevicePtr dev(
             new GenericConnectionDevice(deviceName, [updateFunction, userdata] {
                 return updateFunction(userdata);
@@ -119,6 +123,7 @@ namespace connection {
     Connection::registerAdvancedDevice(NameList const &deviceNames,
                                        OSVR_DeviceUpdateCallback updateFunction,
                                        void *userdata) {
+        pluginhost::waitForHostAccess();
         ConnectionDevicePtr dev(new GenericConnectionDevice(
             deviceNames,
             [updateFunction, userdata] { return updateFunction(userdata); }));
@@ -157,6 +162,7 @@ namespace connection {
     }
 
     void Connection::triggerDescriptorHandlers() {
+        pluginhost::waitForHostAccess();
         for (auto &handler : m_descriptorHandlers) {
             handler();
         }
@@ -38,15 +38,21 @@
 namespace osvr {
 namespace connection {
     class vrpn_BaseFlexServer;
+    class VrpnTrackerServer;
     class DeviceConstructionData : boost::noncopyable {
       public:
         DeviceConstructionData(DeviceInitObject &initObject,
-                               vrpn_Connection *connection)
-            : obj(initObject), conn(connection), flexServer(nullptr) {}
+                               vrpn_Connection *connection, int listenPort)
+            : obj(initObject), conn(connection), port(listenPort),
+              flexServer(nullptr), trackerServer(nullptr) {}
         std::string getQualifiedName() const { return obj.getQualifiedName(); }
         DeviceInitObject &obj;
         vrpn_Connection *conn;
+        /// @brief The port the connection listens on, or 0 if it doesn't.
+        int port;
         vrpn_BaseFlexServer *flexServer;
+        /// @brief Set if the device has a tracker interface.
+        VrpnTrackerServer *trackerServer;
     };
 } // namespace connection
 } // namespace osvr
@@ -79,6 +79,9 @@ namespace connection {
         }
         m_vrpnConnection = vrpn_ConnectionPtr::create_server_connection(
             port, nullptr, nullptr, iface);
+        // A loopback connection doesn't listen at all.
+        bool loopback = iface && std::string(iface) == "loopback:";
+        m_port = loopback ? 0 : port;
     }
 
     MessageTypePtr
@@ -90,7 +93,7 @@ namespace connection {
     ConnectionDevicePtr
     VrpnBasedConnection::m_createConnectionDevice(DeviceInitObject &init) {
         ConnectionDevicePtr ret =
-            make_shared<VrpnConnectionDevice>(init, m_vrpnConnection);
+            make_shared<VrpnConnectionDevice>(init, m_vrpnConnection, m_port);
         return ret;
     }
 
@@ -78,6 +78,8 @@ namespace connection {
                                                      vrpn_HANDLERPARAM);
 
         vrpn_ConnectionPtr m_vrpnConnection;
+        /// @brief The port we listen on, or 0 for a loopback connection.
+        int m_port = 0;
         std::vector<std::function<void()> > m_connectionHandlers;
         common::NetworkingSupport m_network;
     };
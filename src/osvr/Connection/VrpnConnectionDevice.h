@@ -30,6 +30,7 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/UniquePtr.h>
 #include "VrpnBaseFlexServer.h"
+#include "VrpnTrackerServer.h"
 #include "GenerateVrpnDynamicServer.h"
 
 // Library/third-party includes
@@ -44,11 +45,12 @@ namespace connection {
     class VrpnConnectionDevice : public ConnectionDevice {
       public:
         VrpnConnectionDevice(DeviceInitObject &init,
-                             vrpn_ConnectionPtr const &vrpnConn)
+                             vrpn_ConnectionPtr const &vrpnConn, int port)
             : ConnectionDevice(init.getQualifiedName()) {
-            DeviceConstructionData data(init, vrpnConn.get());
+            DeviceConstructionData data(init, vrpnConn.get(), port);
             m_server.reset(generateVrpnDynamicServer(data));
             m_baseobj = data.flexServer;
+            m_tracker = data.trackerServer;
             for (auto const &component : init.getComponents()) {
                 m_baseobj->addComponent(component);
             }
@@ -58,6 +60,9 @@ namespace connection {
             m_getDeviceToken().connectionInteract();
             m_server->mainloop();
             m_baseobj->mainloop();
+            if (m_tracker) {
+                m_tracker->heartbeat();
+            }
         }
         virtual void m_sendData(util::time::TimeValue const &timestamp,
                                 MessageType *type, const char *bytestream,
@@ -68,6 +73,8 @@ namespace connection {
 
       private:
         vrpn_BaseFlexServer *m_baseobj;
+        /// @brief Part of m_server, if the device has a tracker interface.
+        VrpnTrackerServer *m_tracker;
         unique_ptr<vrpn_MainloopObject> m_server;
     };
 } // namespace connection
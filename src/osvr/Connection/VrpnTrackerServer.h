@@ -27,6 +27,8 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include <osvr/Common/InProcessReportRouter.h>
+#include <osvr/Common/TrackerReportRing.h>
 #include <osvr/Connection/TrackerServerInterface.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
@@ -44,7 +46,13 @@ namespace connection {
       public:
         typedef vrpn_Tracker Base;
         VrpnTrackerServer(DeviceConstructionData &init)
-            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn) {
+            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn),
+              m_router(common::InProcessReportRouter::get(init.conn)),
+              m_inProcess(
+                  m_router->getTrackerChannel(init.getQualifiedName())),
+              m_ring(init.port ? common::TrackerReportRing::create(
+                                     init.getQualifiedName(), init.port)
+                               : nullptr) {
             // Initialize data
             m_resetPos();
             m_resetQuat();
@@ -52,8 +60,21 @@ namespace connection {
             m_resetVel();
             m_resetAccel();
 
+            m_inProcess->addPublisher();
+
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
+            init.trackerServer = this;
+        }
+        ~VrpnTrackerServer() { m_inProcess->removePublisher(); }
+
+        /// @brief Called every pass of the server loop, so clients reading
+        /// the shared memory ring know the server is alive even when the
+        /// device isn't sending.
+        void heartbeat() {
+            if (m_ring) {
+                m_ring->heartbeat();
+            }
         }
         static const vrpn_uint32 CLASS_OF_SERVICE = vrpn_CONNECTION_LOW_LATENCY;
 
@@ -136,6 +157,15 @@ namespace connection {
         }
 
       private:
+        /// @brief Held so the router outlives our channel.
+        common::InProcessReportRouterPtr m_router;
+        /// @brief Passes reports directly to consumers in this process, such
+        /// as analysis plugins.
+        common::TrackerReportChannelPtr m_inProcess;
+        /// @brief Passes reports to clients on this machine through shared
+        /// memory: null if it couldn't be created.
+        common::TrackerReportRingPtr m_ring;
+
         void m_resetVec3(vrpn_float64 vec[3]) {
             vec[0] = 0;
             vec[1] = 0;
@@ -172,6 +202,16 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp,
                                        Base::position_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
+
+            if (m_inProcess->hasSubscribers() || m_ring) {
+                OSVR_PoseState pose;
+                osvrVec3FromQuatlib(&(pose.translation), Base::pos);
+                osvrQuatFromQuatlib(&(pose.rotation), Base::d_quat);
+                m_inProcess->sendPose(ts, sensor, pose);
+                if (m_ring) {
+                    m_ring->sendPose(ts, sensor, pose);
+                }
+            }
         }
 
         void m_sendVelocity(OSVR_ChannelCount sensor,
@@ -184,6 +224,21 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp,
                                        Base::velocity_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
+
+            if (m_inProcess->hasSubscribers() || m_ring) {
+                OSVR_VelocityState vel;
+                osvrVec3FromQuatlib(&(vel.linearVelocity), Base::vel);
+                vel.linearVelocityValid = true;
+                osvrQuatFromQuatlib(
+                    &(vel.angularVelocity.incrementalRotation),
+                    Base::vel_quat);
+                vel.angularVelocity.dt = Base::vel_quat_dt;
+                vel.angularVelocityValid = true;
+                m_inProcess->sendVelocity(ts, sensor, vel);
+                if (m_ring) {
+                    m_ring->sendVelocity(ts, sensor, vel);
+                }
+            }
         }
 
         void m_sendAccel(OSVR_ChannelCount sensor,
@@ -196,6 +251,21 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp, Base::accel_m_id,
                                        Base::d_sender_id, msgbuf,
                                        CLASS_OF_SERVICE);
+
+            if (m_inProcess->hasSubscribers() || m_ring) {
+                OSVR_AccelerationState accel;
+                osvrVec3FromQuatlib(&(accel.linearAcceleration), Base::acc);
+                accel.linearAccelerationValid = true;
+                osvrQuatFromQuatlib(
+                    &(accel.angularAcceleration.incrementalRotation),
+                    Base::acc_quat);
+                accel.angularAcceleration.dt = Base::acc_quat_dt;
+                accel.angularAccelerationValid = true;
+                m_inProcess->sendAcceleration(ts, sensor, accel);
+                if (m_ring) {
+                    m_ring->sendAcceleration(ts, sensor, accel);
+                }
+            }
         }
     };
 
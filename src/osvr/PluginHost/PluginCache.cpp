@@ -0,0 +1,291 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PluginCache.h"
+#include <osvr/Util/GetEnvironmentVariable.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem.hpp>
+
+// Standard includes
+#include <fstream>
+#include <stdexcept>
+
+namespace osvr {
+namespace pluginhost {
+    namespace fs = boost::filesystem;
+
+    /// First line of the cache file: bump the version if the format changes.
+    static const char CACHE_HEADER[] = "OSVRPluginCache\t1";
+    static const char CACHE_FILENAME[] = "PluginCache.txt";
+
+    bool canDeferLoading(PluginManifest const &manifest) {
+        return manifest.known && !manifest.hardwareDetect &&
+               !manifest.touchesHost && !manifest.drivers.empty();
+    }
+
+    std::string getPluginCacheFilePath() {
+        using osvr::util::getEnvironmentVariable;
+        auto setting = getEnvironmentVariable("OSVR_PLUGIN_CACHE");
+        if (setting && !setting->empty()) {
+            if (*setting == "0") {
+                return std::string();
+            }
+            return *setting;
+        }
+
+        fs::path cacheDir;
+#if defined(OSVR_ANDROID)
+        return std::string();
+#elif defined(OSVR_LINUX)
+        // Non-essential, regenerable data: $XDG_CACHE_HOME, or $HOME/.cache
+        auto xdg_cache_dir = getEnvironmentVariable("XDG_CACHE_HOME");
+        if (xdg_cache_dir) {
+            cacheDir = *xdg_cache_dir;
+        } else {
+            auto home_dir = getEnvironmentVariable("HOME");
+            if (!home_dir) {
+                return std::string();
+            }
+            cacheDir = fs::path(*home_dir) / ".cache";
+        }
+        cacheDir /= "osvr";
+#elif defined(OSVR_MACOSX)
+        auto home_dir = getEnvironmentVariable("HOME");
+        if (!home_dir) {
+            return std::string();
+        }
+        cacheDir = fs::path(*home_dir) / "Library" / "Caches" / "OSVR";
+#elif defined(OSVR_WINDOWS)
+        auto local_app_dir = getEnvironmentVariable("LocalAppData");
+        if (!local_app_dir) {
+            return std::string();
+        }
+        cacheDir = fs::path(*local_app_dir) / "OSVR" / "Cache";
+#else
+        return std::string();
+#endif
+        return (cacheDir / CACHE_FILENAME).string();
+    }
+
+    namespace {
+        /// Modification time and size of a file, or nothing if we can't tell.
+        bool statFile(std::string const &path, std::time_t &mtime,
+                      std::uintmax_t &size) {
+            boost::system::error_code ec;
+            mtime = fs::last_write_time(path, ec);
+            if (ec) {
+                return false;
+            }
+            size = fs::file_size(path, ec);
+            return !ec;
+        }
+    } // namespace
+
+    PluginCache::PluginCache(std::string const &filename)
+        : m_filename(filename) {
+        try {
+            m_load();
+        } catch (std::exception &) {
+            // Malformed - ignore it and it'll be replaced.
+            m_dirs.clear();
+            m_plugins.clear();
+            m_dirty = true;
+        }
+    }
+
+    void PluginCache::m_load() {
+        std::ifstream file(m_filename);
+        if (!file) {
+            return;
+        }
+        std::string line;
+        if (!std::getline(file, line) || line != CACHE_HEADER) {
+            throw std::runtime_error("Not a plugin cache of this version");
+        }
+        std::vector<std::string> fields;
+        Directory *currentDir = nullptr;
+        while (std::getline(file, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            boost::algorithm::split(fields, line, [](char c) {
+                return c == '\t';
+            });
+            if (fields[0] == "D" && fields.size() == 3) {
+                // D <mtime> <directory> - followed by the P lines for the
+                // plugin files found in it.
+                auto &dir = m_dirs[fields[2]];
+                dir.mtime = static_cast<std::time_t>(std::stoll(fields[1]));
+                currentDir = &dir;
+            } else if (fields[0] == "P" && fields.size() >= 7 && currentDir) {
+                // P <path> <mtime> <size> <known> <hardwareDetect>
+                // <touchesHost> [<driver>...]
+                PluginManifest manifest;
+                manifest.mtime =
+                    static_cast<std::time_t>(std::stoll(fields[2]));
+                manifest.size = std::stoull(fields[3]);
+                manifest.known = fields[4] == "1";
+                manifest.hardwareDetect = fields[5] == "1";
+                manifest.touchesHost = fields[6] == "1";
+                manifest.drivers.assign(fields.begin() + 7, fields.end());
+                currentDir->files.push_back(fields[1]);
+                m_plugins[fields[1]] = std::move(manifest);
+            } else {
+                throw std::runtime_error("Malformed plugin cache line");
+            }
+        }
+    }
+
+    FileList PluginCache::getAllFilesWithExt(SearchPath const &dirPath,
+                                             std::string const &ext) {
+        FileList filesPaths;
+        for (auto const &path : dirPath) {
+            boost::system::error_code ec;
+            auto mtime = fs::last_write_time(path, ec);
+            if (ec) {
+                // Doesn't exist (any more)
+                if (m_dirs.erase(path)) {
+                    m_dirty = true;
+                }
+                continue;
+            }
+            auto &dir = m_dirs[path];
+            if (dir.mtime != mtime || dir.files.empty()) {
+                // Added, removed, or renamed files: walk it again. Manifests
+                // of files still present stay valid as long as the files
+                // themselves haven't changed, checked below.
+                dir.mtime = mtime;
+                dir.files =
+                    pluginhost::getAllFilesWithExt(SearchPath{path}, ext);
+                m_dirty = true;
+            }
+
+            for (auto const &file : dir.files) {
+                std::time_t fileTime;
+                std::uintmax_t fileSize;
+                if (!statFile(file, fileTime, fileSize)) {
+                    continue;
+                }
+                auto &manifest = m_plugins[file];
+                if (manifest.mtime != fileTime || manifest.size != fileSize) {
+                    // New or replaced in place: forget what we knew.
+                    manifest = PluginManifest{};
+                    manifest.mtime = fileTime;
+                    manifest.size = fileSize;
+                    m_dirty = true;
+                }
+                filesPaths.push_back(file);
+            }
+        }
+        return filesPaths;
+    }
+
+    PluginManifest const *
+    PluginCache::getManifest(std::string const &pluginPath) const {
+        auto it = m_plugins.find(pluginPath);
+        if (it == end(m_plugins) || !it->second.known) {
+            return nullptr;
+        }
+        return &(it->second);
+    }
+
+    void PluginCache::recordManifest(std::string const &pluginPath,
+                                     bool hardwareDetect, bool touchesHost,
+                                     std::vector<std::string> const &drivers) {
+        auto it = m_plugins.find(pluginPath);
+        if (it == end(m_plugins)) {
+            // Not something we found in a search directory.
+            return;
+        }
+        auto &manifest = it->second;
+        if (manifest.known && manifest.hardwareDetect == hardwareDetect &&
+            manifest.touchesHost == touchesHost &&
+            manifest.drivers == drivers) {
+            return;
+        }
+        manifest.known = true;
+        manifest.hardwareDetect = hardwareDetect;
+        manifest.touchesHost = touchesHost;
+        manifest.drivers = drivers;
+        m_dirty = true;
+    }
+
+    bool PluginCache::save() {
+        if (!m_dirty) {
+            return true;
+        }
+        boost::system::error_code ec;
+        auto target = fs::path(m_filename);
+        if (target.has_parent_path()) {
+            fs::create_directories(target.parent_path(), ec);
+        }
+        // Write to a temporary, then rename, so another server starting up
+        // never sees a partial file.
+        auto temp = target;
+        temp += ".tmp";
+        {
+            std::ofstream file(temp.string(), std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            file << CACHE_HEADER << "\n";
+            for (auto const &dir : m_dirs) {
+                file << "D\t" << static_cast<long long>(dir.second.mtime)
+                     << "\t" << dir.first << "\n";
+                for (auto const &pluginPath : dir.second.files) {
+                    auto it = m_plugins.find(pluginPath);
+                    if (it == end(m_plugins)) {
+                        continue;
+                    }
+                    auto const &manifest = it->second;
+                    file << "P\t" << pluginPath << "\t"
+                         << static_cast<long long>(manifest.mtime) << "\t"
+                         << manifest.size << "\t" << manifest.known << "\t"
+                         << manifest.hardwareDetect << "\t"
+                         << manifest.touchesHost;
+                    for (auto const &driver : manifest.drivers) {
+                        file << "\t" << driver;
+                    }
+                    file << "\n";
+                }
+            }
+            if (!file) {
+                return false;
+            }
+        }
+        fs::rename(temp, target, ec);
+        if (ec) {
+            fs::remove(temp, ec);
+            return false;
+        }
+        m_dirty = false;
+        return true;
+    }
+
+} // namespace pluginhost
+} // namespace osvr
@@ -0,0 +1,120 @@
+/** @file
+    @brief Header for an on-disk cache of plugin search results and of what
+    each plugin registered when loaded.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PluginCache_h_GUID_982CF3F2_D239_40CF_A656_E8A52C452A36
+#define INCLUDED_PluginCache_h_GUID_982CF3F2_D239_40CF_A656_E8A52C452A36
+
+// Internal Includes
+#include <osvr/PluginHost/SearchPath.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace pluginhost {
+
+    /// @brief What we know about a plugin library file.
+    struct PluginManifest {
+        /// @name Identity of the file this describes
+        /// @{
+        std::time_t mtime = 0;
+        std::uintmax_t size = 0;
+        /// @}
+
+        /// @brief Whether the following have been recorded from actually
+        /// loading the plugin.
+        bool known = false;
+        /// @brief Whether it registered any hardware detect callbacks.
+        bool hardwareDetect = false;
+        /// @brief Whether its entry point called into the host (created
+        /// devices, registered message types, etc.)
+        bool touchesHost = false;
+        /// @brief Names of the drivers it registered.
+        std::vector<std::string> drivers;
+    };
+
+    /// @brief Whether, going by its manifest, loading a plugin can wait until
+    /// one of its drivers is instantiated: only true of plugins that did
+    /// nothing but register drivers.
+    bool canDeferLoading(PluginManifest const &manifest);
+
+    /// @brief Gets the file to use for the plugin cache, or an empty string
+    /// if caching is disabled (by setting the environment variable
+    /// OSVR_PLUGIN_CACHE to 0) or there's no suitable location. Setting
+    /// OSVR_PLUGIN_CACHE to anything else uses that as the filename.
+    std::string getPluginCacheFilePath();
+
+    /// @brief Caches the plugin files found in each search directory, keyed
+    /// by the directory's modification time, along with a manifest for each
+    /// plugin file, keyed by its modification time and size.
+    ///
+    /// A missing or unreadable cache file just means starting from scratch.
+    class PluginCache : boost::noncopyable {
+      public:
+        explicit PluginCache(std::string const &filename);
+
+        /// @brief Like pluginhost::getAllFilesWithExt(), but only walks
+        /// directories that have changed since the cache was written.
+        /// Also discards manifests of any files that have changed.
+        FileList getAllFilesWithExt(SearchPath const &dirPath,
+                                    std::string const &ext);
+
+        /// @brief Gets the manifest of a plugin file returned by
+        /// getAllFilesWithExt(), if it has been recorded and the file hasn't
+        /// changed since.
+        PluginManifest const *getManifest(std::string const &pluginPath) const;
+
+        /// @brief Records what a plugin registered when loaded.
+        void recordManifest(std::string const &pluginPath, bool hardwareDetect,
+                            bool touchesHost,
+                            std::vector<std::string> const &drivers);
+
+        /// @brief Writes the cache back out, if anything changed.
+        /// @return false if it couldn't be written.
+        bool save();
+
+      private:
+        void m_load();
+        struct Directory {
+            std::time_t mtime = 0;
+            FileList files;
+        };
+        std::string m_filename;
+        std::map<std::string, Directory> m_dirs;
+        std::map<std::string, PluginManifest> m_plugins;
+        bool m_dirty = false;
+    };
+
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_PluginCache_h_GUID_982CF3F2_D239_40CF_A656_E8A52C452A36
@@ -99,6 +99,15 @@ namespace pluginhost {
         }
     }
 
+    std::vector<std::string>
+    PluginSpecificRegistrationContextImpl::getDriverNames() const {
+        std::vector<std::string> ret;
+        for (auto const &driver : m_driverInstantiationCallbacks) {
+            ret.push_back(driver.first);
+        }
+        return ret;
+    }
+
     void PluginSpecificRegistrationContextImpl::instantiateDriver(
         const std::string &driverName, const std::string &params) const {
         auto it = m_driverInstantiationCallbacks.find(driverName);
@@ -85,6 +85,16 @@ namespace pluginhost {
         /// if any.
         void triggerHardwareDetectCallbacks();
 
+        /// @brief Whether this plugin registered any hardware detect
+        /// callbacks.
+        bool hasHardwareDetectCallbacks() const {
+            return !m_hardwareDetectCallbacks.empty();
+        }
+
+        /// @brief Get the names of the drivers this plugin registered, in
+        /// sorted order.
+        std::vector<std::string> getDriverNames() const;
+
         /// @brief Call a driver instantiation callback for the given driver
         /// name.
         /// @throws std::runtime_error if there is no driver registered by that
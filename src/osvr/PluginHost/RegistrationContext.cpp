@@ -30,7 +30,9 @@
 // Internal Includes
 #include <osvr/PluginHost/RegistrationContext.h>
 
+#include "PluginCache.h"
 #include "PluginSpecificRegistrationContextImpl.h"
+#include "StartupConcurrency.h"
 #include <osvr/PluginHost/PathConfig.h>
 #include <osvr/PluginHost/SearchPath.h>
 #include <osvr/Util/Log.h>
@@ -46,7 +48,10 @@
 
 // Standard includes
 #include <algorithm>
+#include <exception>
 #include <iterator>
+#include <thread>
+#include <vector>
 
 namespace osvr {
 namespace pluginhost {
@@ -61,6 +66,10 @@ namespace pluginhost {
         Impl() : pluginPaths(pluginhost::getPluginSearchPath()) {}
 
         const std::vector<std::string> pluginPaths;
+
+        /// Plugins that loadPlugins() found but didn't need to load yet, by
+        /// name, with their paths.
+        std::map<std::string, std::string> deferredPlugins;
     };
 
     RegistrationContext::RegistrationContext()
@@ -111,10 +120,18 @@ namespace pluginhost {
     }
 
     void RegistrationContext::loadPlugin(std::string const &pluginName) {
+        m_loadPluginFromPath(
+            pluginName,
+            pluginhost::findPlugin(m_impl->pluginPaths, pluginName));
+    }
+
+    void RegistrationContext::m_loadPluginFromPath(
+        std::string const &pluginName, std::string const &pluginPathName) {
         if (isPluginLoaded(m_regMap, pluginName)) {
             throw std::runtime_error("Already loaded a plugin named " +
                                      pluginName);
         }
+        m_impl->deferredPlugins.erase(pluginName);
 
         PluginRegPtr pluginReg(
             PluginSpecificRegistrationContext::create(pluginName));
@@ -123,8 +140,6 @@ namespace pluginhost {
         bool success = false;
         libfunc::PluginHandle plugin;
         auto ctx = pluginReg->extractOpaquePointer();
-        const std::string pluginPathName =
-            pluginhost::findPlugin(m_impl->pluginPaths, pluginName);
         if (pluginPathName.empty()) {
             // was the plugin pre-loaded or statically linked? Try loading
             // it by name.
@@ -156,11 +171,30 @@ namespace pluginhost {
     }
 
     void RegistrationContext::loadPlugins() {
+        const auto startTime = StartupClock::now();
+        unique_ptr<PluginCache> cache;
+        {
+            auto cacheFile = getPluginCacheFilePath();
+            if (!cacheFile.empty()) {
+                m_logger->debug() << "Using plugin cache " << cacheFile;
+                cache.reset(new PluginCache(cacheFile));
+            }
+        }
+
         // Build a list of all the plugins we can find
-        auto pluginPathNames = pluginhost::getAllFilesWithExt(
-            m_impl->pluginPaths, OSVR_PLUGIN_EXTENSION);
+        auto pluginPathNames =
+            cache ? cache->getAllFilesWithExt(m_impl->pluginPaths,
+                                              OSVR_PLUGIN_EXTENSION)
+                  : pluginhost::getAllFilesWithExt(m_impl->pluginPaths,
+                                                   OSVR_PLUGIN_EXTENSION);
+
+        struct PluginToLoad {
+            std::string name;
+            std::string path;
+        };
+        std::vector<PluginToLoad> pluginsToLoad;
 
-        // Load all of the non-.manualload plugins
+        // Collect all of the non-.manualload plugins
         for (const auto &plugin : pluginPathNames) {
             m_logger->debug() << "Examining plugin '" << plugin << "'...";
             const auto pluginBaseName =
@@ -193,10 +227,91 @@ namespace pluginhost {
 #endif // NDEBUG
 #endif // _MSC_VER
 
+            pluginsToLoad.push_back(PluginToLoad{pluginBaseName, plugin});
+        }
+
+        // Register in a deterministic order regardless of directory
+        // enumeration order: the stable sort keeps the search path order
+        // among same-named plugins, so the first one found still wins.
+        std::stable_sort(begin(pluginsToLoad), end(pluginsToLoad),
+                         [](PluginToLoad const &a, PluginToLoad const &b) {
+                             return a.name < b.name;
+                         });
+        pluginsToLoad.erase(
+            std::unique(begin(pluginsToLoad), end(pluginsToLoad),
+                        [&](PluginToLoad const &a, PluginToLoad const &b) {
+                            if (a.name != b.name) {
+                                return false;
+                            }
+                            m_logger->warn()
+                                << "Ignoring " << b.path
+                                << ": already found a plugin named " << a.name
+                                << " at " << a.path;
+                            return true;
+                        }),
+            end(pluginsToLoad));
+
+        // Set aside those the cache says we won't need unless one of their
+        // drivers gets instantiated.
+        if (cache) {
+            auto deferredEnd = std::stable_partition(
+                begin(pluginsToLoad), end(pluginsToLoad),
+                [&](PluginToLoad const &plugin) {
+                    auto manifest = cache->getManifest(plugin.path);
+                    return !(manifest && canDeferLoading(*manifest));
+                });
+            for (auto it = deferredEnd, e = end(pluginsToLoad); it != e;
+                 ++it) {
+                if (isPluginLoaded(m_regMap, it->name)) {
+                    continue;
+                }
+                m_logger->debug() << "Deferring load of driver-only plugin "
+                                  << it->name;
+                m_impl->deferredPlugins.emplace(it->name, it->path);
+            }
+            pluginsToLoad.erase(deferredEnd, end(pluginsToLoad));
+        }
+
+        const auto numPlugins = pluginsToLoad.size();
+        const auto threads = getStartupConcurrency();
+        const bool preloading = threads > 1 && numPlugins > 1;
+
+        // Get the libraries mapped, relocated, and statically initialized in
+        // parallel: that's the bulk of the cost, and doesn't involve us. We
+        // hold on to them until all the entry points have been called.
+        std::vector<unique_ptr<PreloadedLibrary> > preloaded(numPlugins);
+        std::vector<double> preloadTimes(numPlugins, 0.);
+        if (preloading) {
+            m_logger->info() << "Loading " << numPlugins << " plugins using "
+                             << threads << " threads";
+            forEachConcurrently(numPlugins, threads, [&](std::size_t i) {
+                auto preloadStart = StartupClock::now();
+                try {
+                    preloaded[i].reset(
+                        new PreloadedLibrary(pluginsToLoad[i].path));
+                } catch (...) {
+                    // Just a head start: the real load below reports errors.
+                }
+                preloadTimes[i] = millisecondsSince(preloadStart);
+            });
+        }
+
+        // Call the entry points serially, in order.
+        for (std::size_t i = 0; i < numPlugins; ++i) {
+            auto const &pluginBaseName = pluginsToLoad[i].name;
+            auto registerStart = StartupClock::now();
             try {
-                loadPlugin(pluginBaseName);
+                auto hostAccesses = getHostAccessCount();
+                m_loadPluginFromPath(pluginBaseName, pluginsToLoad[i].path);
                 m_logger->debug() << "Successfully loaded plugin: "
                                   << pluginBaseName;
+                if (cache) {
+                    auto const &reg = *m_regMap[pluginBaseName];
+                    cache->recordManifest(
+                        pluginsToLoad[i].path, reg.hasHardwareDetectCallbacks(),
+                        getHostAccessCount() != hostAccesses,
+                        reg.getDriverNames());
+                }
             } catch (const std::exception &e) {
                 m_logger->warn() << "Failed to load plugin " << pluginBaseName
                                  << ": " << e.what();
@@ -204,7 +319,52 @@ namespace pluginhost {
                 m_logger->warn() << "Failed to load plugin " << pluginBaseName
                                  << ": Unknown error.";
             }
+            auto registerTime = millisecondsSince(registerStart);
+            if (preloading) {
+                m_logger->info()
+                    << "Plugin " << pluginBaseName << ": preload "
+                    << preloadTimes[i] << " ms, register " << registerTime
+                    << " ms";
+            } else {
+                m_logger->info() << "Plugin " << pluginBaseName << ": load "
+                                 << registerTime << " ms";
+            }
+        }
+        preloaded.clear();
+        if (cache && !cache->save()) {
+            m_logger->debug() << "Could not write plugin cache";
         }
+        if (!m_impl->deferredPlugins.empty()) {
+            m_logger->info() << "Deferred loading "
+                             << m_impl->deferredPlugins.size()
+                             << " driver-only plugins until needed";
+        }
+        m_logger->info() << "Loaded plugins in "
+                         << millisecondsSince(startTime) << " ms";
+    }
+
+    bool
+    RegistrationContext::loadDeferredPlugin(std::string const &pluginName) {
+        auto it = m_impl->deferredPlugins.find(pluginName);
+        if (it == end(m_impl->deferredPlugins)) {
+            return false;
+        }
+        // m_loadPluginFromPath removes it from the map.
+        const auto path = it->second;
+        m_logger->debug() << "Loading deferred plugin " << pluginName;
+        m_loadPluginFromPath(pluginName, path);
+        return true;
+    }
+
+    void RegistrationContext::setStartupConcurrency(std::size_t threads) {
+        m_startupConcurrency = threads;
+    }
+
+    std::size_t RegistrationContext::getStartupConcurrency() const {
+        if (m_startupConcurrency == 0) {
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        return m_startupConcurrency;
     }
 
     void RegistrationContext::adoptPluginRegistrationContext(PluginRegPtr ctx) {
@@ -216,9 +376,56 @@ namespace pluginhost {
     }
 
     void RegistrationContext::triggerHardwareDetect() {
+        std::vector<PluginSpecificRegistrationContextImpl *> plugins;
         for (auto &pluginPtr : m_regMap | boost::adaptors::map_values) {
-            pluginPtr->triggerHardwareDetectCallbacks();
+            if (pluginPtr->hasHardwareDetectCallbacks()) {
+                plugins.push_back(pluginPtr.get());
+            }
+        }
+        const auto numPlugins = plugins.size();
+        const auto threads = getStartupConcurrency();
+        std::vector<double> detectTimes(numPlugins, 0.);
+        auto startTime = StartupClock::now();
+
+        if (threads <= 1 || numPlugins <= 1) {
+            for (std::size_t i = 0; i < numPlugins; ++i) {
+                auto detectStart = StartupClock::now();
+                plugins[i]->triggerHardwareDetectCallbacks();
+                detectTimes[i] = millisecondsSince(detectStart);
+            }
+        } else {
+            // Probing runs in parallel, but the sequencer makes sure devices
+            // get created (via waitForHostAccess()) one plugin at a time, in
+            // the same order as above.
+            std::vector<std::exception_ptr> errors(numPlugins);
+            {
+                HostAccessSequencer sequencer(numPlugins);
+                forEachConcurrently(numPlugins, threads, [&](std::size_t i) {
+                    auto detectStart = StartupClock::now();
+                    sequencer.beginTask(i);
+                    try {
+                        plugins[i]->triggerHardwareDetectCallbacks();
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                    sequencer.endTask(i);
+                    detectTimes[i] = millisecondsSince(detectStart);
+                });
+            }
+            for (auto &e : errors) {
+                if (e) {
+                    std::rethrow_exception(e);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < numPlugins; ++i) {
+            m_logger->debug() << "Plugin " << plugins[i]->getName()
+                              << ": hardware detect " << detectTimes[i]
+                              << " ms";
         }
+        m_logger->info() << "Hardware detection took "
+                         << millisecondsSince(startTime) << " ms";
     }
 
     void
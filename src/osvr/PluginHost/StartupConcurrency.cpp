@@ -0,0 +1,187 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "StartupConcurrency.h"
+#include <osvr/PluginHost/HostAccess.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+#include <boost/filesystem.hpp>
+
+#if defined(OSVR_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace pluginhost {
+
+    void forEachConcurrently(std::size_t n, std::size_t threads,
+                             std::function<void(std::size_t)> const &f) {
+        auto numThreads = std::min(threads, n);
+        if (numThreads <= 1) {
+            for (std::size_t i = 0; i < n; ++i) {
+                f(i);
+            }
+            return;
+        }
+        std::atomic<std::size_t> next(0);
+        auto worker = [&] {
+            for (;;) {
+                auto i = next.fetch_add(1);
+                if (i >= n) {
+                    return;
+                }
+                f(i);
+            }
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(numThreads - 1);
+        for (std::size_t i = 1; i < numThreads; ++i) {
+            pool.emplace_back(worker);
+        }
+        // The calling thread pitches in too.
+        worker();
+        for (auto &thread : pool) {
+            thread.join();
+        }
+    }
+
+#if defined(OSVR_WINDOWS)
+    PreloadedLibrary::PreloadedLibrary(std::string const &path)
+        : m_handle(nullptr) {
+        auto nativePath = boost::filesystem::path(path).make_preferred();
+        m_handle = LoadLibraryW(nativePath.wstring().c_str());
+    }
+
+    PreloadedLibrary::~PreloadedLibrary() {
+        if (m_handle) {
+            FreeLibrary(static_cast<HMODULE>(m_handle));
+        }
+    }
+#else
+    PreloadedLibrary::PreloadedLibrary(std::string const &path)
+        : m_handle(dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)) {}
+
+    PreloadedLibrary::~PreloadedLibrary() {
+        if (m_handle) {
+            dlclose(m_handle);
+        }
+    }
+#endif
+
+    namespace {
+        /// State shared between HostAccessSequencer and waitForHostAccess().
+        /// Only one concurrent detection round can be in progress at a time.
+        struct SequencerState {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool active = false;
+            /// Lowest ticket whose task has not yet finished.
+            std::size_t turn = 0;
+            std::vector<bool> finished;
+            std::map<std::thread::id, std::size_t> tickets;
+        };
+
+        SequencerState &getSequencerState() {
+            static SequencerState state;
+            return state;
+        }
+
+        std::atomic<std::size_t> g_hostAccessCount(0);
+    } // namespace
+
+    std::size_t getHostAccessCount() { return g_hostAccessCount.load(); }
+
+    HostAccessSequencer::HostAccessSequencer(std::size_t numTasks) {
+        auto &state = getSequencerState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        BOOST_ASSERT_MSG(!state.active, "Only one concurrent detection round "
+                                        "may be in progress at a time!");
+        state.active = true;
+        state.turn = 0;
+        state.finished.assign(numTasks, false);
+        state.tickets.clear();
+    }
+
+    HostAccessSequencer::~HostAccessSequencer() {
+        auto &state = getSequencerState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.active = false;
+        state.tickets.clear();
+        state.cv.notify_all();
+    }
+
+    void HostAccessSequencer::beginTask(std::size_t ticket) {
+        auto &state = getSequencerState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.tickets[std::this_thread::get_id()] = ticket;
+    }
+
+    void HostAccessSequencer::endTask(std::size_t ticket) {
+        auto &state = getSequencerState();
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.tickets.erase(std::this_thread::get_id());
+            state.finished[ticket] = true;
+            while (state.turn < state.finished.size() &&
+                   state.finished[state.turn]) {
+                ++state.turn;
+            }
+        }
+        state.cv.notify_all();
+    }
+
+    void waitForHostAccess() {
+        ++g_hostAccessCount;
+        auto &state = getSequencerState();
+        std::unique_lock<std::mutex> lock(state.mutex);
+        if (!state.active) {
+            return;
+        }
+        auto it = state.tickets.find(std::this_thread::get_id());
+        if (it == end(state.tickets)) {
+            // Not a detect task: not ours to hold up.
+            return;
+        }
+        auto ticket = it->second;
+        state.cv.wait(lock,
+                      [&] { return !state.active || state.turn >= ticket; });
+    }
+
+} // namespace pluginhost
+} // namespace osvr
@@ -0,0 +1,95 @@
+/** @file
+    @brief Header with internal helpers for loading plugins and running
+    hardware detection concurrently.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StartupConcurrency_h_GUID_88BE23A9_B2EE_475E_AEE3_28D1DAB58D0F
+#define INCLUDED_StartupConcurrency_h_GUID_88BE23A9_B2EE_475E_AEE3_28D1DAB58D0F
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace osvr {
+namespace pluginhost {
+
+    using StartupClock = std::chrono::steady_clock;
+
+    /// @brief Milliseconds elapsed since @p start, for timing reports.
+    inline double millisecondsSince(StartupClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(StartupClock::now() -
+                                                         start)
+            .count();
+    }
+
+    /// @brief Calls @p f with each index in [0, n), using up to @p threads
+    /// threads (including the calling one). Indices are handed out in
+    /// increasing order. @p f must not throw.
+    void forEachConcurrently(std::size_t n, std::size_t threads,
+                             std::function<void(std::size_t)> const &f);
+
+    /// @brief Opens a shared library without calling into it, so that the
+    /// expensive parts of loading (file I/O, relocation, static
+    /// initialization) can happen off the main thread. Loading it again by
+    /// path later - as libfunctionality does - then just bumps a reference
+    /// count.
+    class PreloadedLibrary : boost::noncopyable {
+      public:
+        explicit PreloadedLibrary(std::string const &path);
+        ~PreloadedLibrary();
+        explicit operator bool() const { return m_handle != nullptr; }
+
+      private:
+        void *m_handle;
+    };
+
+    /// @brief Number of calls to waitForHostAccess() so far, from any thread:
+    /// lets us notice whether a plugin's entry point called into the host.
+    std::size_t getHostAccessCount();
+
+    /// @brief Enables the sequencing performed by waitForHostAccess() for its
+    /// lifetime: create one around a concurrent round of hardware detection,
+    /// and bracket each task in it with beginTask()/endTask() on the thread
+    /// running it.
+    class HostAccessSequencer : boost::noncopyable {
+      public:
+        /// @param numTasks Number of tasks (tickets) in this round.
+        explicit HostAccessSequencer(std::size_t numTasks);
+        ~HostAccessSequencer();
+
+        void beginTask(std::size_t ticket);
+        void endTask(std::size_t ticket);
+    };
+
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_StartupConcurrency_h_GUID_88BE23A9_B2EE_475E_AEE3_28D1DAB58D0F
@@ -32,13 +32,15 @@
 #include <osvr/Connection/MessageType.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Util/PreciseSleep.h>
 #include <osvr/Util/Verbosity.h>
 #include "HandleNullContext.h"
 
 // Library/third-party includes
-#include <boost/thread.hpp>
+// - none
 
 // Standard includes
+#include <chrono>
 #include <string>
 
 OSVR_DeviceInitOptions
@@ -211,6 +213,6 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
 }
 
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
-    boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
+    osvr::util::time::sleepFor(std::chrono::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
 }
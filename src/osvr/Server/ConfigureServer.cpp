@@ -27,6 +27,7 @@
 #include <osvr/Server/Server.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/PluginHost/SearchPath.h>
+#include <osvr/Util/ThreadScheduling.h>
 #include <osvr/Util/Verbosity.h>
 #include "JSONResolvePossibleRef.h"
 
@@ -104,6 +105,63 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char SLEEP_SPIN_KEY[] = "sleepSpin";
+    static const char PARALLEL_STARTUP_KEY[] = "parallelStartup";
+    static const char REALTIME_KEY[] = "realtime";
+    static const char LOCK_MEMORY_KEY[] = "lockMemory";
+    static const char TIMER_SLACK_KEY[] = "timerSlackNanoseconds";
+    static const char REPORT_JITTER_KEY[] = "reportJitter";
+    static const char THREADS_KEY[] = "threads";
+    static const char POLICY_KEY[] = "policy";
+    static const char PRIORITY_KEY[] = "priority";
+    static const char CPUS_KEY[] = "cpus";
+
+    /// Parses the "realtime" member of the "server" section into the
+    /// process-wide real-time scheduling configuration.
+    static util::sched::RealtimeConfig
+    parseRealtimeConfig(Json::Value const &jsonRealtime) {
+        namespace sched = util::sched;
+        sched::RealtimeConfig config;
+        config.lockMemory =
+            jsonRealtime.get(LOCK_MEMORY_KEY, config.lockMemory).asBool();
+        Json::Value jsonSlack = jsonRealtime[TIMER_SLACK_KEY];
+        if (jsonSlack.isNumeric()) {
+            config.timerSlackNanoseconds =
+                static_cast<long>(jsonSlack.asDouble());
+        }
+        config.reportJitter =
+            jsonRealtime.get(REPORT_JITTER_KEY, config.reportJitter).asBool();
+
+        Json::Value const &jsonThreads = jsonRealtime[THREADS_KEY];
+        if (!jsonThreads.isObject()) {
+            return config;
+        }
+        for (auto const &roleName : jsonThreads.getMemberNames()) {
+            sched::ThreadRole role;
+            if (!sched::parseThreadRoleName(roleName, role)) {
+                throw std::invalid_argument("Unrecognized thread role in "
+                                            "realtime configuration: " +
+                                            roleName);
+            }
+            Json::Value const &jsonThread = jsonThreads[roleName];
+            auto &params = config[role];
+            auto policyName = jsonThread.get(POLICY_KEY, "fifo").asString();
+            if (!sched::parseSchedulingPolicy(policyName, params.policy)) {
+                throw std::invalid_argument(
+                    "Invalid scheduling policy for " + roleName +
+                    " thread: must be \"fifo\", \"rr\", or \"default\"");
+            }
+            params.priority = jsonThread.get(PRIORITY_KEY, 1).asInt();
+            if (params.priority < 1 || params.priority > 99) {
+                throw std::out_of_range("Invalid priority for " + roleName +
+                                        " thread: must be 1 to 99");
+            }
+            for (auto const &cpu : jsonThread[CPUS_KEY]) {
+                params.cpus.push_back(cpu.asInt());
+            }
+        }
+        return config;
+    }
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
@@ -115,6 +173,8 @@ namespace server {
 #else
         int sleepTime = 1000; // microseconds
 #endif
+        int sleepSpinTime = 0;              // microseconds
+        std::size_t startupConcurrency = 1; // serial
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -146,6 +206,32 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            // Also in milliseconds: the tail of each sleep to busy-wait.
+            Json::Value jsonSleepSpin = jsonServer[SLEEP_SPIN_KEY];
+            if (jsonSleepSpin.isNumeric()) {
+                sleepSpinTime =
+                    static_cast<int>(jsonSleepSpin.asDouble() * 1000.0);
+            }
+
+            // Either true (one thread per core) or a thread count.
+            Json::Value jsonParallelStartup = jsonServer[PARALLEL_STARTUP_KEY];
+            if (jsonParallelStartup.isBool()) {
+                startupConcurrency = jsonParallelStartup.asBool() ? 0 : 1;
+            } else if (jsonParallelStartup.isInt()) {
+                int threads = jsonParallelStartup.asInt();
+                if (threads < 1) {
+                    throw std::out_of_range("Invalid parallelStartup value: "
+                                            "must be a boolean or >= 1");
+                }
+                startupConcurrency = static_cast<std::size_t>(threads);
+            }
+
+            Json::Value const &jsonRealtime = jsonServer[REALTIME_KEY];
+            if (jsonRealtime.isObject()) {
+                util::sched::setRealtimeConfig(
+                    parseRealtimeConfig(jsonRealtime));
+            }
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -165,6 +251,11 @@ namespace server {
         if (sleepTime > 0.0) {
             m_server->setSleepTime(sleepTime);
         }
+        if (sleepSpinTime > 0) {
+            m_server->setSleepSpinTime(sleepSpinTime);
+        }
+
+        m_server->setStartupConcurrency(startupConcurrency);
 
         m_server->setHardwareDetectOnConnection();
 
@@ -132,6 +132,14 @@ namespace server {
     void Server::setSleepTime(int microseconds) {
         m_impl->setSleepTime(microseconds);
     }
+
+    void Server::setSleepSpinTime(int microseconds) {
+        m_impl->setSleepSpinTime(microseconds);
+    }
+
+    void Server::setStartupConcurrency(std::size_t threads) {
+        m_impl->setStartupConcurrency(threads);
+    }
 #if 0
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 #endif
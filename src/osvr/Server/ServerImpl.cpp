@@ -29,6 +29,7 @@
 #include <osvr/Common/CommonComponent.h>
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/ProcessDeviceDescriptor.h>
+#include <osvr/Common/RoutingConstants.h>
 #include <osvr/Common/SystemComponent.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/Connection/Connection.h>
@@ -38,7 +39,6 @@
 #include <osvr/Util/LogNames.h>
 #include <osvr/Util/Logger.h>
 #include <osvr/Util/MessageKeys.h>
-#include <osvr/Util/Microsleep.h>
 #include <osvr/Util/PortFlags.h>
 #include <osvr/Util/StringLiteralFileToString.h>
 #include <osvr/Util/Verbosity.h>
@@ -118,6 +118,12 @@ namespace server {
         vrpnConn->register_handler(
             vrpnConn->register_message_type(vrpn_dropped_last_connection),
             &ServerImpl::m_enterIdle, this);
+
+        // Push the tree to each new client right away, rather than waiting
+        // for its first ping.
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_handleNewConnection, this);
     }
 
     ServerImpl::~ServerImpl() {
@@ -189,6 +195,7 @@ namespace server {
                                        std::string const &params) {
         BOOST_ASSERT_MSG(m_inServerThread(),
                          "This method is only available in the server thread!");
+        m_ctx->loadDeferredPlugin(plugin);
         m_ctx->instantiateDriver(plugin, driver, params);
     }
 
@@ -241,11 +248,46 @@ namespace server {
         }
 
         if (m_currentSleepTime > 0) {
-            osvr::util::time::microsleep(m_currentSleepTime);
+            m_sleep();
         }
         return shouldContinue;
     }
 
+    /// @brief How often to log scheduling jitter statistics.
+    static const std::chrono::seconds JITTER_REPORT_INTERVAL(10);
+
+    void ServerImpl::m_sleep() {
+        using std::chrono::microseconds;
+        auto period = microseconds(m_currentSleepTime);
+        if (m_loopDeadline.getPeriod() != period) {
+            // Entered or left idle mode: start a new cadence.
+            m_loopDeadline.setPeriod(period);
+        }
+        // Only spin while a client is connected.
+        m_loopDeadline.setSpin(m_lowLatency ? microseconds(m_sleepSpinTime)
+                                            : microseconds::zero());
+        auto late = m_loopDeadline.wait();
+        if (!m_reportJitter) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        m_sleepJitter.record(
+            std::chrono::duration<double, std::micro>(late).count());
+        if (now - m_jitterReportStart >= JITTER_REPORT_INTERVAL) {
+            auto missed = m_loopDeadline.missedDeadlines();
+            m_log->info() << "Scheduling jitter over "
+                          << m_sleepJitter.count() << " wakeups: mean "
+                          << m_sleepJitter.mean() << " us late, std dev "
+                          << m_sleepJitter.stddev() << " us, max "
+                          << m_sleepJitter.max() << " us, "
+                          << (missed - m_missedAtReportStart)
+                          << " deadlines missed";
+            m_sleepJitter.reset();
+            m_jitterReportStart = now;
+            m_missedAtReportStart = missed;
+        }
+    }
+
     bool ServerImpl::addRoute(std::string const &routingDirective) {
         bool wasNew;
         m_callControlled([&] { wasNew = m_addRoute(routingDirective); });
@@ -353,7 +395,7 @@ namespace server {
                                   common::AliasPriority priority) {
         bool change = common::AliasProcessor()
                           .setDefaultPriority(priority)
-                          .enableWildcard()
+                          .recordWildcardsIn(m_wildcardAliases)
                           .process(m_tree.getRoot(), aliases);
         m_treeDirty += change;
         return change;
@@ -371,6 +413,14 @@ namespace server {
     void ServerImpl::setSleepTime(int microseconds) {
         m_sleepTime = microseconds;
     }
+
+    void ServerImpl::setSleepSpinTime(int microseconds) {
+        m_sleepSpinTime = microseconds;
+    }
+
+    void ServerImpl::setStartupConcurrency(std::size_t threads) {
+        m_callControlled([&] { m_ctx->setStartupConcurrency(threads); });
+    }
 #if 0
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 #endif
@@ -380,9 +430,18 @@ namespace server {
             if (descriptor.empty()) {
                 m_log->warn() << "Developer Warning: No device descriptor for "
                               << dev->getName();
-            } else {
-                m_treeDirty += common::processDeviceDescriptorForPathTree(
-                    m_tree, dev->getName(), descriptor, m_port, m_host);
+            } else if (common::processDeviceDescriptorForPathTree(
+                           m_tree, dev->getName(), descriptor, m_port,
+                           m_host)) {
+                m_treeDirty.set();
+                // Only the nodes of this device need matching against
+                // wildcard aliases added earlier.
+                auto devPath = dev->getName();
+                if (devPath.front() != common::getPathSeparatorCharacter()) {
+                    devPath.insert(0, common::getPathSeparator());
+                }
+                m_treeDirty += m_wildcardAliases.applyToSubtree(
+                    m_tree.getNodeByPath(devPath));
             }
         }
     }
@@ -399,6 +458,19 @@ namespace server {
         }
         /// Create the low-latency behavior object.
         self->m_lowLatency.reset(new common::LowLatency);
+        self->m_reportJitter = util::sched::getRealtimeConfig().reportJitter;
+        self->m_sleepJitter.reset();
+        self->m_jitterReportStart = std::chrono::steady_clock::now();
+        self->m_missedAtReportStart = self->m_loopDeadline.missedDeadlines();
+        /// Start the cadence over from now, rather than from however long
+        /// ago the idle loop last woke.
+        self->m_loopDeadline.restart();
+        return 0;
+    }
+
+    int ServerImpl::m_handleNewConnection(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_treeDirty.set();
         return 0;
     }
 
@@ -415,6 +487,8 @@ namespace server {
 
         /// Destroy the low-latency behavior object
         self->m_lowLatency.reset();
+        self->m_reportJitter = false;
+        self->m_loopDeadline.restart();
         return 0;
     }
 
@@ -30,6 +30,7 @@
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/LowLatency.h>
 #include <osvr/Common/PathTree.h>
+#include <osvr/Common/WildcardAliases.h>
 #include <osvr/Common/SystemComponent_fwd.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/DeviceToken.h>
@@ -38,7 +39,9 @@
 #include <osvr/Server/Server.h>
 #include <osvr/Util/Flag.h>
 #include <osvr/Util/Log.h>
+#include <osvr/Util/PreciseSleep.h>
 #include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/ThreadScheduling.h>
 #include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
@@ -51,6 +54,7 @@
 #include <vrpn_Connection.h>
 
 // Standard includes
+#include <chrono>
 #include <string>
 
 namespace osvr {
@@ -121,6 +125,12 @@ namespace server {
 
         /// @copydoc Server::setSleepTime()
         void setSleepTime(int microseconds);
+
+        /// @copydoc Server::setSleepSpinTime()
+        void setSleepSpinTime(int microseconds);
+
+        /// @copydoc Server::setStartupConcurrency()
+        void setStartupConcurrency(std::size_t threads);
 #if 0
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
@@ -185,11 +195,19 @@ namespace server {
         /// or effectively so)
         bool m_inServerThread() const;
 
+        /// @brief Sleeps between loop iterations, measuring how late we wake
+        /// up when jitter reporting is enabled.
+        void m_sleep();
+
         /// @brief Callback on getting first connection, to exit idle state.
         static int VRPN_CALLBACK m_exitIdle(void *userdata, vrpn_HANDLERPARAM);
         /// @brief Callback on dropping last connection, to enter idle state.
         static int VRPN_CALLBACK m_enterIdle(void *userdata, vrpn_HANDLERPARAM);
 
+        /// @brief Callback on each new connection, to send it the path tree.
+        static int VRPN_CALLBACK m_handleNewConnection(void *userdata,
+                                                       vrpn_HANDLERPARAM);
+
         /// @brief Connection ownership.
         connection::ConnectionPtr m_conn;
 
@@ -216,6 +234,10 @@ namespace server {
         common::PathTree m_tree;
         util::Flag m_treeDirty;
 
+        /// @brief Wildcard aliases added so far, to apply to devices as their
+        /// descriptors arrive or change.
+        common::WildcardAliasSet m_wildcardAliases;
+
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
 
@@ -234,20 +256,26 @@ namespace server {
         /// m_thread.get_id() but a callControlled might change it.
         mutable boost::thread::id m_mainThreadId;
 
-        /// @brief Number of microseconds to sleep after each loop iteration
-        /// when at least one client is connected. 0 = no sleeping.
+        /// @brief Loop period in microseconds when at least one client is
+        /// connected. 0 = no sleeping.
         int m_sleepTime = 0;
 
-        /// @brief Number of microseconds to sleep after each loop iteration
-        /// when no clients are connected.
+        /// @brief Microseconds of each loop period to spin rather than sleep
+        /// when at least one client is connected.
+        int m_sleepSpinTime = 0;
+
+        /// @brief Loop period in microseconds when no clients are connected.
         ///
         /// This is 1 millisecond, the minimum sleep resolution on Windows.
         static const int IDLE_SLEEP_TIME = 1000;
 
-        /// @brief Number of microseconds to sleep after each loop iteration
-        /// right now. 0 = no sleeping.
+        /// @brief Loop period in microseconds right now. 0 = no sleeping.
         int m_currentSleepTime = IDLE_SLEEP_TIME;
 
+        /// @brief Deadlines for the loop wakeups at m_currentSleepTime.
+        util::time::PeriodicDeadline m_loopDeadline{
+            util::time::PeriodicDeadline::duration::zero()};
+
         /// The host/interface we're listening on, if any.
         std::string m_host;
 
@@ -259,6 +287,14 @@ namespace server {
 
         /// Latency reduction RAII object
         unique_ptr<common::LowLatency> m_lowLatency;
+
+        /// @name Scheduling jitter reporting, while in low-latency mode
+        /// @{
+        bool m_reportJitter = false;
+        util::sched::JitterStats m_sleepJitter;
+        std::chrono::steady_clock::time_point m_jitterReportStart;
+        std::size_t m_missedAtReportStart = 0;
+        /// @}
     };
 
     /// @brief Class to temporarily (in RAII style) change a thread ID variable
@@ -0,0 +1,229 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncLogSink.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <utility>
+
+namespace osvr {
+namespace util {
+    namespace log {
+
+        /// How long the idle worker sleeps before re-checking the queue on its
+        /// own: producers only signal it opportunistically, so this bounds the
+        /// latency of a missed wakeup.
+        static const auto ASYNC_IDLE_WAIT = std::chrono::milliseconds(10);
+
+        static inline std::size_t roundUpToPowerOfTwo(std::size_t n) {
+            std::size_t ret = 2;
+            while (ret < n) {
+                ret <<= 1;
+            }
+            return ret;
+        }
+
+        async_sink::async_sink(std::vector<spdlog::sink_ptr> wrapped_sinks,
+                               std::size_t queue_size,
+                               AsyncOverflowPolicy policy)
+            : sinks_(std::move(wrapped_sinks)),
+              slots_(roundUpToPowerOfTwo(queue_size)),
+              mask_(slots_.size() - 1), policy_(policy), enqueue_pos_(0),
+              dequeue_pos_(0), dropped_(0), worker_sleeping_(false),
+              flush_requested_(false) {
+            for (std::size_t i = 0; i < slots_.size(); ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            worker_ = std::thread([&] { workerLoop(); });
+        }
+
+        async_sink::~async_sink() {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            work_cv_.notify_one();
+            if (worker_.joinable()) {
+                worker_.join();
+            }
+            flushWrapped();
+        }
+
+        void async_sink::log(const spdlog::details::log_msg &msg) {
+            while (!tryPush(msg)) {
+                if (policy_ == AsyncOverflowPolicy::Drop) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                // Block: make sure the worker is awake, then give it a chance
+                // to free a slot.
+                wakeWorker();
+                std::this_thread::yield();
+            }
+            wakeWorker();
+        }
+
+        void async_sink::flush() {
+            // Called by the logger itself for every message at or above its
+            // flush level, so it must not wait: the worker flushes once it has
+            // drained what's queued.
+            flush_requested_.store(true, std::memory_order_release);
+            wakeWorker();
+        }
+
+        void async_sink::drain() {
+            auto target = enqueue_pos_.load(std::memory_order_acquire);
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.notify_one();
+                drained_cv_.wait(lock, [&] {
+                    return !running_ ||
+                           dequeue_pos_.load(std::memory_order_acquire) >=
+                               target;
+                });
+            }
+            flushWrapped();
+        }
+
+        bool async_sink::tryPush(const spdlog::details::log_msg &msg) {
+            auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+            Slot *slot = nullptr;
+            for (;;) {
+                slot = &slots_[pos & mask_];
+                auto seq = slot->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(seq) -
+                            static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos_.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    // full
+                    return false;
+                } else {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            if (msg.logger_name) {
+                slot->logger_name.assign(*msg.logger_name);
+            } else {
+                slot->logger_name.clear();
+            }
+            slot->level = msg.level;
+            slot->time = msg.time;
+            slot->thread_id = msg.thread_id;
+            slot->raw.assign(msg.raw.data(), msg.raw.size());
+            slot->formatted.assign(msg.formatted.data(), msg.formatted.size());
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool async_sink::tryPop(Slot *&slot) {
+            // Single consumer, so no CAS required.
+            auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+            auto &candidate = slots_[pos & mask_];
+            if (candidate.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return false;
+            }
+            slot = &candidate;
+            return true;
+        }
+
+        void async_sink::release(Slot &slot) {
+            auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+            slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+            dequeue_pos_.store(pos + 1, std::memory_order_release);
+        }
+
+        void async_sink::forward(Slot &slot) {
+            spdlog::details::log_msg msg(&slot.logger_name, slot.level);
+            msg.time = slot.time;
+            msg.thread_id = slot.thread_id;
+            msg.raw << fmt::StringRef(slot.raw.data(), slot.raw.size());
+            msg.formatted << fmt::StringRef(slot.formatted.data(),
+                                            slot.formatted.size());
+            for (auto &sink : sinks_) {
+                try {
+                    sink->log(msg);
+                } catch (...) {
+                    // fail silently: nowhere left to report it.
+                }
+            }
+        }
+
+        void async_sink::flushWrapped() {
+            for (auto &sink : sinks_) {
+                try {
+                    sink->flush();
+                } catch (...) {
+                    // fail silently
+                }
+            }
+        }
+
+        void async_sink::wakeWorker() {
+            if (worker_sleeping_.load(std::memory_order_acquire)) {
+                work_cv_.notify_one();
+            }
+        }
+
+        void async_sink::workerLoop() {
+            for (;;) {
+                Slot *slot = nullptr;
+                while (tryPop(slot)) {
+                    forward(*slot);
+                    release(*slot);
+                }
+                if (flush_requested_.exchange(false,
+                                              std::memory_order_acq_rel)) {
+                    flushWrapped();
+                }
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                drained_cv_.notify_all();
+                worker_sleeping_.store(true, std::memory_order_release);
+                auto empty = enqueue_pos_.load(std::memory_order_acquire) ==
+                             dequeue_pos_.load(std::memory_order_relaxed);
+                if (empty) {
+                    if (!running_) {
+                        worker_sleeping_.store(false,
+                                               std::memory_order_relaxed);
+                        return;
+                    }
+                    work_cv_.wait_for(lock, ASYNC_IDLE_WAIT);
+                }
+                worker_sleeping_.store(false, std::memory_order_relaxed);
+            }
+        }
+
+    } // end namespace log
+} // end namespace util
+} // end namespace osvr
@@ -0,0 +1,137 @@
+/** @file
+    @brief Header for a sink decorator that hands log messages off to a
+    background thread through a bounded, lock-free queue.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncLogSink_h_GUID_1EC4A916_845C_420D_B9BB_CF3DF43766FE
+#define INCLUDED_AsyncLogSink_h_GUID_1EC4A916_845C_420D_B9BB_CF3DF43766FE
+
+// Internal Includes
+#include <osvr/Util/LogRegistry.h> // for AsyncOverflowPolicy
+
+// Library/third-party includes
+#include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/sink.h>
+
+// Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace util {
+    namespace log {
+
+        /// A decorator around one or more sinks that makes logging
+        /// non-blocking for the calling thread: the already-formatted message
+        /// is copied into a preallocated slot of a bounded multi-producer
+        /// queue, and a single worker thread passes it on to the wrapped
+        /// sinks.
+        ///
+        /// When the queue is full, the configured AsyncOverflowPolicy decides
+        /// whether the producer waits for room or the message is discarded
+        /// (and counted).
+        class async_sink : public ::spdlog::sinks::sink {
+          public:
+            /// @param wrapped_sinks The sinks to forward messages to, from
+            /// the worker thread.
+            /// @param queue_size Number of message slots: rounded up to a
+            /// power of two.
+            /// @param policy What to do when all slots are in use.
+            async_sink(std::vector<spdlog::sink_ptr> wrapped_sinks,
+                       std::size_t queue_size, AsyncOverflowPolicy policy);
+
+            /// Drains the queue and stops the worker thread.
+            virtual ~async_sink();
+
+            /// Copies the message into the queue - never touches the wrapped
+            /// sinks directly.
+            void log(const spdlog::details::log_msg &msg) override;
+
+            /// Asks the worker to flush the wrapped sinks once it has written
+            /// out everything queued so far. Does not wait.
+            void flush() override;
+
+            /// Blocks until everything queued so far has been written, then
+            /// flushes the wrapped sinks.
+            void drain();
+
+            /// Number of messages discarded because the queue was full (only
+            /// ever non-zero with AsyncOverflowPolicy::Drop)
+            std::uint64_t dropped() const { return dropped_; }
+
+            std::size_t capacity() const { return slots_.size(); }
+
+          private:
+            /// One preallocated queue entry. The strings keep their capacity
+            /// from message to message, so steady-state logging doesn't
+            /// allocate.
+            struct Slot {
+                std::atomic<std::size_t> sequence;
+                std::string logger_name;
+                spdlog::level::level_enum level;
+                spdlog::log_clock::time_point time;
+                std::size_t thread_id;
+                std::string raw;
+                std::string formatted;
+            };
+
+            bool tryPush(const spdlog::details::log_msg &msg);
+            bool tryPop(Slot *&slot);
+            void release(Slot &slot);
+            void forward(Slot &slot);
+            void flushWrapped();
+            void workerLoop();
+            void wakeWorker();
+
+            std::vector<spdlog::sink_ptr> sinks_;
+            std::vector<Slot> slots_;
+            std::size_t mask_;
+            AsyncOverflowPolicy policy_;
+
+            std::atomic<std::size_t> enqueue_pos_;
+            std::atomic<std::size_t> dequeue_pos_;
+            std::atomic<std::uint64_t> dropped_;
+
+            /// Only touched when the worker goes idle or a flush is pending.
+            std::mutex mutex_;
+            std::condition_variable work_cv_;
+            std::condition_variable drained_cv_;
+            std::atomic<bool> worker_sleeping_;
+            std::atomic<bool> flush_requested_;
+            bool running_ = true;
+            std::thread worker_;
+        };
+
+    } // end namespace log
+} // end namespace util
+} // end namespace osvr
+
+#endif // INCLUDED_AsyncLogSink_h_GUID_1EC4A916_845C_420D_B9BB_CF3DF43766FE
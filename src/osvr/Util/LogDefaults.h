@@ -32,7 +32,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace osvr {
 namespace util {
@@ -41,6 +41,9 @@ namespace util {
         static const auto DEFAULT_LEVEL = LogLevel::trace;
         static const auto DEFAULT_CONSOLE_LEVEL = LogLevel::info;
         static const auto DEFAULT_FLUSH_LEVEL = LogLevel::info;
+        /// Number of messages that can be waiting for the async logging
+        /// thread before the overflow policy kicks in.
+        static const std::size_t DEFAULT_ASYNC_QUEUE_SIZE = 1024;
 
         static const auto ANDROID_LOG_TAG = "OSVR";
     } // end namespace log
@@ -27,6 +27,7 @@
 #include <osvr/Util/LogRegistry.h>
 #include <osvr/Util/GetEnvironmentVariable.h>
 
+#include "AsyncLogSink.h"
 #include "LogDefaults.h"
 #include "LogLevelTranslate.h"
 #include "LogSinks.h"
@@ -45,7 +46,9 @@
 #include <spdlog/spdlog.h>
 
 // Standard includes
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <utility>
 
 namespace osvr {
@@ -89,8 +92,9 @@ namespace util {
             if (!spd_logger) {
                 // Bummer, it didn't exist. We'll create one from scratch.
                 try {
+                    auto sinks = loggerSinks();
                     spd_logger = spdlog::details::registry::instance().create(
-                        logger_name, begin(sinks_), end(sinks_));
+                        logger_name, begin(sinks), end(sinks));
                     spd_logger->set_pattern(DEFAULT_PATTERN);
                     /// @todo should this level be different than other levels?
                     spd_logger->set_level(convertToLevelEnum(minLevel_));
@@ -121,6 +125,11 @@ namespace util {
         void LogRegistry::dropAll() { spdlog::drop_all(); }
 
         void LogRegistry::flush() {
+            if (async_sink_) {
+                // Waits for the queue to drain, then flushes the sinks.
+                async_sink_->drain();
+                return;
+            }
             for (auto &sink : sinks_) {
                 try {
                     sink->flush();
@@ -180,6 +189,7 @@ namespace util {
             generalPurposeLog_ = consoleOnlyLog_.get();
 
             createFileSink();
+            createAsyncSink();
 
             auto binLoc = getBinaryLocation();
             if (!binLoc.empty()) {
@@ -190,6 +200,24 @@ namespace util {
         LogRegistry::~LogRegistry() {
             // do nothing but flush
             flush();
+            auto dropped = getDroppedMessageCount();
+            if (dropped > 0 && consoleOnlyLog_) {
+                consoleOnlyLog_->warn()
+                    << dropped
+                    << " log messages were dropped because the asynchronous "
+                       "logging queue was full.";
+            }
+        }
+
+        std::uint64_t LogRegistry::getDroppedMessageCount() const {
+            return async_sink_ ? async_sink_->dropped() : 0;
+        }
+
+        std::vector<spdlog::sink_ptr> LogRegistry::loggerSinks() const {
+            if (async_sink_) {
+                return {async_sink_};
+            }
+            return sinks_;
         }
 
         void LogRegistry::setLevelImpl(LogLevel severity) {
@@ -225,8 +253,6 @@ namespace util {
             // File sink - rotates daily
             std::string logDir;
             try {
-                size_t q_size = 64; // queue size must be power of 2
-                spdlog::set_async_mode(q_size);
                 namespace fs = boost::filesystem;
                 auto base_name = fs::path(getLoggingDirectory(true));
                 if (!base_name.empty()) {
@@ -264,10 +290,14 @@ namespace util {
             }
 
             // If we succeeded in making a file sink, make a general logger that
-            // uses both sinks, then announce as much as useful about the log
-            // file location to it.
-            generalLog_ = Logger::makeWithSinks(OSVR_GENERAL_LOG_NAME,
-                                                {sinks_[0], sinks_[1]});
+            // uses both sinks (by way of the async sink, if we're using one),
+            // then announce as much as useful about the log file location to
+            // it.
+            createAsyncSink();
+            if (!async_sink_) {
+                generalLog_ = Logger::makeWithSinks(OSVR_GENERAL_LOG_NAME,
+                                                    {sinks_[0], sinks_[1]});
+            }
 
             if (generalLog_) {
                 generalPurposeLog_ = generalLog_.get();
@@ -283,6 +313,67 @@ namespace util {
 #endif // OSVR_ANDROID
         }
 
+        /// Returns the requested queue size for asynchronous logging, or 0 if
+        /// we should log synchronously.
+        ///
+        /// OSVR_LOG_ASYNC may be "0" to turn async logging off, a number to
+        /// use as the queue size, or anything else to request async logging
+        /// with the default queue size. When it's not set, we only log
+        /// asynchronously if we're also logging to file.
+        static inline std::size_t getAsyncQueueSize(bool loggingToFile) {
+            using osvr::util::getEnvironmentVariable;
+            auto asyncSetting = getEnvironmentVariable("OSVR_LOG_ASYNC");
+            if (!asyncSetting) {
+                return loggingToFile ? DEFAULT_ASYNC_QUEUE_SIZE : 0;
+            }
+            try {
+                return std::stoul(*asyncSetting);
+            } catch (...) {
+                return DEFAULT_ASYNC_QUEUE_SIZE;
+            }
+        }
+
+        static inline AsyncOverflowPolicy getAsyncOverflowPolicy() {
+            using osvr::util::getEnvironmentVariable;
+            auto policySetting =
+                getEnvironmentVariable("OSVR_LOG_ASYNC_OVERFLOW");
+            if (policySetting && *policySetting == "drop") {
+                return AsyncOverflowPolicy::Drop;
+            }
+            return AsyncOverflowPolicy::Block;
+        }
+
+        void LogRegistry::createAsyncSink() {
+            if (async_sink_) {
+                // already done.
+                return;
+            }
+            auto queueSize = getAsyncQueueSize(couldOpenLogFile());
+            if (0 == queueSize) {
+                return;
+            }
+            auto policy = getAsyncOverflowPolicy();
+            try {
+                async_sink_ =
+                    std::make_shared<async_sink>(sinks_, queueSize, policy);
+            } catch (const std::exception &e) {
+                generalPurposeLog_->error()
+                    << "Could not start asynchronous logging: " << e.what()
+                    << ". Will log synchronously.";
+                return;
+            }
+
+            generalLog_ =
+                Logger::makeWithSink(OSVR_GENERAL_LOG_NAME, async_sink_);
+            generalPurposeLog_ = generalLog_.get();
+            generalPurposeLog_->debug()
+                << "Logging asynchronously, queue size "
+                << async_sink_->capacity() << ", "
+                << (policy == AsyncOverflowPolicy::Drop
+                        ? "dropping messages when full"
+                        : "blocking when full");
+        }
+
     } // end namespace log
 } // end namespace util
 } // end namespace osvr
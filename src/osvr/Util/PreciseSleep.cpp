@@ -0,0 +1,106 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Util/PreciseSleep.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <thread>
+
+#ifdef __linux__
+#define OSVR_HAVE_CLOCK_NANOSLEEP
+#include <errno.h>
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace osvr {
+namespace util {
+    namespace time {
+        /// Hint to the CPU that we're in a spin-wait loop.
+        static inline void cpuRelax() {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+            __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+            _mm_pause();
+#endif
+        }
+
+        void sleepUntil(PreciseClock::time_point deadline) {
+#ifdef OSVR_HAVE_CLOCK_NANOSLEEP
+            auto remaining = deadline - PreciseClock::now();
+            if (remaining <= PreciseClock::duration::zero()) {
+                return;
+            }
+            /// Translate into an absolute CLOCK_MONOTONIC deadline, rather
+            /// than assuming the epoch of PreciseClock.
+            static const long NSEC_PER_SEC = 1000000000L;
+            auto ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(remaining)
+                    .count();
+            timespec target;
+            clock_gettime(CLOCK_MONOTONIC, &target);
+            target.tv_sec += static_cast<time_t>(ns / NSEC_PER_SEC);
+            target.tv_nsec += static_cast<long>(ns % NSEC_PER_SEC);
+            if (target.tv_nsec >= NSEC_PER_SEC) {
+                target.tv_sec++;
+                target.tv_nsec -= NSEC_PER_SEC;
+            }
+            /// With an absolute deadline, being interrupted by a signal
+            /// doesn't shift the wakeup: just go back to sleep.
+            while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                            &target, nullptr)) {
+            }
+            /// The two clocks normally agree, but make sure we're not early
+            /// if they don't.
+            while (PreciseClock::now() < deadline) {
+                cpuRelax();
+            }
+#else
+            std::this_thread::sleep_until(deadline);
+#endif
+        }
+
+        void sleepUntil(PreciseClock::time_point deadline,
+                        PreciseClock::duration spin) {
+            if (spin > PreciseClock::duration::zero()) {
+                sleepUntil(deadline - spin);
+            } else {
+                sleepUntil(deadline);
+            }
+            while (PreciseClock::now() < deadline) {
+                cpuRelax();
+            }
+        }
+
+    } // namespace time
+} // namespace util
+} // namespace osvr
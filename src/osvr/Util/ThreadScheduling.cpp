@@ -0,0 +1,247 @@
+/** @file
+    @brief Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Util/ThreadScheduling.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <mutex>
+
+#ifdef __linux__
+#define OSVR_HAVE_LINUX_SCHEDULING
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#endif
+
+namespace osvr {
+namespace util {
+    namespace sched {
+        namespace {
+            static const char *const ROLE_NAMES[THREAD_ROLE_COUNT] = {
+                "server", "asyncDevice", "tracker", "imageProcessing"};
+
+            struct Registry {
+                std::mutex mutex;
+                RealtimeConfig config;
+                /// Number of outstanding successful lockProcessMemory() calls
+                std::size_t memoryLocks = 0;
+            };
+
+            Registry &registry() {
+                static Registry reg;
+                return reg;
+            }
+
+            log::LoggerPtr getLogger() {
+                return log::make_logger("ThreadScheduling");
+            }
+        } // namespace
+
+        const char *getThreadRoleName(ThreadRole role) {
+            return ROLE_NAMES[static_cast<std::size_t>(role)];
+        }
+
+        bool parseThreadRoleName(std::string const &name, ThreadRole &role) {
+            for (std::size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+                if (name == ROLE_NAMES[i]) {
+                    role = static_cast<ThreadRole>(i);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool parseSchedulingPolicy(std::string const &name,
+                                   SchedulingPolicy &policy) {
+            if (name == "default") {
+                policy = SchedulingPolicy::Default;
+            } else if (name == "fifo") {
+                policy = SchedulingPolicy::Fifo;
+            } else if (name == "rr") {
+                policy = SchedulingPolicy::RoundRobin;
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        void setRealtimeConfig(RealtimeConfig const &config) {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.config = config;
+        }
+
+        RealtimeConfig getRealtimeConfig() {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            return reg.config;
+        }
+
+#ifdef OSVR_HAVE_LINUX_SCHEDULING
+        bool applyThreadRole(ThreadRole role) {
+            auto config = getRealtimeConfig();
+            auto const &params = config[role];
+            auto roleName = getThreadRoleName(role);
+            bool success = true;
+
+            if (config.timerSlackNanoseconds >= 0) {
+                /// A slack of 0 would mean "reset to the default" - so the
+                /// tightest we can ask for is 1 ns.
+                auto slack = (std::max)(config.timerSlackNanoseconds, 1L);
+                if (0 != prctl(PR_SET_TIMERSLACK,
+                               static_cast<unsigned long>(slack), 0, 0, 0)) {
+                    getLogger()->warn()
+                        << "Could not set timer slack for " << roleName
+                        << " thread: " << std::strerror(errno);
+                    success = false;
+                }
+            }
+
+            if (!params.cpus.empty()) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                for (auto cpu : params.cpus) {
+                    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                        CPU_SET(cpu, &cpus);
+                    }
+                }
+                auto err = pthread_setaffinity_np(pthread_self(),
+                                                  sizeof(cpus), &cpus);
+                if (0 != err) {
+                    getLogger()->warn()
+                        << "Could not pin " << roleName
+                        << " thread to the configured CPUs: "
+                        << std::strerror(err);
+                    success = false;
+                }
+            }
+
+            if (SchedulingPolicy::Default == params.policy) {
+                return success;
+            }
+            auto policy =
+                SchedulingPolicy::Fifo == params.policy ? SCHED_FIFO : SCHED_RR;
+            auto policyName =
+                SchedulingPolicy::Fifo == params.policy ? "SCHED_FIFO"
+                                                        : "SCHED_RR";
+            sched_param sp = {};
+            sp.sched_priority = (std::min)(
+                (std::max)(params.priority, sched_get_priority_min(policy)),
+                sched_get_priority_max(policy));
+            auto err = pthread_setschedparam(pthread_self(), policy, &sp);
+            if (EPERM == err) {
+                /// Without CAP_SYS_NICE, unprivileged users may still use
+                /// priorities up to RLIMIT_RTPRIO.
+                rlimit limit;
+                if (0 == getrlimit(RLIMIT_RTPRIO, &limit) &&
+                    limit.rlim_cur > 0 &&
+                    static_cast<rlim_t>(sp.sched_priority) > limit.rlim_cur) {
+                    sp.sched_priority = static_cast<int>(limit.rlim_cur);
+                    err = pthread_setschedparam(pthread_self(), policy, &sp);
+                    if (0 == err) {
+                        getLogger()->warn()
+                            << "Priority for " << roleName
+                            << " thread clamped to RLIMIT_RTPRIO ("
+                            << sp.sched_priority << ")";
+                        success = false;
+                    }
+                }
+            }
+            if (0 != err) {
+                getLogger()->warn()
+                    << "Could not set " << policyName << " priority "
+                    << sp.sched_priority << " for " << roleName
+                    << " thread (" << std::strerror(err)
+                    << "), leaving it at normal priority. Grant the server "
+                       "CAP_SYS_NICE or raise its RLIMIT_RTPRIO to use "
+                       "real-time scheduling.";
+                return false;
+            }
+            getLogger()->info() << roleName << " thread running with "
+                                << policyName << " priority "
+                                << sp.sched_priority;
+            return success;
+        }
+
+        bool lockProcessMemory() {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            if (!reg.config.lockMemory) {
+                return false;
+            }
+            if (reg.memoryLocks > 0) {
+                reg.memoryLocks++;
+                return true;
+            }
+            if (0 != mlockall(MCL_CURRENT | MCL_FUTURE)) {
+                getLogger()->warn()
+                    << "Could not lock process memory ("
+                    << std::strerror(errno)
+                    << "): page faults may add latency. Grant the server "
+                       "CAP_IPC_LOCK or raise its RLIMIT_MEMLOCK.";
+                return false;
+            }
+            reg.memoryLocks = 1;
+            getLogger()->info() << "Process memory locked.";
+            return true;
+        }
+
+        void unlockProcessMemory() {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            if (0 == reg.memoryLocks) {
+                return;
+            }
+            if (0 == --reg.memoryLocks) {
+                munlockall();
+            }
+        }
+
+#else // !OSVR_HAVE_LINUX_SCHEDULING
+
+        // Fallback no-op implementations
+        bool applyThreadRole(ThreadRole role) {
+            auto config = getRealtimeConfig();
+            return SchedulingPolicy::Default == config[role].policy &&
+                   config[role].cpus.empty();
+        }
+        bool lockProcessMemory() { return false; }
+        void unlockProcessMemory() {}
+
+#endif // OSVR_HAVE_LINUX_SCHEDULING
+
+    } // namespace sched
+} // namespace util
+} // namespace osvr
@@ -28,6 +28,7 @@
 
 // Library/third-party includes
 #include <osvr/Connection/Connection.h>
+#include <osvr/PluginHost/HostAccess.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <vrpn_Connection.h>
 
@@ -43,6 +44,10 @@ namespace vrpnserver {
 
     vrpn_Connection *getVRPNConnection(
         osvr::pluginhost::PluginSpecificRegistrationContext &context) {
+        // Whoever asks for the connection is about to construct a VRPN
+        // object on it, which registers senders and message types in the
+        // shared vrpn_Connection: only one plugin may do that at a time.
+        osvr::pluginhost::waitForHostAccess();
         osvr::connection::ConnectionPtr conn =
             osvr::connection::Connection::retrieveConnection(
                 context.getParent());
@@ -0,0 +1,178 @@
+/** @file
+    @brief Tests for lending image frames from shared memory.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/ClientKit/ImagingC.h>
+#include <osvr/Common/BorrowedImage.h>
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace common = osvr::common;
+using common::IPCRingBuffer;
+
+/// Just enough of a client context to own image buffers.
+class ImageTestContext : public ::OSVR_ClientContextObject {
+  public:
+    explicit ImageTestContext(common::ClientContextDeleter del)
+        : ::OSVR_ClientContextObject("org.osvr.test.borrowedimages", del) {}
+
+  private:
+    void m_update() override {}
+    void m_sendRoute(std::string const &) override {}
+    common::PathTree const &m_getPathTree() const override { return m_tree; }
+    common::Transform const &m_getRoomToWorldTransform() const override {
+        return m_roomToWorld;
+    }
+    void m_setRoomToWorldTransform(common::Transform const &xform) override {
+        m_roomToWorld = xform;
+    }
+    common::PathTree m_tree;
+    common::Transform m_roomToWorld;
+};
+
+/// 64x64, 8-bit grayscale.
+static const OSVR_ImagingMetadata METADATA = {64, 64, 1, 1,
+                                              OSVR_IVT_UNSIGNED_INT};
+static const std::size_t FRAME_SIZE = 64 * 64;
+
+/// A two-frame ring buffer, as written by a server and read by a client.
+class TestRing {
+  public:
+    TestRing() {
+        std::random_device rd;
+        auto opts = IPCRingBuffer::Options("org.osvr.test.borrowedimages" +
+                                           std::to_string(rd()))
+                        .setEntries(2)
+                        .setEntrySize(FRAME_SIZE);
+        m_server = IPCRingBuffer::create(opts);
+        REQUIRE(m_server);
+        m_client = IPCRingBuffer::find(opts);
+        REQUIRE(m_client);
+    }
+
+    /// Writes a frame with every pixel set to @p value, and gets it like the
+    /// imaging component does.
+    common::ImageData send(std::uint8_t value) {
+        IPCRingBuffer::value_type frame[FRAME_SIZE];
+        std::memset(frame, value, FRAME_SIZE);
+        auto seq = m_server->put(frame, FRAME_SIZE);
+        auto proxy = m_client->get(seq);
+        REQUIRE(proxy);
+        return common::ImageData{0, METADATA, proxy.getBufferSmartPointer(),
+                                 m_client, seq};
+    }
+
+  private:
+    common::IPCRingBufferPtr m_server;
+    common::IPCRingBufferPtr m_client;
+};
+
+/// Hands a frame to the context like the imaging remote handler does, for a
+/// single callback, and returns the buffer that callback would get.
+static OSVR_ImageBufferElement *callback(OSVR_ClientContext ctx,
+                                         common::ImageData const &data) {
+    common::BorrowedImagePtr borrowed;
+    common::acquireImage(*ctx, data, 1, borrowed);
+    if (borrowed) {
+        borrowed->locked.reset();
+    }
+    return data.buffer.get();
+}
+
+/// Copies a buffer from a callback, returning the value of its pixels.
+static int copyAndFree(OSVR_ClientContext ctx, OSVR_ImageBufferElement *buf) {
+    OSVR_ImageBufferElement *copy = nullptr;
+    if (OSVR_RETURN_SUCCESS != osvrClientCopyImage(ctx, buf, &copy)) {
+        return -1;
+    }
+    REQUIRE(copy != nullptr);
+    int ret = copy[0];
+    REQUIRE(copy[FRAME_SIZE - 1] == ret);
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeImage(ctx, copy));
+    return ret;
+}
+
+TEST_CASE("BorrowedImage-ring-wrap") {
+    TestRing ring;
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<ImageTestContext>());
+    REQUIRE(OSVR_RETURN_SUCCESS ==
+            osvrClientSetImageBorrowing(ctx.get(), OSVR_TRUE));
+
+    auto first = callback(ctx.get(), ring.send(1));
+    REQUIRE(ctx->findObject<common::BorrowedImagePtr>(first));
+    REQUIRE(copyAndFree(ctx.get(), first) == 1);
+    auto second = callback(ctx.get(), ring.send(2));
+    REQUIRE(second != first);
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeImage(ctx.get(), second));
+
+    // The app still holds the first frame, lent, when the ring wraps around
+    // to its entry: the third frame at the same address is handed over, and
+    // the address means the third frame from now on.
+    auto third = callback(ctx.get(), ring.send(3));
+    REQUIRE(third == first);
+    REQUIRE(ctx->findObject<common::ImageBufferPtr>(third));
+    REQUIRE(copyAndFree(ctx.get(), third) == 3);
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeImage(ctx.get(), third));
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeImage(ctx.get(), first));
+    REQUIRE(OSVR_RETURN_FAILURE == osvrClientFreeImage(ctx.get(), first));
+
+    // Nothing held at that address any more: lent again.
+    REQUIRE(OSVR_RETURN_SUCCESS ==
+            osvrClientFreeImage(ctx.get(), callback(ctx.get(), ring.send(4))));
+    auto fifth = callback(ctx.get(), ring.send(5));
+    REQUIRE(fifth == first);
+    REQUIRE(ctx->findObject<common::BorrowedImagePtr>(fifth));
+    REQUIRE_FALSE(ctx->findObject<common::ImageBufferPtr>(fifth));
+    REQUIRE(copyAndFree(ctx.get(), fifth) == 5);
+
+    // Written over, while lent, by frames this context never got: gone.
+    ring.send(6);
+    ring.send(7);
+    REQUIRE(copyAndFree(ctx.get(), fifth) == -1);
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeImage(ctx.get(), fifth));
+}
+
+TEST_CASE("BorrowedImage-not-lending") {
+    TestRing ring;
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<ImageTestContext>());
+    auto buf = callback(ctx.get(), ring.send(1));
+    REQUIRE_FALSE(ctx->findObject<common::BorrowedImagePtr>(buf));
+    REQUIRE(ctx->findObject<common::ImageBufferPtr>(buf));
+    REQUIRE(copyAndFree(ctx.get(), buf) == 1);
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeImage(ctx.get(), buf));
+}
@@ -0,0 +1,386 @@
+/** @file
+    @brief Tests for the cached eye matrices behind the display API.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/ClientKit/DisplayC.h>
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace common = osvr::common;
+
+/// Stereo, side-by-side, with less than full overlap so that the eyes' view
+/// axes are rotated as well as offset.
+static const char DISPLAY_JSON[] = R"({
+  "meta": { "schemaVersion": 1 },
+  "hmd": {
+    "device": { "vendor": "OSVR", "model": "Test", "num_displays": 1 },
+    "field_of_view": {
+      "monocular_horizontal": 90,
+      "monocular_vertical": 96.73,
+      "overlap_percent": 80,
+      "pitch_tilt": 0
+    },
+    "resolutions": [ {
+      "width": 1920, "height": 1080, "video_inputs": 1,
+      "display_mode": "horz_side_by_side", "swap_eyes": 0
+    } ],
+    "eyes": [
+      { "center_proj_x": 0.5, "center_proj_y": 0.5, "rotate_180": 0 },
+      { "center_proj_x": 0.5, "center_proj_y": 0.5, "rotate_180": 0 }
+    ]
+  }
+})";
+
+/// Just enough of a client context for a display config: the display
+/// descriptor in its path tree, and a head pose, set by the test, delivered
+/// to every interface during update().
+class DisplayTestContext : public ::OSVR_ClientContextObject {
+  public:
+    explicit DisplayTestContext(common::ClientContextDeleter del)
+        : ::OSVR_ClientContextObject("org.osvr.test.displaymatrices", del) {
+        m_tree.getNodeByPath("/display",
+                             common::elements::StringElement(DISPLAY_JSON));
+    }
+
+    /// The head pose to report on the next update: translated along x, and
+    /// rotated about y by @p yaw radians.
+    void setHeadPose(double x, double yaw, OSVR_TimeValue const &timestamp) {
+        osvrPose3SetIdentity(&m_pose);
+        m_pose.translation.data[0] = x;
+        m_pose.rotation.data[0] = std::cos(yaw / 2.);
+        m_pose.rotation.data[2] = std::sin(yaw / 2.);
+        m_timestamp = timestamp;
+        m_hasPose = true;
+    }
+
+  private:
+    void m_update() override {
+        if (!m_hasPose) {
+            return;
+        }
+        for (auto const &iface : getInterfaces()) {
+            OSVR_PoseReport report;
+            report.sensor = 0;
+            report.pose = m_pose;
+            iface->setState(m_timestamp, report);
+        }
+    }
+    void m_sendRoute(std::string const &) override {}
+    common::PathTree const &m_getPathTree() const override { return m_tree; }
+    common::Transform const &m_getRoomToWorldTransform() const override {
+        return m_roomToWorld;
+    }
+    void m_setRoomToWorldTransform(common::Transform const &xform) override {
+        m_roomToWorld = xform;
+    }
+    common::PathTree m_tree;
+    common::Transform m_roomToWorld;
+    bool m_hasPose = false;
+    OSVR_Pose3 m_pose;
+    OSVR_TimeValue m_timestamp;
+};
+
+template <typename Scalar> using Matrix = std::array<Scalar, OSVR_MATRIX_SIZE>;
+using Matrixd = Matrix<double>;
+
+static OSVR_DisplayConfig getDisplay(OSVR_ClientContext ctx) {
+    OSVR_DisplayConfig disp = nullptr;
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientGetDisplay(ctx, &disp));
+    REQUIRE(disp != nullptr);
+    return disp;
+}
+
+static Matrixd getView(OSVR_DisplayConfig disp, OSVR_EyeCount eye) {
+    Matrixd ret;
+    REQUIRE(OSVR_RETURN_SUCCESS ==
+            osvrClientGetViewerEyeViewMatrixd(
+                disp, 0, eye, OSVR_MATRIX_COLMAJOR, ret.data()));
+    return ret;
+}
+
+static Matrixd getProjection(OSVR_DisplayConfig disp, OSVR_EyeCount eye,
+                             double near, double far,
+                             OSVR_MatrixConventions flags) {
+    Matrixd ret;
+    REQUIRE(OSVR_RETURN_SUCCESS ==
+            osvrClientGetViewerEyeSurfaceProjectionMatrixd(
+                disp, 0, eye, 0, near, far, flags, ret.data()));
+    return ret;
+}
+
+static OSVR_TimeValue makeTime(OSVR_TimeValue_Seconds seconds) {
+    OSVR_TimeValue ret;
+    ret.seconds = seconds;
+    ret.microseconds = 0;
+    return ret;
+}
+
+TEST_CASE("ViewerEye-view-cache-follows-pose") {
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<DisplayTestContext>());
+    auto &testCtx = static_cast<DisplayTestContext &>(*ctx);
+    auto disp = getDisplay(ctx.get());
+
+    Matrixd mat;
+    REQUIRE(OSVR_RETURN_FAILURE ==
+            osvrClientGetViewerEyeViewMatrixd(disp, 0, 0, OSVR_MATRIX_COLMAJOR,
+                                              mat.data()));
+
+    testCtx.setHeadPose(1., 0.25, makeTime(5));
+    ctx->update();
+    auto firstLeft = getView(disp, 0);
+    auto firstRight = getView(disp, 1);
+    REQUIRE(firstLeft != firstRight);
+    // Asking again without an update gives the same thing.
+    REQUIRE(getView(disp, 0) == firstLeft);
+
+    SECTION("New pose, new timestamp") {
+        testCtx.setHeadPose(-2., 0.5, makeTime(6));
+    }
+    SECTION("New pose, repeated timestamp") {
+        testCtx.setHeadPose(-2., 0.5, makeTime(5));
+    }
+    ctx->update();
+    auto left = getView(disp, 0);
+    auto right = getView(disp, 1);
+    REQUIRE(left != firstLeft);
+    REQUIRE(right != firstRight);
+
+    // A display config that has never seen the old pose must agree: its
+    // interface gets the (same) pose on the next update.
+    auto fresh = getDisplay(ctx.get());
+    ctx->update();
+    REQUIRE(getView(fresh, 0) == left);
+    REQUIRE(getView(fresh, 1) == right);
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeDisplay(fresh));
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeDisplay(disp));
+}
+
+TEST_CASE("ViewerEye-projection-cache") {
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<DisplayTestContext>());
+    auto disp = getDisplay(ctx.get());
+
+    struct Params {
+        double near;
+        double far;
+        OSVR_MatrixConventions flags;
+    };
+    // More than the cache holds, so entries get replaced.
+    std::vector<Params> params = {
+        {0.1, 100., OSVR_MATRIX_COLMAJOR},
+        {0.1, 100., OSVR_MATRIX_ROWMAJOR},
+        {0.1, 100., OSVR_MATRIX_LHINPUT | OSVR_MATRIX_UNSIGNEDZ},
+        {0.1, 1000., OSVR_MATRIX_COLMAJOR},
+        {0.5, 100., OSVR_MATRIX_COLMAJOR},
+        {0.5, 50., OSVR_MATRIX_ROWVECTORS | OSVR_MATRIX_UNSIGNEDZ}};
+
+    // Each computed once, by a display config of its own.
+    std::vector<std::array<Matrixd, 2> > expected;
+    for (auto const &p : params) {
+        auto reference = getDisplay(ctx.get());
+        expected.push_back({{getProjection(reference, 0, p.near, p.far,
+                                           p.flags),
+                             getProjection(reference, 1, p.near, p.far,
+                                           p.flags)}});
+        REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeDisplay(reference));
+    }
+    REQUIRE(expected[0][0] != expected[2][0]);
+    REQUIRE(expected[0][0] != expected[3][0]);
+
+    for (int round = 0; round < 3; ++round) {
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            // Revisit each set, and the most recent one twice in a row.
+            for (std::size_t j : {i, i, (i + 3) % params.size()}) {
+                auto const &p = params[j];
+                INFO("round " << round << ", parameter set " << j);
+                REQUIRE(getProjection(disp, 0, p.near, p.far, p.flags) ==
+                        expected[j][0]);
+                REQUIRE(getProjection(disp, 1, p.near, p.far, p.flags) ==
+                        expected[j][1]);
+            }
+        }
+    }
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeDisplay(disp));
+}
+
+template <typename Scalar> struct PerEye;
+template <> struct PerEye<double> {
+    static OSVR_ReturnCode view(OSVR_DisplayConfig disp, OSVR_EyeCount eye,
+                                OSVR_MatrixConventions flags, double *mat) {
+        return osvrClientGetViewerEyeViewMatrixd(disp, 0, eye, flags, mat);
+    }
+    static OSVR_ReturnCode projection(OSVR_DisplayConfig disp,
+                                      OSVR_EyeCount eye, double near,
+                                      double far,
+                                      OSVR_MatrixConventions flags,
+                                      double *mat) {
+        return osvrClientGetViewerEyeSurfaceProjectionMatrixd(
+            disp, 0, eye, 0, near, far, flags, mat);
+    }
+    static OSVR_ReturnCode bulk(OSVR_DisplayConfig disp, double near,
+                                double far, OSVR_MatrixConventions flags,
+                                OSVR_EyeCount numEyes, double *views,
+                                double *projections) {
+        return osvrClientGetViewerEyeViewProjectionMatricesd(
+            disp, 0, near, far, flags, numEyes, views, projections);
+    }
+};
+template <> struct PerEye<float> {
+    static OSVR_ReturnCode view(OSVR_DisplayConfig disp, OSVR_EyeCount eye,
+                                OSVR_MatrixConventions flags, float *mat) {
+        return osvrClientGetViewerEyeViewMatrixf(disp, 0, eye, flags, mat);
+    }
+    static OSVR_ReturnCode projection(OSVR_DisplayConfig disp,
+                                      OSVR_EyeCount eye, float near, float far,
+                                      OSVR_MatrixConventions flags,
+                                      float *mat) {
+        return osvrClientGetViewerEyeSurfaceProjectionMatrixf(
+            disp, 0, eye, 0, near, far, flags, mat);
+    }
+    static OSVR_ReturnCode bulk(OSVR_DisplayConfig disp, float near,
+                                float far, OSVR_MatrixConventions flags,
+                                OSVR_EyeCount numEyes, float *views,
+                                float *projections) {
+        return osvrClientGetViewerEyeViewProjectionMatricesf(
+            disp, 0, near, far, flags, numEyes, views, projections);
+    }
+};
+
+template <typename Scalar>
+static void checkBulkMatchesPerEye(OSVR_DisplayConfig disp,
+                                   OSVR_MatrixConventions flags) {
+    using Calls = PerEye<Scalar>;
+    const Scalar near = Scalar(0.1);
+    const Scalar far = Scalar(100);
+    std::array<Matrix<Scalar>, 2> views;
+    std::array<Matrix<Scalar>, 2> projections;
+    REQUIRE(OSVR_RETURN_SUCCESS == Calls::bulk(disp, near, far, flags, 2,
+                                               views[0].data(),
+                                               projections[0].data()));
+    for (OSVR_EyeCount eye = 0; eye < 2; ++eye) {
+        INFO("eye " << int(eye));
+        Matrix<Scalar> view;
+        Matrix<Scalar> projection;
+        REQUIRE(OSVR_RETURN_SUCCESS ==
+                Calls::view(disp, eye, flags, view.data()));
+        REQUIRE(OSVR_RETURN_SUCCESS == Calls::projection(disp, eye, near, far,
+                                                         flags,
+                                                         projection.data()));
+        REQUIRE(views[eye] == view);
+        REQUIRE(projections[eye] == projection);
+    }
+}
+
+TEST_CASE("ViewerEye-bulk-matrices-match-per-eye-calls") {
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<DisplayTestContext>());
+    auto &testCtx = static_cast<DisplayTestContext &>(*ctx);
+    auto disp = getDisplay(ctx.get());
+
+    OSVR_EyeCount numEyes = 0;
+    REQUIRE(OSVR_RETURN_SUCCESS ==
+            osvrClientGetNumEyesForViewer(disp, 0, &numEyes));
+    REQUIRE(numEyes == 2);
+
+    // Twice the room needed, filled with a marker value.
+    std::vector<double> views(4 * OSVR_MATRIX_SIZE, -42.);
+    std::vector<double> projections(4 * OSVR_MATRIX_SIZE, -42.);
+    auto untouched = [&] {
+        for (auto v : views) {
+            REQUIRE(v == -42.);
+        }
+        for (auto v : projections) {
+            REQUIRE(v == -42.);
+        }
+    };
+
+    SECTION("No pose yet") {
+        REQUIRE(OSVR_RETURN_FAILURE ==
+                osvrClientGetViewerEyeViewProjectionMatricesd(
+                    disp, 0, 0.1, 100., OSVR_MATRIX_COLMAJOR, 2, views.data(),
+                    projections.data()));
+        untouched();
+    }
+
+    testCtx.setHeadPose(0.5, -0.3, makeTime(1));
+    ctx->update();
+
+    SECTION("Invalid arguments") {
+        REQUIRE(OSVR_RETURN_FAILURE ==
+                osvrClientGetViewerEyeViewProjectionMatricesd(
+                    disp, 0, 0.1, 100., OSVR_MATRIX_COLMAJOR, 1, views.data(),
+                    projections.data()));
+        REQUIRE(OSVR_RETURN_FAILURE ==
+                osvrClientGetViewerEyeViewProjectionMatricesd(
+                    disp, 0, 0.1, 100., OSVR_MATRIX_COLMAJOR, 3, views.data(),
+                    projections.data()));
+        REQUIRE(OSVR_RETURN_FAILURE ==
+                osvrClientGetViewerEyeViewProjectionMatricesd(
+                    disp, 0, 1., 1., OSVR_MATRIX_COLMAJOR, 2, views.data(),
+                    projections.data()));
+        REQUIRE(OSVR_RETURN_FAILURE ==
+                osvrClientGetViewerEyeViewProjectionMatricesd(
+                    disp, 0, 0.1, 100., OSVR_MATRIX_COLMAJOR, 2, nullptr,
+                    projections.data()));
+        untouched();
+    }
+
+    SECTION("Only the requested eyes are written") {
+        REQUIRE(OSVR_RETURN_SUCCESS ==
+                osvrClientGetViewerEyeViewProjectionMatricesd(
+                    disp, 0, 0.1, 100., OSVR_MATRIX_COLMAJOR, 2, views.data(),
+                    projections.data()));
+        for (std::size_t i = 2 * OSVR_MATRIX_SIZE; i < views.size(); ++i) {
+            REQUIRE(views[i] == -42.);
+            REQUIRE(projections[i] == -42.);
+        }
+    }
+
+    std::vector<OSVR_MatrixConventions> conventions = {
+        OSVR_MATRIX_COLMAJOR | OSVR_MATRIX_COLVECTORS,
+        OSVR_MATRIX_ROWMAJOR | OSVR_MATRIX_COLVECTORS,
+        OSVR_MATRIX_COLMAJOR | OSVR_MATRIX_ROWVECTORS | OSVR_MATRIX_LHINPUT,
+        OSVR_MATRIX_ROWMAJOR | OSVR_MATRIX_UNSIGNEDZ};
+    for (auto flags : conventions) {
+        INFO("flags " << int(flags));
+        checkBulkMatchesPerEye<double>(disp, flags);
+        checkBulkMatchesPerEye<float>(disp, flags);
+    }
+    REQUIRE(OSVR_RETURN_SUCCESS == osvrClientFreeDisplay(disp));
+}
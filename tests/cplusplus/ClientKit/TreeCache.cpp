@@ -0,0 +1,206 @@
+/** @file
+    @brief Test for the client's on-disk cache of the server's path tree.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TreeCache.h"
+#include <osvr/Util/GetEnvironmentVariable.h>
+
+// Library/third-party includes
+#include <boost/filesystem.hpp>
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <fstream>
+#include <string>
+
+using osvr::client::getTreeCacheFilePath;
+using osvr::client::loadCachedTree;
+using osvr::client::saveCachedTree;
+namespace fs = boost::filesystem;
+
+/// A scratch directory for cache files, removed when done.
+class ScratchDir {
+  public:
+    ScratchDir()
+        : m_root(fs::temp_directory_path() /
+                 fs::unique_path("osvr-treecache-%%%%-%%%%-%%%%")) {
+        fs::create_directories(m_root);
+    }
+    ~ScratchDir() {
+        boost::system::error_code ec;
+        fs::remove_all(m_root, ec);
+    }
+    std::string file(std::string const &name) const {
+        return (m_root / name).string();
+    }
+    /// Number of entries in the directory.
+    std::size_t count() const {
+        return std::distance(fs::directory_iterator(m_root),
+                             fs::directory_iterator());
+    }
+    /// Writes a file with exactly the given contents.
+    std::string write(std::string const &name, std::string const &contents) {
+        auto ret = file(name);
+        std::ofstream(ret, std::ios::trunc) << contents;
+        return ret;
+    }
+
+  private:
+    fs::path m_root;
+};
+
+static Json::Value makeNodes() {
+    Json::Value nodes(Json::arrayValue);
+    Json::Value node(Json::objectValue);
+    node["path"] = "/me/head";
+    node["type"] = "alias";
+    node["source"] = "/com_osvr_Example/Tracker/tracker/0";
+    nodes.append(node);
+    node = Json::Value(Json::objectValue);
+    node["path"] = "/com_osvr_Example/Tracker";
+    node["type"] = "device";
+    nodes.append(node);
+    return nodes;
+}
+
+TEST_CASE("TreeCache-round-trip") {
+    ScratchDir scratch;
+    const auto filename = scratch.file("ClientTree-localhost.json");
+    const auto nodes = makeNodes();
+    REQUIRE(saveCachedTree(filename, nodes, "version-1"));
+    // Only the cache itself is left behind: the temporary was renamed.
+    REQUIRE(scratch.count() == 1);
+
+    Json::Value loadedNodes;
+    std::string loadedVersion;
+    REQUIRE(loadCachedTree(filename, loadedNodes, loadedVersion));
+    REQUIRE(loadedVersion == "version-1");
+    REQUIRE(loadedNodes == nodes);
+
+    SECTION("Saving again replaces the contents") {
+        Json::Value fewer(Json::arrayValue);
+        fewer.append(nodes[0]);
+        REQUIRE(saveCachedTree(filename, fewer, "version-2"));
+        REQUIRE(scratch.count() == 1);
+        REQUIRE(loadCachedTree(filename, loadedNodes, loadedVersion));
+        REQUIRE(loadedVersion == "version-2");
+        REQUIRE(loadedNodes == fewer);
+    }
+
+    SECTION("An empty tree round-trips too") {
+        REQUIRE(saveCachedTree(filename, Json::Value(Json::arrayValue), ""));
+        REQUIRE(loadCachedTree(filename, loadedNodes, loadedVersion));
+        REQUIRE(loadedVersion.empty());
+        REQUIRE(loadedNodes.isArray());
+        REQUIRE(loadedNodes.empty());
+    }
+
+    SECTION("Saving into a missing directory fails cleanly") {
+        REQUIRE_FALSE(saveCachedTree(scratch.file("missing/tree.json"), nodes,
+                                     "version-1"));
+    }
+}
+
+TEST_CASE("TreeCache-rejects-malformed") {
+    ScratchDir scratch;
+    // Outputs must be left alone when a cache is rejected.
+    Json::Value nodes("untouched");
+    std::string version = "untouched";
+    auto rejects = [&](std::string const &filename) {
+        auto ret = !loadCachedTree(filename, nodes, version);
+        return ret && nodes == Json::Value("untouched") &&
+               version == "untouched";
+    };
+
+    SECTION("Missing file") { REQUIRE(rejects(scratch.file("missing.json"))); }
+    SECTION("Not JSON") {
+        REQUIRE(rejects(scratch.write("bad.json", "{\"format\": 1,")));
+    }
+    SECTION("Not an object") {
+        REQUIRE(rejects(scratch.write("bad.json", "[1, \"v\", []]")));
+    }
+    SECTION("Wrong format") {
+        REQUIRE(rejects(scratch.write(
+            "bad.json", R"({"format": 2, "version": "v", "nodes": []})")));
+    }
+    SECTION("Format of the wrong type") {
+        REQUIRE(rejects(scratch.write(
+            "bad.json", R"({"format": "1", "version": "v", "nodes": []})")));
+    }
+    SECTION("Missing format") {
+        REQUIRE(rejects(
+            scratch.write("bad.json", R"({"version": "v", "nodes": []})")));
+    }
+    SECTION("Missing version") {
+        REQUIRE(rejects(
+            scratch.write("bad.json", R"({"format": 1, "nodes": []})")));
+    }
+    SECTION("Version not a string") {
+        REQUIRE(rejects(scratch.write(
+            "bad.json", R"({"format": 1, "version": 3, "nodes": []})")));
+    }
+    SECTION("Missing nodes") {
+        REQUIRE(rejects(
+            scratch.write("bad.json", R"({"format": 1, "version": "v"})")));
+    }
+    SECTION("Nodes not an array") {
+        REQUIRE(rejects(scratch.write(
+            "bad.json", R"({"format": 1, "version": "v", "nodes": {}})")));
+    }
+
+    SECTION("The well-formed equivalent loads") {
+        REQUIRE(loadCachedTree(
+            scratch.write("good.json",
+                          R"({"format": 1, "version": "v", "nodes": []})"),
+            nodes, version));
+        REQUIRE(version == "v");
+    }
+}
+
+TEST_CASE("TreeCache-file-names") {
+    // Set by the test harness, to a directory without a trailing separator.
+    auto dir = osvr::util::getEnvironmentVariable("OSVR_CLIENT_TREE_CACHE");
+    REQUIRE(dir.is_initialized());
+    REQUIRE_FALSE(dir->empty());
+    REQUIRE(*dir != "0");
+    const auto prefix = *dir + "/ClientTree-";
+
+    REQUIRE(getTreeCacheFilePath("localhost") == prefix + "localhost.json");
+    REQUIRE(getTreeCacheFilePath("host:3883") == prefix + "host_3883.json");
+    REQUIRE(getTreeCacheFilePath("192.168.0.10:3883") ==
+            prefix + "192.168.0.10_3883.json");
+    REQUIRE(getTreeCacheFilePath("[::1]:3883") == prefix + "___1__3883.json");
+    REQUIRE(getTreeCacheFilePath("my-host") == prefix + "my-host.json");
+
+    SECTION("Path separators can't escape the cache directory") {
+        REQUIRE(getTreeCacheFilePath("../etc/passwd") ==
+                prefix + ".._etc_passwd.json");
+        REQUIRE(getTreeCacheFilePath("a\\b") == prefix + "a_b.json");
+    }
+
+    SECTION("Distinct ports get distinct files") {
+        REQUIRE(getTreeCacheFilePath("host:3883") !=
+                getTreeCacheFilePath("host:3884"));
+    }
+}
@@ -0,0 +1,210 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageStreamCodec.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using osvr::common::encodeDeltaRLE;
+using osvr::common::decodeDeltaRLE;
+using osvr::common::ImageChunkHeader;
+using osvr::common::ImageEncoding;
+using osvr::common::isImageChunkValid;
+typedef std::vector<std::uint8_t> Bytes;
+
+static Bytes roundTrip(Bytes const &frame, std::size_t pixelStride,
+                       std::size_t *encodedSize = nullptr) {
+    Bytes encoded;
+    encodeDeltaRLE(frame.data(), frame.size(), pixelStride, encoded);
+    if (encodedSize) {
+        *encodedSize = encoded.size();
+    }
+    Bytes decoded(frame.size());
+    REQUIRE(decodeDeltaRLE(encoded.data(), encoded.size(), pixelStride,
+                           decoded.data(), decoded.size()));
+    return decoded;
+}
+
+TEST_CASE("DeltaRLE-round-trip") {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    SECTION("empty") { REQUIRE(roundTrip(Bytes(), 1).empty()); }
+    SECTION("single byte") { REQUIRE(roundTrip(Bytes{7}, 1) == Bytes{7}); }
+    SECTION("noise") {
+        Bytes frame(10000);
+        for (auto &b : frame) {
+            b = std::uint8_t(dist(gen));
+        }
+        REQUIRE(roundTrip(frame, 1) == frame);
+        REQUIRE(roundTrip(frame, 3) == frame);
+        REQUIRE(roundTrip(frame, 2) == frame);
+    }
+    SECTION("runs of every length") {
+        Bytes frame;
+        for (int len = 1; len < 300; ++len) {
+            frame.insert(frame.end(), len, std::uint8_t(len));
+        }
+        REQUIRE(roundTrip(frame, 1) == frame);
+        REQUIRE(roundTrip(frame, 4) == frame);
+    }
+}
+
+TEST_CASE("DeltaRLE-compresses-flat-and-gradient-frames") {
+    std::size_t encodedSize = 0;
+    SECTION("flat") {
+        Bytes frame(640 * 480, 12);
+        REQUIRE(roundTrip(frame, 1, &encodedSize) == frame);
+        REQUIRE(encodedSize < frame.size() / 50);
+    }
+    SECTION("grey horizontal gradient, 3 channels") {
+        Bytes frame;
+        for (int y = 0; y < 100; ++y) {
+            for (int x = 0; x < 200; ++x) {
+                frame.insert(frame.end(), 3, std::uint8_t(x));
+            }
+        }
+        REQUIRE(roundTrip(frame, 3, &encodedSize) == frame);
+        REQUIRE(encodedSize < frame.size() / 10);
+    }
+}
+
+TEST_CASE("DeltaRLE-rejects-malformed-data") {
+    Bytes frame(1000, 5);
+    frame[500] = 9;
+    Bytes encoded;
+    encodeDeltaRLE(frame.data(), frame.size(), 1, encoded);
+    Bytes decoded(frame.size());
+
+    SECTION("truncated") {
+        REQUIRE_FALSE(decodeDeltaRLE(encoded.data(), encoded.size() - 1, 1,
+                                     decoded.data(), decoded.size()));
+    }
+    SECTION("destination too small") {
+        REQUIRE_FALSE(decodeDeltaRLE(encoded.data(), encoded.size(), 1,
+                                     decoded.data(), decoded.size() - 1));
+    }
+    SECTION("destination too large") {
+        decoded.resize(frame.size() + 1);
+        REQUIRE_FALSE(decodeDeltaRLE(encoded.data(), encoded.size(), 1,
+                                     decoded.data(), decoded.size()));
+    }
+    SECTION("literal run past the end") {
+        Bytes bad{10, 1, 2};
+        REQUIRE_FALSE(decodeDeltaRLE(bad.data(), bad.size(), 1,
+                                     decoded.data(), decoded.size()));
+    }
+}
+
+/// The second of three chunks of a raw 640x480 8-bit frame.
+static ImageChunkHeader makeChunkHeader() {
+    ImageChunkHeader header;
+    header.metadata.height = 480;
+    header.metadata.width = 640;
+    header.metadata.channels = 1;
+    header.metadata.depth = 1;
+    header.metadata.type = OSVR_IVT_UNSIGNED_INT;
+    header.sensor = 0;
+    header.frameNumber = 7;
+    header.chunkIndex = 1;
+    header.chunkCount = 3;
+    header.encoding = ImageEncoding::Raw;
+    header.encodedSize = 640 * 480;
+    header.offset = 102400;
+    header.length = 102400;
+    return header;
+}
+
+TEST_CASE("ImageChunk-rejects-malformed-headers") {
+    auto header = makeChunkHeader();
+    std::size_t payloadLen = header.length;
+    REQUIRE(isImageChunkValid(header, payloadLen));
+
+    SECTION("sensor that would wrap when counted") {
+        header.sensor = UINT32_MAX;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("sensor too large to allocate state for") {
+        header.sensor = osvr::common::MAX_IMAGE_CHUNK_SENSOR + 1;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+        header.sensor = osvr::common::MAX_IMAGE_CHUNK_SENSOR;
+        REQUIRE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("frame size overflowing 32 bits") {
+        header.metadata.height = 65536;
+        header.metadata.width = 65536;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("frame too large, without overflowing") {
+        // 512 MiB, and claimed consistently.
+        header.metadata.height = 16384;
+        header.metadata.width = 8192;
+        header.metadata.channels = 4;
+        header.encodedSize = 16384u * 8192u * 4u;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("empty frame") {
+        header.metadata.width = 0;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("raw encoded size not the frame size") {
+        header.encodedSize += 1;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("DeltaRLE not smaller than the frame") {
+        header.encoding = ImageEncoding::DeltaRLE;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+        header.encodedSize = 250000;
+        REQUIRE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("unknown encoding") {
+        header.encoding = static_cast<ImageEncoding>(9);
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("chunk index out of range") {
+        header.chunkIndex = 3;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("no chunks") {
+        header.chunkCount = 0;
+        header.chunkIndex = 0;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("piece past the end of the frame") {
+        header.offset = header.encodedSize - 100;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+        header.offset = UINT32_MAX;
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen));
+    }
+    SECTION("piece longer than the message") {
+        REQUIRE_FALSE(isImageChunkValid(header, payloadLen - 1));
+    }
+}
@@ -0,0 +1,174 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InProcessReportRouter.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace common = osvr::common;
+
+/// Never dereferenced: the router only uses connections as keys.
+static vrpn_Connection *fakeConnection(int i) {
+    static char storage[2];
+    return reinterpret_cast<vrpn_Connection *>(&storage[i]);
+}
+
+TEST_CASE("InProcessReportRouter-lookup") {
+    auto router = common::InProcessReportRouter::get(fakeConnection(0));
+    REQUIRE(router);
+    REQUIRE(common::InProcessReportRouter::get(fakeConnection(0)) == router);
+    REQUIRE(common::InProcessReportRouter::get(fakeConnection(1)) != router);
+
+    auto channel = router->getTrackerChannel("com_osvr_Test/Tracker");
+    REQUIRE(channel);
+    REQUIRE(router->getTrackerChannel("com_osvr_Test/Tracker") == channel);
+    REQUIRE(router->getTrackerChannel("com_osvr_Test/Other") != channel);
+}
+
+TEST_CASE("InProcessReportRouter-registry-forgets-dead-routers") {
+    auto before = common::InProcessReportRouter::getNumRouters();
+    {
+        auto router = common::InProcessReportRouter::get(fakeConnection(1));
+        REQUIRE(common::InProcessReportRouter::getNumRouters() == before + 1);
+        auto again = common::InProcessReportRouter::get(fakeConnection(1));
+        REQUIRE(again == router);
+        REQUIRE(common::InProcessReportRouter::getNumRouters() == before + 1);
+    }
+    REQUIRE(common::InProcessReportRouter::getNumRouters() == before);
+
+    // And a connection's router can be recreated after that.
+    auto router = common::InProcessReportRouter::get(fakeConnection(1));
+    REQUIRE(router);
+    REQUIRE(common::InProcessReportRouter::getNumRouters() == before + 1);
+    router.reset();
+    REQUIRE(common::InProcessReportRouter::getNumRouters() == before);
+}
+
+TEST_CASE("TrackerReportChannel") {
+    common::TrackerReportChannel channel;
+    REQUIRE_FALSE(channel.hasPublisher());
+    REQUIRE_FALSE(channel.hasSubscribers());
+    channel.addPublisher();
+    REQUIRE(channel.hasPublisher());
+
+    std::vector<OSVR_ChannelCount> poses;
+    std::size_t velocities = 0;
+    std::string order;
+    common::TrackerReportChannel::Subscriber subscriber;
+    subscriber.pose = [&](OSVR_TimeValue const &, OSVR_ChannelCount sensor,
+                          OSVR_PoseState const &pose) {
+        REQUIRE(pose.translation.data[0] == 1.5);
+        poses.push_back(sensor);
+        order.push_back('p');
+    };
+    subscriber.velocity = [&](OSVR_TimeValue const &, OSVR_ChannelCount,
+                              OSVR_VelocityState const &) {
+        ++velocities;
+        order.push_back('v');
+    };
+    auto id = channel.subscribe(subscriber);
+    REQUIRE(channel.hasSubscribers());
+
+    OSVR_TimeValue timestamp = {};
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    pose.translation.data[0] = 1.5;
+    OSVR_VelocityState vel = {};
+    OSVR_AccelerationState accel = {};
+
+    SECTION("Reports reach subscribers when delivered") {
+        channel.sendPose(timestamp, 2, pose);
+        channel.sendVelocity(timestamp, 2, vel);
+        channel.sendPose(timestamp, 5, pose);
+        // No acceleration handler: ignored.
+        channel.sendAcceleration(timestamp, 2, accel);
+        REQUIRE(poses.empty());
+        REQUIRE(velocities == 0);
+
+        channel.deliver(id);
+        REQUIRE(poses.size() == 2);
+        REQUIRE(poses[0] == 2);
+        REQUIRE(poses[1] == 5);
+        REQUIRE(velocities == 1);
+        REQUIRE(order == "pvp");
+
+        // Each report only once.
+        channel.deliver(id);
+        REQUIRE(poses.size() == 2);
+    }
+
+    SECTION("Each subscriber delivers its own queue") {
+        std::size_t otherPoses = 0;
+        common::TrackerReportChannel::Subscriber other;
+        other.pose = [&](OSVR_TimeValue const &, OSVR_ChannelCount,
+                         OSVR_PoseState const &) { ++otherPoses; };
+        auto otherID = channel.subscribe(other);
+        channel.sendPose(timestamp, 2, pose);
+        channel.deliver(otherID);
+        REQUIRE(otherPoses == 1);
+        REQUIRE(poses.empty());
+        channel.deliver(id);
+        REQUIRE(poses.size() == 1);
+        REQUIRE(otherPoses == 1);
+        channel.unsubscribe(otherID);
+    }
+
+    SECTION("Undelivered reports are bounded, dropping the oldest") {
+        const auto max = common::TrackerReportChannel::MAX_QUEUED_REPORTS;
+        for (std::size_t i = 0; i < max + 10; ++i) {
+            channel.sendPose(timestamp, OSVR_ChannelCount(i), pose);
+        }
+        channel.deliver(id);
+        REQUIRE(poses.size() == max);
+        for (std::size_t i = 0; i < max; ++i) {
+            REQUIRE(poses[i] == i + 10);
+        }
+
+        // Back to an empty queue, in order again after wrapping around.
+        poses.clear();
+        for (std::size_t i = 0; i < 3; ++i) {
+            channel.sendPose(timestamp, OSVR_ChannelCount(i), pose);
+        }
+        channel.deliver(id);
+        REQUIRE(poses == std::vector<OSVR_ChannelCount>({0, 1, 2}));
+    }
+
+    SECTION("Not after unsubscribing") {
+        channel.sendPose(timestamp, 2, pose);
+        channel.unsubscribe(id);
+        REQUIRE_FALSE(channel.hasSubscribers());
+        channel.sendPose(timestamp, 2, pose);
+        channel.deliver(id);
+        REQUIRE(poses.empty());
+    }
+
+    channel.removePublisher();
+    REQUIRE_FALSE(channel.hasPublisher());
+}
@@ -0,0 +1,113 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/InterfaceStateSnapshot.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace common = osvr::common;
+
+/// Just enough of a client context to get interfaces from, with reports
+/// delivered during update() as a real one would.
+class SnapshotTestContext : public ::OSVR_ClientContextObject {
+  public:
+    explicit SnapshotTestContext(common::ClientContextDeleter del)
+        : ::OSVR_ClientContextObject("org.osvr.test.snapshot", del) {}
+
+  private:
+    /// Sets the pose x of each interface to the number of updates so far.
+    void m_update() override {
+        OSVR_TimeValue timestamp;
+        timestamp.seconds = OSVR_TimeValue_Seconds(getUpdateCount());
+        timestamp.microseconds = 0;
+        for (auto const &iface : getInterfaces()) {
+            OSVR_PoseReport report;
+            report.sensor = 0;
+            osvrPose3SetIdentity(&report.pose);
+            report.pose.translation.data[0] = double(getUpdateCount());
+            iface->setState(timestamp, report);
+        }
+    }
+    void m_sendRoute(std::string const &) override {}
+    common::PathTree const &m_getPathTree() const override { return m_tree; }
+    common::Transform const &m_getRoomToWorldTransform() const override {
+        return m_roomToWorld;
+    }
+    void m_setRoomToWorldTransform(common::Transform const &xform) override {
+        m_roomToWorld = xform;
+    }
+    common::PathTree m_tree;
+    common::Transform m_roomToWorld;
+};
+
+TEST_CASE("InterfaceStateSnapshot") {
+    auto ctx =
+        common::wrapSharedContext(common::makeContext<SnapshotTestContext>());
+    std::vector<common::ClientInterfacePtr> ifaces;
+    common::InterfaceStateSnapshot snapshot(*ctx);
+    for (int i = 0; i < 4; ++i) {
+        ifaces.push_back(ctx->getInterface(
+            ("/me/tracker/" + std::to_string(i)).c_str()));
+        snapshot.push_back(*ifaces.back());
+    }
+    REQUIRE(snapshot.size() == 4);
+    std::vector<common::StateSnapshotEntry<OSVR_PoseReport>> entries(4);
+
+    SECTION("No state yet") {
+        REQUIRE(snapshot.get<OSVR_PoseReport>(entries.data()) == 0);
+        for (auto const &entry : entries) {
+            REQUIRE_FALSE(entry.valid);
+        }
+    }
+
+    SECTION("All from the same update") {
+        ctx->update();
+        ctx->update();
+        REQUIRE(snapshot.get<OSVR_PoseReport>(entries.data()) == 2);
+        for (auto const &entry : entries) {
+            REQUIRE(entry.valid);
+            REQUIRE(entry.timestamp.seconds == 1);
+            REQUIRE(entry.state.translation.data[0] == 1.);
+        }
+    }
+
+    SECTION("Other report types") {
+        ctx->update();
+        std::vector<common::StateSnapshotEntry<OSVR_ButtonReport>> buttons(4);
+        snapshot.get<OSVR_ButtonReport>(buttons.data());
+        for (auto const &entry : buttons) {
+            REQUIRE_FALSE(entry.valid);
+        }
+    }
+}
@@ -84,3 +84,24 @@ TEST_CASE("PathTreeJSON-SerializedTreeToJsonWithRoundtrip") {
 
     REQUIRE(common::pathTreeToJson(tree) == val);
 }
+
+TEST_CASE("PathTreeJSON-VersionMatchesEqualTrees") {
+    PathTree tree;
+    setupDummyTree(tree);
+    auto json = common::pathTreeToJson(tree);
+    auto version = common::pathTreeJsonVersion(json);
+    REQUIRE(version.size() == 16u);
+
+    PathTree tree2;
+    common::jsonToPathTree(tree2, json);
+    REQUIRE(common::pathTreeJsonVersion(common::pathTreeToJson(tree2)) ==
+            version);
+
+    tree2.getNodeByPath("/org_osvr_example/extra").value() =
+        common::elements::StringElement("changed");
+    REQUIRE(common::pathTreeJsonVersion(common::pathTreeToJson(tree2)) !=
+            version);
+
+    REQUIRE(common::pathTreeJsonVersion(Json::Value(Json::arrayValue)) !=
+            version);
+}
@@ -93,3 +93,67 @@ TEST_CASE_METHOD(PathTreeResolution, "PathTreeResolution-BackCompatRoute") {
     setAlias(val.toStyledString());
     checkResolution();
 }
+
+TEST_CASE_METHOD(PathTreeResolution, "PathTreeResolution-Cached") {
+    Json::Value val(Json::objectValue);
+    val["child"] = getFullSourcePath();
+    val["rotate"]["axis"] = "x";
+    val["rotate"]["degrees"] = 90;
+    setAlias(val.toStyledString());
+    // Copy out what we'll compare against, since the tree may be replaced.
+    auto expected = *common::resolveTreeNode(tree, dummy::getAlias());
+    auto expectedSensor = *expected.getSensorNumber();
+    auto expectedTransform = expected.getTransformJson();
+
+    common::TreeNodeResolutionCache cache;
+    auto checkCached = [&](std::size_t expectedHits) {
+        auto cached = cache.resolve(tree, dummy::getAlias());
+        REQUIRE(cached.is_initialized());
+        REQUIRE(cache.getHits() == expectedHits);
+        REQUIRE(cached->getInterface() ==
+                &tree.getNodeByPath(dummy::getInterfacePath()));
+        REQUIRE(*cached->getSensorNumber() == expectedSensor);
+        REQUIRE(cached->getTransformJson() == expectedTransform);
+    };
+    checkCached(0);
+    checkCached(1);
+
+    SECTION("Replaced tree with the same contents") {
+        tree.reset();
+        dummy::setupDummyDevice(tree);
+        setAlias(val.toStyledString());
+        checkCached(2);
+    }
+
+    SECTION("Changed alias") {
+        tree.getNodeByPath(dummy::getAlias()).value() =
+            common::elements::AliasElement(getFullSourcePath());
+        auto cached = cache.resolve(tree, dummy::getAlias());
+        REQUIRE(cached.is_initialized());
+        REQUIRE(cache.getHits() == 1);
+        REQUIRE_FALSE(cached->hasTransform());
+    }
+
+    SECTION("Source went away") {
+        tree.reset();
+        setAlias(val.toStyledString());
+        REQUIRE_FALSE(cache.resolve(tree, dummy::getAlias()).is_initialized());
+        REQUIRE(cache.getHits() == 1);
+    }
+}
+
+TEST_CASE("PathTree-getNodeByPathCache") {
+    PathTree tree;
+    auto &node = tree.getNodeByPath("/com_osvr_Dummy/tracker/0");
+    REQUIRE(&tree.getNodeByPath("/com_osvr_Dummy/tracker/0") == &node);
+
+    PathTree const &constTree = tree;
+    REQUIRE(&constTree.getNodeByPath("/com_osvr_Dummy/tracker/0") == &node);
+    REQUIRE_THROWS(constTree.getNodeByPath("/com_osvr_Dummy/tracker/1"));
+    REQUIRE_THROWS(constTree.getNodeByPath("/com_osvr_Dummy/tracker/1"));
+
+    tree.reset();
+    REQUIRE_THROWS(constTree.getNodeByPath("/com_osvr_Dummy/tracker/0"));
+    REQUIRE(&tree.getNodeByPath("/com_osvr_Dummy/tracker/0") !=
+            &tree.getRoot());
+}
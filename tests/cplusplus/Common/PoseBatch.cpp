@@ -0,0 +1,116 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ChangeOfBasis.h>
+#include <osvr/Common/PoseBatch.h>
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cmath>
+#include <vector>
+
+namespace common = osvr::common;
+namespace ei = osvr::util::eigen_interop;
+
+static std::vector<OSVR_Pose3> makePoses(std::size_t n) {
+    std::vector<OSVR_Pose3> ret;
+    for (std::size_t i = 0; i < n; ++i) {
+        OSVR_Pose3 pose;
+        ei::map(pose.rotation) =
+            Eigen::Quaterniond(Eigen::AngleAxisd(
+                0.1 * i, Eigen::Vector3d(1, 0.5 * i, -1).normalized()));
+        ei::map(pose.translation) = Eigen::Vector3d(0.1 * i, 1.5, -0.02 * i);
+        ret.push_back(pose);
+    }
+    return ret;
+}
+
+/// Compare against applying the transform to each pose as a matrix.
+static void checkBatch(common::Transform const &xform, std::size_t n) {
+    auto poses = makePoses(n);
+    common::PoseBatch batch;
+    for (auto const &pose : poses) {
+        batch.push_back(pose);
+    }
+    REQUIRE(batch.size() == n);
+    batch.transform(xform);
+    for (std::size_t i = 0; i < n; ++i) {
+        OSVR_Pose3 expected = poses[i];
+        ei::map(expected) = xform.transform(ei::map(expected).matrix());
+        OSVR_Pose3 actual;
+        batch.get(i, actual);
+        REQUIRE(ei::map(actual.translation)
+                    .isApprox(ei::map(expected.translation), 1e-9));
+        // Same rotation: the quaternions may differ in sign.
+        REQUIRE(std::abs(ei::map(actual.rotation).quat().dot(
+                    ei::map(expected.rotation).quat())) == Approx(1.0));
+    }
+}
+
+TEST_CASE("PoseBatch-rigid") {
+    Eigen::Affine3d pre(Eigen::Translation3d(0.05, 0, -0.1) *
+                        Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()));
+    Eigen::Affine3d post(Eigen::Translation3d(0, 1.2, 0) *
+                         Eigen::AngleAxisd(-1.1, Eigen::Vector3d::UnitX()));
+    common::Transform xform(pre.matrix(), post.matrix());
+    REQUIRE(common::PoseBatch::isRigid(xform.getPre()));
+    REQUIRE(common::PoseBatch::isRigid(xform.getPost()));
+
+    SECTION("Empty") { checkBatch(xform, 0); }
+    SECTION("One") { checkBatch(xform, 1); }
+    SECTION("Many") { checkBatch(xform, 37); }
+    SECTION("Identity") { checkBatch(common::Transform(), 5); }
+}
+
+TEST_CASE("PoseBatch-nonrigid") {
+    // A change of basis that flips handedness.
+    common::ChangeOfBasis cb;
+    cb.setNewX(Eigen::Vector3d::UnitX());
+    cb.setNewY(Eigen::Vector3d::UnitZ());
+    cb.setNewZ(Eigen::Vector3d::UnitY());
+    auto xform = cb.get();
+    REQUIRE_FALSE(common::PoseBatch::isRigid(xform.getPost()));
+    checkBatch(xform, 12);
+}
+
+TEST_CASE("PoseBatch-reuse") {
+    common::PoseBatch batch;
+    auto poses = makePoses(20);
+    for (auto const &pose : poses) {
+        batch.push_back(pose);
+    }
+    batch.clear();
+    REQUIRE(batch.empty());
+    batch.push_back(poses[3]);
+    batch.transform(common::Transform());
+    OSVR_Pose3 actual;
+    batch.get(0, actual);
+    REQUIRE(ei::map(actual.translation)
+                .isApprox(ei::map(poses[3].translation)));
+}
@@ -30,6 +30,7 @@
 
 // Standard includes
 #include <string>
+#include <vector>
 
 using osvr::common::CorrelatedStringMap;
 using osvr::common::RegisteredStringMap;
@@ -156,3 +157,69 @@ TEST_CASE_METHOD(RegisteredStringMapTest,
     REQUIRE("RegVal1" == corMap.getStringFromId(corID4));
     REQUIRE("RegVal2" == corMap.getStringFromId(corID5));
 }
+
+TEST_CASE_METHOD(RegisteredStringMapTest,
+                 "RegisteredStringMapTest-lookupWithoutStdString") {
+    const char *name = "RegVal1";
+    REQUIRE(regID1.value() == regMap.getStringID(name).value());
+
+    // Only the first 7 characters: must not match on the prefix "RegVal1".
+    std::string longer = "RegVal12";
+    REQUIRE(regMap.getStringID(boost::string_ref(longer.data(), 7)).value() ==
+            regID1.value());
+    REQUIRE(regMap.getStringID(longer).empty());
+    REQUIRE(regMap.getStringID("RegVal").empty());
+}
+
+TEST_CASE_METHOD(RegisteredStringMapTest,
+                 "RegisteredStringMapTest-registerDoesNotKeepCallerString") {
+    StringID id;
+    {
+        std::string temp = "Temporary";
+        id = regMap.registerStringID(temp);
+        temp = "Overwritten";
+    }
+    REQUIRE(id.value() == regMap.getStringID("Temporary").value());
+    REQUIRE("Temporary" == regMap.getStringFromId(id));
+}
+
+TEST_CASE_METHOD(RegisteredStringMapTest, "RegisteredStringMapTest-copy") {
+    RegisteredStringMap copy(regMap);
+    // Growing the original must not disturb the copy's index, or the
+    // other way around.
+    for (int i = 0; i < 100; ++i) {
+        regMap.registerStringID("Extra" + std::to_string(i));
+    }
+    copy.registerStringID("CopyOnly");
+    REQUIRE(3 + 100 == regMap.size());
+    REQUIRE(4 == copy.size());
+    REQUIRE(regID2.value() == copy.getStringID("RegVal2").value());
+    REQUIRE(copy.getStringID("Extra0").empty());
+    REQUIRE(regMap.getStringID("CopyOnly").empty());
+
+    RegisteredStringMap assigned;
+    assigned = copy;
+    REQUIRE(3 == assigned.getStringID("CopyOnly").value());
+    REQUIRE("RegVal0" == assigned.getStringFromId(regID0));
+}
+
+TEST_CASE("RegisteredStringMap-manyEntries") {
+    RegisteredStringMap regMap;
+    std::vector<std::string> names;
+    for (int i = 0; i < 5000; ++i) {
+        names.push_back("/me/hands/left/finger" + std::to_string(i));
+    }
+    regMap.registerStringID(names.front());
+    auto const &first = regMap.getStringFromId(StringID(0));
+    for (auto const &name : names) {
+        regMap.registerStringID(name);
+    }
+    REQUIRE(names.size() == regMap.size());
+    // References stay valid as the map grows.
+    REQUIRE(names.front() == first);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        auto id = regMap.getStringID(names[i]);
+        REQUIRE(i == id.value());
+        REQUIRE(names[i] == regMap.getStringFromId(id));
+    }
+}
@@ -0,0 +1,180 @@
+/** @file
+    @brief Test for StackBuffer, including that serializing reports into
+    one makes no heap allocations.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/StackBuffer.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+/// @name Counting replacements for the global allocation functions
+/// @{
+static std::atomic<std::size_t> g_allocations(0);
+
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    if (void *ret = std::malloc(size ? size : 1)) {
+        return ret;
+    }
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+/// @}
+
+using osvr::common::Buffer;
+using osvr::common::StackBuffer;
+using osvr::common::serialize;
+using osvr::common::deserialize;
+
+namespace {
+/// A message like a pose report.
+class PoseReportMessage {
+  public:
+    PoseReportMessage(uint32_t sensor = 0, double value = 0)
+        : m_sensor(sensor), m_pose{value,       value + 1., value + 2.,
+                                   value + 3., value + 4., value + 5.,
+                                   value + 6.} {}
+
+    template <typename T> void processMessage(T &p) {
+        p(m_sensor);
+        for (auto &v : m_pose) {
+            p(v);
+        }
+    }
+
+    uint32_t m_sensor;
+    double m_pose[7];
+};
+/// The sensor is padded to align the doubles.
+static const std::size_t REPORT_SIZE = 8 + 7 * sizeof(double);
+} // namespace
+
+TEST_CASE("StackBuffer-TypeTraits") {
+    REQUIRE(osvr::common::is_buffer<StackBuffer<> >::value);
+}
+
+TEST_CASE("StackBuffer-RoundTrip") {
+    StackBuffer<> buf;
+    PoseReportMessage in(5, 1.5);
+    serialize(buf, in);
+    REQUIRE(buf.size() == REPORT_SIZE);
+    REQUIRE(buf.getContents().isInline());
+
+    auto reader = buf.startReading();
+    PoseReportMessage out;
+    deserialize(reader, out);
+    REQUIRE(reader.bytesRemaining() == 0);
+    REQUIRE(out.m_sensor == 5);
+    for (int i = 0; i < 7; ++i) {
+        REQUIRE(out.m_pose[i] == 1.5 + i);
+    }
+}
+
+TEST_CASE("StackBuffer-SpillsToHeap") {
+    StackBuffer<16> buf;
+    buf.append(uint32_t(0x01020304));
+    REQUIRE(buf.getContents().isInline());
+    buf.appendPadding(12);
+    REQUIRE(buf.getContents().isInline());
+    REQUIRE(buf.size() == 16);
+
+    // Past the inline capacity: moves to the heap, keeping the contents.
+    std::string str(100, 'x');
+    buf.append(str.data(), str.size());
+    REQUIRE_FALSE(buf.getContents().isInline());
+    REQUIRE(buf.size() == 116);
+
+    auto reader = buf.startReading();
+    uint32_t first;
+    reader.read(first);
+    REQUIRE(first == 0x01020304);
+    reader.skipPadding(12);
+    auto chars = reader.readBytes(str.size());
+    REQUIRE(std::string(chars, chars + str.size()) == str);
+
+    SECTION("copies are independent") {
+        auto copy = buf;
+        REQUIRE(copy.size() == buf.size());
+        REQUIRE(copy.data() != buf.data());
+        REQUIRE(std::equal(buf.getContents().begin(),
+                           buf.getContents().end(),
+                           copy.getContents().begin()));
+    }
+}
+
+TEST_CASE("StackBuffer-Alignment") {
+    StackBuffer<64> buf;
+    REQUIRE(reinterpret_cast<std::uintptr_t>(buf.data()) %
+                osvr::common::DesiredBufferAlignment::value ==
+            0);
+    buf.append('a');
+    buf.appendAligned(double(1), sizeof(double));
+    REQUIRE(buf.size() == 2 * sizeof(double));
+}
+
+TEST_CASE("StackBuffer-NoAllocationsPerReport") {
+    // Sanity check that the counter sees allocations at all.
+    auto before = g_allocations.load();
+    {
+        std::vector<char> vec(10);
+        (void)vec;
+    }
+    auto vectorAllocations = g_allocations.load() - before;
+    REQUIRE(vectorAllocations > 0);
+
+    const std::size_t reports = 1000;
+    std::size_t bytes = 0;
+    double sum = 0;
+    before = g_allocations.load();
+    for (std::size_t i = 0; i < reports; ++i) {
+        StackBuffer<> buf;
+        PoseReportMessage msg(static_cast<uint32_t>(i % 4), double(i));
+        serialize(buf, msg);
+        bytes += buf.size();
+
+        auto reader = buf.startReading();
+        PoseReportMessage out;
+        deserialize(reader, out);
+        sum += out.m_pose[0];
+    }
+    auto allocations = g_allocations.load() - before;
+    REQUIRE(bytes == reports * REPORT_SIZE);
+    REQUIRE(sum == (reports - 1) * reports / 2.);
+    REQUIRE(allocations == 0);
+}
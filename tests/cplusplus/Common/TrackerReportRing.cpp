@@ -0,0 +1,184 @@
+/** @file
+    @brief Test for the shared memory ring of tracker reports.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerReportRing.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common = osvr::common;
+using common::TrackerReportRing;
+typedef osvr::common::IPCRingBuffer::sequence_type sequence_type;
+
+TEST_CASE("TrackerReportRing-getFirstToRead") {
+    const std::size_t entries = 256;
+    SECTION("Behind by less than a ring") {
+        REQUIRE(TrackerReportRing::getFirstToRead(5, 10, entries) == 5);
+        REQUIRE(TrackerReportRing::getFirstToRead(10, 10, entries) == 10);
+    }
+    SECTION("Caught up") {
+        REQUIRE(TrackerReportRing::getFirstToRead(11, 10, entries) == 11);
+    }
+    SECTION("Overrun") {
+        REQUIRE(TrackerReportRing::getFirstToRead(0, 1000, entries) ==
+                1000 - entries + 1);
+        REQUIRE(TrackerReportRing::getFirstToRead(0, entries, entries) == 1);
+    }
+    const sequence_type max = ~sequence_type(0);
+    SECTION("Behind across the wrap") {
+        REQUIRE(TrackerReportRing::getFirstToRead(max - 5, 3, entries) ==
+                max - 5);
+    }
+    SECTION("Caught up at the wrap") {
+        REQUIRE(TrackerReportRing::getFirstToRead(0, max, entries) == 0);
+        REQUIRE(TrackerReportRing::getFirstToRead(max, max - 1, entries) ==
+                max);
+    }
+    SECTION("Overrun across the wrap") {
+        REQUIRE(TrackerReportRing::getFirstToRead(max - 1000, 100, entries) ==
+                max - 154);
+        REQUIRE(TrackerReportRing::getFirstToRead(max - 1000, 10, entries) ==
+                max - (entries - 12));
+    }
+}
+
+/// Device name unlikely to collide with another test run's.
+static std::string getUniqueDeviceName() {
+    std::random_device rd;
+    return "com_osvr_Test/TrackerReportRing" + std::to_string(rd());
+}
+
+/// The port of the server "writing" the rings.
+static const int PORT = 3883;
+
+TEST_CASE("TrackerReportRing") {
+    auto device = getUniqueDeviceName();
+    REQUIRE_FALSE(TrackerReportRing::find(device, PORT));
+    auto writer = TrackerReportRing::create(device, PORT);
+    REQUIRE(writer);
+    auto reader = TrackerReportRing::find(device, PORT);
+    REQUIRE(reader);
+    REQUIRE(reader->isWriterAlive());
+
+    std::vector<OSVR_ChannelCount> poses;
+    std::size_t velocities = 0;
+    common::TrackerReportChannel::Subscriber handlers;
+    handlers.pose = [&](OSVR_TimeValue const &, OSVR_ChannelCount sensor,
+                        OSVR_PoseState const &pose) {
+        REQUIRE(pose.translation.data[0] == 1.5);
+        poses.push_back(sensor);
+    };
+    handlers.velocity = [&](OSVR_TimeValue const &, OSVR_ChannelCount,
+                            OSVR_VelocityState const &) { ++velocities; };
+
+    OSVR_TimeValue timestamp = {};
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    pose.translation.data[0] = 1.5;
+    OSVR_VelocityState vel = {};
+
+    // Only the heartbeat from create() so far, which isn't a report.
+    REQUIRE(reader->poll(handlers) == 0);
+
+    SECTION("Reports in order") {
+        writer->sendPose(timestamp, 1, pose);
+        writer->sendVelocity(timestamp, 1, vel);
+        writer->sendPose(timestamp, 2, pose);
+        REQUIRE(reader->poll(handlers) == 3);
+        REQUIRE(poses == std::vector<OSVR_ChannelCount>({1, 2}));
+        REQUIRE(velocities == 1);
+        REQUIRE(reader->poll(handlers) == 0);
+
+        writer->sendPose(timestamp, 3, pose);
+        REQUIRE(reader->poll(handlers) == 1);
+        REQUIRE(poses.back() == 3);
+    }
+
+    SECTION("Overrun skips the overwritten reports") {
+        const OSVR_ChannelCount n = 1000;
+        for (OSVR_ChannelCount i = 0; i < n; ++i) {
+            writer->sendPose(timestamp, i, pose);
+        }
+        auto got = reader->poll(handlers);
+        REQUIRE(got > 0);
+        REQUIRE(got < n);
+        REQUIRE(poses.size() == got);
+        // The newest ones, contiguous.
+        REQUIRE(poses.back() == n - 1);
+        for (std::size_t i = 0; i < poses.size(); ++i) {
+            REQUIRE(poses[i] == n - got + i);
+        }
+        REQUIRE(reader->poll(handlers) == 0);
+    }
+
+    SECTION("Servers on other ports have rings of their own") {
+        REQUIRE_FALSE(TrackerReportRing::find(device, PORT + 1));
+        auto otherWriter = TrackerReportRing::create(device, PORT + 1);
+        REQUIRE(otherWriter);
+        auto otherReader = TrackerReportRing::find(device, PORT + 1);
+        REQUIRE(otherReader);
+        otherWriter->sendPose(timestamp, 7, pose);
+        REQUIRE(reader->poll(handlers) == 0);
+        REQUIRE(otherReader->poll(handlers) == 1);
+        REQUIRE(poses == std::vector<OSVR_ChannelCount>({7}));
+        writer->sendPose(timestamp, 8, pose);
+        REQUIRE(otherReader->poll(handlers) == 0);
+        REQUIRE(reader->poll(handlers) == 1);
+    }
+
+    SECTION("Heartbeats keep a quiet writer alive") {
+        for (int i = 0; i < 8; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            writer->heartbeat();
+            REQUIRE(reader->poll(handlers) == 0);
+            REQUIRE(reader->isWriterAlive());
+        }
+        writer->sendPose(timestamp, 4, pose);
+        REQUIRE(reader->poll(handlers) == 1);
+    }
+
+    SECTION("A writer that stops is detected") {
+        writer->sendPose(timestamp, 1, pose);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+        REQUIRE(reader->poll(handlers) == 0);
+        REQUIRE_FALSE(reader->isWriterAlive());
+        REQUIRE(poses.empty());
+        REQUIRE_FALSE(TrackerReportRing::find(device, PORT));
+
+        // Stays stale, even if it comes back: find it again instead.
+        writer->heartbeat();
+        writer->sendPose(timestamp, 2, pose);
+        REQUIRE(reader->poll(handlers) == 0);
+        REQUIRE_FALSE(reader->isWriterAlive());
+        REQUIRE(TrackerReportRing::find(device, PORT));
+    }
+}
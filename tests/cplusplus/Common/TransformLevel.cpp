@@ -0,0 +1,142 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/GeneralizedTransform.h>
+#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Common/TransformLevel.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <json/value.h>
+
+// Standard includes
+#include <stdexcept>
+
+namespace common = osvr::common;
+
+static Json::Value makeLevels() {
+    Json::Value inner(Json::objectValue);
+    inner["translate"] = Json::Value(Json::arrayValue);
+    inner["translate"].append(0.1);
+    inner["translate"].append(0.2);
+    inner["translate"].append(0.3);
+    inner["child"] = "/com_osvr_Dummy/Tracker/tracker/0";
+
+    Json::Value middle(Json::objectValue);
+    middle["changeBasis"]["x"] = "-z";
+    middle["changeBasis"]["y"] = "x";
+    middle["changeBasis"]["z"] = "-y";
+    middle["child"] = inner;
+
+    Json::Value outer(Json::objectValue);
+    outer["postrotate"]["axis"] = "y";
+    outer["postrotate"]["degrees"] = 90;
+    outer["rotate"]["axis"] = "x";
+    outer["rotate"]["radians"] = 0.5;
+    outer["child"] = middle;
+    return outer;
+}
+
+static bool sameTransform(common::Transform const &a,
+                          common::Transform const &b) {
+    return a.getPre().isApprox(b.getPre(), 1e-6) &&
+           a.getPost().isApprox(b.getPost(), 1e-6);
+}
+
+TEST_CASE("TransformLevel-parse") {
+    SECTION("Non-objects and unrelated members are identity") {
+        REQUIRE(common::TransformLevel::parse(Json::Value("/a/b"))
+                    .isIdentity());
+        Json::Value level(Json::objectValue);
+        level["calibration0"] = true;
+        REQUIRE(common::TransformLevel::parse(level).isIdentity());
+    }
+    SECTION("Translation") {
+        Json::Value level(Json::objectValue);
+        level["posttranslate"] = "-x";
+        auto xform = common::TransformLevel::parse(level).get();
+        REQUIRE(xform.getPre().isIdentity());
+        REQUIRE(xform.getPost()(0, 3) == -1);
+    }
+    SECTION("Malformed") {
+        Json::Value level(Json::objectValue);
+        level["rotate"]["axis"] = "xy";
+        level["rotate"]["degrees"] = 90;
+        REQUIRE_THROWS_AS(common::TransformLevel::parse(level),
+                          std::runtime_error);
+    }
+}
+
+TEST_CASE("GeneralizedTransform-compose") {
+    auto levels = makeLevels();
+    common::JSONTransformVisitor visitor(levels);
+
+    SECTION("Nested all at once") {
+        common::GeneralizedTransform xform(levels);
+        REQUIRE(sameTransform(xform.compose(), visitor.getTransform()));
+    }
+    SECTION("Nested one level at a time") {
+        common::GeneralizedTransform xform;
+        Json::Value level = levels;
+        while (level.isObject() && level.isMember("child")) {
+            Json::Value justThis = level;
+            justThis["child"] = "/placeholder";
+            xform.nest(justThis);
+            level = Json::Value(level["child"]);
+        }
+        REQUIRE(xform.size() == 3);
+        REQUIRE(sameTransform(xform.compose(), visitor.getTransform()));
+    }
+    SECTION("Wrapped from the inside out") {
+        common::GeneralizedTransform xform(levels["child"]);
+        Json::Value outer = levels;
+        outer.removeMember("child");
+        xform.wrap(outer);
+        REQUIRE(sameTransform(xform.compose(), visitor.getTransform()));
+    }
+    SECTION("Levels removed") {
+        common::GeneralizedTransform xform(levels);
+        common::remove_if(xform, [](Json::Value const &level) {
+            return level.isMember("changeBasis");
+        });
+        REQUIRE(xform.size() == 2);
+        common::JSONTransformVisitor expected(xform.get());
+        REQUIRE(sameTransform(xform.compose(), expected.getTransform()));
+    }
+}
+
+TEST_CASE("GeneralizedTransform-composeMalformed") {
+    auto levels = makeLevels();
+    levels["child"]["changeBasis"]["x"] = "sideways";
+    // Only reported when the transform is used.
+    common::GeneralizedTransform xform;
+    REQUIRE_NOTHROW(xform.nest(levels));
+    REQUIRE_THROWS_AS(xform.compose(), std::runtime_error);
+
+    common::remove_if(xform, [](Json::Value const &level) {
+        return level.isMember("changeBasis");
+    });
+    REQUIRE_NOTHROW(xform.compose());
+}
@@ -0,0 +1,134 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/AliasProcessor.h>
+#include <osvr/Common/WildcardAliases.h>
+
+// Library/third-party includes
+#include <boost/variant/get.hpp>
+#include <catch2/catch.hpp>
+#include <json/value.h>
+
+// Standard includes
+#include <string>
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+using namespace osvr::common::elements;
+
+static const int NUM_SENSORS = 3;
+
+static void addSensors(PathTree &tree) {
+    for (int i = 0; i < NUM_SENSORS; ++i) {
+        tree.getNodeByPath(dummy::getInterfacePath() + "/" +
+                               std::to_string(i),
+                           SensorElement());
+    }
+}
+
+static Json::Value getWildcardAliases() {
+    Json::Value aliases(Json::objectValue);
+    aliases["/me/trackers"] = dummy::getInterfacePath() + "/*";
+    return aliases;
+}
+
+static std::string getAliasSource(PathTree const &tree,
+                                  std::string const &path) {
+    auto elt = boost::get<AliasElement>(&tree.getNodeByPath(path).value());
+    REQUIRE(elt != nullptr);
+    return elt->getSource();
+}
+
+TEST_CASE("WildcardAliases-processedAfterDevice") {
+    PathTree tree;
+    dummy::setupDummyDevice(tree);
+    addSensors(tree);
+    common::WildcardAliasSet wildcards;
+    REQUIRE(common::AliasProcessor()
+                .setDefaultPriority(common::ALIASPRIORITY_MANUAL)
+                .recordWildcardsIn(wildcards)
+                .process(tree.getRoot(), getWildcardAliases()));
+    REQUIRE(wildcards.size() == 1);
+    REQUIRE(getAliasSource(tree, "/me/trackers") ==
+            dummy::getInterfacePath());
+    for (int i = 0; i < NUM_SENSORS; ++i) {
+        auto sensor = std::to_string(i);
+        REQUIRE(getAliasSource(tree, "/me/trackers/" + sensor) ==
+                dummy::getInterfacePath() + "/" + sensor);
+    }
+
+    SECTION("Re-applying changes nothing") {
+        REQUIRE_FALSE(wildcards.applyToSubtree(
+            tree.getNodeByPath(dummy::getDevicePath())));
+    }
+
+    SECTION("Processing again records nothing new") {
+        common::AliasProcessor()
+            .setDefaultPriority(common::ALIASPRIORITY_MANUAL)
+            .recordWildcardsIn(wildcards)
+            .process(tree.getRoot(), getWildcardAliases());
+        REQUIRE(wildcards.size() == 1);
+    }
+}
+
+TEST_CASE("WildcardAliases-deviceAddedLater") {
+    PathTree tree;
+    common::WildcardAliasSet wildcards;
+    common::AliasProcessor()
+        .setDefaultPriority(common::ALIASPRIORITY_MANUAL)
+        .recordWildcardsIn(wildcards)
+        .process(tree.getRoot(), getWildcardAliases());
+    REQUIRE(wildcards.size() == 1);
+
+    dummy::setupDummyDevice(tree);
+    addSensors(tree);
+    PathTree const &constTree = tree;
+    REQUIRE_THROWS(constTree.getNodeByPath("/me/trackers/0"));
+
+    SECTION("Unrelated subtree") {
+        tree.getNodeByPath("/org_example/other", DeviceElement());
+        REQUIRE_FALSE(
+            wildcards.applyToSubtree(tree.getNodeByPath("/org_example")));
+    }
+
+    SECTION("Applying to the new device") {
+        REQUIRE(wildcards.applyToSubtree(
+            tree.getNodeByPath(dummy::getDevicePath())));
+        for (int i = 0; i < NUM_SENSORS; ++i) {
+            auto sensor = std::to_string(i);
+            REQUIRE(getAliasSource(tree, "/me/trackers/" + sensor) ==
+                    dummy::getInterfacePath() + "/" + sensor);
+        }
+    }
+
+    SECTION("Applying to just one new sensor") {
+        REQUIRE(wildcards.applyToSubtree(
+            tree.getNodeByPath(dummy::getInterfacePath() + "/1")));
+        REQUIRE(getAliasSource(tree, "/me/trackers/1") ==
+                dummy::getInterfacePath() + "/1");
+        REQUIRE_THROWS(constTree.getNodeByPath("/me/trackers/0"));
+    }
+}
@@ -0,0 +1,81 @@
+/** @file
+    @brief Test for deferred loading of driver-only plugins, using an example
+    plugin from the build tree.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/Util/GetEnvironmentVariable.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+using osvr::pluginhost::RegistrationContext;
+
+/// Only registers a driver instantiation callback, so it's deferrable once
+/// the cache knows that.
+static const char DRIVER_ONLY_PLUGIN[] = "com_osvr_example_Configured";
+
+TEST_CASE("DeferredPluginLoadsOnDemand") {
+    // Set by the test harness, so we don't disturb the user's cache.
+    auto cacheFile = osvr::util::getEnvironmentVariable("OSVR_PLUGIN_CACHE");
+    REQUIRE(cacheFile.is_initialized());
+    REQUIRE_FALSE(cacheFile->empty());
+    REQUIRE(*cacheFile != "0");
+    std::remove(cacheFile->c_str());
+
+    {
+        // No manifests yet: everything gets loaded, and recorded.
+        RegistrationContext ctx;
+        ctx.loadPlugins();
+        REQUIRE_FALSE(ctx.loadDeferredPlugin(DRIVER_ONLY_PLUGIN));
+        REQUIRE_THROWS_AS(ctx.loadPlugin(DRIVER_ONLY_PLUGIN),
+                          std::runtime_error);
+    }
+
+    {
+        RegistrationContext ctx;
+        ctx.loadPlugins();
+        // Deferred, so not loaded yet...
+        REQUIRE(ctx.loadDeferredPlugin(DRIVER_ONLY_PLUGIN));
+        // ...until now, and only once.
+        REQUIRE_FALSE(ctx.loadDeferredPlugin(DRIVER_ONLY_PLUGIN));
+        REQUIRE_THROWS_AS(ctx.loadPlugin(DRIVER_ONLY_PLUGIN),
+                          std::runtime_error);
+    }
+
+    {
+        // Not deferred when loaded by name before anything asks for it.
+        RegistrationContext ctx;
+        ctx.loadPlugin(DRIVER_ONLY_PLUGIN);
+        ctx.loadPlugins();
+        REQUIRE_FALSE(ctx.loadDeferredPlugin(DRIVER_ONLY_PLUGIN));
+    }
+    std::remove(cacheFile->c_str());
+}
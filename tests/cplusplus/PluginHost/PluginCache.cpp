@@ -0,0 +1,185 @@
+/** @file
+    @brief Test for the on-disk plugin discovery cache.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "PluginCache.h"
+
+// Library/third-party includes
+#include <boost/filesystem.hpp>
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+using osvr::pluginhost::FileList;
+using osvr::pluginhost::PluginCache;
+using osvr::pluginhost::SearchPath;
+using osvr::pluginhost::canDeferLoading;
+namespace fs = boost::filesystem;
+
+static const char EXT[] = ".plugin";
+
+/// A scratch directory of fake plugin files, plus a cache file beside it,
+/// removed when done.
+class ScratchPlugins {
+  public:
+    ScratchPlugins()
+        : m_root(fs::temp_directory_path() /
+                 fs::unique_path("osvr-plugincache-%%%%-%%%%-%%%%")) {
+        fs::create_directories(dir());
+    }
+    ~ScratchPlugins() {
+        boost::system::error_code ec;
+        fs::remove_all(m_root, ec);
+    }
+    fs::path dir() const { return m_root / "plugins"; }
+    std::string cacheFile() const {
+        return (m_root / "PluginCache.txt").string();
+    }
+    SearchPath searchPath() const {
+        return SearchPath{dir().generic_string()};
+    }
+
+    /// Creates or appends to a plugin file, returning its path as
+    /// PluginCache reports it.
+    std::string write(std::string const &name, std::string const &contents) {
+        std::ofstream file((dir() / (name + EXT)).string(), std::ios::app);
+        file << contents;
+        return path(name);
+    }
+    std::string path(std::string const &name) const {
+        auto files = osvr::pluginhost::getAllFilesWithExt(searchPath(), EXT);
+        auto it = std::find_if(
+            begin(files), end(files), [&](std::string const &file) {
+                return fs::path(file).stem().string() == name;
+            });
+        return it == end(files) ? std::string() : *it;
+    }
+
+  private:
+    fs::path m_root;
+};
+
+static bool contains(FileList const &files, std::string const &file) {
+    return std::find(begin(files), end(files), file) != end(files);
+}
+
+TEST_CASE("PluginCache") {
+    ScratchPlugins scratch;
+    const auto driverOnly = scratch.write("driverOnly", "abc");
+    const auto detecting = scratch.write("detecting", "abc");
+    REQUIRE_FALSE(driverOnly.empty());
+    REQUIRE_FALSE(detecting.empty());
+
+    // First run: nothing known, record what "loading" found, and save.
+    {
+        PluginCache cache(scratch.cacheFile());
+        auto files = cache.getAllFilesWithExt(scratch.searchPath(), EXT);
+        REQUIRE(files.size() == 2);
+        REQUIRE(contains(files, driverOnly));
+        REQUIRE(contains(files, detecting));
+        REQUIRE(cache.getManifest(driverOnly) == nullptr);
+        cache.recordManifest(driverOnly, false, false, {"Driver"});
+        cache.recordManifest(detecting, true, false, {"Other"});
+        REQUIRE(cache.save());
+    }
+    REQUIRE(fs::exists(scratch.cacheFile()));
+
+    SECTION("Cache hit") {
+        // Add a file without changing the directory's recorded mtime: only
+        // the cached listing can make it not show up.
+        const auto dirTime = fs::last_write_time(scratch.dir());
+        const auto added = scratch.write("added", "abc");
+        fs::last_write_time(scratch.dir(), dirTime);
+
+        PluginCache cache(scratch.cacheFile());
+        auto files = cache.getAllFilesWithExt(scratch.searchPath(), EXT);
+        REQUIRE(files.size() == 2);
+        REQUIRE_FALSE(contains(files, added));
+
+        auto manifest = cache.getManifest(driverOnly);
+        REQUIRE(manifest != nullptr);
+        REQUIRE(manifest->drivers == std::vector<std::string>{"Driver"});
+        REQUIRE(canDeferLoading(*manifest));
+
+        manifest = cache.getManifest(detecting);
+        REQUIRE(manifest != nullptr);
+        REQUIRE(manifest->hardwareDetect);
+        REQUIRE_FALSE(canDeferLoading(*manifest));
+    }
+
+    SECTION("Directory change triggers a new walk") {
+        const auto dirTime = fs::last_write_time(scratch.dir());
+        const auto added = scratch.write("added", "abc");
+        fs::last_write_time(scratch.dir(), dirTime + 10);
+
+        PluginCache cache(scratch.cacheFile());
+        auto files = cache.getAllFilesWithExt(scratch.searchPath(), EXT);
+        REQUIRE(files.size() == 3);
+        REQUIRE(contains(files, added));
+        REQUIRE(cache.getManifest(added) == nullptr);
+        // Unchanged files keep their manifests.
+        REQUIRE(cache.getManifest(driverOnly) != nullptr);
+    }
+
+    SECTION("Size change invalidates the manifest") {
+        const auto fileTime = fs::last_write_time(driverOnly);
+        scratch.write("driverOnly", "def");
+        fs::last_write_time(driverOnly, fileTime);
+
+        PluginCache cache(scratch.cacheFile());
+        cache.getAllFilesWithExt(scratch.searchPath(), EXT);
+        REQUIRE(cache.getManifest(driverOnly) == nullptr);
+        REQUIRE(cache.getManifest(detecting) != nullptr);
+    }
+
+    SECTION("Modification time change invalidates the manifest") {
+        fs::last_write_time(driverOnly, fs::last_write_time(driverOnly) + 10);
+
+        PluginCache cache(scratch.cacheFile());
+        cache.getAllFilesWithExt(scratch.searchPath(), EXT);
+        REQUIRE(cache.getManifest(driverOnly) == nullptr);
+        REQUIRE(cache.getManifest(detecting) != nullptr);
+
+        SECTION("and the invalidation is saved") {
+            REQUIRE(cache.save());
+            PluginCache reloaded(scratch.cacheFile());
+            REQUIRE(reloaded.getManifest(driverOnly) == nullptr);
+        }
+    }
+
+    SECTION("Malformed cache is treated as empty") {
+        {
+            std::ofstream file(scratch.cacheFile(), std::ios::trunc);
+            file << "not a plugin cache\n";
+        }
+        PluginCache cache(scratch.cacheFile());
+        REQUIRE(cache.getManifest(driverOnly) == nullptr);
+        auto files = cache.getAllFilesWithExt(scratch.searchPath(), EXT);
+        REQUIRE(files.size() == 2);
+    }
+}
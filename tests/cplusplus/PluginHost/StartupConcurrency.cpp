@@ -0,0 +1,164 @@
+/** @file
+    @brief Tests for the helpers behind concurrent plugin startup.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "StartupConcurrency.h"
+#include <osvr/PluginHost/HostAccess.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using osvr::pluginhost::HostAccessSequencer;
+using osvr::pluginhost::forEachConcurrently;
+using osvr::pluginhost::getHostAccessCount;
+using osvr::pluginhost::waitForHostAccess;
+
+TEST_CASE("forEachConcurrently-visits-every-index-once") {
+    std::size_t n = 0;
+    std::size_t threads = 0;
+    SECTION("nothing to do") {
+        n = 0;
+        threads = 4;
+    }
+    SECTION("serial") {
+        n = 20;
+        threads = 1;
+    }
+    SECTION("more threads than work") {
+        n = 3;
+        threads = 8;
+    }
+    SECTION("more work than threads") {
+        n = 200;
+        threads = 4;
+    }
+    std::vector<std::atomic<int> > visits(n);
+    for (auto &v : visits) {
+        v = 0;
+    }
+    forEachConcurrently(n, threads, [&](std::size_t i) { ++visits.at(i); });
+    for (std::size_t i = 0; i < n; ++i) {
+        INFO("index " << i);
+        REQUIRE(visits[i] == 1);
+    }
+}
+
+TEST_CASE("forEachConcurrently-thread-use") {
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    auto recordThread = [&](std::size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::lock_guard<std::mutex> lock(mutex);
+        ids.insert(std::this_thread::get_id());
+    };
+    SECTION("a single thread is the caller's") {
+        forEachConcurrently(10, 1, recordThread);
+        REQUIRE(ids.size() == 1);
+        REQUIRE(*ids.begin() == std::this_thread::get_id());
+    }
+    SECTION("never more threads than asked for") {
+        forEachConcurrently(40, 3, recordThread);
+        REQUIRE(ids.size() <= 3);
+        REQUIRE(ids.count(std::this_thread::get_id()) == 1);
+    }
+}
+
+TEST_CASE("waitForHostAccess-without-sequencer") {
+    auto before = getHostAccessCount();
+    // Must return right away: nothing is sequencing.
+    waitForHostAccess();
+    waitForHostAccess();
+    REQUIRE(getHostAccessCount() == before + 2);
+}
+
+TEST_CASE("HostAccessSequencer-orders-host-access-by-ticket") {
+    static const std::size_t NUM_TASKS = 8;
+    std::mutex mutex;
+    std::vector<std::size_t> order;
+    {
+        HostAccessSequencer sequencer(NUM_TASKS);
+        forEachConcurrently(NUM_TASKS, 4, [&](std::size_t ticket) {
+            sequencer.beginTask(ticket);
+            // Later tickets finish "probing" sooner, so without the
+            // sequencer they would reach the host first.
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(4 * (NUM_TASKS - ticket)));
+            if (ticket % 3 != 1) {
+                // Some tasks never touch the host: they must still let
+                // the rest through once they're done.
+                waitForHostAccess();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    order.push_back(ticket);
+                }
+                // Having had its turn, a task keeps it.
+                waitForHostAccess();
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(ticket);
+            }
+            sequencer.endTask(ticket);
+        });
+    }
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < NUM_TASKS; ++i) {
+        if (i % 3 != 1) {
+            expected.push_back(i);
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(order == expected);
+}
+
+TEST_CASE("HostAccessSequencer-ignores-other-threads") {
+    HostAccessSequencer sequencer(2);
+    std::atomic<bool> secondGotAccess(false);
+    std::thread second([&] {
+        sequencer.beginTask(1);
+        waitForHostAccess();
+        secondGotAccess = true;
+        sequencer.endTask(1);
+    });
+    // Ticket 0 hasn't finished, so ticket 1 is kept waiting...
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK_FALSE(secondGotAccess);
+    // ...while threads not running a task pass straight through.
+    waitForHostAccess();
+    std::thread other([] { waitForHostAccess(); });
+    other.join();
+    CHECK_FALSE(secondGotAccess);
+
+    sequencer.beginTask(0);
+    sequencer.endTask(0);
+    second.join();
+    REQUIRE(secondGotAccess);
+}
@@ -0,0 +1,263 @@
+/** @file
+    @brief Test for the asynchronous log sink and the rate-limited logger.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "AsyncLogSink.h"
+#include <osvr/Util/Logger.h>
+#include <osvr/Util/RateLimitedLogger.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/sink.h>
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::util::log::AsyncOverflowPolicy;
+using osvr::util::log::async_sink;
+
+namespace {
+/// Records what it's asked to do, in order. Optionally holds the first
+/// message until released, to stall the async sink's worker.
+class RecordingSink : public spdlog::sinks::sink {
+  public:
+    explicit RecordingSink(bool gated = false) : m_gated(gated) {}
+
+    void log(const spdlog::details::log_msg &msg) override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_entered = true;
+        m_cv.notify_all();
+        m_cv.wait(lock, [&] { return !m_gated; });
+        m_events.push_back(msg.raw.str());
+    }
+
+    void flush() override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_events.push_back(FLUSH);
+    }
+
+    /// Waits for the first message to reach the sink.
+    void waitForEntry() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&] { return m_entered; });
+    }
+
+    void open() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_gated = false;
+        m_cv.notify_all();
+    }
+
+    std::vector<std::string> events() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_events;
+    }
+
+    static const char *FLUSH;
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_gated;
+    bool m_entered = false;
+    std::vector<std::string> m_events;
+};
+const char *RecordingSink::FLUSH = "<flush>";
+
+void logText(async_sink &sink, std::string const &text) {
+    static const std::string name = "test";
+    spdlog::details::log_msg msg(&name, spdlog::level::info);
+    msg.raw << text;
+    msg.formatted << text;
+    sink.log(msg);
+}
+
+/// Checks that the messages are "0" through "n-1", in order.
+void requireNumbered(std::vector<std::string> const &messages, std::size_t n) {
+    REQUIRE(messages.size() == n);
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(messages[i] == std::to_string(i));
+    }
+}
+} // namespace
+
+TEST_CASE("AsyncLogSink-concurrent-producers") {
+    auto recorder = std::make_shared<RecordingSink>();
+    /// Small enough that producers keep running into a full queue.
+    async_sink sink({recorder}, 16, AsyncOverflowPolicy::Block);
+    REQUIRE(sink.capacity() == 16);
+
+    const int producers = 4;
+    const int messagesEach = 2000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&sink, p] {
+            for (int i = 0; i < messagesEach; ++i) {
+                logText(sink, std::to_string(p) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    sink.drain();
+    REQUIRE(sink.dropped() == 0);
+
+    /// Every message arrives, each producer's in the order it sent them.
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    for (auto const &event : recorder->events()) {
+        if (event == RecordingSink::FLUSH) {
+            continue;
+        }
+        auto colon = event.find(':');
+        REQUIRE(colon != std::string::npos);
+        auto p = std::stoi(event.substr(0, colon));
+        auto i = std::stoi(event.substr(colon + 1));
+        REQUIRE(p >= 0);
+        REQUIRE(p < producers);
+        REQUIRE(i == next[p]);
+        ++next[p];
+        ++received;
+    }
+    REQUIRE(received == producers * messagesEach);
+}
+
+TEST_CASE("AsyncLogSink-drop-when-full") {
+    auto recorder = std::make_shared<RecordingSink>(true);
+    async_sink sink({recorder}, 8, AsyncOverflowPolicy::Drop);
+    auto capacity = sink.capacity();
+
+    /// The worker takes the first message and gets stuck in the sink,
+    /// without freeing its slot.
+    logText(sink, "0");
+    recorder->waitForEntry();
+    for (std::size_t i = 1; i < capacity; ++i) {
+        logText(sink, std::to_string(i));
+    }
+    REQUIRE(sink.dropped() == 0);
+
+    /// Now every slot is in use.
+    const int extra = 10;
+    for (int i = 0; i < extra; ++i) {
+        logText(sink, "dropped");
+    }
+    REQUIRE(sink.dropped() == extra);
+
+    recorder->open();
+    sink.drain();
+    auto events = recorder->events();
+    REQUIRE(events.back() == RecordingSink::FLUSH);
+    events.pop_back();
+    requireNumbered(events, capacity);
+
+    /// Room again once the queue has drained.
+    logText(sink, "after");
+    sink.drain();
+    REQUIRE(sink.dropped() == extra);
+}
+
+TEST_CASE("AsyncLogSink-drain-and-destruction-order") {
+    auto recorder = std::make_shared<RecordingSink>();
+    std::unique_ptr<async_sink> sink(
+        new async_sink({recorder}, 64, AsyncOverflowPolicy::Block));
+    const std::size_t n = 200;
+    for (std::size_t i = 0; i < n; ++i) {
+        logText(*sink, std::to_string(i));
+    }
+
+    SECTION("Drain writes everything queued, then flushes") {
+        sink->drain();
+        auto events = recorder->events();
+        REQUIRE(events.back() == RecordingSink::FLUSH);
+        events.pop_back();
+        requireNumbered(events, n);
+    }
+
+    SECTION("Destruction writes everything queued, then flushes") {
+        sink.reset();
+        auto events = recorder->events();
+        REQUIRE(events.back() == RecordingSink::FLUSH);
+        events.pop_back();
+        requireNumbered(events, n);
+    }
+}
+
+namespace {
+/// Counts how many times it has been formatted.
+struct CountFormatting {
+    int *count;
+};
+std::ostream &operator<<(std::ostream &os, CountFormatting const &c) {
+    ++(*c.count);
+    return os << "formatted";
+}
+} // namespace
+
+TEST_CASE("RateLimitedLogger-discards-without-formatting") {
+    using osvr::util::log::Logger;
+    using osvr::util::log::RateLimitedLogger;
+    auto recorder = std::make_shared<RecordingSink>();
+    auto logger = Logger::makeWithSink("RateLimitedLoggerTest", recorder);
+
+    SECTION("Over the limit") {
+        RateLimitedLogger limited(logger, 3, std::chrono::hours(1));
+        int formatted = 0;
+        for (int i = 0; i < 10; ++i) {
+            limited.warn() << "message " << CountFormatting{&formatted};
+        }
+        REQUIRE(formatted == 3);
+        REQUIRE(limited.getSuppressedCount() == 7);
+        REQUIRE(recorder->events().size() == 3);
+    }
+
+    SECTION("Suppressed messages are noted once under the limit again") {
+        RateLimitedLogger limited(logger, 1, std::chrono::milliseconds(50));
+        limited.warn() << "first";
+        limited.warn() << "second";
+        limited.warn() << "third";
+        auto suppressed = limited.getSuppressedCount();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        limited.warn() << "last";
+        REQUIRE(limited.getSuppressedCount() == 0);
+        auto events = recorder->events();
+        REQUIRE(events.front().find("first") != std::string::npos);
+        auto const &last = events.back();
+        REQUIRE(last.find("last") != std::string::npos);
+        if (suppressed > 0) {
+            REQUIRE(last.find("(" + std::to_string(suppressed) +
+                              " earlier messages suppressed)") !=
+                    std::string::npos);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/KeyedOwnershipContainer.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <vector>
+
+using osvr::util::MultipleKeyedOwnershipContainer;
+using osvr::make_shared;
+using osvr::shared_ptr;
+
+TEST_CASE("MultipleKeyedOwnershipContainer-references") {
+    MultipleKeyedOwnershipContainer container;
+    auto obj = make_shared<int>(5);
+    REQUIRE(obj.use_count() == 1);
+    REQUIRE(container.acquire(obj) == obj.get());
+    REQUIRE(container.acquire(obj) == obj.get());
+    REQUIRE(obj.use_count() == 3);
+
+    REQUIRE(container.release(obj.get()));
+    REQUIRE(obj.use_count() == 2);
+    REQUIRE(container.release(obj.get()));
+    REQUIRE(obj.use_count() == 1);
+    REQUIRE_FALSE(container.release(obj.get()));
+}
+
+TEST_CASE("MultipleKeyedOwnershipContainer-find") {
+    MultipleKeyedOwnershipContainer container;
+    int data[2];
+    auto obj = make_shared<double>(1.5);
+    container.acquire(&data[0], obj);
+    REQUIRE(container.find<shared_ptr<double>>(&data[0]) != nullptr);
+    REQUIRE(**container.find<shared_ptr<double>>(&data[0]) == 1.5);
+    REQUIRE(container.find<shared_ptr<int>>(&data[0]) == nullptr);
+    REQUIRE(container.find<shared_ptr<double>>(&data[1]) == nullptr);
+    REQUIRE(container.release(&data[0]));
+    REQUIRE(container.find<shared_ptr<double>>(&data[0]) == nullptr);
+}
+
+TEST_CASE("MultipleKeyedOwnershipContainer-find-by-type") {
+    MultipleKeyedOwnershipContainer container;
+    int data;
+    container.acquire(&data, make_shared<double>(1.5));
+    container.acquire(&data, make_shared<int>(3));
+    REQUIRE(container.find<shared_ptr<int>>(&data) != nullptr);
+    REQUIRE(**container.find<shared_ptr<int>>(&data) == 3);
+    REQUIRE(container.find<shared_ptr<double>>(&data) != nullptr);
+    REQUIRE(**container.find<shared_ptr<double>>(&data) == 1.5);
+    REQUIRE(container.find<shared_ptr<float>>(&data) == nullptr);
+}
+
+TEST_CASE("MultipleKeyedOwnershipContainer-many") {
+    MultipleKeyedOwnershipContainer container;
+    std::vector<shared_ptr<int>> objects;
+    for (int i = 0; i < 1000; ++i) {
+        objects.push_back(make_shared<int>(i));
+        container.acquire(objects.back());
+    }
+    // Release every other one, then acquire them again: reusing slots of
+    // released entries, and growing past them.
+    for (int i = 0; i < 1000; i += 2) {
+        REQUIRE(container.release(objects[i].get()));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(objects[i].use_count() == (i % 2 == 0 ? 1 : 2));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        container.acquire(objects[i]);
+    }
+    for (auto const &obj : objects) {
+        REQUIRE(obj.use_count() == 2);
+        REQUIRE(container.find<shared_ptr<int>>(obj.get()) != nullptr);
+    }
+    for (auto const &obj : objects) {
+        REQUIRE(container.release(obj.get()));
+        REQUIRE(obj.use_count() == 1);
+    }
+}
@@ -0,0 +1,134 @@
+/** @file
+    @brief Test comparing the One Euro filter bank against per-sensor filters.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Util/EigenFilters.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using osvr::util::filters::PoseOneEuroFilterBankd;
+using osvr::util::filters::PoseOneEuroFilterd;
+using osvr::util::filters::one_euro::Params;
+
+namespace {
+/// Some smooth, per-sensor-distinct motion.
+Eigen::Vector3d positionAt(std::size_t sensor, double t) {
+    auto s = static_cast<double>(sensor);
+    return Eigen::Vector3d(std::sin(t + s), std::cos(2. * t) * s, 0.1 * t);
+}
+Eigen::Quaterniond orientationAt(std::size_t sensor, double t) {
+    auto s = static_cast<double>(sensor);
+    return Eigen::Quaterniond(
+        Eigen::AngleAxisd(std::sin(3. * t) + s, Eigen::Vector3d::UnitY()) *
+        Eigen::AngleAxisd(0.5 * t, Eigen::Vector3d::UnitX()));
+}
+static const Params POSITION_PARAMS{1.5, 0.8, 1.2};
+static const Params ORI_PARAMS{1., 0.3, 1.};
+} // namespace
+
+TEST_CASE("OneEuroFilterBank") {
+    static const std::size_t SENSORS = 5;
+    PoseOneEuroFilterBankd bank(POSITION_PARAMS, ORI_PARAMS);
+    std::vector<PoseOneEuroFilterd> reference(
+        SENSORS, PoseOneEuroFilterd(POSITION_PARAMS, ORI_PARAMS));
+    auto requireSame = [&](std::size_t sensor) {
+        auto &ref = reference[sensor];
+        REQUIRE(bank.getPosition(sensor).isApprox(ref.getPosition()));
+        REQUIRE(bank.getOrientation(sensor).coeffs().isApprox(
+            ref.getOrientation().coeffs()));
+        REQUIRE(bank.getLinearVelocityMagnitude(sensor) ==
+                Approx(ref.getLinearVelocityMagnitude()));
+        REQUIRE(bank.getAngularVelocityMagnitude(sensor) ==
+                Approx(ref.getAngularVelocityMagnitude()));
+    };
+
+    SECTION("Full frames match per-sensor filters") {
+        const double dt = 0.01;
+        for (int frame = 0; frame < 200; ++frame) {
+            auto t = frame * dt;
+            for (std::size_t s = 0; s < SENSORS; ++s) {
+                bank.addToFrame(s, dt, positionAt(s, t), orientationAt(s, t));
+                reference[s].filter(dt, positionAt(s, t), orientationAt(s, t));
+            }
+            REQUIRE(bank.frameSize() == SENSORS);
+            bank.filterFrame();
+            REQUIRE(bank.frameSize() == 0);
+            for (std::size_t s = 0; s < SENSORS; ++s) {
+                requireSame(s);
+            }
+        }
+        REQUIRE(bank.size() == SENSORS);
+    }
+
+    SECTION("Partial frames and per-sensor rates") {
+        for (int frame = 0; frame < 300; ++frame) {
+            // Sensor s reports every (s + 1)th frame, in reverse order.
+            for (std::size_t i = 0; i < SENSORS; ++i) {
+                auto s = SENSORS - 1 - i;
+                if (frame % (s + 1) != 0) {
+                    continue;
+                }
+                auto dt = 0.005 * static_cast<double>(s + 1);
+                auto t = frame * 0.005;
+                bank.addToFrame(s, dt, positionAt(s, t), orientationAt(s, t));
+                reference[s].filter(dt, positionAt(s, t), orientationAt(s, t));
+                REQUIRE(bank.isPending(s));
+            }
+            bank.filterFrame();
+            for (std::size_t s = 0; s < SENSORS; ++s) {
+                REQUIRE_FALSE(bank.isPending(s));
+                if (frame % (s + 1) == 0) {
+                    requireSame(s);
+                }
+            }
+        }
+    }
+
+    SECTION("Bad dt reuses the sensor's last good dt") {
+        PoseOneEuroFilterd ref(POSITION_PARAMS, ORI_PARAMS);
+        const double dt = 0.02;
+        for (int frame = 0; frame < 50; ++frame) {
+            auto t = frame * dt;
+            // Every tenth report comes with a duplicate timestamp.
+            auto reportedDt = (frame % 10 == 5) ? 0. : dt;
+            bank.addToFrame(2, reportedDt, positionAt(2, t),
+                            orientationAt(2, t));
+            ref.filter(dt, positionAt(2, t), orientationAt(2, t));
+            bank.filterFrame();
+            REQUIRE(bank.getPosition(2).isApprox(ref.getPosition()));
+            REQUIRE(bank.getOrientation(2).coeffs().isApprox(
+                ref.getOrientation().coeffs()));
+        }
+        // Grown on demand, untouched sensors stay at their initial state.
+        REQUIRE(bank.size() == 3);
+        REQUIRE(bank.getPosition(0).isZero());
+    }
+}
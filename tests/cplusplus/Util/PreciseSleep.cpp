@@ -0,0 +1,112 @@
+/** @file
+    @brief Test for precise sleeps and periodic deadlines.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Util/PreciseSleep.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+
+using namespace osvr::util::time;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST_CASE("SleepUntilNeverReturnsEarly") {
+    for (int i = 0; i < 20; ++i) {
+        auto deadline = PreciseClock::now() + microseconds(500);
+        sleepUntil(deadline);
+        REQUIRE(PreciseClock::now() >= deadline);
+    }
+}
+
+TEST_CASE("HybridSleepNeverReturnsEarly") {
+    for (int i = 0; i < 20; ++i) {
+        auto deadline = PreciseClock::now() + microseconds(500);
+        sleepUntil(deadline, microseconds(200));
+        REQUIRE(PreciseClock::now() >= deadline);
+    }
+    SECTION("spin longer than the sleep") {
+        auto deadline = PreciseClock::now() + microseconds(100);
+        sleepUntil(deadline, milliseconds(1));
+        REQUIRE(PreciseClock::now() >= deadline);
+    }
+}
+
+TEST_CASE("SleepForPastDeadlineReturns") {
+    auto start = PreciseClock::now();
+    sleepUntil(start - milliseconds(1));
+    sleepFor(microseconds(0));
+    sleepFor(microseconds(-5), microseconds(10));
+    REQUIRE(PreciseClock::now() - start < milliseconds(100));
+}
+
+TEST_CASE("PeriodicDeadlineCadence") {
+    const microseconds period(1000);
+    PeriodicDeadline deadline(period);
+    REQUIRE(deadline.getPeriod() == period);
+    deadline.restart();
+    auto first = deadline.nextDeadline();
+    for (int i = 1; i <= 5; ++i) {
+        auto expected = deadline.nextDeadline();
+        auto late = deadline.wait();
+        REQUIRE(late >= PeriodicDeadline::duration::zero());
+        if (deadline.missedDeadlines() == 0) {
+            // Deadlines advance by exactly one period, regardless of how
+            // late each wakeup was.
+            REQUIRE(deadline.nextDeadline() == expected + period);
+            REQUIRE(deadline.nextDeadline() == first + i * period);
+        }
+    }
+}
+
+TEST_CASE("PeriodicDeadlineSkipsMissedDeadlines") {
+    const milliseconds period(1);
+    PeriodicDeadline deadline(period);
+    deadline.restart();
+    // Stall for several periods.
+    sleepFor(milliseconds(10));
+    auto before = deadline.nextDeadline();
+    deadline.wait();
+    auto now = PreciseClock::now();
+    REQUIRE(deadline.missedDeadlines() >= 8);
+    // Back on the original cadence, with the next deadline in the future.
+    REQUIRE(deadline.nextDeadline() > now - period);
+    REQUIRE((deadline.nextDeadline() - before) % period ==
+            PeriodicDeadline::duration::zero());
+}
+
+TEST_CASE("PeriodicDeadlineSetPeriodRestarts") {
+    PeriodicDeadline deadline(milliseconds(1));
+    deadline.setPeriod(microseconds(300));
+    deadline.setSpin(microseconds(100));
+    REQUIRE(deadline.getSpin() == microseconds(100));
+    auto start = PreciseClock::now();
+    auto late = deadline.wait();
+    REQUIRE(late >= PeriodicDeadline::duration::zero());
+    REQUIRE(PreciseClock::now() - start >= microseconds(300));
+}
@@ -0,0 +1,95 @@
+/** @file
+    @brief Test for thread scheduling configuration helpers.
+
+    @date 2017
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2017 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Util/ThreadScheduling.h>
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <string>
+
+using namespace osvr::util::sched;
+
+TEST_CASE("ThreadRoleNames") {
+    for (std::size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        auto role = static_cast<ThreadRole>(i);
+        ThreadRole parsed = ThreadRole::Server;
+        REQUIRE(parseThreadRoleName(getThreadRoleName(role), parsed));
+        REQUIRE(parsed == role);
+    }
+    ThreadRole unused;
+    REQUIRE_FALSE(parseThreadRoleName("renderer", unused));
+}
+
+TEST_CASE("SchedulingPolicyNames") {
+    SchedulingPolicy policy = SchedulingPolicy::Default;
+    REQUIRE(parseSchedulingPolicy("fifo", policy));
+    REQUIRE(policy == SchedulingPolicy::Fifo);
+    REQUIRE(parseSchedulingPolicy("rr", policy));
+    REQUIRE(policy == SchedulingPolicy::RoundRobin);
+    REQUIRE(parseSchedulingPolicy("default", policy));
+    REQUIRE(policy == SchedulingPolicy::Default);
+    REQUIRE_FALSE(parseSchedulingPolicy("SCHED_FIFO", policy));
+}
+
+TEST_CASE("DefaultRealtimeConfigIsNoOp") {
+    setRealtimeConfig(RealtimeConfig{});
+    REQUIRE(applyThreadRole(ThreadRole::Tracker));
+    REQUIRE_FALSE(lockProcessMemory());
+    // Balanced even though nothing was locked.
+    unlockProcessMemory();
+}
+
+TEST_CASE("RealtimeConfigRoundTrip") {
+    RealtimeConfig config;
+    config[ThreadRole::Tracker].policy = SchedulingPolicy::Fifo;
+    config[ThreadRole::Tracker].priority = 50;
+    config[ThreadRole::Tracker].cpus = {2, 3};
+    setRealtimeConfig(config);
+    auto copy = getRealtimeConfig();
+    REQUIRE(copy[ThreadRole::Tracker].policy == SchedulingPolicy::Fifo);
+    REQUIRE(copy[ThreadRole::Tracker].priority == 50);
+    REQUIRE(copy[ThreadRole::Tracker].cpus.size() == 2);
+    REQUIRE(copy[ThreadRole::Server].policy == SchedulingPolicy::Default);
+    setRealtimeConfig(RealtimeConfig{});
+}
+
+TEST_CASE("JitterStats") {
+    JitterStats stats;
+    REQUIRE(stats.count() == 0);
+    REQUIRE(stats.mean() == 0.);
+    stats.record(10.);
+    stats.record(20.);
+    stats.record(30.);
+    REQUIRE(stats.count() == 3);
+    REQUIRE(stats.mean() == Approx(20.));
+    REQUIRE(stats.max() == Approx(30.));
+    REQUIRE(stats.stddev() == Approx(8.16497));
+    stats.reset();
+    REQUIRE(stats.count() == 0);
+    REQUIRE(stats.max() == 0.);
+}
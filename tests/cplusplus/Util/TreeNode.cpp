@@ -370,3 +370,47 @@ TEST_CASE("TreeNode-ParentPointers") {
     ParentCheckerVisitor visitor;
     visitor(*tree);
 }
+
+TEST_CASE("TreeNode-ManyChildren") {
+    // Enough children to switch from linear search to the hashed index.
+    const int numChildren = 100;
+    IntTreePtr tree(IntTree::createRoot());
+    for (int i = 0; i < numChildren; ++i) {
+        IntTree::create(*tree, "child" + std::to_string(i), i);
+    }
+    REQUIRE(tree->numChildren() == numChildren);
+
+    SECTION("Lookup finds every child") {
+        for (int i = 0; i < numChildren; ++i) {
+            auto name = "child" + std::to_string(i);
+            REQUIRE(tree->getChildByName(name).value() == i);
+            REQUIRE(tree->getOrCreateChildByName(name).getName() == name);
+        }
+        REQUIRE(tree->numChildren() == numChildren);
+    }
+
+    SECTION("Missing children") {
+        REQUIRE(tree->findChildByName("child") == nullptr);
+        REQUIRE_THROWS_AS(tree->getChildByName("child100"),
+                          osvr::util::tree::NoSuchChild);
+        REQUIRE_NOTHROW(tree->getOrCreateChildByName("child100").value() = 5);
+        REQUIRE(tree->numChildren() == numChildren + 1);
+        REQUIRE(tree->getChildByName("child100").value() == 5);
+    }
+
+    SECTION("Lookup by a substring of a longer buffer") {
+        std::string buf = "child42/more";
+        boost::string_ref name(buf.data(), 7);
+        REQUIRE(tree->getChildByName(name).value() == 42);
+    }
+
+    SECTION("Visit order is creation order") {
+        int expected = 0;
+        auto visitor = [&](IntTree const &child) {
+            REQUIRE(child.value() == expected);
+            ++expected;
+        };
+        tree->visitConstChildren(visitor);
+        REQUIRE(expected == numChildren);
+    }
+}